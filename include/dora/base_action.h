@@ -53,7 +53,7 @@ struct rvp_t;
  *
  ********************************************************************/
 
-class base_action_t
+class base_action_t : public cache_link_t
 {
 public:
 
@@ -101,7 +101,7 @@ protected:
 public:
 
     base_action_t() :
-        _prvp(NULL), _xct(NULL), _keys_needed(0), 
+        cache_link_t(), _prvp(NULL), _xct(NULL), _keys_needed(0), 
         _read_only(false), _keys_set(0), _secondary(false)
     { }
 
@@ -74,6 +74,16 @@ protected:
     // processor binding
     processorid_t _prs_id;
 
+    // NUMA node the queues, pools and lock manager are allocated on,
+    // -1 if not placed
+    int           _node;
+
+    // Load accounting, read by the repartitioner:
+    // actions enqueued so far, and committed actions whose locks are
+    // not released yet
+    uint_t volatile _enqueued;
+    uint_t volatile _unreleased;
+
 public:
 
     base_partition_t(ShoreEnv* env, table_desc_t* ptable, 
@@ -85,6 +95,13 @@ public:
     uint part_id() const { return (_part_id); }
     void set_part_id(const uint pid);
     table_desc_t* table() const { return (_table); } 
+    int node() const { return (_node); }
+
+    uint_t enqueued() const { return (*&_enqueued); }
+    uint_t unreleased() const { return (*&_unreleased); }
+
+    // called by the owner after it releases the locks of a committed action
+    void released() { atomic_dec_uint(&_unreleased); }
 
     // partition policy
     ePartitionPolicy get_part_policy();
@@ -119,6 +136,9 @@ public:
     virtual void statistics(worker_stats_t& gather)=0;
     virtual void stlsize(uint& gather)=0;
 
+    // a copy of the stats of the owner, which leaves them untouched
+    virtual void peek_stats(worker_stats_t& stats)=0;
+
     // dumps information
     virtual void dump();
 
@@ -186,7 +186,7 @@ const int ACTIONS_PER_RVP_POOL_SZ = 30; // should be comparable with batch_sz
         guard< object_cache_t<Type> > _cache;           \
         Type##_cache() {                                \
             _cache = new object_cache_t<Type>(); }      \
-        ~Type##_cache() { _cache.done(); } };
+        ~Type##_cache() { _cache.release()->retire(); } };
 
 
 #define DECLARE_TLS_RVP_CACHE(Type)              \
@@ -204,7 +204,7 @@ const int ACTIONS_PER_RVP_POOL_SZ = 30; // should be comparable with batch_sz
         guard<Pool> _dtPool;                                            \
         Type##_cache() {                                                \
             _cache = new object_cache_t<Type>(); }                      \
-        ~Type##_cache() { _cache.done(); } };
+        ~Type##_cache() { _cache.release()->retire(); } };
 
 
 
@@ -114,7 +114,7 @@ class dora_notifier_t;
 class dora_flusher_t : public flusher_t
 {   
 public:
-    typedef srmwqueue<terminal_rvp_t>    DoraQueue;
+    typedef WorkerQueue<terminal_rvp_t>::Type DoraQueue;
 
 private:
 
@@ -160,7 +160,7 @@ public:
 class dora_notifier_t : public base_worker_t
 {   
 public:
-    typedef srmwqueue<terminal_rvp_t>    DoraQueue;
+    typedef WorkerQueue<terminal_rvp_t>::Type DoraQueue;
 
 private:
 
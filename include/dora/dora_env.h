@@ -50,6 +50,7 @@ using namespace shore;
 ENTER_NAMESPACE(dora);
 
 
+class dora_repartitioner_t;
 
 
 /******************************************************************** 
@@ -95,9 +96,30 @@ protected:
     // The determined number of dora-flushers, typically == #sockets
     uint_t _num_flushers;
 
+    // Whether the partitions and the flushers are placed on the NUMA
+    // nodes (numa-placement). Then flusher (i) runs on node (i).
+    bool _numa;
+
     // A vector of dora-flusher thread(s)
     std::vector<dora_flusher_t*> _vec_flusher;
 
+    // Online repartitioning (dora-repartition). While it is on, the 
+    // submitted xcts are counted until they reach their terminal rvp, 
+    // and new ones wait while the admission is closed.
+    bool _rebalance;
+    uint_t volatile _in_flight;
+    bool volatile _admit_closed;
+    guard<dora_repartitioner_t> _repartitioner;
+
+    // Early lock release, if the ELR of the ShoreEnv is on (CFG_FLUSHER only).
+    // The terminal rvp releases the locks as soon as the commit has an lsn.
+    // An xct that commits afterwards may depend on it, so it does not
+    // report before the highest such lsn (_elr_lsn) is durable either.
+    ShoreEnv* _penv;
+    tatas_lock _elr_lock;
+    lsn_t _elr_lsn;
+    bool volatile _elr_used;
+
 public:
     
     DoraEnv();
@@ -112,8 +134,12 @@ public:
 
     //// Client API
 
-    // Return the partition responsible for the specific integer identifier
+    // Return the partition responsible for the specific integer identifier.
+    // Through the flat routing of the table, if it has one.
     inline irpImpl* decide_part(irpTableImpl* atable, const int aid) {
+        if (const route_table_t* aroute = atable->get_route_table()) {
+            return (static_cast<irpImpl*>(aroute->route(aid)));
+        }
         cvec_t key((char*)&aid,sizeof(int));
         lpid_t pid;
         w_rc_t r = atable->getPartIdxByKey(key,pid);
@@ -122,10 +148,22 @@ public:
     }      
 
 
+    //// Early lock release ////
+
+    inline bool is_elr() const { return (_penv && _penv->isELREnabled()); }
+
+    // Returns the lsn that has to be durable before an xct with commit
+    // lsn (alsn) reports. If it (releases) its locks early, (alsn) is
+    // also the lsn the ones that commit later wait for.
+    lsn_t elr_lsn(const lsn_t& alsn, const bool release);
+
     inline void enqueue_toflush(terminal_rvp_t* arvp) 
     {
         w_assert2 (arvp);
-        uint_t flusherIdx = (arvp->xct_id() % _num_flushers);
+        // with NUMA placement, to the flusher of the node we run on
+        uint_t flusherIdx = (_numa ? 
+                             numa_topology_t::instance()->current_node() :
+                             arvp->xct_id()) % _num_flushers;
         w_assert0 (_vec_flusher[flusherIdx]);
         _vec_flusher[flusherIdx]->enqueue_toflush(arvp);
     }
@@ -136,6 +174,37 @@ public:
     {
         return (_num_flushers);
     }
+
+
+    //// Admission, for the online repartitioning ////
+
+    // Called before submitting an xct. Waits while the admission is 
+    // closed.
+    inline void admit() 
+    {
+        if (!_rebalance) return;
+        while (true) {
+            atomic_inc_uint(&_in_flight);
+            membar_enter();
+            if (!*&_admit_closed) return;
+            atomic_dec_uint(&_in_flight);
+            while (*&_admit_closed) usleep(100);
+        }
+    }
+
+    // Called once the xct reached its terminal rvp, or if it could not
+    // be submitted
+    inline void xct_done() 
+    {
+        if (_rebalance) atomic_dec_uint(&_in_flight);
+    }
+
+    inline uint_t in_flight() const { return (*&_in_flight); }
+
+    inline void close_admission() { _admit_closed = true; membar_enter(); }
+    inline void open_admission() { membar_exit(); _admit_closed = false; }
+
+    irpTablePtrVector& tables() { return (_irptp_vec); }
             
 
 protected:
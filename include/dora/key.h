@@ -37,6 +37,8 @@
 #include <sstream>
 #include <vector>
 
+#include "util/fnv.h"
+
 #include "sm/shore/shore_env.h"
 
 
@@ -58,8 +60,10 @@ const uint MAX_KEY_SIZE = 5;
  *
  * @brief:  Template-based class used for Keys
  *
- * @note:   - Wraps a vector of key entries. Needed for STL  
+ * @note:   - Stores up to MAX_KEY_SIZE key entries inline, so creating,
+ *            copying and reading keys never touches the heap
  *          - All the entries of the key of the same type
+ *          - The hash of the entries is updated as they are pushed
  * 
  *
  ********************************************************************/
@@ -67,30 +71,29 @@ const uint MAX_KEY_SIZE = 5;
 template<typename DataType>
 struct key_wrapper_t
 {
-    //typedef typename PooledVec<DataType>::Type        DataVec;
-    typedef std::vector<DataType>            DataVec;
-    typedef typename DataVec::iterator       DataVecIt;
-    typedef typename DataVec::const_iterator DataVecCit;
+    // the entries - of the same type
+    DataType _key_v[MAX_KEY_SIZE];
+    uint     _key_sz;
 
-    // the vector with the entries - of the same type
-    DataVec _key_v;
+    // the FNV hash of the entries
+    uint     _hash;
 
     // empty constructor
-    key_wrapper_t() { }
+    key_wrapper_t() : _key_sz(0), _hash(FNV_INIT) { }
 
     // copying needs to be allowed (stl...)
     key_wrapper_t(const key_wrapper_t<DataType>& rhs)
+        : _key_sz(0), _hash(FNV_INIT)
     {
-        // if already set do not reallocate        
-        //        _key_v = new DataVec( rhs._key_v->get_allocator() );
-        copy_vector(rhs._key_v);
+        copy(rhs);
     }
     
     // copy constructor
     key_wrapper_t<DataType>& operator=(const key_wrapper_t<DataType>& rhs) 
     {        
-        //_key_v = new DataVec( rhs._key_v->get_allocator() );
-        copy_vector(rhs._key_v);
+        if (this == &rhs) return (*this);
+        _key_sz = 0;
+        copy(rhs);
         return (*this);
     }
     
@@ -98,34 +101,39 @@ struct key_wrapper_t
     ~key_wrapper_t() { }
 
     // push one item
-    inline void push_back(DataType& anitem) {
-        _key_v.push_back(anitem);
+    inline void push_back(const DataType& anitem) {
+        assert (_key_sz<MAX_KEY_SIZE);
+        _key_v[_key_sz++] = anitem;
+        _hash = fnv_hash((const char*)&anitem, sizeof(DataType), _hash);
     }
 
-    // reserve vector space
+    // nothing to reserve, the space is inline
     inline void reserve(const uint keysz) {
-        _key_v.reserve(keysz);
+        assert (keysz<=MAX_KEY_SIZE);
     }
 
-    // drops the key
-    //inline void drop() { if (_key_v) delete (_key_v); }
-
     inline void copy(const key_wrapper_t<DataType>& rhs) {
-        copy_vector(rhs._key_v);
+        assert (_key_sz==0);
+        _key_sz = rhs._key_sz;
+        _hash = rhs._hash;
+        for (uint i=0; i<_key_sz; ++i) _key_v[i] = rhs._key_v[i];
     }
-    
 
-    // helper functions
-    inline void copy_vector(const DataVec& aVec) {
-        assert (_key_v.empty());
-        _key_v.reserve(aVec.size());
-        _key_v.assign(aVec.begin(),aVec.end()); // copy vector content
+    // access methods
+    inline uint size() const { return (_key_sz); }
+    inline bool empty() const { return (_key_sz==0); }
+    inline const DataType& operator[](const uint i) const { 
+        assert (i<_key_sz); return (_key_v[i]); 
     }
 
+    // Returns the hash of the key entries, used by the lock table
+    inline uint hash() const { return (_hash); }
+    
+
     // Returns a corresponding cvec_t 
     cvec_t toCVec() const {
         cvec_t acv;
-        for (uint i=0; i<_key_v.size(); ++i) {
+        for (uint i=0; i<_key_sz; ++i) {
             acv.put(&_key_v[i],sizeof(DataType));
         }
         return (acv);
@@ -134,27 +142,12 @@ struct key_wrapper_t
     // Sets the key based on a cvec_t
     // Returns the number of DataTypes read
     uint readCVec(const cvec_t& acv) {
-        // Clear key contents, if any
-        reset();
-        
-        // Read the cvec_t into a char*
-        uint sz = MAX_KEY_SIZE * sizeof(DataType);
-        char* co = (char*)malloc(sz);
-        size_t bwriten = acv.copy_to(co,sz);
-        size_t bread = 0;
-
-        // Read the DataTypes and insert them to the key vector
-        uint dtread = 0;
-        while (bread < bwriten) {
-            DataType adt = *(DataType*)(co[bread]);
-            _key_v.push_back(adt);
-
-            // move to next
-            bread += sizeof(DataType);
-            ++dtread;
-        }
-        free (co);
-        return (dtread);
+        // Read the cvec_t directly into the entries
+        size_t bwriten = acv.copy_to((char*)_key_v, sizeof(_key_v));
+        _key_sz = bwriten / sizeof(DataType);
+        _hash = (_key_sz ? fnv_hash((const char*)_key_v, _key_sz*sizeof(DataType)) 
+                 : FNV_INIT);
+        return (_key_sz);
     }
 
     // comparison operators
@@ -169,13 +162,14 @@ struct key_wrapper_t
 
     // Clear contents
     void reset() {
-        _key_v.erase(_key_v.begin(),_key_v.end());
+        _key_sz = 0;
+        _hash = FNV_INIT;
     }
 
     string toString() {
-        std::ostringstream out = string("");
-        for (DataVecIt it=_key_v.begin(); it!=_key_v.end(); ++it)
-            out << out << (*it) << "|";
+        std::ostringstream out;
+        for (uint i=0; i<_key_sz; ++i)
+            out << _key_v[i] << "|";
         return (out.str());
     }
 
@@ -190,9 +184,8 @@ template<typename DataType>
 std::ostream& operator<< (std::ostream& os,
                           const key_wrapper_t<DataType>& rhs)
 {
-    typedef typename key_wrapper_t<DataType>::DataVecCit KeyDataIt;
-    for (KeyDataIt it = rhs._key_v.begin(); it != rhs._key_v.end(); ++it) {
-        os << (*it) << "|";
+    for (uint i=0; i<rhs._key_sz; ++i) {
+        os << rhs._key_v[i] << "|";
     }
     return (os);
 }
@@ -208,7 +201,7 @@ std::ostream& operator<< (std::ostream& os,
 //
 // workaround: 
 //
-// minsize = min(_key_v.size(), rhs._key_v.size());
+// minsize = min(_key_sz, rhs._key_sz);
 // for (int i=0; i<minsize; ++) { ... }
 //
 
@@ -217,8 +210,8 @@ std::ostream& operator<< (std::ostream& os,
 template<typename DataType>
 inline bool key_wrapper_t<DataType>::operator<(const key_wrapper_t<DataType>& rhs) const 
 {
-    assert (_key_v.size()<=rhs._key_v.size()); // not necesserily of the same length
-    for (uint i = 0; i <_key_v.size(); ++i) {
+    assert (_key_sz<=rhs._key_sz); // not necesserily of the same length
+    for (uint i = 0; i <_key_sz; ++i) {
         // goes over the key fields until one inequality is found
         if (_key_v[i]==rhs._key_v[i])
             continue;
@@ -231,8 +224,8 @@ inline bool key_wrapper_t<DataType>::operator<(const key_wrapper_t<DataType>& rh
 template<typename DataType>
 inline bool key_wrapper_t<DataType>::operator==(const key_wrapper_t<DataType>& rhs) const 
 {    
-    assert (_key_v.size()<=rhs._key_v.size()); // not necesserily of the same length
-    for (uint i=0; i<_key_v.size(); i++) {
+    assert (_key_sz<=rhs._key_sz); // not necesserily of the same length
+    for (uint i=0; i<_key_sz; i++) {
         // goes over the key fields until one inequality is found
         if (_key_v[i]==rhs._key_v[i])
             continue;
@@ -245,8 +238,8 @@ inline bool key_wrapper_t<DataType>::operator==(const key_wrapper_t<DataType>& r
 template<typename DataType>
 inline bool key_wrapper_t<DataType>::operator<=(const key_wrapper_t<DataType>& rhs) const 
 {
-    assert (_key_v.size()<=rhs._key_v.size()); // not necesserily of the same length
-    for (uint i=0; i<_key_v.size(); i++) {
+    assert (_key_sz<=rhs._key_sz); // not necesserily of the same length
+    for (uint i=0; i<_key_sz; i++) {
         // goes over the key fields
         if (_key_v[i]==rhs._key_v[i])
             continue;
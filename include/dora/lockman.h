@@ -58,7 +58,7 @@ typedef BaseActionPtrList::iterator     BaseActionPtrIt;
  * @brief: Lock manager for the locks of a partition
  *
  * @note:  The lock manager consists of a
- *         - A map for the status of logical locks (llst_map_t)
+ *         - A hash table for the status of logical locks (KeyLockMap)
  *         - A bi-map for associating trxs with Keys
  *
  *
@@ -75,9 +75,6 @@ public:
     typedef key_wrapper_t<DataType>  Key;
 
     typedef KeyLockMap<DataType>     KeyLLMap;
-    typedef std::pair<Key,LogicalLock>        KeyLLPair;
-
-    typedef std::_Rb_tree_node<KeyLLPair>     KeyLLMapNode;
 
     typedef KALReq_t<DataType>      KALReq;
     //typedef typename PooledVec<KALReq>::Type KALReqVec;
@@ -33,12 +33,14 @@
 #define __DORA_LOGICAL_LOCK_H
 
 #include <cstdio>
+#include <cstring>
 #include <map>
 #include <vector>
 #include <deque>
 
 #include "util/stl_pooled_alloc.h"
 #include "util/stl_block_alloc.h"
+#include "util/stl_pool.h"
 
 #include "dora/common.h"
 #include "dora/dora_error.h"
@@ -175,6 +177,123 @@ struct KALReq_t : public ActionLockReq
 
 
 
+/******************************************************************** 
+ *
+ * @struct: ActionLockReqOwners
+ *
+ * @brief:  The owners of a logical lock. 
+ *
+ * @note:   The common case is a lock with a single owner. Hence, the first 
+ *          owner is kept inline and only the additional (shared) owners
+ *          spill to the heap.
+ *
+ ********************************************************************/
+
+struct ActionLockReqOwners
+{
+    typedef std::vector<ActionLockReq>  ActionLockReqVec;
+
+    ActionLockReqOwners() : _sz(0) { }
+    ~ActionLockReqOwners() { }
+
+    uint size() const  { return (_sz); }
+    bool empty() const { return (_sz==0); }
+
+    ActionLockReq& operator[](const uint i) {
+        assert (i<_sz);
+        return (i ? _rest[i-1] : _first);
+    }
+
+    void push_back(const ActionLockReq& alr) {
+        if (_sz) _rest.push_back(alr);
+        else _first = alr;
+        ++_sz;
+    }
+
+    // removes the i-th owner, the rest keep their order
+    void erase(const uint i) {
+        assert (i<_sz);
+        if (i) {
+            _rest.erase(_rest.begin()+(i-1));
+        }
+        else if (!_rest.empty()) {
+            _first = _rest.front();
+            _rest.erase(_rest.begin());
+        }
+        --_sz;
+    }
+
+    void clear() { _rest.clear(); _sz=0; }
+
+private:
+
+    ActionLockReq     _first;   // the first owner, inline
+    ActionLockReqVec  _rest;    // the overflow
+    uint              _sz;
+
+}; // EOF: struct ActionLockReqOwners
+
+
+
+/******************************************************************** 
+ *
+ * @struct: ActionLockReqWaiters
+ *
+ * @brief:  The FIFO of the waiters of a logical lock.
+ *
+ * @note:   A vector with a moving head. Most locks never have waiters,
+ *          so nothing is allocated until the first waiter shows up. The
+ *          served entries are reclaimed when the queue drains, or when 
+ *          they are the majority of the vector.
+ *
+ ********************************************************************/
+
+const uint WAITERS_COMPACT_THRES = 16;
+
+struct ActionLockReqWaiters
+{
+    typedef std::vector<ActionLockReq>          ActionLockReqVec;
+    typedef ActionLockReqVec::iterator          iterator;
+    typedef ActionLockReqVec::const_iterator    const_iterator;
+
+    ActionLockReqWaiters() : _head(0) { }
+    ~ActionLockReqWaiters() { }
+
+    uint size() const  { return (_q.size()-_head); }
+    bool empty() const { return (_head==_q.size()); }
+
+    ActionLockReq& front() { assert (!empty()); return (_q[_head]); }
+
+    void push_back(const ActionLockReq& alr) { _q.push_back(alr); }
+
+    void pop_front() {
+        assert (!empty());
+        ++_head;
+        if (_head==_q.size()) {
+            clear();
+        }
+        else if ((_head>WAITERS_COMPACT_THRES) && (_head*2>_q.size())) {
+            _q.erase(_q.begin(),_q.begin()+_head);
+            _head = 0;
+        }
+    }
+
+    void clear() { _q.clear(); _head=0; }
+
+    iterator begin() { return (_q.begin()+_head); }
+    iterator end()   { return (_q.end()); }
+    const_iterator begin() const { return (_q.begin()+_head); }
+    const_iterator end() const   { return (_q.end()); }
+
+private:
+
+    ActionLockReqVec  _q;
+    uint              _head;
+
+}; // EOF: struct ActionLockReqWaiters
+
+
+
 /******************************************************************** 
  *
  * @struct: LogicalLock
@@ -190,9 +309,8 @@ struct KALReq_t : public ActionLockReq
 
 struct LogicalLock
 {    
-    typedef std::vector<ActionLockReq>          ActionLockReqVec;
-    typedef ActionLockReqVec::iterator          ActionLockReqVecIt;
-    typedef PooledList<ActionLockReq>::Type     ActionLockReqList;
+    typedef ActionLockReqOwners                 ActionLockReqVec;
+    typedef ActionLockReqWaiters                ActionLockReqList;
     typedef ActionLockReqList::iterator         ActionLockReqListIt;
     typedef ActionLockReqList::const_iterator   ActionLockReqListCit;
 
@@ -235,8 +353,8 @@ private:
 
     // data
     eDoraLockMode       _dlm;       // logical lock
-    ActionLockReqVec    _owners;    // vector of owners
-    ActionLockReqList   _waiters;   // list of waiters - we want to push/pop both sides
+    ActionLockReqVec    _owners;    // owners - the first one inline
+    ActionLockReqList   _waiters;   // FIFO of waiters
 
     // can acquire
     bool _head_can_acquire();
@@ -258,17 +376,18 @@ private:
  *
  *          (Acquire) Returns false if locked in incompatible mode.
  *
- * @note:   It is based on a map of key_wrapper_t to ll_entry
- * @note:   Never removes entries. The map will be increasing as long
- *          as new keys are queried.
- * @note:   We can have a background thread that removes entries from
- *          the map if its size becomes a problem.
+ * @note:   It is an open-addressing hash table with linear probing.
+ *          Each slot keeps the hash of its key next to the pointer to
+ *          the entry (key and logical lock), so a probe touches only the
+ *          slot array until the hashes match. The entries are allocated
+ *          from a pool sized by the key estimation of the partition.
+ * @note:   Never removes entries. The table will be increasing as long
+ *          as new keys are queried, doubling when it gets half full, 
+ *          until the partition resets it.
  *
  ********************************************************************/
 
-#define BLOCK_ALLOC_LLMAP
-
-static const int ENTRIES_PER_KEY_LL_MAP = 6000;
+static const uint KEY_LL_MAP_MIN_SLOTS = 1024;
 
 template<class DataType>
 struct KeyLockMap
@@ -276,64 +395,55 @@ struct KeyLockMap
 public:
 
     typedef key_wrapper_t<DataType>   Key;
-    //typedef typename PooledVec<Key>::Type   KeyList;
-    typedef std::vector<Key>   KeyList;
-
-    typedef KALReq_t<DataType>              KALReq;
-
-#ifdef BLOCK_ALLOC_LLMAP
-    typedef typename map__block_alloc<Key,LogicalLock>::Type LLMap;
-#else
-    typedef typename PooledMap<Key,LogicalLock>::Type  LLMap;
-#endif
-    
-    typedef typename LLMap::iterator        LLMapIt;
-    typedef typename LLMap::const_iterator  LLMapCit;
-
-    typedef typename LLMap::value_type      LLMapVT;
-#ifndef BLOCK_ALLOC_LLMAP
-    typedef _Rb_tree_node<LLMapVT> LLMapNode;
-#endif
+    typedef KALReq_t<DataType>        KALReq;
+
+    // an entry of the table
+    struct KeyLL {
+        Key         _key;
+        LogicalLock _ll;
+        KeyLL(const Key& akey, ActionLockReq& anowner) 
+            : _key(akey), _ll(anowner) 
+        { }
+    };
+
+    // a slot of the table - empty if (_kll==NULL)
+    struct Slot {
+        uint   _hash;
+        KeyLL* _kll;
+    };
 
 protected:
 
     // data
-    guard<LLMap>   _ll_map;    // map of logical locks - each key has its own ll
-    LLMapIt _ll_map_it; 
+    Slot*               _slots;     // the hash table
+    uint                _mask;      // number of slots - 1 (power of 2)
+    uint                _entries;   // number of occupied slots
 
-    // pool for KeyLL nodes
+    // pool for the entries
     guard<Pool> _keyll_pool;
 
-    // cache of Keys
-    guard< object_cache_t<Key> > _key_cache;
-
 public:
 
     KeyLockMap(const int keyEstimation) 
+        : _slots(NULL), _mask(0), _entries(0)
     { 
-        // setup Key-LL map
+        // setup Key-LL table
         assert (keyEstimation);
-#ifdef BLOCK_ALLOC_LLMAP
-	_ll_map = new LLMap;
-#else
-        _keyll_pool = new Pool(sizeof(LLMapNode),  keyEstimation); 
+        _keyll_pool = new Pool(sizeof(KeyLL), keyEstimation);
         assert (_keyll_pool);
-        _ll_map = new LLMap(std::less<Key>(),_keyll_pool.get());
-#endif
 
-        _key_cache = new object_cache_t<Key>();
-        assert (_key_cache);
+        // start with at least two slots per estimated key
+        uint nslots = KEY_LL_MAP_MIN_SLOTS;
+        while (nslots < 2*(uint)keyEstimation) nslots <<= 1;
+        _alloc_slots(nslots);
     }
 
     ~KeyLockMap() 
     { 
-        // delete Key-LL map entries
+        // delete Key-LL table entries
         reset();
-        
-        // remove cache
-        _key_cache.done();
 
-        _ll_map.done();
+        delete [] _slots;
         _keyll_pool.done();
     }
 
@@ -343,25 +453,18 @@ public:
     inline bool acquire(KALReq& akalr) 
     {
         bool bAcquire = false;
+        uint h = akalr._key->hash();
+        Slot* pslot = _probe(*akalr._key, h);
 
-        // IP: applying the efficientAddOrUpdate optimization from "Effective STL" pp. 110.
-        _ll_map_it = _ll_map->lower_bound(*akalr._key);
-        
-        if (_ll_map_it!=_ll_map->end() && 
-            !(_ll_map->key_comp()(*akalr._key,_ll_map_it->first))) {
-            
+        if (pslot->_kll) {
             // update
-            bAcquire = _ll_map_it->second.acquire(akalr);
+            bAcquire = pslot->_kll->_ll.acquire(akalr);
         }
         else {
             // insert
-
-            // use a key from the cache
-            Key* akey = _key_cache->borrow();
-            akey->copy(*akalr._key);
-
-            _ll_map->insert(_ll_map_it,LLMapVT(*akey,akalr));
-            _key_cache->giveback(akey);
+            pslot->_hash = h;
+            pslot->_kll = new (_keyll_pool->Allocate()) KeyLL(*akalr._key,akalr);
+            if (++_entries > (_mask>>1)) _grow();
             bAcquire = true;
         }
 
@@ -374,52 +477,54 @@ public:
                              BaseActionPtr paction,
                              BaseActionPtrList& promotedList) 
     {        
-//         ostringstream out;
-//         string sout;
-//         out << aKey;
-//         sout = out.str();
-//         TRACE( TRACE_ALWAYS, "Releasing (%s)\n", sout.c_str());
-
-        _ll_map_it = _ll_map->find(aKey);
-        LogicalLock* ll = &_ll_map_it->second;
-        assert (ll);
+        Slot* pslot = _probe(aKey, aKey.hash());
+        assert (pslot->_kll);
+        LogicalLock* ll = &pslot->_kll->_ll;
 
         int rhs = ll->release(paction,promotedList);
-        //        if (ll->is_clean()) _ll_map->erase(_ll_map_it);
         return (rhs);
     }
 
 
     //// Debugging ////
 
-    // clear map
-    void clear() { _ll_map->clear(); }
+    // clear table
+    void clear() { 
+        for (uint i=0; i<=_mask; ++i) {
+            if (_slots[i]._kll) {
+                _keyll_pool->Destroy(_slots[i]._kll);
+                _slots[i]._kll = NULL;
+            }
+        }
+        _entries = 0;
+    }
 
-    // reset map
+    // reset table
     void reset() {
         // clear all entries
         vector<xct_t*> toabort;
-        for (LLMapIt it=_ll_map->begin(); it!=_ll_map->end(); ++it) {
-            it->second.abort_and_reset(toabort);
+        for (uint i=0; i<=_mask; ++i) {
+            if (_slots[i]._kll) _slots[i]._kll->_ll.abort_and_reset(toabort);
         }
-        // clear map
-        _ll_map->clear();
+        // clear table
+        clear();
     }
 
     // return the number of keys
-    uint keystouched() const { return (_ll_map->size()); }
+    uint keystouched() const { return (_entries); }
 
     // returns (true) if all locks are clean
     bool is_clean(vector<xct_t*>& toabort) {
         // clear all entries
         bool isClean = true;
         uint dirtyCount = 0;
-        for (LLMapIt it=_ll_map->begin(); it!=_ll_map->end(); ++it) {
-            if (!it->second.is_clean()) {
+        for (uint i=0; i<=_mask; ++i) {
+            KeyLL* kll = _slots[i]._kll;
+            if (kll && !kll->_ll.is_clean()) {
                 ++dirtyCount;
                 //isClean = false;
-                //cout << it->second;
-                it->second.abort_and_reset(toabort);
+                //cout << kll->_ll;
+                kll->_ll.abort_and_reset(toabort);
             }
         }
         if (dirtyCount) {
@@ -429,14 +534,58 @@ public:
     }
 
     void dump() {
-        int sz = _ll_map->size();
-        TRACE( TRACE_DEBUG, "Keys (%d)\n", sz);
-        for (LLMapIt it=_ll_map->begin(); it!=_ll_map->end(); ++it) {
-            cout << "K (" << it->first << ")\nL\n"; 
-            cout << it->second << "\n";
+        TRACE( TRACE_DEBUG, "Keys (%d) Slots (%d)\n", _entries, _mask+1);
+        for (uint i=0; i<=_mask; ++i) {
+            KeyLL* kll = _slots[i]._kll;
+            if (kll) {
+                cout << "K (" << kll->_key << ")\nL\n"; 
+                cout << kll->_ll << "\n";
+            }
         }
     }
 
+private:
+
+    // returns the slot of the key, or the empty slot where it should go
+    inline Slot* _probe(const Key& aKey, const uint h) {
+        uint i = h & _mask;
+        while (_slots[i]._kll) {
+            // Key::operator== compares only the prefix, so check the sizes
+            const Key& skey = _slots[i]._kll->_key;
+            if ((_slots[i]._hash==h) && (skey.size()==aKey.size()) && 
+                (skey==aKey)) break;
+            i = (i+1) & _mask;
+        }
+        return (&_slots[i]);
+    }
+
+    void _alloc_slots(const uint nslots) {
+        _slots = new Slot[nslots];
+        memset(_slots, 0, nslots*sizeof(Slot));
+        _mask = nslots-1;
+    }
+
+    // doubles the table, re-inserting the entries with their stored hashes
+    void _grow() {
+        Slot* old = _slots;
+        uint oldslots = _mask+1;
+        _alloc_slots(oldslots<<1);
+        for (uint i=0; i<oldslots; ++i) {
+            if (old[i]._kll) {
+                uint j = old[i]._hash & _mask;
+                while (_slots[j]._kll) j = (j+1) & _mask;
+                _slots[j] = old[i];
+            }
+        }
+        delete [] old;
+        TRACE( TRACE_DEBUG, "Grew to (%d) slots for (%d) keys\n", 
+               _mask+1, _entries);
+    }
+
+    // copying not allowed
+    KeyLockMap(KeyLockMap const &);
+    void operator=(KeyLockMap const &);
+
 }; // EOF: struct KeyLockMap
 
 EXIT_NAMESPACE(dora);
@@ -125,12 +125,16 @@ public:
     // decide the next processor
     virtual processorid_t next_cpu(const processorid_t& aprd);
 
+    // the processor of the (idx)-th partition with NUMA placement
+    processorid_t numa_cpu(const uint idx) const;
+
     table_desc_t* table() const;
 
     //// For debugging ////
 
-    // information
-    void statistics() const;
+    // information, optionally gathered per NUMA node as well
+    void statistics(std::vector<worker_stats_t>* pernode = NULL,
+                    std::vector<uint>* pernode_parts = NULL) const;
 
     // information
     void info() const;
@@ -34,7 +34,7 @@
 
 #include "dora/base_partition.h"
 
-#include "sm/shore/srmwqueue.h"
+#include "sm/shore/lfqueue.h"
 
 #include "dora/lockman.h"
 #include "dora/worker.h"
@@ -66,7 +66,7 @@ public:
 
     typedef action_t<DataType>         Action;
     typedef dora_worker_t              Worker;
-    typedef srmwqueue<Action>          Queue;
+    typedef typename WorkerQueue<Action>::Type Queue;
     typedef key_wrapper_t<DataType>    Key;
     typedef lock_man_t<DataType>       LockManager;
 
@@ -117,6 +117,9 @@ protected:
     guard<Pool>     _actionptr_input_pool;
     guard<Pool>     _actionptr_commit_pool;
 
+    // per partition key estimation, for (re-)creating the lock manager
+    uint            _key_estimation;
+
     // There is a new type of input queue we want to add which is a queue for
     // system signals (_sys_queue)
 
@@ -207,6 +210,7 @@ public:
 
     // stats
     virtual void statistics(worker_stats_t& gather);
+    virtual void peek_stats(worker_stats_t& stats);
 
     virtual void dump();
 
@@ -220,6 +224,9 @@ private:
     int _generate_primary();
     Worker* _generate_worker(const processorid_t aprsid, c_str wname, const int use_sli);    
 
+    // (re-)creates the lock manager, the queues and their pools
+    void _allocate();
+
 protected:    
 
     int isFree(Key akey, eDoraLockMode lmode);
@@ -242,9 +249,20 @@ partition_t<DataType>::partition_t(ShoreEnv* env, table_desc_t* ptable,
                                    const processorid_t aprsid,
                                    const uint keyEstimation) 
     : base_partition_t(env,ptable,apartid,aprsid),
-      _owner(NULL)
+      _owner(NULL), _key_estimation(keyEstimation)
+{
+    _allocate();
+}
+
+
+template <class DataType>
+void partition_t<DataType>::_allocate()
 {
-    _plm = new LockManager(keyEstimation);
+    // the queues go before the pools they use
+    _input_queue.done();
+    _committed_queue.done();
+
+    _plm = new LockManager(_key_estimation);
 
     _actionptr_input_pool = new Pool(sizeof(Action*),ACTIONS_PER_INPUT_QUEUE_POOL_SZ);
     _input_queue = new Queue(_actionptr_input_pool.get());
@@ -281,6 +299,7 @@ int partition_t<DataType>::enqueue(Action* pAction, const bool bWake)
 #endif
 
     pAction->set_partition(this);
+    atomic_inc_uint(&_enqueued);
     _input_queue->push(pAction,bWake);
     return (0);
 }
@@ -318,6 +337,7 @@ int partition_t<DataType>::enqueue_commit(Action* pAction, const bool bWake)
     w_assert1(pAction->get_partition()==this);
     TRACE( TRACE_TRX_FLOW, "Enq committed (%d) to (%s-%d)\n", 
            pAction->tid().get_lo(), _table->name(), _part_id);
+    atomic_inc_uint(&_unreleased);
     _committed_queue->push(pAction,bWake);
     return (0);
 }
@@ -379,6 +399,12 @@ void partition_t<DataType>::stop()
  *
  * @note:   Check dora_error.h for error codes
  *
+ * @note:   With NUMA placement (numa-placement) everything runs on the
+ *          node of the processor. If the partition moves to another
+ *          node, its lock manager, queues and pools are allocated
+ *          again, there. The owner is forked there too, so even if it
+ *          does not bind to the processor it stays on the node.
+ *
  ******************************************************************/
 
 template <class DataType>
@@ -390,12 +416,26 @@ int partition_t<DataType>::reset(const processorid_t aprsid)
     // Stop the worker & standby threads
     _stop_threads();
 
-    // Clear queues
-    _input_queue->clear();
-    _committed_queue->clear();
+    int node = -1;
+    if ((aprsid != PBIND_NONE) && 
+        (envVar::instance()->getVarInt("numa-placement",0) == 1)) {
+        node = numa_topology_t::instance()->node_of(aprsid);
+    }
+    numa_local_t local(node);
+
+    if (node != _node) {
+        // The queues are empty and nobody uses them
+        _allocate();
+        _node = node;
+    }
+    else {
+        // Clear queues
+        _input_queue->clear();
+        _committed_queue->clear();
     
-    // Reset lock-manager
-    _plm->reset();
+        // Reset lock-manager
+        _plm->reset();
+    }
 
 
     // Lock the owner and generate worker
@@ -455,6 +495,7 @@ w_rc_t partition_t<DataType>::prepareNewRun()
         _owner->doRecovery();
     }
     _committed_queue->clear(false);
+    _unreleased = 0;
 
     while (!_input_queue->is_really_empty()) {
         TRACE( TRACE_ALWAYS, "InputQueue of (%s-%d) not empty\n");
@@ -636,33 +677,19 @@ template <class DataType>
 int partition_t<DataType>::abort_all_enqueued()
 {
     // 1. go over all requests
-    Action* pa;
+    std::vector<Action*> pending;
     int reqs_read  = 0;
     int reqs_write = 0;
     int reqs_abt   = 0;
 
     assert (_owner);
 
-    // go over the readers list
-    while (_input_queue->_read_pos != _input_queue->_for_readers->end()) {
-        pa = *(_input_queue->_read_pos++);
-        ++reqs_read;
-        if (_owner->abort_one_trx(pa->xct())) 
-            ++reqs_abt;        
-    }
-
-    // go over the writers list
-    {
-        CRITICAL_SECTION(q_cs, _input_queue->_lock);
-        for (_input_queue->_read_pos = _input_queue->_for_writers->begin();
-             _input_queue->_read_pos != _input_queue->_for_writers->end();
-             _input_queue->_read_pos++) 
-            {
-                pa = *(_input_queue->_read_pos);
-                ++reqs_write;
-                if (_owner->abort_one_trx(pa->xct())) 
-                    ++reqs_abt;
-            }
+    // go over the readers and the writers list
+    reqs_read  = _input_queue->pending(pending);
+    reqs_write = pending.size() - reqs_read;
+    for (uint i=0; i<pending.size(); i++) {
+        if (_owner->abort_one_trx(pending[i]->xct())) 
+            ++reqs_abt;
     }
 
     if ((reqs_read + reqs_write) > 0) {
@@ -690,6 +717,15 @@ void partition_t<DataType>::statistics(worker_stats_t& gather)
 }
 
 
+template <class DataType>
+void partition_t<DataType>::peek_stats(worker_stats_t& stats) 
+{
+    if (_owner) {
+        stats = _owner->get_stats();
+    }
+}
+
+
 /****************************************************************** 
  *
  * @fn:     stlsize()
@@ -38,6 +38,7 @@
 
 #include "dora/part_table.h"
 #include "dora/base_partition.h"
+#include "dora/route_table.h"
 
 
 using namespace shore;
@@ -67,6 +68,15 @@ protected:
     // key ranges map - The DORA version
     guard<dkey_ranges_map> _prMap;
 
+    // Flat routing of the keys, used instead of the _prMap while set.
+    // Built from the _prMap by repartition(), and replaced online by the
+    // repartitioner (set_route()). It is swapped only while no xct runs
+    // on the table, and the previous one is freed at the next swap.
+    // @note: All the DORA tables are partitioned on a single integer
+    route_table_t* volatile _proute;
+    route_table_t*          _pretired;
+    uint                    _route_version;
+
 public:
 
     range_table_t(ShoreEnv* env, table_desc_t* ptable, const uint dtype,
@@ -86,6 +96,22 @@ public:
         return (_prMap->get_partition(cvkey,pid));
     }
 
+    //// Online routing ////
+
+    // NULL if the ranges of the _prMap could not be read
+    inline const route_table_t* get_route_table() const { return (*&_proute); }
+
+    // Returns the current routing. If there is none, returns
+    // an equal-width split of the key domain of the table over the
+    // partitions, which is what the _prMap of plain DORA does.
+    void get_route(std::vector<int>& lo, std::vector<base_partition_t*>& parts);
+
+    // Installs a routing, false if (parts) are no longer the partitions
+    // of the table
+    // @note: The caller guarantees that no xct runs on the table
+    bool set_route(const std::vector<int>& lo, 
+                   const std::vector<base_partition_t*>& parts);
+
     // Reads the updated range partitioning information (if plp* from the sm::range_map_keys,
     // if dora from the dkeymap) and adjusts the boundaries of all logical partitions.
     // If needed, creates new partitions.
@@ -95,6 +121,13 @@ private:
 
     w_rc_t _get_updated_map(dkey_ranges_map*& drm);
 
+    // Flat routing helpers. They assume that the _lock is held
+    base_partition_t* _probe(const int aid);
+    bool _probe_route(std::vector<int>& lo, std::vector<base_partition_t*>& parts);
+    void _install_route(const std::vector<int>& lo, 
+                        const std::vector<base_partition_t*>& parts);
+    void _clear_route();
+
 protected:
 
     virtual w_rc_t _create_one_part(const shpid_t& pid, base_partition_t*& abp)=0;
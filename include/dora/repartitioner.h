@@ -0,0 +1,142 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   repartitioner.h
+ *
+ *  @brief:  The dora-repartitioner, which moves the key ranges of the
+ *           partitions online, following the load
+ *
+ *  @note:   Every interval it samples, for each partition, the actions
+ *           enqueued and the actions served by its worker (worker_stats_t).
+ *           The load of a partition is the actions it received in the
+ *           interval plus those still queued. If the most loaded (hot)
+ *           partition of a table is much above the mean it does one of:
+ *
+ *           split/merge - The two neighbouring ranges with the least load
+ *                         are merged to the lower one. The freed partition
+ *                         takes the upper half of the range of the hot one.
+ *           shift       - The least loaded neighbour of the hot partition
+ *                         takes the adjacent half of its range.
+ *
+ *           The number of partitions, and their workers, do not change.
+ *           Only the routing of the keys does (range_table_t::set_route()).
+ *
+ *           A move happens while no xct runs: the admission of new xcts
+ *           is closed, the xcts in flight drain and the partitions release
+ *           their locks, the routing changes and the admission opens.
+ *           The environment keeps running, the clients just wait.
+ */
+
+#ifndef __DORA_REPARTITIONER_H
+#define __DORA_REPARTITIONER_H
+
+#include <map>
+#include <vector>
+
+#include "dora/dora_env.h"
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(dora);
+
+
+/********************************************************************
+ *
+ * @class: dora_repartitioner_t
+ *
+ ********************************************************************/
+
+class dora_repartitioner_t : public thread_t
+{
+private:
+
+    DoraEnv*       _denv;
+
+    // configuration
+    int            _interval_ms;
+    uint           _imbalance;     // hot load vs. mean load, in percent
+    int            _drain_ms;
+    uint           _min_load;
+
+    bool volatile  _stop;
+    pthread_mutex_t _lock;
+    pthread_cond_t  _cond;
+
+    // what was read from a partition at the last sample
+    struct sample_t {
+        uint_t _enqueued;
+        uint   _served;      // as reported by the worker
+        uint_t _served_sum;  // since the first sample, robust to resets
+        uint_t _enqueued_0;  // at the first sample
+        sample_t() : _enqueued(0), _served(0), _served_sum(0), _enqueued_0(0) { }
+    };
+    std::map<base_partition_t*,sample_t> _samples;
+
+    // a new routing for a table
+    struct move_t {
+        range_table_t* _table;
+        std::vector<int> _lo;
+        std::vector<base_partition_t*> _parts;
+        bool _split;      // else a shift
+    };
+
+    // stats
+    uint           _migrations;
+    uint           _splits;
+    uint           _shifts;
+    uint           _timeouts;
+    long long      _drain_us;
+    long long      _max_drain_us;
+
+    // the load of each partition in (parts) in the last interval
+    void _sample(const std::vector<base_partition_t*>& parts,
+                 std::vector<uint_t>& loads);
+
+    // decides on a new routing for the table, false if none
+    bool _plan(range_table_t* table, move_t& move);
+
+    // drains, installs the new routings and resumes
+    bool _migrate(std::vector<move_t>& moves);
+
+    void _tick();
+
+public:
+
+    dora_repartitioner_t(DoraEnv* denv);
+    ~dora_repartitioner_t();
+
+    // thread entrance
+    void work();
+
+    // makes the thread exit, the caller should join()
+    void stop();
+
+    void print_stats() const;
+
+}; // EOF: dora_repartitioner_t
+
+
+EXIT_NAMESPACE(dora);
+
+#endif /** __DORA_REPARTITIONER_H */
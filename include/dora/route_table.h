@@ -0,0 +1,132 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   route_table.h
+ *
+ *  @brief:  Flat routing of integer keys to the partitions of a range
+ *           partitioned table in DORA
+ *
+ *  @note:   Read by DoraEnv::decide_part() for every action enqueued,
+ *           instead of the key_ranges_map of the sm and the partition map
+ *           of the table. The lower bounds of the ranges are packed in
+ *           one array, padded to a power of two, which is searched without
+ *           branches. If the key domain is small there is also a table
+ *           with the index of the range of every key in the domain.
+ *
+ *           A route_table_t does not change once built. The range table
+ *           builds a new one and swaps the pointer (range_table_t::
+ *           _install_route()).
+ */
+
+#ifndef __DORA_ROUTE_TABLE_H
+#define __DORA_ROUTE_TABLE_H
+
+#include <vector>
+
+#include "util.h"
+
+#include "dora/base_partition.h"
+
+
+ENTER_NAMESPACE(dora);
+
+
+/********************************************************************
+ *
+ * @class: route_table_t
+ *
+ * @brief: Read-only routing of integer keys to partitions
+ *
+ ********************************************************************/
+
+class route_table_t
+{
+public:
+
+    // The largest key domain with a direct-mapped table (16-bit entries)
+    static const uint DIRECT_MAX = 4096;
+
+private:
+
+    // The lower bounds (padded with INT_MAX) and the partitions (padded
+    // with the last one) of the ranges, in one allocation
+    char*              _buf;
+    int*               _lo;
+    base_partition_t** _part;
+    uint               _cnt;   // ranges
+    uint               _slots; // padded, a power of two
+
+    // Direct-mapped: the range of each key in [_dmin,_dmin+_dspan)
+    unsigned short*    _direct;
+    int                _dmin;
+    uint               _dspan;
+
+    uint               _version;
+
+public:
+
+    // (lo) are the lower bounds of the ranges in ascending order and
+    // (parts) their partitions. The domain [minKey,maxKey) decides if
+    // there is a direct-mapped table.
+    route_table_t(const std::vector<int>& lo,
+                  const std::vector<base_partition_t*>& parts,
+                  const int minKey, const int maxKey,
+                  const uint version);
+    ~route_table_t();
+
+    // The partition of the range (aid) falls in, keys below the first
+    // bound go to the first range
+    inline base_partition_t* route(const int aid) const {
+        if (_direct) {
+            uint off = (uint)aid - (uint)_dmin;
+            if (off < _dspan) return (_part[_direct[off]]);
+        }
+        const int* base = _lo;
+        uint n = _slots;
+        while (n > 1) {
+            uint half = n >> 1;
+            base += ((base[half] <= aid) ? half : 0);
+            n -= half;
+        }
+        return (_part[base - _lo]);
+    }
+
+    // Copies out the ranges
+    void get(std::vector<int>& lo, std::vector<base_partition_t*>& parts) const;
+
+    inline uint size() const { return (_cnt); }
+    inline uint version() const { return (_version); }
+    inline bool is_direct() const { return (_direct != NULL); }
+
+private:
+
+    // copying not allowed
+    route_table_t(route_table_t const &);
+    void operator=(route_table_t const &);
+
+}; // EOF: route_table_t
+
+
+EXIT_NAMESPACE(dora);
+
+#endif /** __DORA_ROUTE_TABLE_H */
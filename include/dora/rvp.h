@@ -181,6 +181,10 @@ protected:
     ss_m* _db;
     DoraEnv* _denv;
 
+    // The actions were handed back to the partitions at commit, before
+    // the xct was durable (early lock release)
+    bool _released;
+
 public:
 
     terminal_rvp_t();
@@ -199,6 +203,7 @@ public:
         rvp_t::_set(pxct,atid,axctid,presult,intra_trx_cnt,total_actions);
         _db = db;
         _denv = denv;
+        _released = false;
     }
 
     w_rc_t run();
@@ -206,6 +211,7 @@ public:
     void notify_on_abort();
 
     int notify_partitions();  // notifies for committed actions    
+    inline bool released() const { return (_released); }
 
     virtual void upd_committed_stats()=0; // update the committed trx stats
     virtual void upd_aborted_stats()=0;   // update the aborted trx stats
@@ -49,6 +49,27 @@ using namespace tm1;
 ENTER_NAMESPACE(dora);
 
 
+// Look also at include/workload/tm1/tm1_const.h
+// @note: The DORA_XXX should be (DORA_MIX + REGULAR_TRX_ID)
+const int XCT_TM1_DORA_MIX           = 200;
+const int XCT_TM1_DORA_GET_SUB_DATA  = 221;
+const int XCT_TM1_DORA_GET_NEW_DEST  = 222;
+const int XCT_TM1_DORA_GET_ACC_DATA  = 223;
+const int XCT_TM1_DORA_UPD_SUB_DATA  = 224;
+const int XCT_TM1_DORA_UPD_LOCATION  = 225;
+const int XCT_TM1_DORA_CALL_FWD_MIX  = 226;
+
+const int XCT_TM1_DORA_INS_CALL_FWD  = 227;
+const int XCT_TM1_DORA_DEL_CALL_FWD  = 228;
+
+const int XCT_TM1_DORA_GET_SUB_NBR   = 229;
+
+const int XCT_TM1_DORA_CALL_FWD_MIX_BENCH  = 230;
+const int XCT_TM1_DORA_INS_CALL_FWD_BENCH  = 231;
+const int XCT_TM1_DORA_DEL_CALL_FWD_BENCH  = 232;
+
+const int XCT_TM1_DORA_UPD_SUB_DATA_MIX  = 234;
+
 
 // Forward declarations
 
@@ -173,6 +194,12 @@ public:
     w_rc_t update_partitioning();
 
 
+    //// Trx submission, routes each trx type to its dora_XXX()
+    w_rc_t submit_xct(const int xct_type, const int xct_id,
+                      const int spec_id, trx_result_tuple_t& atrt,
+                      const uint worker_hint, const bool bWake);
+
+
     //// DORA TM1 - PARTITIONED TABLES
 
     DECLARE_DORA_PARTS(sub);
@@ -49,6 +49,9 @@ using namespace tpcb;
 ENTER_NAMESPACE(dora);
 
 
+// Look also at include/workload/tpcb/tpcb_const.h
+const int XCT_TPCB_DORA_ACCT_UPDATE   = 331;
+
 
 // Forward declarations
 
@@ -94,6 +97,12 @@ public:
     w_rc_t update_partitioning();
 
 
+    //// Trx submission, routes each trx type to its dora_XXX()
+    w_rc_t submit_xct(const int xct_type, const int xct_id,
+                      const int spec_id, trx_result_tuple_t& atrt,
+                      const uint worker_hint, const bool bWake);
+
+
     //// DORA TPCB - PARTITIONED TABLES
 
     DECLARE_DORA_PARTS(br);  // Branch
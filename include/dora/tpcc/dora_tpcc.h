@@ -49,6 +49,20 @@ using namespace tpcc;
 ENTER_NAMESPACE(dora);
 
 
+// Look also at include/workload/tpcc/tpcc_const.h
+const int XCT_DORA_MIX           = 100;
+const int XCT_DORA_NEW_ORDER     = 101;
+const int XCT_DORA_PAYMENT       = 102;
+const int XCT_DORA_ORDER_STATUS  = 103;
+const int XCT_DORA_DELIVERY      = 104;
+const int XCT_DORA_STOCK_LEVEL   = 105;
+
+const int XCT_DORA_LITTLE_MIX    = 109;
+
+const int XCT_DORA_MBENCH_WH   = 111;
+const int XCT_DORA_MBENCH_CUST = 112;
+
+
 // Forward declarations
 
 // MBenches
@@ -138,6 +152,12 @@ public:
     //// Partition-related
     w_rc_t update_partitioning();
 
+
+    //// Trx submission, routes each trx type to its dora_XXX()
+    w_rc_t submit_xct(const int xct_type, const int xct_id,
+                      const int spec_id, trx_result_tuple_t& atrt,
+                      const uint worker_hint, const bool bWake);
+
     //// DORA TPCC TABLE PARTITIONS
     DECLARE_DORA_PARTS(whs);
     DECLARE_DORA_PARTS(dis);
@@ -26,6 +26,7 @@
 
 #include "qpipe/core/tuple.h"
 #include <algorithm>
+#include <vector>
 
 
 
@@ -36,6 +37,11 @@ ENTER_NAMESPACE(qpipe);
 
 
 
+// positions of the tuples of a page that pass a filter
+typedef std::vector<size_t> selection_t;
+
+
+
 /** 
  * @brief Base selection/projection functor. Should be extended to
  * implement other selection/projection functors.
@@ -94,6 +100,71 @@ public:
     }
 
 
+    /**
+     *  @brief Whether the stages should filter whole pages through
+     *  select_batch() and project_batch(), instead of calling select()
+     *  and project() for each tuple.
+     *
+     *  Many filters keep state from select() to the project() of the
+     *  same tuple (e.g. the table_row_t the tuple was loaded to), so
+     *  the stages call the batch methods only for the filters that
+     *  return true here.
+     */
+
+    virtual bool batched() const {
+        return false;
+    }
+
+
+    /**
+     *  @brief Batch version of select(). Evaluates the predicates on
+     *  every tuple of a page and stores the positions of the tuples
+     *  that pass them in (sel), in increasing order.
+     *
+     *  This default implementation calls select() for each tuple.
+     */
+
+    virtual void select_batch(page &p, selection_t &sel);
+
+
+    /**
+     *  @brief Branch-free select_batch() for the filters that read
+     *  the fields straight from the records. (pred) is called with the
+     *  data of each tuple of the page, and returns whether it passes.
+     *
+     *  Every position is written to (sel), but the count of the
+     *  selected ones advances only when the tuple passes, so that the
+     *  loop does not mispredict on selective predicates.
+     */
+
+    template <class Pred>
+    static void select_batch_if(page &p, selection_t &sel, const Pred &pred) {
+        const size_t count = p.tuple_count();
+        sel.resize(count);
+        size_t selected = 0;
+        for(size_t i=0; i < count; i++) {
+            sel[selected] = i;
+            selected += (size_t)pred(p.get_tuple(i).data);
+        }
+        sel.resize(selected);
+    }
+
+
+    /**
+     *  @brief Batch version of project(). Projects the tuples of a
+     *  page at the positions in (sel) to newly allocated tuples of the
+     *  (out) buffer.
+     *
+     *  This default implementation calls project() for each tuple.
+     *
+     *  @throw TerminatedBufferException if the consumer of (out) has
+     *  terminated it.
+     */
+
+    virtual void project_batch(tuple_fifo* out, page &p,
+                               const selection_t &sel);
+
+
     // should simply return new <child-class>(*this);
     virtual tuple_filter_t* clone() const=0;
 
@@ -221,6 +221,17 @@ public:
     }
 
 
+    /**
+     *  @brief Whether the packets that did not see the whole input of
+     *  a stage can be merged into any other list of such packets in
+     *  the container queue, because they only need the input from the
+     *  beginning up to their _next_tuple_needed (e.g. table scans).
+     */
+    virtual bool is_circular() const {
+        return false;
+    }
+
+
     void assign_query_state(query_state_t* qstate) {
         _qstate = qstate;
     }
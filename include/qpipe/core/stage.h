@@ -63,6 +63,15 @@ public:
         virtual void output(page* p)=0;
 	virtual void stop_accepting_packets()=0;	
         virtual bool check_for_cancellation()=0;
+
+        // the number of packets the output goes to
+        virtual int packet_count()=0;
+
+        // Idle workers of the stage that the packet may take for
+        // itself, to process it in parallel. Never waits, returns how
+        // many it got (at most n). By default there are none.
+        virtual int reserve_helpers(int /* n */) { return (0); }
+        virtual void release_helpers(int /* n */) { }
         
         /**
          *  @brief Write a tuple to each waiting output buffer in a
@@ -70,6 +70,7 @@ protected:
     // container queue manipulation
     void container_queue_enqueue_no_merge(packet_list_t* packets);
     void container_queue_enqueue_no_merge(packet_t* packet);
+    bool container_queue_merge_circular(packet_list_t* packets);
     packet_list_t* container_queue_dequeue();
     void create_worker();
    
@@ -149,6 +150,10 @@ protected:
     // Group many output() tuples into a page before "sending"
     // entire page to packet list
     guard<page> out_page;
+
+    // Survivors of the batched output filters, reused across pages.
+    // Only the worker thread of the stage outputs pages.
+    selection_t _selection;
 	
     // Checked independently of other variables. Don't need to
     // protect this with _stage_adaptor_mutex.
@@ -203,6 +208,20 @@ public:
     }
 
 
+    /**
+     *  @brief Only the thread running the stage removes packets from
+     *  the list, so it only needs to lock out the mergers.
+     */
+    virtual int packet_count() {
+	critical_section_t cs(_stage_adaptor_lock);
+	return _packet_list->size();
+    }
+
+
+    virtual int reserve_helpers(int n);
+    virtual void release_helpers(int n);
+
+
     stage_container_t::merge_t try_merge(packet_t* packet);
     void run_stage(stage_t* stage);
     
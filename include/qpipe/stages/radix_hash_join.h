@@ -0,0 +1,264 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   radix_hash_join.h
+ *
+ *  @brief:  Declaration of the RADIX_HASH_JOIN stage and packet.
+ *
+ *  The stage materializes the right (build) input and radix-partitions
+ *  it on the low bits of the hash of the join key, in one or two passes.
+ *  Each pass writes to at most (1<<RHJ_PASS_BITS) partitions, so that
+ *  the output pages of a pass stay in the TLB. There are enough
+ *  partitions for each to fit in the cache, and each gets a small hash
+ *  table over a contiguous bucket array. The left (probe) input is
+ *  streamed into the same partitions, which are probed in batches, so
+ *  that only a bounded part of it is in memory. The partitions of a
+ *  batch can be probed by multiple threads.
+ *
+ *  @note:   The "qpipe-join" option selects between this stage ("radix")
+ *           and the HASH_JOIN stage ("hash") in the TPC-H and SSB plans.
+ *           "qpipe-rhj-threads" sets the number of probing threads, and
+ *           "qpipe-rhj-batch-mb" the memory for a batch of the left input.
+ */
+
+#ifndef __QPIPE_RADIX_HASH_JOIN_STAGE_H
+#define __QPIPE_RADIX_HASH_JOIN_STAGE_H
+
+#include "qpipe/core.h"
+
+#include <vector>
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+#define RADIX_HASH_JOIN_STAGE_NAME  "RADIX_HASH_JOIN"
+#define RADIX_HASH_JOIN_PACKET_TYPE "RADIX_HASH_JOIN"
+
+
+// target size of the right side of a partition (bytes)
+const size_t RHJ_CACHE_BYTES = 256*1024;
+
+// partitioning bits per pass, and in total (two passes)
+const int RHJ_PASS_BITS = 6;
+const int RHJ_MAX_BITS  = 2*RHJ_PASS_BITS;
+
+// maximum number of probing threads
+const int RHJ_MAX_THREADS = 32;
+
+// default memory for a batch of the left input (MB)
+const int RHJ_DEFAULT_BATCH_MB = 256;
+
+// pages of output a probing thread buffers for the stage thread
+const size_t RHJ_PROBER_PAGES = 32;
+
+
+
+/**************************
+ * radix_hash_join_packet *
+ **************************/
+
+class radix_hash_join_packet_t : public packet_t {
+
+public:
+    static const c_str PACKET_TYPE;
+
+    guard<packet_t> _left;
+    guard<packet_t> _right;
+    guard<tuple_fifo> _left_buffer;
+    guard<tuple_fifo> _right_buffer;
+
+    guard<tuple_join_t> _join;
+    bool _outer;
+    bool _distinct;
+
+    /**
+     *  @brief Constructor. Same as the one of hash_join_packet_t.
+     *
+     *  @param left Left side-input packet. It becomes the outer
+     *  (probing) relation of the join.
+     *
+     *  @param right Right-side packet. It becomes the inner (build)
+     *  relation of the join. It should be the smaller input.
+     */
+    radix_hash_join_packet_t(const c_str &packet_id,
+                             tuple_fifo* out_buffer,
+                             tuple_filter_t *output_filter,
+                             packet_t* left,
+                             packet_t* right,
+                             tuple_join_t *join,
+                             bool outer=false,
+                             bool distinct=false)
+        : packet_t(packet_id, PACKET_TYPE, out_buffer, output_filter,
+                   create_plan(output_filter, join, outer, distinct, left, right),
+                   true, /* merging allowed */
+                   true  /* unreserve worker on completion */
+                   ),
+          _left(left),
+          _right(right),
+          _left_buffer(left->output_buffer()),
+          _right_buffer(right->output_buffer()),
+          _join(join),
+          _outer(outer), _distinct(distinct)
+    {
+    }
+
+    static query_plan* create_plan(tuple_filter_t* filter, tuple_join_t* join,
+                                   bool outer, bool distinct,
+                                   packet_t* left, packet_t* right)
+    {
+        c_str action("%s:%s:%d:%d", PACKET_TYPE.data(),
+                     join->to_string().data(), outer, distinct);
+
+        query_plan const** children = new query_plan const*[2];
+        children[0] = left->plan();
+        children[1] = right->plan();
+        return new query_plan(action, filter->to_string(), children, 2);
+    }
+
+    virtual void declare_worker_needs(resource_declare_t* declare) {
+        declare->declare(_packet_type, 1);
+        _left->declare_worker_needs(declare);
+        _right->declare_worker_needs(declare);
+    }
+};
+
+
+
+/*************************
+ * radix_hash_join_stage *
+ *************************/
+
+class radix_hash_join_stage_t : public stage_t {
+
+public:
+
+    /* A materialized input or partition, with the hash of the key of
+       each tuple */
+    struct relation_t {
+        size_t _tuple_size;
+        size_t _count;
+        std::vector<char>     _data;
+        std::vector<uint32_t> _hash;
+
+        relation_t(size_t tuple_size)
+            : _tuple_size(tuple_size), _count(0)
+        {
+        }
+
+        char* tuple(size_t i) { return (&_data[i*_tuple_size]); }
+
+        void append(const char* data, uint32_t hash) {
+            _data.insert(_data.end(), data, data + _tuple_size);
+            _hash.push_back(hash);
+            _count++;
+        }
+
+        void clear() {
+            _data.clear();
+            _hash.clear();
+            _count = 0;
+        }
+    };
+
+    /* The partitions of a batch probed by one thread */
+    struct probe_range_t {
+        int _first;
+        int _last;
+
+        probe_range_t() : _first(0), _last(0) { }
+    };
+
+private:
+
+    tuple_join_t* _join;
+    bool _outer;
+    bool _distinct;
+    int  _bits;
+    int  _threads;
+
+    // partition boundaries of the right relation, (1<<_bits)+1 entries
+    std::vector<size_t> _right_bounds;
+
+    // the hash tables of the right partitions. The buckets of partition
+    // p are [_bucket_bounds[p], _bucket_bounds[p+1]), the chains are
+    // indexed by the position of the tuple in its partition.
+    std::vector<size_t> _bucket_bounds;
+    std::vector<int> _buckets;
+    std::vector<int> _next;
+
+    void read_right(tuple_fifo* buffer, relation_t &rel);
+    void partition(relation_t &rel, std::vector<size_t> &bounds);
+    void radix_pass(relation_t &src, relation_t &dst,
+                    size_t begin, size_t end,
+                    int shift, int bits,
+                    std::vector<size_t> &bounds);
+    void build(relation_t &right);
+
+    void probe_batch(relation_t &right, std::vector<relation_t> &left);
+    void probe_partition(relation_t &right, relation_t &left, int part,
+                         tuple_fifo* out);
+
+    class prober_t;
+    void stop_probers(std::vector<prober_t*> &probers);
+
+public:
+
+    typedef radix_hash_join_packet_t stage_packet_t;
+
+    static const c_str DEFAULT_STAGE_NAME;
+
+    virtual void process_packet();
+
+    void probe_range(relation_t &right, std::vector<relation_t> &left,
+                     const probe_range_t &range, tuple_fifo* out);
+
+    radix_hash_join_stage_t()
+        : _join(NULL), _outer(false), _distinct(false), _bits(0), _threads(1)
+    {
+    }
+
+    ~radix_hash_join_stage_t() {
+    }
+
+};
+
+
+
+/**
+ *  @brief Creates a HASH_JOIN or a RADIX_HASH_JOIN packet, depending
+ *  on the "qpipe-join" option. Used by the TPC-H and SSB plans.
+ */
+packet_t* create_hash_join_packet(const c_str &packet_id,
+                                  tuple_fifo* out_buffer,
+                                  tuple_filter_t *output_filter,
+                                  packet_t* left,
+                                  packet_t* right,
+                                  tuple_join_t *join,
+                                  bool outer=false,
+                                  bool distinct=false);
+
+
+EXIT_NAMESPACE(qpipe);
+
+#endif	// __QPIPE_RADIX_HASH_JOIN_STAGE_H
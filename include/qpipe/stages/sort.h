@@ -24,12 +24,10 @@
 #ifndef __QPIPE_SORT_H
 #define __QPIPE_SORT_H
 
-#include "qpipe/stages/merge.h"
 #include "qpipe/core.h"
 
 #include <list>
-#include <map>
-#include <deque>
+#include <vector>
 
 
 
@@ -130,14 +128,24 @@ public:
 /**
  * @brief Sort stage that partitions the input into sorted runs and
  * merges them into a single output run.
+ *
+ * The runs are sorted on (hint,pointer) pairs and written to temporary
+ * files, optionally by helper threads ("qpipe-sort-threads"). The runs
+ * are then merged by the SORT worker itself with a loser tree. The
+ * merge factor is the number of pages of the memory budget
+ * ("qpipe-sort-pages", which is also the size of a run), less one for
+ * the output. If there are more runs than that, the smallest runs are
+ * merged first into intermediate runs, so that the final merge reads
+ * exactly (merge factor) runs.
  */
 class sort_stage_t : public stage_t {
 
 private:
 
 
-    static const unsigned int MERGE_FACTOR;
+    static const unsigned int MAX_MERGE_FACTOR;
     static const unsigned int PAGES_PER_INITIAL_SORTED_RUN;
+    static const unsigned int MAX_SORT_THREADS;
 
     
     // state provided by the packet
@@ -148,42 +156,30 @@ private:
     
 
     typedef list<c_str> run_list_t;
+    typedef std::vector<hint_tuple_pair_t> hint_vector_t;
+
 
+    // a run read in memory, to be sorted and written to a file
+    struct run_t {
+        page_trash_stack _pages;
+        hint_vector_t    _array;
+        c_str            _file_name;
+        guard<key_extractor_t> _extract;
+        guard<key_compare_t>   _compare;
 
-    // all information we need for an active merge
-    struct merge_t {
-	c_str _output; // name of output file
-	run_list_t _inputs;
-        tuple_fifo* _signal_buffer;
-	
-	merge_t () { }
-        merge_t(const c_str &output, const run_list_t &inputs, tuple_fifo * signal_buffer)
-            : _output(output),
-	      _inputs(inputs),
-	      _signal_buffer(signal_buffer)
+        run_t(key_extractor_t* extract, key_compare_t* compare)
+            : _extract(extract->clone()), _compare(compare->clone())
         {
         }
-    };
-
-    
-    typedef std::map<int, run_list_t> run_map_t;
-    typedef std::list<merge_t> merge_list_t;
-    typedef std::map<int, merge_list_t> merge_map_t;
-    typedef merge_packet_t::buffer_list_t buffer_list_t;
-    typedef std::vector<hint_tuple_pair_t> hint_vector_t;
-
 
-    // used to communicate with the monitor thread
-    pthread_t _monitor_thread;
-    notify_t  _monitor;
+        void sort_and_write(size_t tuple_size);
+    };
 
+    class run_writer_t;
 
-    volatile bool _sorting_finished;
-    
 
-    // run/merge management
-    run_map_t   _run_map;
-    merge_map_t _merge_map;
+    // the sorted runs on disk, in the order they were created
+    run_list_t _runs;
     
 public:
 
@@ -193,33 +189,14 @@ public:
 
     sort_stage_t()
         : _input_buffer(NULL), _extract(NULL), _compare(NULL),
-          _tuple_size(0), _monitor_thread(0)
+          _tuple_size(0)
     {
     }
 
     
     ~sort_stage_t() {
-
-        // make sure the monitor thread exits before we do...
-        {
-	    //This critical section makes sure that the monitor thread will be joined only once.
-            critical_section_t cs(_monitor._lock);
-            if(_monitor_thread) {
-                thread_join<void>(_monitor_thread);
-                //MA: Have to make sure it is not breaking anything <-- Indeed it was breaking. But we need the changes in the sort.cpp
-                //pthread_kill(_monitor_thread,SIGKILL);
-            }
-        }
-        // also, remove any remaining temp files
-        merge_map_t::iterator level_it=_merge_map.begin();
-        while(level_it != _merge_map.end()) {
-            merge_list_t::iterator it = level_it->second.begin();
-            while(it != level_it->second.end()) {
-                remove_input_files(it->_inputs);
-                ++it;
-            }
-            ++level_it;
-        }
+        // remove any remaining temp files
+        remove_input_files(_runs);
     }
 
 protected:
@@ -228,19 +205,14 @@ protected:
     
 private:
 
-    bool final_merge_ready();
-    int create_sorted_run(int page_count);
-
-    tuple_fifo* monitor_merge_packets();
+    bool read_run(run_t* run, unsigned int pages);
+    void add_run(run_t* run);
 
-    void check_finished_merges();
-    void start_new_merges();
-    void start_merge(int new_level, run_list_t& runs, int merge_factor);
+    void merge_runs(run_list_t& inputs, FILE* file);
     void remove_input_files(run_list_t& files);
 
     // debug
     int print_runs();
-    int print_merges();
 };
 
 
@@ -27,6 +27,24 @@
  *
  *  @author: Ippokratis Pandis
  *  @date:   Apr 2010
+ *
+ *  @note:   The scans are circular. A TSCAN packet attaches to the
+ *           running scan of the same table, whatever its filter, and
+ *           receives the rest of the table. The stage container then
+ *           re-runs the scan from the beginning for the late packets,
+ *           until each of them has seen the whole table. So there is
+ *           one physical scan per table. Setting "qpipe-tscan-circular"
+ *           to 0 gives each packet its own scan. The pages read and the
+ *           pages delivered to the packets are kept per table.
+ *
+ *  @note:   A scan can be parallel. The file is cut into morsels of
+ *           "qpipe-tscan-morsel-pages" pages, which helper threads claim
+ *           in file order and read into a fifo each. The TSCAN worker
+ *           outputs the fifos in morsel order, so the packets see the
+ *           records in the same order as with a single reader, which is
+ *           what the circular scans count on. The helpers are idle
+ *           workers of the TSCAN stage, at most "qpipe-tscan-helpers",
+ *           and run inside the transaction of the packet.
  */
 
 #ifndef __QPIPE_TSCAN_H
@@ -37,6 +55,8 @@
 #include "qpipe/core/tuple_fifo.h"
 #include "qpipe/core.h"
 
+#include <map>
+
 using namespace shore;
 
 ENTER_NAMESPACE(qpipe);
@@ -54,6 +74,7 @@ struct tscan_packet_t : public packet_t
     table_desc_t* _table;
     xct_t*        _xct;
     lock_mode_t   _lm;
+    bool          _circular;
 
     static const c_str PACKET_TYPE;
    
@@ -94,10 +115,39 @@ struct tscan_packet_t : public packet_t
     static query_plan* create_plan(tuple_filter_t* filter, table_desc_t* file);
     void declare_worker_needs(resource_declare_t* declare);
 
+    bool is_circular() const { return (_circular); }
+
 }; // EOF: tscan_packet_t
 
 
 
+/******************************************************************
+ * 
+ * @struct: tscan_stats_t
+ *
+ * @brief:  The pages of a table read by the scans and delivered to
+ *          the TSCAN packets. Independent scans would have read as 
+ *          many pages as were delivered.
+ *
+ ******************************************************************/
+
+struct tscan_stats_t
+{
+    ulong_t _scans;
+    ulong_t _pages_read;
+    ulong_t _pages_delivered;
+    ulong_t _morsels;      // read by helpers, 0 for a serial scan
+
+    tscan_stats_t() 
+        : _scans(0), _pages_read(0), _pages_delivered(0), _morsels(0)
+    { }
+
+    ulong_t pages_saved() const { return (_pages_delivered - _pages_read); }
+
+}; // EOF: tscan_stats_t
+
+
+
 /******************************************************************
  * 
  * @class: Table scan stage
@@ -111,15 +161,34 @@ public:
     typedef tscan_packet_t stage_packet_t;
     static const c_str  DEFAULT_STAGE_NAME;
 
-    static const size_t TSCAN_BULK_READ_BUFFER_SIZE;
+    static const uint DEFAULT_MORSEL_PAGES;
+    static const uint MAX_TSCAN_HELPERS;
 
     tscan_stage_t() { }
     ~tscan_stage_t() { }
 
+    // per table statistics
+    static void add_stats(const c_str& table, const tscan_stats_t& stats);
+    static void clear_stats();
+    static void trace_stats();
+
 protected:
     
     virtual void process_packet();
 
+private:
+
+    struct morsel_t;
+    class  morsel_queue_t;
+    class  morsel_reader_t;
+
+    void scan_serial(tscan_packet_t* packet, tscan_stats_t& stats);
+    void scan_parallel(tscan_packet_t* packet, int helpers, uint pages,
+                       tscan_stats_t& stats);
+
+    static pthread_mutex_t _stats_mutex;
+    static std::map<c_str, tscan_stats_t> _stats;
+
 }; // EOF: tscan_stage_t
 
 
@@ -36,6 +36,7 @@
 #include "sm/shore/shore_reqs.h"
 #include "sm/shore/shore_worker.h"
 #include "sm/shore/srmwqueue.h"
+#include "sm/shore/lfqueue.h"
 
 #include "sm/shore/shore_error.h"
 #include "sm/shore/shore_tools.h"
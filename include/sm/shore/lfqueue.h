@@ -0,0 +1,278 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:  lfqueue.h
+ *
+ *  @brief: A lock-free single-reader, multiple-writer queue.
+ *
+ *  Drop-in replacement of the srmwqueue. The writers push with a single
+ *  CAS to a LIFO list of nodes, and the reader detaches the whole list with
+ *  a single swap and reverses it to its private vector, in order to serve
+ *  the elements in FIFO order. There is no lock on the push path, so the
+ *  writers contend only on the cache line of the head pointer.
+ *
+ *  As the srmwqueue, the reader initially spins while waiting for new
+ *  elements to arrive and then sleeps on the condex of its owner.
+ *
+ *  @note:  The nodes are allocated from a blob_pool, which allows the reader
+ *          to release nodes allocated by the writer threads.
+ */
+
+#ifndef __SHORE_LF_QUEUE_H
+#define __SHORE_LF_QUEUE_H
+
+#include "sm/shore/srmwqueue.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+template<class Action>
+struct lfqueue
+{
+    typedef typename PooledVec<Action*>::Type ActionVec;
+    typedef typename ActionVec::iterator ActionVecIt;
+
+    // a node of the writers list
+    struct node_t {
+        Action* _action;
+        node_t* _next;
+        node_t(Action* a) : _action(a), _next(NULL) { }
+    };
+
+    // owner thread
+    base_worker_t* _owner;
+
+    // the writers push to the head of the list
+    node_t* volatile _head;
+    blob_pool        _node_pool;
+
+    // the writers count the elements they push only if there is a threshold
+    // to check. Writers cannot look at the depth of the list, because the 
+    // reader may have already detached and released the head node
+    uint volatile    _pushed;
+
+    guard<ActionVec> _for_readers;
+    ActionVecIt _read_pos;
+
+    eWorkingState _my_ws;
+
+    int _loops; // how many loops (spins) it will do before going to sleep (1=sleep immediately)
+    int _thres; // threshold value before waking up
+
+    lfqueue(Pool* actionPtrPool)
+        : _owner(NULL), _head(NULL), _node_pool(sizeof(node_t)), _pushed(0),
+          _my_ws(WS_UNDEF), _loops(0), _thres(0)
+    {
+        assert (actionPtrPool);
+        _for_readers = new ActionVec(actionPtrPool);
+        _read_pos = _for_readers->begin();
+    }
+    ~lfqueue() { _release(_detach()); }
+
+
+    // sets the pointer of the queue to the controls of a specific worker thread
+    // @note: the owner should not be running at that point
+    void setqueue(eWorkingState aws, base_worker_t* owner, const int& loops, const int& thres)
+    {
+        _my_ws = aws;
+        _owner = owner;
+        _loops = loops;
+        _thres = thres;
+        membar_producer();
+    }
+
+    // returns true if the passed control is the same
+    bool is_control(base_worker_t* athread) const { return (_owner==athread); }
+
+    // !!! @note: should be called only by the reader !!!
+    inline int is_empty(void) const {
+        return ((_read_pos == _for_readers->end()) && (*&_head == NULL));
+    }
+
+    // There is no lock to take, it is the same with is_empty()
+    bool is_really_empty(void)
+    {
+        return (is_empty());
+    }
+
+    // spins until new input is set
+    bool wait_for_input()
+    {
+        assert (_owner);
+        int loopcnt = 0;
+        uint_t wc = WC_ACTIVE;
+
+        // 1. start spinning
+	while (*&_head == NULL) {
+
+            wc = _owner->get_control();
+
+            // 2. if thread was signalled to stop
+	    if (wc != WC_ACTIVE) {
+                _owner->set_ws(WS_FINISHED);
+		return (false);
+            }
+
+            // 3. if thread was signalled to go to other queue
+            if (!_owner->can_continue(_my_ws)) return (false);
+
+            // 4. if spinned too much, start waiting on the condex
+            if (++loopcnt > _loops) {
+                // after it wakes up, it does the loop again (see srmwqueue)
+                loopcnt = _owner->condex_sleep();
+            }
+	}
+
+        // Detach the list of the writers and put it in FIFO order
+        node_t* list = _detach();
+        if (_thres) atomic_swap_uint(&_pushed, 0);
+        _for_readers->erase(_for_readers->begin(),_for_readers->end());
+        _for_readers->resize(_length(list));
+        ActionVecIt it = _for_readers->end();
+        for (node_t* node = list; node; node = node->_next) {
+            *(--it) = node->_action;
+        }
+        assert (it == _for_readers->begin());
+        _release(list);
+
+	_read_pos = _for_readers->begin();
+	return (true);
+    }
+
+    inline Action* pop() {
+        // pops an action from the input vector, or waits for one to show up
+	if ((_read_pos == _for_readers->end()) && (!wait_for_input()))
+	    return (NULL);
+	return (*(_read_pos++));
+    }
+
+    inline void push(Action* a, const bool bWake) {
+        node_t* node = new (_node_pool) node_t(a);
+        uint queue_sz = 0;
+
+        // push action
+        node_t* old_head = *&_head;
+        while (true) {
+            node->_next = old_head;
+            node_t* cur_head = atomic_cas(&_head, old_head, node);
+            if (cur_head == old_head) break;
+            old_head = cur_head;
+        }
+        if (_thres) queue_sz = atomic_inc_uint_nv(&_pushed);
+
+        // don't try to wake on every call. let for some requests to batch up
+        if ((queue_sz >= (uint)_thres) || bWake) {
+            // wake up if assigned worker thread sleeping
+            _owner->set_ws(_my_ws);
+        }
+    }
+
+    // Copies the elements not consumed yet, first those on the reader
+    // side and then those still on the writer side.
+    // Returns how many of them were found on the reader side.
+    // @note: should be called only by the reader, or after the reader stopped
+    uint pending(std::vector<Action*>& out) {
+        uint reads = 0;
+        for (ActionVecIt it = _read_pos; it != _for_readers->end(); ++it) {
+            out.push_back(*it);
+            ++reads;
+        }
+        // the nodes already in the list do not change, the writers can
+        // only put new nodes in front of them
+        node_t* list = *&_head;
+        out.resize(out.size() + _length(list));
+        for (uint i = out.size(); list; list = list->_next) {
+            out[--i] = list->_action;
+        }
+        return (reads);
+    }
+
+    // resets queue
+    void clear(const bool removeOwner=true) {
+        // clear owner
+        if (removeOwner) _owner = NULL;
+
+        // clear lists
+        _release(_detach());
+        atomic_swap_uint(&_pushed, 0);
+        _for_readers->erase(_for_readers->begin(),_for_readers->end());
+
+        // set the reading position to the beginning
+        _read_pos = _for_readers->begin();
+    }
+
+private:
+
+    // takes the whole list from the writers
+    node_t* _detach() {
+        return (atomic_swap(&_head, (node_t*)NULL));
+    }
+
+    static uint _length(node_t* list) {
+        uint len = 0;
+        for (; list; list = list->_next) ++len;
+        return (len);
+    }
+
+    void _release(node_t* list) {
+        node_t* next;
+        for (; list; list = next) {
+            next = list->_next;
+            _node_pool.destroy(list);
+        }
+    }
+
+    // copying not allowed
+    lfqueue(lfqueue const &);
+    void operator=(lfqueue const &);
+
+}; // EOF: struct lfqueue
+
+
+
+/********************************************************************
+ *
+ * @struct: WorkerQueue
+ *
+ * @brief:  The queue used by the worker threads, the DORA partitions
+ *          and the flushers. Configure with --disable-lfqueue to fall
+ *          back to the lock-based srmwqueue.
+ *
+ ********************************************************************/
+
+template<class Action>
+struct WorkerQueue
+{
+#ifdef CFG_LFQUEUE
+    typedef lfqueue<Action> Type;
+#else
+    typedef srmwqueue<Action> Type;
+#endif
+};
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /** __SHORE_LF_QUEUE_H */
+
@@ -0,0 +1,176 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_bulk_loader.h
+ *
+ *  @brief:  Sorted runs of (key,rid) pairs, used to build the indexes of
+ *           a table bottom-up after its heap file has been loaded.
+ *
+ *  @note:   The bulk loading happens in three phases:
+ *           1. The rows are appended to the heap file without touching
+ *              the indexes (see table_man_t::add_tuple).
+ *           2. The heap file is scanned once, and the (key,rid) pairs of
+ *              every index (partition) are collected to sorted runs, which
+ *              are spilled to temporary files.
+ *           3. The runs of each index are merged to a temporary Shore file
+ *              which is passed to the bulk-loading of the Shore B-tree.
+ *              MRBTrees, and indexes that are not empty, are instead
+ *              filled with inserts in key order.
+ */
+
+#ifndef __SHORE_BULK_LOADER_H
+#define __SHORE_BULK_LOADER_H
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include <cstdio>
+#include <vector>
+
+#include "sm/shore/shore_index.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+class table_desc_t;
+
+// default size of a run in memory (MB)
+const int BULK_RUN_MB = 64;
+
+
+
+/********************************************************************
+ *
+ * @class: bulk_runs_t
+ *
+ * @brief: The (key,rid) pairs of one index partition. The pairs are
+ *         buffered and every time the buffer fills up, it gets sorted
+ *         in key order and spilled to a temporary file as a run.
+ *
+ * @note:  The keys are compared the same way the B-tree compares them,
+ *         field by field according to the key description of the index.
+ *
+ ********************************************************************/
+
+class bulk_runs_t
+{
+public:
+
+    // the type of comparison of each field of the key
+    struct key_field_t {
+        char   _kind;   // 'i' (signed int), 'f' (float), 'b' (bytes)
+        uint_t _offset;
+        uint_t _size;
+    };
+
+private:
+
+    index_desc_t* _pindex;
+    int           _pnum;
+
+    std::vector<key_field_t> _fields;
+    uint_t        _key_sz;
+    uint_t        _entry_sz; // key + rid
+
+    // the run in memory
+    char*         _buf;
+    uint_t        _run_entries; // capacity of the run
+    uint_t        _entries;
+
+    // the runs spilled
+    std::vector<FILE*> _runs;
+    uint_t        _total;
+
+    w_rc_t _spill();
+
+public:
+
+    bulk_runs_t(table_desc_t* ptable, index_desc_t* pindex,
+                const int pnum, const uint_t run_bytes);
+    ~bulk_runs_t();
+
+    inline index_desc_t* index() const { return (_pindex); }
+    inline int pnum() const { return (_pnum); }
+    inline uint_t count() const { return (_total + _entries); }
+    inline uint_t key_size() const { return (_key_sz); }
+
+    int compare(const char* akey, const char* bkey) const;
+
+    // Adds a (key,rid) pair
+    w_rc_t append(const char* key, const rid_t& rid);
+
+    // Loads the index partition. The caller should not be in a trx
+    w_rc_t build(ss_m* db, const vid_t& vid);
+
+private:
+
+    w_rc_t _build_bulk(ss_m* db, const vid_t& vid);
+    w_rc_t _build_inserts(ss_m* db);
+
+    // copying not allowed
+    bulk_runs_t(bulk_runs_t const &);
+    void operator=(bulk_runs_t const &);
+
+}; // EOF: bulk_runs_t
+
+
+
+/********************************************************************
+ *
+ * @class: bulk_merge_t
+ *
+ * @brief: K-way merge of the runs of a bulk_runs_t, returns the (key,rid)
+ *         pairs in key order
+ *
+ ********************************************************************/
+
+class bulk_merge_t
+{
+    const bulk_runs_t*  _runs;
+    std::vector<FILE*>  _files;
+    std::vector<char*>  _heads;  // the current entry of each run
+    std::vector<int>    _heap;   // min-heap of the runs with entries
+    char*               _last;   // the entry last returned
+    uint_t              _entry_sz;
+
+    bool _read(const int run);
+    void _sift_down(uint_t pos);
+    bool _less(const int a, const int b) const;
+
+public:
+
+    bulk_merge_t(const bulk_runs_t* runs,
+                 const std::vector<FILE*>& files,
+                 const uint_t entry_sz);
+    ~bulk_merge_t();
+
+    // returns false when all the runs are consumed
+    bool next(const char*& key, rid_t& rid);
+
+}; // EOF: bulk_merge_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_BULK_LOADER_H */
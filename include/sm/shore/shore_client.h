@@ -108,7 +108,92 @@ int close_test_env();
 
 const int DF_WARMUP_INTERVAL = 2; // 2 secs
 
-enum MeasurementType { MT_UNDEF, MT_NUM_OF_TRXS, MT_TIME_DUR };
+enum MeasurementType { MT_UNDEF, MT_NUM_OF_TRXS, MT_TIME_DUR, MT_OPEN_LOOP };
+
+
+// default maximum trxs in flight of an open-loop run
+const int DF_OPEN_LOOP_MAX_OUT = 100000;
+
+
+/******************************************************************** 
+ *
+ * @class: open_loop_t
+ *
+ * @brief: The arrivals of an open-loop (MT_OPEN_LOOP) run. One Poisson
+ *         stream at the offered rate, whose arrivals the clients take
+ *         in order and submit without waiting for the trxs to complete.
+ *
+ * @note:  Each trx is stamped with its arrival (see set_trx_arrival()),
+ *         so its latency counts the time it waited for a free client.
+ *         An arrival when the trxs in flight reach (max_out) is dropped.
+ *
+ ********************************************************************/
+
+struct open_loop_stats_t
+{
+    uint64_t _arrived;   // arrivals taken by the clients
+    uint64_t _dropped;   // arrivals not submitted, too many in flight
+    uint64_t _done;      // trxs completed
+    uint64_t _aborted;   // ... of which aborted
+
+    open_loop_stats_t() : _arrived(0), _dropped(0), _done(0), _aborted(0) { }
+
+    open_loop_stats_t& operator-=(const open_loop_stats_t& rhs);
+
+}; // EOF: open_loop_stats_t
+
+
+class open_loop_t : public trx_done_t
+{
+private:
+
+    double        _rate;    // offered, trxs/sec
+    uint          _max_out;
+
+    tatas_lock    _lock;
+    bool          _running;
+    double        _next;    // usecs, the next arrival
+    uint64_t      _arrived;
+    uint64_t      _dropped;
+
+    uint64_t volatile _done;
+    uint64_t volatile _aborted;
+    uint volatile     _out;
+
+public:
+
+    open_loop_t(const double rate, const uint max_out);
+    ~open_loop_t() { }
+
+    inline double rate() const { return (_rate); }
+    inline uint outstanding() const { return (*&_out); }
+
+    // The arrivals start now, and end with stop()
+    void start();
+    void stop();
+
+    // Takes the next arrival. Returns 0 if stopped. Otherwise, the
+    // arrival (usecs) and (admitted) whether to submit it.
+    long long next_arrival(bool& admitted);
+
+    // Called by the thread that notifies the client of the trx
+    void trx_done(const uint_t tag, const TrxState state);
+
+    // An admitted arrival that was not submitted after all
+    void cancel();
+
+    // Waits up to (secs) for the trxs in flight, false if some are left
+    bool drain(const int secs);
+
+    void get_stats(open_loop_stats_t& stats);
+
+private:
+
+    // copying not allowed
+    open_loop_t(open_loop_t const &);
+    void operator=(open_loop_t const &);
+
+}; // EOF: open_loop_t
 
 
 /******************************************************************** 
@@ -143,6 +228,9 @@ protected:
     // used for submitting batches
     guard<condex_pair> _cp;
 
+    // the arrivals, in MT_OPEN_LOOP (not the owner)
+    open_loop_t* _driver;
+
     // for processor binding
     bool          _is_bound;
     processorid_t _prs_id;
@@ -154,7 +242,7 @@ public:
 
     base_client_t() 
         : thread_t("none"), _env(NULL), _measure_type(MT_UNDEF), 
-          _trxid(-1), _notrxs(-1), _think_time(0),
+          _trxid(-1), _notrxs(-1), _think_time(0), _driver(NULL),
           _is_bound(false), _prs_id(PBIND_NONE),
           _rv(1)
     { }
@@ -164,12 +252,13 @@ public:
                   const int numOfTrxs,
                   processorid_t aprsid = PBIND_NONE) 
 	: thread_t(tname), _env(env), _measure_type(aType), 
-          _trxid(trxid), _notrxs(numOfTrxs), _think_time(0),
+          _trxid(trxid), _notrxs(numOfTrxs), _think_time(0), _driver(NULL),
           _is_bound(false), _prs_id(aprsid), _id(id), _rv(0)
     {
         assert (_env);
         assert (_measure_type != MT_UNDEF);
-        assert (_notrxs || (_measure_type == MT_TIME_DUR));
+        assert (_notrxs || (_measure_type == MT_TIME_DUR) || 
+                (_measure_type == MT_OPEN_LOOP));
         _cp = new condex_pair();
     }
 
@@ -199,6 +288,7 @@ public:
     // access methods
     int id() { return (_id); }
     bool is_bound() const { return (_is_bound); }
+    void set_driver(open_loop_t* driver) { _driver = driver; }
     inline int rv() { return (_rv); }
     
     // methods
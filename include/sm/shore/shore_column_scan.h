@@ -0,0 +1,128 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_column_scan.h
+ *
+ *  @brief:  Column-at-a-time scan over the heap file of a table
+ *
+ *  @note:   Instead of loading every field of every row to a table_row_t
+ *           (see table_man_t::load), the scanner copies only the requested
+ *           fixed-length fields, straight from the pinned record body, to
+ *           one array per field. Each call to next_batch() fills up to
+ *           COLUMN_BATCH_ROWS rows, so that the query kernels can run
+ *           tight loops over the arrays.
+ */
+
+#ifndef __SHORE_COLUMN_SCAN_H
+#define __SHORE_COLUMN_SCAN_H
+
+#include "sm_vas.h"
+#include "util.h"
+
+#include <vector>
+#include <cstring>
+
+#include "sm/shore/shore_iter.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+class table_desc_t;
+
+// rows per batch
+const uint_t COLUMN_BATCH_ROWS = 1024;
+
+
+// offset of a fixed-length field, that cannot be NULL, in every
+// record of the table
+offset_t fixed_field_offset(table_desc_t* ptable, const uint_t fid);
+
+// reads a field at such an offset from a record body, which need
+// not be aligned
+template <class T>
+inline T fixed_field(const char* body, const offset_t offset) {
+    T value;
+    memcpy(&value, body + offset, sizeof(T));
+    return (value);
+}
+
+
+
+/********************************************************************
+ *
+ * @class: column_scan_t
+ *
+ * @brief: Table scan that decodes a set of fixed-length fields to
+ *         column batches
+ *
+ * @note:  Only fixed-length fields that cannot be NULL can be scanned.
+ *         Those are stored at the same offset of every record.
+ *
+ ********************************************************************/
+
+class column_scan_t
+{
+private:
+
+    table_desc_t*          _ptable;
+    simple_table_iter_t    _iter;
+
+    uint_t                 _ncols;
+    std::vector<offset_t>  _offsets; // offset of each field in the record
+    std::vector<uint_t>    _sizes;   // size of each field
+    std::vector<char*>     _cols;    // COLUMN_BATCH_ROWS values per field
+
+public:
+
+    column_scan_t(ss_m* db, table_desc_t* ptable,
+                  const uint_t* fields, const uint_t nfields,
+                  lock_mode_t alm = SH);
+    ~column_scan_t();
+
+    // fills the next batch, (rows) is 0 only at (eof)
+    w_rc_t next_batch(uint_t& rows, bool& eof);
+
+    // the values of the (i)-th requested field
+    template <class T>
+    inline const T* column(const uint_t i) const {
+        assert (i<_ncols);
+        return ((const T*)_cols[i]);
+    }
+
+    inline const char* column_bytes(const uint_t i) const {
+        assert (i<_ncols);
+        return (_cols[i]);
+    }
+
+    inline uint_t column_size(const uint_t i) const {
+        assert (i<_ncols);
+        return (_sizes[i]);
+    }
+
+}; // EOF: column_scan_t
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /* __SHORE_COLUMN_SCAN_H */
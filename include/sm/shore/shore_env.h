@@ -175,6 +175,7 @@ const int    SHORE_NUM_DB_OPTIONS  = 5;
             TRACE( TRACE_TRX_FLOW, "Xct (%d) aborted [0x%x]\n", xct_id, e.err_num()); \
             w_rc_t e2 = _pssm->abort_xct();                             \
             if(e2.is_error()) TRACE( TRACE_ALWAYS, "Xct (%d) abort failed [0x%x]\n", xct_id, e2.err_num()); \
+            prequest->_result.set_state(ROLLBACKED);                    \
             prequest->notify_client();                                  \
             _request_pool.destroy(prequest);				\
             if ((*&_measure)!=MST_MEASURE) return (e);                  \
@@ -202,6 +203,7 @@ const int    SHORE_NUM_DB_OPTIONS  = 5;
             TRACE( TRACE_TRX_FLOW, "Xct (%d) aborted [0x%x]\n", xct_id, e.err_num()); \
             w_rc_t e2 = _pssm->abort_xct();                             \
             if(e2.is_error()) TRACE( TRACE_ALWAYS, "Xct (%d) abort failed [0x%x]\n", xct_id, e2.err_num()); \
+            prequest->_result.set_state(ROLLBACKED);                    \
             prequest->notify_client();                                  \
             if ((*&_measure)!=MST_MEASURE) return (e);                  \
             _env_stats.inc_trx_att();                                   \
@@ -234,6 +236,18 @@ const int    SHORE_NUM_DB_OPTIONS  = 5;
     DEFINE_TRX_STATS(cname,trx)
 
 
+// An alternative implementation (trximpl) of a transaction (trxlid),
+// which shares the input and the statistics of the transaction
+#define DECLARE_TRX_IMPL(trxlid,trximpl)                                \
+    w_rc_t run_##trximpl(Request* prequest, trxlid##_input_t& in);      \
+    w_rc_t run_##trximpl(Request* prequest);                            \
+    w_rc_t xct_##trximpl(const int xct_id, trxlid##_input_t& in)
+
+#define DEFINE_TRX_IMPL(cname,trxlid,trximpl)                           \
+    DEFINE_RUN_WITHOUT_INPUT_TRX_WRAPPER(cname,trxlid,trximpl);         \
+    DEFINE_RUN_WITH_INPUT_TRX_WRAPPER(cname,trxlid,trximpl)
+
+
 #ifdef USE_SHORE_6
 
 #define CHECK_XCT_RETURN(rc,needed_next_time,retry,ENV)			\
@@ -438,7 +452,7 @@ public:
     typedef std::map<string,string> ParamMap;
 
     typedef trx_request_t Request;
-    typedef blob_pool RequestStack;
+    typedef request_pool_t RequestStack;
     typedef trx_worker_t                Worker;
     typedef trx_worker_t*               WorkerPtr;
     typedef std::vector<WorkerPtr>           WorkerPool;
@@ -647,7 +661,7 @@ public:
     uint upd_worker_cnt();
     trx_worker_t* worker(const uint idx);        
 
-    // Request atomic trash stack
+    // Request caches, per client thread
     RequestStack _request_pool;
 
     // For thread-local stats
@@ -664,6 +678,12 @@ public:
     // Takes a checkpoint (forces dirty pages)
     int checkpoint();
 
+    // Bulk loading: the tables are loaded without their indexes, which
+    // are built at the end of the loading (see shore_bulk_loader.h)
+    bool is_bulkload_enabled() const;
+    void bulkload_begin();
+    w_rc_t bulkload_end();
+
     string sysname() { return (_sysname); }
 
     env_stats_t* get_env_stats() { return (&_env_stats); }
@@ -691,6 +711,13 @@ public:
     // Run one transaction
     virtual w_rc_t run_one_xct(Request* prequest)=0;
 
+    // Submits one transaction without a client thread. The (atrt) is
+    // notified when it completes. The baseline environments enqueue it
+    // to the (worker_hint)-th worker, the DORA ones to the partitions.
+    virtual w_rc_t submit_xct(const int xct_type, const int xct_id,
+                              const int spec_id, trx_result_tuple_t& atrt,
+                              const uint worker_hint, const bool bWake);
+
 
 
     // Control whether asynchronous commit will be used
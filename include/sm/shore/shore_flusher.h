@@ -64,6 +64,14 @@
       }
    }
 
+   With "flusher-policy = adaptive" the group size and the timeout are not
+   fixed. The flusher measures the latency of its flushes and the arrival 
+   rate of the xcts, and targets a group of as many xcts as arrive during
+   one flush. At low load this is a single xct, which is flushed right away.
+   With "flusher-pipeline = 1" the flusher also flushes the xcts that arrived
+   while the previous flush was in flight as soon as it returns, so that
+   the log device is kept busy. 
+
    In order to enable this mechanism Shore-kits needs to be configured with:
    --enable-dflusher
 */
@@ -98,6 +106,16 @@ struct flusher_stats_t
     uint trigByXcts;
     uint trigBySize;
     uint trigByTimeout;
+    uint trigByPipeline;
+
+    // The group commit policy and its last decisions
+    bool   adaptive;
+    bool   pipeline;
+    uint   groupTarget;   // xcts
+    uint   timeoutTarget; // usec
+    uint   adjustments;
+    double flushUsec;     // average flush latency
+    double arrivalRate;   // xcts per msec
     
     flusher_stats_t();
     ~flusher_stats_t();
@@ -121,6 +139,56 @@ struct flusher_stats_t
 
 
 
+/******************************************************************** 
+ *
+ * @class: group_commit_ctrl_t
+ *
+ * @brief: Picks the group size and the timeout of the flusher. With 
+ *         the static policy they are the configured thresholds. With
+ *         the adaptive policy they follow the moving averages of the
+ *         flush latency and of the arrival rate.
+ * 
+ ********************************************************************/
+
+const int    FLUSHER_MIN_TIMEOUT = 20;      // usec
+const double FLUSHER_EWMA_WEIGHT = 0.125;   // weight of the new sample
+
+class group_commit_ctrl_t
+{
+private:
+
+    bool   _adaptive;
+    bool   _pipeline;
+    uint   _max_group;
+    uint   _max_timeout;
+
+    double _flush_usec;
+    double _arrival_rate;  // xcts per usec
+
+    uint   _group;
+    uint   _timeout;
+
+public:
+
+    group_commit_ctrl_t(const bool adaptive, const bool pipeline,
+                        const uint max_group, const uint max_timeout);
+
+    inline bool adaptive() const { return (_adaptive); }
+    inline bool pipeline() const { return (_pipeline); }
+    inline uint group() const { return (_group); }
+    inline uint timeout() const { return (_timeout); }
+
+    // A flush of (xcts) took (flush_usec), (interval_usec) after the 
+    // previous one completed. Returns true if the targets changed.
+    bool flushed(const uint xcts, const double flush_usec, 
+                 const double interval_usec);
+
+    void export_stats(flusher_stats_t& stats) const;
+
+}; // EOF: group_commit_ctrl_t
+
+
+
 /******************************************************************** 
  *
  * @class: flusher_t
@@ -140,7 +208,7 @@ const int FLUSHER_TIME_THRESHOLD        = 1000;   // Flush every 1000usec (msec)
 class flusher_t : public base_worker_t
 {   
 public:
-    typedef srmwqueue<trx_request_t>    BaseQueue;
+    typedef WorkerQueue<trx_request_t>::Type BaseQueue;
 
 private:
 
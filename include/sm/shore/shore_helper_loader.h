@@ -272,6 +272,7 @@ public:
                 //*** CONSUME ***//
 
                 key_sz = _pmanager->format_key(_pindex, _ptuple, *_ptuple->_rep);
+                pdest = _ptuple->_rep->_dest;
                 assert (pdest); // if NULL invalid key
             
 		int pnum = _pmanager->get_pnum(_pindex, _ptuple);
@@ -350,6 +351,48 @@ public:
 
 
 
+/****************************************************************** 
+ *
+ *  @class: index_bulkload_smt_t
+ *
+ *  @brief: An smthread inherited class that it is used for building
+ *          the indexes of a table after its heap file has been loaded
+ *          in bulk loading mode. Optionally, it checks the consistency
+ *          of the indexes with the table afterwards.
+ *
+ ******************************************************************/
+
+class index_bulkload_smt_t : public thread_t 
+{
+private:
+
+    ss_m*        _pssm;
+    table_man_t* _pmanager;
+    uint_t       _run_bytes;
+    bool         _check;
+    int          _rv;
+
+public:
+    
+    index_bulkload_smt_t(c_str tname, ss_m* assm, table_man_t* amanager,
+                         const uint_t run_bytes, const bool check) 
+	: thread_t(tname), _pssm(assm), _pmanager(amanager), 
+          _run_bytes(run_bytes), _check(check), _rv(0)
+    {
+        assert (_pssm);
+        assert (_pmanager);
+    }
+
+    ~index_bulkload_smt_t() { }
+
+    // thread entrance
+    void work();
+    inline int rv() { return (_rv); }
+
+}; // EOF: index_bulkload_smt_t
+
+
+
 /****************************************************************** 
  *
  *  @class table_checking_smt_t
@@ -0,0 +1,86 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_latency.h
+ *
+ *  @brief:  Per-thread latency histograms of the trxs
+ *
+ *  @note:   The trxs are stamped when the client submits them (see 
+ *           trx_request_t::set() and the DORA clients), or when they
+ *           arrived for the open-loop clients (open_loop_t). Their
+ *           latency is recorded at notify_client(), by the thread that
+ *           notifies the client. Each recording thread has its own 
+ *           histograms, one per trx type, so the hot path has no locks or
+ *           shared writes. The histograms are merged only when printing.
+ */
+
+#ifndef __SHORE_LATENCY_H
+#define __SHORE_LATENCY_H
+
+#include <sys/time.h>
+#include <map>
+#include <string>
+
+#include "k_defines.h"
+#include "util/histogram.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+// Trx not stamped
+const int NO_LATENCY_TYPE = -1;
+
+// Maximum trx types a thread keeps histograms for
+const uint LAT_MAX_TYPES = 64;
+
+
+// The clock of the latency histograms, in usecs
+inline long long trx_latency_now() 
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (tv.tv_usec + tv.tv_sec*1000000ll);
+}
+
+
+// Records the latency of a trx of type (xct_type) to the histograms
+// of the calling thread
+void trx_latency_record(const int xct_type, const long long usecs);
+
+// Starts a new measurement. The printed percentiles consider only the
+// latencies recorded after the last reset
+void trx_latency_reset();
+
+// Prints the p50/p90/p99/p99.9/max latency per trx type. The names 
+// of the types are taken from the map, if found
+void trx_latency_print(const std::map<int,std::string>& names);
+
+// Merges into (out) the latencies of all the trx types recorded since
+// the last reset
+void trx_latency_total(histogram_t& out);
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /** __SHORE_LATENCY_H */
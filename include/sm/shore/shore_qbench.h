@@ -0,0 +1,189 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_qbench.h
+ *
+ *  @brief:  Microbenchmark of the worker queues. Multiple producer threads
+ *           push to the queue of a single worker, the same way the clients
+ *           push to the trx_workers and the partitions.
+ *
+ *  @note:   Used by the "qbench" shell command
+ */
+
+#ifndef __SHORE_QBENCH_H
+#define __SHORE_QBENCH_H
+
+#include "sm/shore/srmwqueue.h"
+#include "sm/shore/lfqueue.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+const int QBENCH_MAX_PRODUCERS = 128;
+const int QBENCH_PUSHES        = 100000;
+const int QBENCH_POOL_SZ       = 60;
+
+// What the producers push
+struct qbench_item_t
+{
+    int _producer;
+    qbench_item_t() : _producer(-1) { }
+};
+
+
+/********************************************************************
+ *
+ * @class: qbench_consumer_t
+ *
+ * @brief: The single reader, it serves the queue as the trx_worker does
+ *
+ ********************************************************************/
+
+template<class Queue>
+class qbench_consumer_t : public base_worker_t
+{
+private:
+    Queue*        _queue;
+    volatile uint _consumed;
+
+    int _work_ACTIVE_impl()
+    {
+        while (get_control() == WC_ACTIVE) {
+            set_ws(WS_LOOP);
+            if (_queue->pop()) {
+                ++_consumed;
+                ++_stats._processed;
+            }
+        }
+        return (0);
+    }
+
+    int _pre_STOP_impl() { return (0); }
+
+public:
+
+    qbench_consumer_t(ShoreEnv* env, Queue* aqueue)
+        : base_worker_t(env, c_str("qbench-cons"), PBIND_NONE, 0),
+          _queue(aqueue), _consumed(0)
+    {
+        assert (_queue);
+    }
+    ~qbench_consumer_t() { }
+
+    uint consumed() const { return (*&_consumed); }
+
+}; // EOF: qbench_consumer_t
+
+
+
+/********************************************************************
+ *
+ * @class: qbench_producer_t
+ *
+ * @brief: One of the writers
+ *
+ ********************************************************************/
+
+template<class Queue>
+class qbench_producer_t : public thread_t
+{
+private:
+    Queue*         _queue;
+    qbench_item_t* _item;
+    int            _pushes;
+
+public:
+
+    qbench_producer_t(Queue* aqueue, qbench_item_t* aitem,
+                      const int id, const int pushes)
+        : thread_t(c_str("qbench-prod-%d", id)),
+          _queue(aqueue), _item(aitem), _pushes(pushes)
+    {
+        _item->_producer = id;
+    }
+    ~qbench_producer_t() { }
+
+    void work()
+    {
+        for (int i=0; i<_pushes; i++) {
+            _queue->push(_item,false);
+        }
+    }
+
+}; // EOF: qbench_producer_t
+
+
+
+/********************************************************************
+ *
+ * @fn:     qbench_run
+ *
+ * @brief:  Runs one experiment with (producers) writers that push
+ *          (pushes) elements each
+ *
+ * @return: The throughput in pushes/sec
+ *
+ ********************************************************************/
+
+template<class Queue>
+double qbench_run(ShoreEnv* env, const int producers, const int pushes,
+                  const int loops)
+{
+    Pool pool(sizeof(qbench_item_t*),QBENCH_POOL_SZ);
+    Queue queue(&pool);
+    std::vector<qbench_item_t> items(producers);
+    std::vector<qbench_producer_t<Queue>*> prods(producers);
+    uint expected = producers*pushes;
+
+    qbench_consumer_t<Queue>* cons = new qbench_consumer_t<Queue>(env,&queue);
+    queue.setqueue(WS_INPUT_Q,cons,loops,0);
+    cons->start();
+    cons->fork();
+
+    for (int i=0; i<producers; i++) {
+        prods[i] = new qbench_producer_t<Queue>(&queue,&items[i],i,pushes);
+    }
+
+    stopwatch_t timer;
+    for (int i=0; i<producers; i++) prods[i]->fork();
+    for (int i=0; i<producers; i++) {
+        prods[i]->join();
+        delete (prods[i]);
+    }
+    while (cons->consumed() < expected) {
+        // spin until the consumer drains the queue
+    }
+    double secs = timer.time();
+
+    cons->stop();
+    cons->join();
+    delete (cons);
+
+    return ((double)expected/secs);
+}
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /** __SHORE_QBENCH_H */
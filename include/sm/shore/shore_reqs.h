@@ -36,6 +36,8 @@
 #include "sm_vas.h"
 #include "util.h"
 
+#include "sm/shore/shore_latency.h"
+
 
 ENTER_NAMESPACE(shore);
 
@@ -59,6 +61,39 @@ enum TrxState { UNDEF       = 0x0,
 };
 
 
+/******************************************************************** 
+ *
+ * @class: trx_done_t
+ *
+ * @brief: Interface for the asynchronous completion of a trx. If set
+ *         to the result of a trx, the thread that notifies the client
+ *         calls trx_done() with the tag of the trx and whether it 
+ *         committed (COMMITTED) or aborted (ROLLBACKED). 
+ *
+ * @note:  trx_done() runs in a worker, flusher or partition thread,
+ *         so it should only hand the result over and return
+ *
+ ********************************************************************/
+
+class trx_done_t
+{
+public:
+    virtual ~trx_done_t() { }
+    virtual void trx_done(const uint_t tag, const TrxState state)=0;
+
+}; // EOF: trx_done_t
+
+
+
+// The open-loop clients (see open_loop_t) set the arrival of the next
+// trx the calling thread submits: when it arrived, so that its latency
+// counts the wait before it was submitted, and the trx_done_t to call
+// when it completes. The next trx_result_tuple_t::stamp() takes it.
+void set_trx_arrival(const long long usecs, trx_done_t* done);
+bool take_trx_arrival(long long& usecs, trx_done_t*& done);
+
+
+
 /******************************************************************** 
  *
  * @class: trx_result_tuple_t
@@ -74,25 +109,44 @@ private:
     TrxState R_STATE;
     int R_ID;
     condex* _notify;
+
+    // for the latency histograms: the trx type and when it was submitted
+    int       _lat_type;
+    long long _lat_start;
+
+    // for the asynchronous completion (see trx_done_t)
+    trx_done_t* _done;
+    uint_t      _tag;
    
 public:
 
-    trx_result_tuple_t() { reset(UNDEF, -1, NULL); }
+    trx_result_tuple_t() 
+        : _lat_type(NO_LATENCY_TYPE), _lat_start(0), _done(NULL), _tag(0)
+    { reset(UNDEF, -1, NULL); }
 
-    trx_result_tuple_t(TrxState aTrxState, int anID, condex* apcx = NULL) { 
+    trx_result_tuple_t(TrxState aTrxState, int anID, condex* apcx = NULL) 
+        : _lat_type(NO_LATENCY_TYPE), _lat_start(0), _done(NULL), _tag(0)
+    { 
         reset(aTrxState, anID, apcx);
     }
 
     ~trx_result_tuple_t() { }
 
     // @fn copy constructor
-    trx_result_tuple_t(const trx_result_tuple_t& t) {
+    trx_result_tuple_t(const trx_result_tuple_t& t) 
+        : _lat_type(t._lat_type), _lat_start(t._lat_start),
+          _done(t._done), _tag(t._tag)
+    {
 	reset(t.R_STATE, t.R_ID, t._notify);
     }      
 
     // @fn copy assingment
     trx_result_tuple_t& operator=(const trx_result_tuple_t& t) {        
         reset(t.R_STATE, t.R_ID, t._notify);        
+        _lat_type = t._lat_type;
+        _lat_start = t._lat_start;
+        _done = t._done;
+        _tag = t._tag;
         return (*this);
     }
     
@@ -108,9 +162,33 @@ public:
     condex* get_notify() const { return (_notify); }
     void set_notify(condex* notify) { _notify = notify; }
     
+    trx_done_t* get_done() const { return (_done); }
+    uint_t get_tag() const { return (_tag); }
+    void set_done(trx_done_t* done, const uint_t tag) { _done = done; _tag = tag; }
+
     int get_id() const { return (R_ID); }
     void set_id(const int aID) { R_ID = aID; }
 
+    // stamps the submission of a trx of type (xct_type), or its arrival
+    // if set (see set_trx_arrival())
+    void stamp(const int xct_type) { 
+        _lat_type = xct_type;
+        trx_done_t* done = NULL;
+        if (take_trx_arrival(_lat_start, done)) {
+            if (done) set_done(done, 0);
+        }
+        else {
+            _lat_start = trx_latency_now();
+        }
+    }
+
+    // records the latency since the stamp, only once
+    void record_latency() {
+        if (_lat_type == NO_LATENCY_TYPE) return;
+        trx_latency_record(_lat_type, trx_latency_now() - _lat_start);
+        _lat_type = NO_LATENCY_TYPE;
+    }
+
     TrxState get_state() { return (R_STATE); }
     void set_state(TrxState aState) { 
        assert ((aState >= UNDEF) && (aState <= ROLLBACKED));
@@ -139,7 +217,7 @@ public:
  * 
  ********************************************************************/
 
-struct base_request_t
+struct base_request_t : public cache_link_t
 {
     // trx-specific
     xct_t*              _xct; // Not the owner
@@ -200,15 +278,18 @@ struct trx_request_t : public base_request_t
     int                 _xct_type;
     int                 _spec_id; 
 
+    // the cache of the client thread that borrowed it
+    object_cache_t<trx_request_t>* _cache;
+
     trx_request_t() 
-        : base_request_t(), _xct_type(-1),_spec_id(0)
+        : base_request_t(), _xct_type(-1),_spec_id(0), _cache(NULL)
     { }
 
     trx_request_t(xct_t* pxct, const tid_t& atid, const int axctid,
                   const trx_result_tuple_t& aresult, 
                   const int axcttype, const int aspecid)
         : base_request_t(pxct,atid,axctid,aresult),
-          _xct_type(axcttype), _spec_id(aspecid)
+          _xct_type(axcttype), _spec_id(aspecid), _cache(NULL)
     {
     }
 
@@ -221,16 +302,46 @@ struct trx_request_t : public base_request_t
         base_request_t::set(pxct,atid,axctid,aresult);
         _xct_type = axcttype;
         _spec_id = aspecid;
+        _result.stamp(axcttype);
     }
 
     inline int type() const { return (_xct_type); }
     inline void set_type(const int atype) { _xct_type = atype; }
     inline int selectedID() { return (_spec_id); }
 
+    inline void giveback() { _cache->giveback(this); }
+
+    // CACHEABLE INTERFACE
+
+    void init() { }
+    void reset() { _xct = NULL; }
+
 }; // EOF: trx_request_t
 
 
 
+/******************************************************************** 
+ *
+ * @class: request_pool_t
+ *
+ * @brief: The requests of the Baseline system. Each client thread 
+ *         borrows them from its own cache, and the worker that serves 
+ *         them gives them back to that cache (through its return list).
+ * 
+ ********************************************************************/
+
+class request_pool_t
+{
+public:
+
+    trx_request_t* borrow();
+
+    inline void destroy(trx_request_t* prequest) { prequest->giveback(); }
+
+}; // EOF: request_pool_t
+
+
+
 EXIT_NAMESPACE(shore);
 
 #endif /** __SHORE_REQS_H */
@@ -111,6 +111,22 @@ typedef blob_pool ats_char_t;
 typedef intptr_t offset_t;
 
 
+
+/* ---------------------------------------------------------------
+ *
+ * @brief: Macros for correct offset calculation in the disk format
+ *         of a row
+ *
+ * --------------------------------------------------------------- */
+
+//#define VAR_SLOT(start, offset)   ((offset_t*)((start)+(offset)))
+#define VAR_SLOT(start, offset)   ((start)+(offset))
+#define SET_NULL_FLAG(start, offset)                            \
+    (*(char*)((start)+((offset)>>3))) &= (1<<((offset)>>3))
+#define IS_NULL_FLAG(start, offset)                     \
+    (*(char*)((start)+((offset)>>3)))&(1<<((offset)>>3))
+
+
 /* ---------------------------------------------------------------
  *
  * @struct: rep_row_t
@@ -165,6 +181,18 @@ struct table_row_t
     offset_t _var_offset;
     uint     _null_count;
 
+    // lazy decoding (see set_lazy())
+    mutable bool _lazy;           /* some fields are only in _lazy_buf */
+    bool*        _decoded;        /* per field: already decoded to _pvalues */
+    offset_t*    _field_offset;   /* per field: value or var slot offset */
+    int*         _null_index;     /* per field: bit in the NULL bitmap, or -1 */
+    char*        _lazy_buf;       /* copy of the record body */
+    uint_t       _lazy_buf_size;  /* allocated size of _lazy_buf */
+
+    // dirty fields (see clean())
+    bool         _tracked;        /* the clean fields are as in the record */
+    bool*        _dirty;          /* per field: set since the last clean() */
+
     rep_row_t*     _rep;          /* a pointer to a row representation struct */
     rep_row_t*     _rep_key;      /* a pointer to a row-key representation struct */
 
@@ -179,6 +207,9 @@ struct table_row_t
 	  _field_cnt(0), _is_setup(false), 
 	  _rid(rid_t::null), _pvalues(NULL), 
 	  _fixed_offset(0),_var_slot_offset(0),_var_offset(0),_null_count(0),
+	  _lazy(false), _decoded(NULL), _field_offset(NULL), _null_index(NULL),
+	  _lazy_buf(NULL), _lazy_buf_size(0),
+	  _tracked(false), _dirty(NULL),
 	  _rep(NULL), _rep_key(NULL)
     {
         assert (ptd);
@@ -214,6 +245,44 @@ struct table_row_t
     uint size() const;
 
 
+    /* --------------------- */
+    /* --- lazy decoding --- */
+    /* --------------------- */
+
+    /* keep a copy of the record body (in disk format) and decode
+       each field only when it is first accessed */
+    void set_lazy(const char* data, const uint_t len);
+
+    /* decode every field that has not been decoded yet */
+    void materialize() const;
+
+    inline void decode(const uint idx) const {
+        if (_lazy && !_decoded[idx]) _decode_field(idx);
+    }
+
+    inline void touch(const uint idx) {
+        if (_lazy) _decoded[idx] = true;
+        _dirty[idx] = true;
+    }
+
+    void _decode_field(const uint idx) const;
+
+
+    /* -------------------- */
+    /* --- dirty fields --- */
+    /* -------------------- */
+
+    /* the values are the ones of the record, as after it is read
+       or written. set_value() and set_null() mark a field dirty */
+    void clean();
+
+    /* the record can be updated by writing only the dirty fields,
+       all of which are of fixed length and not NULL-able */
+    bool is_delta_updatable() const;
+
+    inline bool is_dirty(const uint idx) const { return (_dirty[idx]); }
+
+
     /* ------------------------ */
     /* --- set field values --- */
     /* ------------------------ */
@@ -265,6 +334,8 @@ struct table_row_t
     /* clear the tuple and prepare it for re-use */
     void reset() { 
         assert (_is_setup);
+        _lazy = false;
+        _tracked = false;
         for (uint_t i=0; i<_field_cnt; i++)
             _pvalues[i].reset();
     }        
@@ -275,6 +346,29 @@ struct table_row_t
             delete [] _pvalues;
             _pvalues = NULL;
         }
+        if (_decoded) {
+            delete [] _decoded;
+            _decoded = NULL;
+        }
+        if (_field_offset) {
+            delete [] _field_offset;
+            _field_offset = NULL;
+        }
+        if (_null_index) {
+            delete [] _null_index;
+            _null_index = NULL;
+        }
+        if (_dirty) {
+            delete [] _dirty;
+            _dirty = NULL;
+        }
+        _tracked = false;
+        if (_lazy_buf) {
+            free (_lazy_buf);
+            _lazy_buf = NULL;
+            _lazy_buf_size = 0;
+        }
+        _lazy = false;
     }
 
 }; // EOF: table_row_t
@@ -325,6 +419,7 @@ inline void table_row_t::set_null(const uint idx)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_null();
 }
 
@@ -333,6 +428,7 @@ inline void table_row_t::set_value(const uint idx, const int v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_int_value(v);
 }
 
@@ -341,6 +437,7 @@ inline void table_row_t::set_value(const uint idx, const bool v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_bit_value(v);
 }
 
@@ -349,6 +446,7 @@ inline void table_row_t::set_value(const uint idx, const short v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_smallint_value(v);
 }
 
@@ -357,6 +455,7 @@ inline void table_row_t::set_value(const uint idx, const double v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_float_value(v);
 }
 
@@ -365,6 +464,7 @@ inline void table_row_t::set_value(const uint idx, const long long v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_long_value(v);
 }
 
@@ -373,6 +473,7 @@ inline void table_row_t::set_value(const uint idx, const decimal v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_decimal_value(v);
 }
 
@@ -381,6 +482,7 @@ inline void table_row_t::set_value(const uint idx, const time_t v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_time_value(v);
 }
 
@@ -389,6 +491,7 @@ inline void table_row_t::set_value(const uint idx, const char v)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_char_value(v);
 }
 
@@ -397,6 +500,7 @@ inline void table_row_t::set_value(const uint idx, const char* string)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
 
     sqltype_t sqlt = _pvalues[idx].field_desc()->type();
     assert (sqlt == SQL_VARCHAR || sqlt == SQL_FIXCHAR );
@@ -417,6 +521,7 @@ inline void table_row_t::set_value(const uint idx, const timestamp_t& time)
     assert (_is_setup);
     assert (idx < _field_cnt);
     assert (_pvalues[idx].is_setup());
+    touch(idx);
     _pvalues[idx].set_value(&time, 0);
 }
 
@@ -433,6 +538,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = 0;
         return false;
@@ -446,6 +552,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = false;
         return false;
@@ -459,6 +566,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = 0;
         return false;
@@ -472,6 +580,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = 0;
         return false;
@@ -486,6 +595,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         destbuf[0] = '\0';
         return (false);
@@ -502,6 +612,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = 0;
         return false;
@@ -515,6 +626,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = 0;
         return false;
@@ -528,6 +640,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         dest = decimal(0);
         return false;        
@@ -541,6 +654,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         return false;
     }
@@ -553,6 +667,7 @@ inline bool table_row_t::get_value(const uint idx,
 {
     assert (_is_setup);
     assert(idx < _field_cnt);
+    decode(idx);
     if (_pvalues[idx].is_null()) {
         return false;
     }
@@ -38,6 +38,7 @@
 #include "sm/shore/shore_env.h"
 #include "sm/shore/shore_helper_loader.h"
 #include "sm/shore/shore_client.h"
+#include "sm/shore/shore_xct_server.h"
 
 
 ENTER_NAMESPACE(shore);
@@ -66,6 +67,11 @@ const int DF_NUM_OF_QUERIED_SF    = 10;
 // default transaction id to be executed
 const int DF_TRX_ID                = -1;
 
+// default offered rates of the latency-vs-load sweeps (trxs/sec)
+const int DF_SWEEP_RATE_FROM       = 1000;
+const int DF_SWEEP_RATE_TO         = 10000;
+const int DF_SWEEP_RATE_STEP       = 1000;
+
 
 
 // Declares commands that need only a pointer to the Enviroment object.
@@ -94,6 +100,7 @@ DECLARE_ENV_CMD(db_print);
 DECLARE_ENV_CMD(db_fetch);
 DECLARE_ENV_CMD(stats_verbose);
 DECLARE_ENV_CMD(log);
+DECLARE_ENV_CMD(qbench);
 
 
 
@@ -158,6 +165,9 @@ DECLARE_KIT_CMD(test);
 DECLARE_KIT_CMD(warmup);
 DECLARE_KIT_CMD(load);
 DECLARE_KIT_CMD(trxs);
+DECLARE_KIT_CMD(xctserver);
+DECLARE_KIT_CMD(netload);
+DECLARE_KIT_CMD(sweep);
 
 
 
@@ -173,7 +183,7 @@ DECLARE_KIT_CMD(trxs);
  *          - Call the start() function
  *
  *
- *  @note:  Supported commands - { TEST/MEASURE/WARMUP/LOAD }
+ *  @note:  Supported commands - { TEST/MEASURE/WARMUP/LOAD/SWEEP }
  *  @note:  To add new command function process_command() should be overridden 
  *  @note:  SIGINT handling
  *
@@ -215,6 +225,7 @@ protected:
     guard<db_fetch_cmd_t>       _db_fetch;
     
     guard<log_cmd_t>            _logger;
+    guard<qbench_cmd_t>         _qbencher;
     guard<asynch_cmd_t>         _asyncher;
 
     guard<sli_cmd_t>            _slier;
@@ -229,6 +240,12 @@ protected:
     guard<warmup_cmd_t>         _warmuper;
     guard<load_cmd_t>           _loader;
     guard<trxs_cmd_t>           _trxser;
+    guard<xctserver_cmd_t>      _xctserverer;
+    guard<netload_cmd_t>        _netloader;
+    guard<sweep_cmd_t>          _sweeper;
+
+    // the network front-end, if started
+    guard<xct_server_t>         _xct_server;
 
 public:
 
@@ -268,11 +285,14 @@ public:
     virtual int process_cmd_TEST(const char* command);
     virtual int process_cmd_WARMUP(const char* command);    
     virtual int process_cmd_LOAD(const char* command);        
+    virtual int process_cmd_XCTSERVER(const char* command);
+    virtual int process_cmd_NETLOAD(const char* command);
+    virtual int process_cmd_SWEEP(const char* command);
 
 
-    // virtual implementation of the {WARMUP/TEST/MEASURE} 
+    // virtual implementation of the {WARMUP/TEST/MEASURE/SWEEP} 
     // WARMUP/LOAD are virtual
-    // TEST/MEASURE are pure virtual
+    // TEST/MEASURE/SWEEP are pure virtual
     virtual int _cmd_WARMUP_impl(const double iQueriedSF, const int iTrxs, 
                                  const int iDuration, const int iIterations);
     virtual int _cmd_LOAD_impl(void);
@@ -285,6 +305,10 @@ public:
                                   const int iNumOfThreads, const int iDuration,
                                   const int iSelectedTrx, const int iIterations,
                                   const eBindingType abt)=0;    
+    virtual int _cmd_SWEEP_impl(const double iQueriedSF, const int iSpread,
+                                const int iNumOfThreads, const int iDuration,
+                                const int iSelectedTrx, const int iRateFrom,
+                                const int iRateTo, const int iRateStep)=0;
 
     virtual w_rc_t prepareNewRun() { return (RCOK); }
 
@@ -282,13 +282,21 @@ protected:
 
     guard<ats_char_t> _pts;   /* trash stack */
 
+    volatile bool _bulkload;  /* if set, add_tuple() does not update the indexes */
+
+    // writes the [start,end) bytes of data to the pinned record
+    w_rc_t _update_range(pin_i& pin, const char* data,
+                         const int start, const int end,
+                         const bool bIgnoreLocks,
+                         const bool no_heap_latch);
+
 public:
 
     typedef table_row_t table_tuple; 
 
     table_man_t(table_desc_t* aTableDesc,
 		bool construct_cache=true) 
-        : _ptable(aTableDesc)
+        : _ptable(aTableDesc), _bulkload(false)
     {
 	// init tuple cache
         if (construct_cache) {
@@ -310,6 +318,11 @@ public:
     // loads store id values in fid field for this table and its indexes
     w_rc_t load_and_register_fid(ss_m* db);
 
+    // bulk loading mode, the indexes are built by bulkload_indexes()
+    void set_bulkload(const bool bulkload) { _bulkload = bulkload; }
+    bool is_bulkload() const { return (_bulkload); }
+    bool can_bulkload() const;
+
     /* ------------------------------ */
     /* --- trash stack operations --- */
     /* ------------------------------ */
@@ -430,6 +443,12 @@ public:
                            table_tuple* ptuple, 
                            const lock_mode_t lock_mode = EX);
 
+    // Writes only the dirty fields of the tuple to the pinned record
+    w_rc_t    update_fields(pin_i& pin,
+                            table_tuple* ptuple,
+                            const bool bIgnoreLocks,
+                            const bool no_heap_latch);
+
     // Direct access through the rid
     w_rc_t    read_tuple(table_tuple* ptuple, 
                          lock_mode_t lock_mode = SH,
@@ -489,6 +508,13 @@ public:
     virtual w_rc_t scan_index(ss_m* db, index_desc_t* pidx)=0;
 
 
+    /* ---------------------------------------------------- */
+    /* --- build the indexes of a bulk-loaded heap file --- */
+    /* ---------------------------------------------------- */
+
+    virtual w_rc_t bulkload_indexes(ss_m* db, const uint_t run_bytes)=0;
+
+
     /* -------------------------------- */
     /* - population related if needed - */
     /* -------------------------------- */
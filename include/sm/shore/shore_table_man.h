@@ -55,6 +55,7 @@
 
 #include "shore_table.h"
 #include "shore_row_cache.h"
+#include "shore_bulk_loader.h"
 
 
 ENTER_NAMESPACE(shore);
@@ -173,6 +174,13 @@ public:
     w_rc_t scan_index(ss_m* db, index_desc_t* pidx);
 
 
+    /* ---------------------------------------------------- */
+    /* --- build the indexes of a bulk-loaded heap file --- */
+    /* ---------------------------------------------------- */
+
+    w_rc_t bulkload_indexes(ss_m* db, const uint_t run_bytes);
+
+
     /* ------------------------------ */
     /* --- tuple cache operations --- */
     /* ------------------------------ */
@@ -658,6 +666,112 @@ w_rc_t table_man_impl<TableDesc>::check_index(ss_m* db,
 
 
 
+/* ------------------------ */
+/* --- bulk index build --- */
+/* ------------------------ */
+
+
+/********************************************************************* 
+ *
+ *  @fn:    bulkload_indexes
+ *
+ *  @brief: Builds all the indexes of a table whose heap file was loaded
+ *          in bulk loading mode. It scans the heap file once and collects
+ *          the (key,rid) pairs of every index partition to sorted runs,
+ *          and then it builds each index partition from its runs.
+ *
+ *  @note:  The (run_bytes) memory budget is split among the index 
+ *          partitions of the table. The indexes should be empty.
+ *
+ *********************************************************************/
+
+template <class TableDesc>
+w_rc_t table_man_impl<TableDesc>::bulkload_indexes(ss_m* db, 
+                                                   const uint_t run_bytes)
+{
+    assert (_ptable);
+
+    // tables that do not support it have been loaded with their indexes
+    if (!can_bulkload()) return (RCOK);
+
+    TRACE( TRACE_DEBUG, "Building the indexes of table (%s)\n",
+           _ptable->name());
+
+    time_t tstart = time(NULL);
+
+    // 1. one set of runs per index partition
+    index_desc_t* pindex = NULL;
+    std::vector<int> base;
+    int nruns = 0;
+    for (pindex = _ptable->indexes(); pindex; pindex = pindex->next()) {
+        base.push_back(nruns);
+        nruns += (pindex->is_partitioned() ? pindex->get_partition_count() : 1);
+    }
+    if (nruns == 0) return (RCOK);
+
+    std::vector<bulk_runs_t*> runs;
+    for (pindex = _ptable->indexes(); pindex; pindex = pindex->next()) {
+        int parts = (pindex->is_partitioned() ? pindex->get_partition_count() : 1);
+        for (int p=0; p<parts; p++) {
+            runs.push_back(new bulk_runs_t(_ptable, pindex, p, run_bytes/nruns));
+        }
+    }
+
+    // 2. scan the heap file and extract the keys
+    w_rc_t e = db->begin_xct();
+    if (!e.is_error()) {
+        table_iter* iter = NULL;
+        e = get_iter_for_file_scan(db, iter, NL);
+
+        bool eof = false;
+        table_tuple tuple(_ptable);
+        rep_row_t krep(_pts);
+        krep.set(_ptable->maxsize());
+        uint_t tuple_cnt = 0;
+
+        if (!e.is_error()) e = iter->next(db, eof, tuple);
+        while (!e.is_error() && !eof) {
+            int ix = 0;
+            for (pindex = _ptable->indexes(); pindex; pindex = pindex->next()) {
+                format_key(pindex, &tuple, krep);
+                int pnum = get_pnum(pindex, &tuple);
+                e = runs[base[ix] + pnum]->append(krep._dest, tuple.rid());
+                if (e.is_error()) break;
+                ++ix;
+            }
+            ++tuple_cnt;
+            if (!e.is_error()) e = iter->next(db, eof, tuple);
+        }
+        if (iter) delete (iter);
+
+        if (e.is_error()) {
+            W_COERCE(db->abort_xct());
+        }
+        else {
+            e = db->commit_xct();
+            TRACE( TRACE_DEBUG, "Table (%s): %d tuples scanned in (%d) secs\n",
+                   _ptable->name(), tuple_cnt, time(NULL)-tstart);
+        }
+    }
+
+    // 3. build each index partition
+    for (uint_t i=0; i<runs.size(); i++) {
+        if (!e.is_error()) e = runs[i]->build(db, _ptable->vid());
+        delete (runs[i]);
+    }
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "Building the indexes of (%s) failed [0x%x]\n",
+               _ptable->name(), e.err_num());
+        return (e);
+    }
+
+    TRACE( TRACE_DEBUG, "Indexes of table (%s) built in (%d) secs...\n",
+           _ptable->name(), time(NULL)-tstart);
+    return (RCOK);
+}
+
+
+
 /* ------------------ */
 /* --- scan index --- */
 /* ------------------ */
@@ -26,6 +26,14 @@
  *  @brief: Wrapper for the worker threads in Baseline 
  *          (specialization of the Shore workers)
  *
+ *  @note:  With db-worker-steal each worker takes its requests from a
+ *          deque (wsqueue) instead of its input queue. A worker whose
+ *          deque is empty steals the oldest request of the worker with
+ *          the longest deque, before going to sleep. A client that
+ *          pushes to the deque of a busy worker wakes a sleeping one to
+ *          steal. So a worker blocked on a lock or on I/O does not hold
+ *          back the requests queued behind it.
+ *
  *  @author Ippokratis Pandis, Nov 2008
  */
 
@@ -34,7 +42,8 @@
 #define __SHORE_TRX_WORKER_H
 
 
-#include "sm/shore/srmwqueue.h"
+#include "sm/shore/lfqueue.h"
+#include "sm/shore/wsqueue.h"
 #include "sm/shore/shore_reqs.h"
 #include "sm/shore/shore_worker.h"
 
@@ -56,15 +65,31 @@ class trx_worker_t : public base_worker_t
 {
 public:
     typedef trx_request_t      Request;
-    typedef srmwqueue<Request> Queue;
+    typedef WorkerQueue<Request>::Type Queue;
+    typedef wsqueue<Request> Deque;
+    typedef std::vector<trx_worker_t*> Peers;
 
 private:
 
     guard<Queue>         _pqueue;
     guard<Pool>          _actionpool;
 
+    // work stealing, if there are peers to steal from
+    guard<Deque>         _pdeque;
+    const Peers*         _peers;
+    int                  _loops;
+    int                  _thres;
+
     // states
     int _work_ACTIVE_impl(); 
+    int _work_ACTIVE_steal();
+
+    // waits for a request, stealing one if possible
+    Request* _wait_or_steal();
+    Request* _steal();
+
+    // wakes a sleeping peer to steal from this worker
+    void _wake_thief();
 
     int _pre_STOP_impl();
 
@@ -80,10 +105,23 @@ public:
 
     // Enqueues a request to the queue of the worker thread
     inline void enqueue(Request* arequest, const bool bWake=true) {
-        _pqueue->push(arequest,bWake);
+        if (!_peers) {
+            _pqueue->push(arequest,bWake);
+            return;
+        }
+        bool busy = !is_sleeping();
+        uint depth = _pdeque->push(arequest);
+        if ((depth >= (uint)_thres) || bWake) set_ws(WS_INPUT_Q);
+        if ((depth > 1) && busy) _wake_thief();
     }
         
-    void init(const int lc);        
+    // (peers) are all the workers, this one included. If given the
+    // worker steals from them and they from it.
+    void init(const int lc, const Peers* peers = NULL);
+
+    // requests waiting in the deque, for the thieves
+    inline uint backlog() { return (_pdeque.get() ? _pdeque->size() : 0); }
+    inline Request* steal_one() { return (_pdeque->pop()); }
 
 }; // EOF: trx_worker_t
 
@@ -87,6 +87,11 @@ struct worker_stats_t
     uint _early_aborts;
     uint _mid_aborts;
 
+    // work stealing between the Baseline workers (see trx_worker_t)
+    uint _steals;
+    uint _failed_steals;
+    double _idle_time; // in msecs
+
 #ifdef WORKER_VERBOSE_STATS
     void update_served(const double serve_time_ms);
     double _serving_total;   // in msecs
@@ -112,7 +117,8 @@ struct worker_stats_t
         : _processed(0), _problems(0),
           _served_input(0), _served_waiting(0),
           _condex_sleep(0), _failed_sleep(0),
-          _early_aborts(0), _mid_aborts(0)
+          _early_aborts(0), _mid_aborts(0),
+          _steals(0), _failed_steals(0), _idle_time(0)
 #ifdef WORKER_VERBOSE_STATS
         , _serving_total(0), 
           _rvp_exec(0), _rvp_exec_time(0), _rvp_notify_time(0), 
@@ -0,0 +1,256 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_xct_server.h
+ *
+ *  @brief:  Binary network front-end for submitting trxs, and a
+ *           loopback load driver for it
+ *
+ *  @note:   Every message is a fixed-size frame of 32-bit integers in
+ *           network byte order:
+ *
+ *           request:  | tag | xct type | spec id |
+ *           response: | tag | status   |
+ *
+ *           The (xct type) is one of the trxs the shell lists with the
+ *           "trxs" command, the (spec id) is passed as the selected id
+ *           of the clients (0 lets the input generator pick) and the
+ *           (tag) is returned as is. A client may send many requests
+ *           without waiting for their responses (pipelining). The
+ *           responses come back in completion order, not request order.
+ *
+ *           A single thread serves all the connections through epoll.
+ *           It submits each request with ShoreEnv::submit_xct(), so the
+ *           trxs go either to the trx_workers or to the DORA partitions.
+ *           The thread that completes a trx hands the response back to
+ *           the server through trx_done_t, and the server sends it.
+ */
+
+#ifndef __SHORE_XCT_SERVER_H
+#define __SHORE_XCT_SERVER_H
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "sm/shore/shore_env.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+// Frame sizes
+const int XS_REQUEST_SIZE  = 3*sizeof(uint32_t);
+const int XS_RESPONSE_SIZE = 2*sizeof(uint32_t);
+
+// Response status
+const int XS_COMMITTED = 0;
+const int XS_ABORTED   = 1;
+const int XS_REJECTED  = 2; // unknown xct type, or could not submit
+
+// Default port
+const int XS_DEFAULT_PORT = 8999;
+
+// Default maximum xcts in flight per connection
+const int XS_DEFAULT_MAX_PENDING = 1024;
+
+// Size of the input buffer of a connection
+const int XS_INPUT_BUF_SIZE = 64*1024;
+
+// Events per epoll_wait()
+const int XS_MAX_EVENTS = 256;
+
+
+class xct_server_t;
+
+
+/********************************************************************
+ *
+ * @class: xct_conn_t
+ *
+ * @brief: A client connection to the server. Its xcts report their
+ *         completion to it.
+ *
+ * @note:  Only the server thread touches its members. A connection
+ *         that is closed while it has xcts in flight is deleted when
+ *         the last one completes.
+ *
+ ********************************************************************/
+
+class xct_conn_t : public trx_done_t
+{
+public:
+
+    xct_server_t* _server;
+    int           _fd;
+
+    char          _in[XS_INPUT_BUF_SIZE];
+    int           _in_len;       // received bytes not parsed yet
+    std::vector<char> _out;      // responses not sent yet
+
+    int           _pending;      // xcts in flight
+    bool          _reading;      // EPOLLIN is set
+    bool          _writing;      // EPOLLOUT is set
+    bool          _closed;
+
+    xct_conn_t(xct_server_t* server, const int fd)
+        : _server(server), _fd(fd), _in_len(0), _pending(0),
+          _reading(true), _writing(false), _closed(false)
+    { }
+    ~xct_conn_t() { }
+
+    void trx_done(const uint_t tag, const TrxState state);
+
+}; // EOF: xct_conn_t
+
+
+
+/********************************************************************
+ *
+ * @struct: xct_server_stats_t
+ *
+ ********************************************************************/
+
+struct xct_server_stats_t
+{
+    uint_t _accepted;      // connections
+    uint_t _requests;
+    uint_t _committed;
+    uint_t _aborted;
+    uint_t _rejected;
+    uint_t _max_pending;   // xcts in flight, over all the connections
+
+    xct_server_stats_t() { reset(); }
+
+    void reset() {
+        _accepted = _requests = _committed = _aborted = _rejected = 0;
+        _max_pending = 0;
+    }
+
+    void print(const double secs) const;
+
+}; // EOF: xct_server_stats_t
+
+
+
+/********************************************************************
+ *
+ * @class: xct_server_t
+ *
+ * @brief: The server thread
+ *
+ ********************************************************************/
+
+class xct_server_t : public thread_t
+{
+private:
+
+    ShoreEnv*      _env;
+    std::map<int,string> _sup_trxs;
+    int            _port;
+    int            _max_pending;
+
+    int            _listen_fd;
+    int            _epoll_fd;
+    int            _wake_fd[2];    // pipe that wakes up the server
+    volatile bool  _stop;
+
+    std::map<int,xct_conn_t*> _conns;   // open connections, by fd
+    std::vector<xct_conn_t*>  _trash;   // closed, no xcts in flight
+    bool           _closing;            // stop() was seen
+    int            _pending;            // xcts in flight
+    int            _xct_id;
+    uint           _next_worker;
+
+    // completions handed over by the trx_done() calls
+    struct completion_t {
+        xct_conn_t* _conn;
+        uint_t      _tag;
+        TrxState    _state;
+    };
+    pthread_mutex_t           _done_lock;
+    std::vector<completion_t> _done;
+    std::vector<completion_t> _done_drain;
+
+    // updated by the server thread, printed and reset by the shell
+    pthread_mutex_t    _stats_lock;
+    xct_server_stats_t _stats;
+    long long          _stats_start;  // usecs, see trx_latency_now()
+
+    // server thread
+    void _accept();
+    void _read(xct_conn_t* conn);
+    void _parse(xct_conn_t* conn);
+    void _submit(xct_conn_t* conn, const char* frame);
+    void _respond(xct_conn_t* conn, const uint_t tag, const int status);
+    void _flush(xct_conn_t* conn);
+    void _drain();
+    void _update_events(xct_conn_t* conn);
+    void _close(xct_conn_t* conn);
+
+public:
+
+    xct_server_t(ShoreEnv* env, const std::map<int,string>& sup_trxs,
+                 const int port);
+    ~xct_server_t();
+
+    // opens the listening socket, returns 0 on success
+    int open();
+
+    // thread entrance, the epoll loop
+    void work();
+
+    // makes the loop exit, the caller should join()
+    void stop();
+
+    // called by the thread that completes an xct of the connection
+    void complete(xct_conn_t* conn, const uint_t tag, const TrxState state);
+
+    int port() const { return (_port); }
+    void print_stats();
+    void reset_stats();
+
+}; // EOF: xct_server_t
+
+
+
+/********************************************************************
+ *
+ * @fn:     xct_load_run
+ *
+ * @brief:  Loopback load driver. Opens (conns) connections to the
+ *          server at (port) of this host, each keeping (depth)
+ *          requests for trxs of type (xct_type) in flight, for (secs).
+ *          Prints the throughput and the end-to-end latency.
+ *
+ * @return: 0 on success
+ *
+ ********************************************************************/
+
+int xct_load_run(const int port, const int conns, const int depth,
+                 const int secs, const int xct_type, const int spec_id);
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /** __SHORE_XCT_SERVER_H */
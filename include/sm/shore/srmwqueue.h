@@ -183,6 +183,22 @@ struct srmwqueue
         }
     }
 
+    // Copies the elements not consumed yet, first those on the reader
+    // side and then those still on the writer side.
+    // Returns how many of them were found on the reader side.
+    // @note: should be called only by the reader, or after the reader stopped
+    uint pending(std::vector<Action*>& out) {
+        uint reads = 0;
+        for (ActionVecIt it = _read_pos; it != _for_readers->end(); ++it) {
+            out.push_back(*it);
+            ++reads;
+        }
+        CRITICAL_SECTION(cs, _lock);
+        for (ActionVecIt it = _for_writers->begin(); it != _for_writers->end(); ++it)
+            out.push_back(*it);
+        return (reads);
+    }
+
     // resets queue
     void clear(const bool removeOwner=true) {
         CRITICAL_SECTION(q_cs, _lock);
@@ -0,0 +1,116 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:  wsqueue.h
+ *
+ *  @brief: A multiple-reader, multiple-writer deque, for work stealing
+ *          between the Baseline worker threads.
+ *
+ *  The writers (clients) push to the back. The owner worker pops from the
+ *  front, and so do the other workers when they steal from it, so the
+ *  requests are served in FIFO order whoever serves them.
+ *
+ *  @note:  Unlike the srmwqueue and the lfqueue the deque does not wait.
+ *          The owner worker spins, steals and sleeps on its own (see
+ *          trx_worker_t), and it is woken by the writers through set_ws().
+ */
+
+#ifndef __SHORE_WS_QUEUE_H
+#define __SHORE_WS_QUEUE_H
+
+#include <deque>
+#include <vector>
+
+#include "util.h"
+#include "sm/shore/common.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+template<class Action>
+struct wsqueue
+{
+    typedef std::deque<Action*> ActionDeque;
+
+    ActionDeque   _deque;
+    mcs_lock      _lock;
+
+    // read without the lock, by the thieves to pick a victim and by the
+    // owner to skip the lock when there is nothing to pop
+    uint volatile _size;
+
+    wsqueue() : _size(0) { }
+    ~wsqueue() { }
+
+    inline uint size() const { return (*&_size); }
+
+    // returns the number of elements after the push
+    inline uint push(Action* a) {
+        CRITICAL_SECTION(cs, _lock);
+        _deque.push_back(a);
+        _size = _deque.size();
+        return (_size);
+    }
+
+    // the oldest element, or NULL if empty. Both for the owner and the thieves
+    inline Action* pop() {
+        if (*&_size == 0) return (NULL);
+        CRITICAL_SECTION(cs, _lock);
+        if (_deque.empty()) return (NULL);
+        Action* a = _deque.front();
+        _deque.pop_front();
+        _size = _deque.size();
+        return (a);
+    }
+
+    // Takes out the elements not consumed yet, so that no thief takes
+    // them afterwards. Returns how many they were.
+    uint pending(std::vector<Action*>& out) {
+        CRITICAL_SECTION(cs, _lock);
+        uint n = _deque.size();
+        out.insert(out.end(), _deque.begin(), _deque.end());
+        _deque.clear();
+        _size = 0;
+        return (n);
+    }
+
+    // resets queue
+    void clear() {
+        CRITICAL_SECTION(cs, _lock);
+        _deque.clear();
+        _size = 0;
+    }
+
+private:
+
+    // copying not allowed
+    wsqueue(wsqueue const &);
+    void operator=(wsqueue const &);
+
+}; // EOF: struct wsqueue
+
+
+EXIT_NAMESPACE(shore);
+
+#endif /** __SHORE_WS_QUEUE_H */
@@ -0,0 +1,106 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+
+/** @file:   arena.h
+ *
+ *  @brief:  Bump allocator whose memory is freed in one shot
+ *
+ *  @note:   For the short-lived structures of a query (join and group-by
+ *           tables). The objects in an arena are never destructed, so
+ *           they should not own memory elsewhere.
+ */
+
+#ifndef __UTIL_ARENA_H
+#define __UTIL_ARENA_H
+
+#include <cstddef>
+#include <new>
+
+
+/********************************************************************
+ *
+ * @class: arena_t
+ *
+ * @brief: Hands out memory from chunks of (chunk_size) bytes, or from
+ *         a chunk of its own for larger requests. Everything goes away
+ *         with the arena, or with release().
+ *
+ ********************************************************************/
+
+class arena_t
+{
+private:
+
+    struct chunk_t {
+        chunk_t* _next;
+        size_t   _size;
+    };
+
+    chunk_t* _chunks;
+    char*    _next;       // free space in the first chunk
+    char*    _end;
+    size_t   _chunk_size;
+    size_t   _allocated;  // given out
+    size_t   _reserved;   // taken from malloc
+
+    // no copying
+    arena_t(const arena_t&);
+    arena_t& operator=(const arena_t&);
+
+    void* _alloc_chunk(const size_t size);
+
+public:
+
+    static const size_t DEFAULT_CHUNK_SIZE = 1024*1024;
+    static const size_t ALIGNMENT = 8;
+
+    arena_t(const size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~arena_t() { release(); }
+
+    // (size) bytes aligned to ALIGNMENT
+    void* alloc(size_t size) {
+        size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        if (size > (size_t)(_end - _next)) return (_alloc_chunk(size));
+        void* p = _next;
+        _next += size;
+        _allocated += size;
+        return (p);
+    }
+
+    // room for (n) objects of T, not constructed
+    template <class T>
+    T* alloc_array(const size_t n) {
+        return ((T*)alloc(n*sizeof(T)));
+    }
+
+    // frees all the memory
+    void release();
+
+    size_t allocated() const { return (_allocated); }
+    size_t reserved() const { return (_reserved); }
+
+}; // EOF: arena_t
+
+
+#endif /* __UTIL_ARENA_H */
@@ -25,15 +25,100 @@
  *
  *  @brief:  Template-based cache objects
  *
+ *  @note:   The caches are thread-local, but the objects are often given
+ *           back by another thread (e.g. a DORA action is borrowed by the
+ *           client and given back by the partition worker). Such objects
+ *           go to a lock-free return list of the cache they came from, and
+ *           the owner thread takes them back in batches. So each object
+ *           returns to the pool of the thread that uses it, instead of
+ *           piling up at the thread that frees it.
+ *
+ *  @note:   A cache may outlive its owner thread, while objects borrowed
+ *           from it are still in flight (see object_cache_t::retire()).
+ *
  *  @author: Ippokratis Pandis, Dec 2008
  */
 
 #ifndef __UTIL_OBJECT_CACHE_H
 #define __UTIL_OBJECT_CACHE_H
 
+#include <cassert>
+#include <pthread.h>
+
 #include "k_defines.h"
 #include "block_alloc.h"
 
+#include "util/atomic_ops.h"
+#include "util/stopwatch.h"
+
+
+
+/******************************************************************** 
+ *
+ * @struct: cache_link_t
+ *
+ * @brief: The link of an object on the return list or the free list 
+ *         of its cache. The objects of the object_cache_t derive from it.
+ * 
+ ********************************************************************/
+
+struct cache_link_t
+{
+    cache_link_t* _cache_next;
+
+    cache_link_t() : _cache_next(NULL) { }
+
+}; // EOF: cache_link_t
+
+
+
+/******************************************************************** 
+ *
+ * @struct: cache_stats_t
+ *
+ * @brief: Totals over all the object caches. Each cache adds its 
+ *         counts every batch, and when it is retired.
+ * 
+ ********************************************************************/
+
+struct cache_stats_t
+{
+    uint64_t volatile _borrowed;
+    uint64_t volatile _remote;     // given back by another thread
+    uint64_t volatile _reclaims;   // batches taken back by the owners
+    uint64_t volatile _high_water; // sum of the high-water marks
+    uint64_t volatile _trimmed;    // released above the recent marks
+    uint64_t volatile _orphaned;   // given back after the owner exited
+
+    // for the rate since the last print
+    uint64_t   _last_borrowed;
+    stopwatch_t _timer;
+
+    cache_stats_t() 
+        : _borrowed(0), _remote(0), _reclaims(0), _high_water(0),
+          _trimmed(0), _orphaned(0), _last_borrowed(0)
+    { }
+
+    static cache_stats_t* instance() { static cache_stats_t _s; return (&_s); }
+
+    void add(const uint borrowed, const uint remote, const uint reclaims,
+             const uint high_water, const uint trimmed) 
+    {
+        atomic_add_64(&_borrowed, borrowed);
+        atomic_add_64(&_remote, remote);
+        atomic_add_64(&_reclaims, reclaims);
+        atomic_add_64(&_high_water, high_water);
+        atomic_add_64(&_trimmed, trimmed);
+    }
+
+    void add_orphaned() { atomic_add_64(&_orphaned, 1); }
+
+    // Prints the totals, the borrows per sec since the last call, and
+    // the resident set size of the process
+    void print_stats();
+
+}; // EOF: cache_stats_t
+
 
 
 /******************************************************************** 
@@ -43,6 +128,12 @@
  * @brief: (template-based) object cache of cacheable objects
  *
  * @note:  The Object needs to implement the cacheable_iface
+ *
+ * @note:  The cache keeps the objects given back on its own free list,
+ *         reset. Every RECLAIM_BATCH borrows it trims that list, so that
+ *         the objects it holds are no more than the most it had out 
+ *         since the previous trim (the recent mark). The objects above
+ *         that go back to the underlying pool.
  * 
  ********************************************************************/
 
@@ -51,18 +142,188 @@ class object_cache_t : public object_cache<Object, object_cache_initializing_fac
 {
 public:
 
-    // Ask for an unused object, if cache empty allocate and return a new one
+    // How many borrows between two looks at the return list
+    static const uint RECLAIM_BATCH = 32;
+
+private:
+
+    pthread_t _owner;
+
+    // Objects given back by the other threads. They push, the owner
+    // takes the whole list, so there is no ABA. ORPHANED once retired.
+    cache_link_t* volatile _returned;
+
+    // Reset objects, ready to be lent again. Only the owner uses it.
+    cache_link_t* _free;
+    uint _free_cnt;
+
+    // Objects out of the cache (borrowed, or on the return list), their 
+    // maximum, and their maximum since the last batch taken back
+    uint _out;
+    uint _high_water;
+    uint _recent_high;
+
+    // Once retired, the objects still out minus those given back since
+    // (see retire())
+    uint volatile _live;
+
+    // Not yet added to the cache_stats_t
+    uint _borrowed;
+    uint _remote;
+    uint _reclaims;
+    uint _trimmed;
+    uint _high_water_added;
+
+    static inline cache_link_t* ORPHANED() { return ((cache_link_t*)0x1); }
+
+public:
+
+    object_cache_t() 
+        : _owner(pthread_self()), _returned(NULL), _free(NULL), _free_cnt(0),
+          _out(0), _high_water(0), _recent_high(0), _live(0),
+          _borrowed(0), _remote(0), _reclaims(0), _trimmed(0), 
+          _high_water_added(0)
+    { }
+
+    ~object_cache_t()
+    {
+        if (*&_returned != ORPHANED()) _reclaim();
+        _release_free(0);
+        _add_stats();
+    }
+
+    // Ask for an unused object, if cache empty allocate and return a new one.
+    // Before going above the high-water mark the objects given back by 
+    // the other threads are taken back, so the cache grows only if the
+    // objects really are in use.
     Object* borrow() 
     {
+        if ((_out >= _high_water) || (_borrowed >= RECLAIM_BATCH)) {
+            if (*&_returned) _reclaim();
+            if (_borrowed >= RECLAIM_BATCH) {
+                _trim();
+                _add_stats();
+            }
+        }
+        if (++_out > _high_water) _high_water = _out;
+        if (_out > _recent_high) _recent_high = _out;
+        ++_borrowed;
+        if (_free) {
+            Object* pObj = static_cast<Object*>(_free);
+            _free = _free->_cache_next;
+            --_free_cnt;
+            pObj->_cache_next = NULL;
+            pObj->init();
+            return (pObj);
+        }
         return(this->acquire());
     }    
 
     // Returns an object to the cache. The object is reset and put on the
-    // free list.
+    // free list. If the caller is not the owner it is put on the return 
+    // list instead, or released to the pool if the owner has exited.
+    // A retired cache is checked first, since a later thread may get
+    // the pthread_t of the exited owner.
     void giveback(Object* pObj) 
     {
-        this->release(pObj);
+        if ((*&_returned != ORPHANED()) && pthread_equal(pthread_self(), _owner)) {
+            --_out;
+            _put(pObj);
+            return;
+        }
+        cache_link_t* link = pObj;
+        cache_link_t* head = NULL;
+        do {
+            head = *&_returned;
+            if (head == ORPHANED()) {
+                this->release(pObj);
+                cache_stats_t::instance()->add_orphaned();
+                // the last object out deletes the retired cache
+                if (atomic_add_int_nv(&_live, -1) == 0) delete (this);
+                return;
+            }
+            link->_cache_next = head;
+        } while (atomic_cas(&_returned, head, link) != head);
     }    
+
+    // Called by the owner thread when it exits, instead of deleting the
+    // cache. The objects still out may be given back later by the other
+    // threads, so the cache is deleted only when the last of them is.
+    void retire()
+    {
+        assert (pthread_equal(pthread_self(), _owner));
+        _take(atomic_swap(&_returned, ORPHANED()));
+        _release_free(0);
+        _add_stats();
+        // the objects given back after the swap have already subtracted
+        // themselves from _live
+        if (atomic_add_int_nv(&_live, (int)_out) == 0) delete (this);
+    }
+
+    inline uint high_water() const { return (_high_water); }
+
+private:
+
+    void _put(Object* pObj)
+    {
+        pObj->reset();
+        pObj->_cache_next = _free;
+        _free = pObj;
+        ++_free_cnt;
+    }
+
+    // Releases to the pool the free objects above (keep)
+    void _release_free(const uint keep)
+    {
+        while (_free_cnt > keep) {
+            Object* pObj = static_cast<Object*>(_free);
+            _free = _free->_cache_next;
+            --_free_cnt;
+            pObj->_cache_next = NULL;
+            this->release(pObj);
+            ++_trimmed;
+        }
+    }
+
+    void _take(cache_link_t* link)
+    {
+        while (link) {
+            cache_link_t* next = link->_cache_next;
+            --_out;
+            ++_remote;
+            _put(static_cast<Object*>(link));
+            link = next;
+        }
+    }
+
+    void _reclaim()
+    {
+        cache_link_t* link = atomic_swap(&_returned, (cache_link_t*)NULL);
+        if (!link) return;
+        ++_reclaims;
+        _take(link);
+    }
+
+    // Trims the free list to the recent mark, and starts a new one
+    void _trim()
+    {
+        uint keep = (_recent_high > _out ? _recent_high - _out : 0);
+        _release_free(keep);
+        _recent_high = _out;
+    }
+
+    void _add_stats()
+    {
+        cache_stats_t::instance()->add(_borrowed, _remote, _reclaims,
+                                       _high_water - _high_water_added,
+                                       _trimmed);
+        _high_water_added = _high_water;
+        _borrowed = 0;
+        _remote = 0;
+        _reclaims = 0;
+        _trimmed = 0;
+    }
+
 }; // EOF: object_cache_t
 
 
@@ -0,0 +1,99 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   histogram.h
+ *
+ *  @brief:  Log-bucketed (HDR-style) histogram of 64-bit values
+ *
+ *  @note:   Values below 2*HIST_SUB_BUCKETS are counted exactly. Above
+ *           that, each power of two is split into HIST_SUB_BUCKETS
+ *           linear sub-buckets, so the relative error of a reported 
+ *           value is below 1/HIST_SUB_BUCKETS (~3%). Recording is an 
+ *           increment, there are no allocations or locks. Values above
+ *           the largest bucket are clamped to it.
+ */
+
+#ifndef __UTIL_HISTOGRAM_H
+#define __UTIL_HISTOGRAM_H
+
+#include <stdint.h>
+#include <cstring>
+
+#include "k_defines.h"
+
+
+const uint HIST_SUB_BITS    = 5;
+const uint HIST_SUB_BUCKETS = (1<<HIST_SUB_BITS);
+const uint HIST_MAX_BITS    = 36; // 2^36 usecs is about 19 hours
+const uint HIST_BUCKETS     = (HIST_MAX_BITS-HIST_SUB_BITS+1)*HIST_SUB_BUCKETS;
+
+
+class histogram_t
+{
+private:
+
+    uint64_t _counts[HIST_BUCKETS];
+    uint64_t _total;
+
+public:
+
+    histogram_t() { reset(); }
+    ~histogram_t() { }
+
+    // Returns the bucket of a value
+    static inline uint bucket(uint64_t v) {
+        if (v < 2*HIST_SUB_BUCKETS) return ((uint)v);
+        uint msb = 63 - __builtin_clzll(v);
+        if (msb >= HIST_MAX_BITS) return (HIST_BUCKETS-1);
+        uint shift = msb - HIST_SUB_BITS;
+        return ((shift+1)*HIST_SUB_BUCKETS + (uint)(v>>shift) - HIST_SUB_BUCKETS);
+    }
+
+    // Returns the highest value that falls in a bucket
+    static uint64_t bucket_value(const uint idx);
+
+    inline void record(const uint64_t v) {
+        ++_counts[bucket(v)];
+        ++_total;
+    }
+
+    void reset() {
+        memset(_counts, 0, sizeof(_counts));
+        _total = 0;
+    }
+
+    uint64_t count() const { return (_total); }
+
+    // Returns the value below which (p)% of the recorded values fall
+    uint64_t percentile(const double p) const;
+
+    // Returns the (bucket of the) largest recorded value
+    uint64_t max() const;
+
+    histogram_t& operator+=(const histogram_t& rhs);
+    histogram_t& operator-=(const histogram_t& rhs);
+
+}; // EOF: histogram_t
+
+
+#endif /** __UTIL_HISTOGRAM_H */
@@ -0,0 +1,137 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   numa.h
+ *
+ *  @brief:  NUMA topology of the machine, and helpers for placing
+ *           threads and their memory on a node
+ *
+ *  @note:   The topology is read from /sys/devices/system/node. If it is
+ *           not there (not Linux, or a kernel without NUMA) the machine
+ *           is reported as a single node with all the online cpus, and
+ *           the binding calls do nothing.
+ *
+ *  @note:   No libnuma is needed. Memory is placed by first touch: a
+ *           numa_local_t scope runs the calling thread on the cpus of a
+ *           node and prefers that node for its new pages. Threads forked
+ *           inside the scope inherit both.
+ */
+
+#ifndef __UTIL_NUMA_H
+#define __UTIL_NUMA_H
+
+#include <vector>
+#include <sys/types.h>
+
+#include "k_defines.h"
+
+
+/********************************************************************
+ *
+ * @class: numa_topology_t
+ *
+ * @brief: The nodes of the machine and their cpus. Singleton.
+ *
+ ********************************************************************/
+
+class numa_topology_t
+{
+private:
+
+    // cpus of each node, in ascending order
+    std::vector< std::vector<processorid_t> > _node_cpus;
+
+    // node of each cpu, -1 if the cpu is not online
+    std::vector<int> _cpu_node;
+
+    // the id the kernel gives to each node, which differs from ours
+    // if some node has no cpus
+    std::vector<int> _sys_ids;
+
+    // whether the topology was read from sysfs
+    bool _discovered;
+
+    numa_topology_t();
+
+    void _add(const int node, const processorid_t cpu);
+    bool _read_sysfs();
+
+public:
+
+    static numa_topology_t* instance() { static numa_topology_t _instance; return (&_instance); }
+
+    inline bool discovered() const { return (_discovered); }
+    inline uint nodes() const { return (_node_cpus.size()); }
+    inline uint cpus(const uint node) const { return (_node_cpus[node].size()); }
+    inline int sys_id(const uint node) const { return (_sys_ids[node]); }
+
+    // the node of a cpu, 0 if unknown
+    int node_of(const processorid_t cpu) const;
+
+    // the (idx)-th cpu of a node, wrapping around
+    processorid_t cpu_of(const uint node, const uint idx) const;
+
+    // the node the calling thread runs on now
+    int current_node() const;
+
+    void print() const;
+
+}; // EOF: numa_topology_t
+
+
+
+// binds the calling thread to a cpu/to all the cpus of a node,
+// 0 on success
+int numa_bind_cpu(const processorid_t cpu);
+int numa_bind_node(const int node);
+
+
+
+/********************************************************************
+ *
+ * @class: numa_local_t
+ *
+ * @brief: For the duration of the scope the calling thread runs on the
+ *         cpus of (node) and its new pages come from (node). A negative
+ *         node makes it a no-op.
+ *
+ ********************************************************************/
+
+class numa_local_t
+{
+private:
+
+    int                        _node;
+    std::vector<processorid_t> _old_cpus;   // affinity to restore
+    int                        _old_policy; // -1 if not changed
+    unsigned long              _old_nodemask;
+
+public:
+
+    numa_local_t(const int node);
+    ~numa_local_t();
+
+}; // EOF: numa_local_t
+
+
+#endif /* __UTIL_NUMA_H */
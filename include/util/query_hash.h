@@ -0,0 +1,394 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+
+/** @file:   query_hash.h
+ *
+ *  @brief:  Tables for the joins and the group-bys of the queries, in
+ *           place of std::map
+ *
+ *  @note:   hash_map_t   - Open addressing with linear probing, for
+ *                          sparse keys such as order keys, or composite
+ *                          group-by keys.
+ *           dense_map_t  - An array indexed by the key, for keys from a
+ *                          bounded domain such as nations, parts,
+ *                          suppliers or customers.
+ *           arena_list_t - A list of values per key, as payload.
+ *
+ *  @note:   All of them take their memory from an arena_t and are
+ *           pre-sized from the expected number of keys (the cardinality
+ *           of the table the keys come from). They grow if the estimate
+ *           is short, leaving the old memory to the arena. Nothing is
+ *           ever destructed, so the keys and values should not own
+ *           memory elsewhere. Keys are never removed. The iteration
+ *           order of a hash_map_t is unspecified.
+ */
+
+#ifndef __UTIL_QUERY_HASH_H
+#define __UTIL_QUERY_HASH_H
+
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdint.h>
+
+#include "util/arena.h"
+
+
+/********************************************************************
+ *
+ * @struct: int_hash_fcn
+ *
+ * @brief:  The identity. The tables scramble every hash value with a
+ *          multiplicative (Fibonacci) hash anyway.
+ *
+ ********************************************************************/
+
+struct int_hash_fcn
+{
+    uint32_t operator()(const int key) const { return ((uint32_t)key); }
+};
+
+
+// To combine the fields of a composite key
+inline uint32_t hash_combine(const uint32_t h, const int field)
+{
+    return ((h ^ (uint32_t)field) * 16777619U);
+}
+
+
+
+/********************************************************************
+ *
+ * @class: hash_map_t
+ *
+ * @brief: Open addressing hash table, at most half full
+ *
+ ********************************************************************/
+
+template <class K, class V, 
+          class HashFcn = int_hash_fcn, class EqualKey = std::equal_to<K> >
+class hash_map_t
+{
+public:
+
+    struct entry_t {
+        K _key;
+        V _value;
+    };
+
+    class iterator;
+    friend class iterator;
+
+private:
+
+    arena_t*   _arena;
+    entry_t*   _entries;
+    char*      _used;
+    size_t     _capacity;   // power of 2
+    int        _shift;      // 32 - log2(_capacity)
+    size_t     _size;
+
+    HashFcn    _hash;
+    EqualKey   _equal;
+
+    size_t _home(const K& key) const {
+        return ((uint32_t)(_hash(key) * 2654435769U) >> _shift);
+    }
+
+    // the slot of the key, or the free slot where it would go
+    size_t _probe(const K& key) const {
+        size_t i = _home(key);
+        while (_used[i] && !_equal(_entries[i]._key, key)) {
+            i = (i + 1) & (_capacity - 1);
+        }
+        return (i);
+    }
+
+    void _alloc(const size_t capacity) {
+        _capacity = 2;
+        _shift = 31;
+        while (_capacity < capacity) {
+            _capacity <<= 1;
+            --_shift;
+        }
+        _entries = _arena->alloc_array<entry_t>(_capacity);
+        _used = _arena->alloc_array<char>(_capacity);
+        memset(_used, 0, _capacity);
+    }
+
+    void _grow() {
+        entry_t* entries = _entries;
+        char* used = _used;
+        size_t capacity = _capacity;
+        _alloc(2*capacity);
+        for (size_t i=0; i<capacity; i++) {
+            if (used[i]) {
+                size_t j = _probe(entries[i]._key);
+                new (&_entries[j]) entry_t(entries[i]);
+                _used[j] = 1;
+            }
+        }
+    }
+
+    // no copying
+    hash_map_t(const hash_map_t&);
+    hash_map_t& operator=(const hash_map_t&);
+
+public:
+
+    hash_map_t(arena_t& arena, const size_t expected,
+               HashFcn hash = HashFcn(), EqualKey equal = EqualKey())
+        : _arena(&arena), _size(0), _hash(hash), _equal(equal)
+    {
+        _alloc(2*expected);
+    }
+
+    size_t size() const { return (_size); }
+    bool empty() const { return (_size == 0); }
+
+    // NULL if the key is not there
+    V* find(const K& key) {
+        size_t i = _probe(key);
+        return (_used[i] ? &_entries[i]._value : NULL);
+    }
+
+    bool contains(const K& key) const {
+        return (_used[_probe(key)]);
+    }
+
+    // the value of the key, inserting (init) if the key is not there
+    V& get(const K& key, const V& init = V()) {
+        size_t i = _probe(key);
+        if (!_used[i]) {
+            if (2*(_size+1) > _capacity) {
+                _grow();
+                i = _probe(key);
+            }
+            entry_t e = { key, init };
+            new (&_entries[i]) entry_t(e);
+            _used[i] = 1;
+            ++_size;
+        }
+        return (_entries[i]._value);
+    }
+
+    // like std::map::insert(), false and no change if the key is there
+    bool insert(const K& key, const V& value) {
+        size_t size = _size;
+        get(key, value);
+        return (_size > size);
+    }
+
+
+    class iterator
+    {
+        hash_map_t* _map;
+        size_t      _i;
+
+        void _skip() {
+            while ((_i < _map->_capacity) && !_map->_used[_i]) ++_i;
+        }
+
+    public:
+
+        iterator(hash_map_t* map, const size_t i) : _map(map), _i(i) { _skip(); }
+
+        const K& key() const { return (_map->_entries[_i]._key); }
+        V& value() const { return (_map->_entries[_i]._value); }
+
+        iterator& operator++() { ++_i; _skip(); return (*this); }
+        bool operator==(const iterator& other) const { return (_i == other._i); }
+        bool operator!=(const iterator& other) const { return (_i != other._i); }
+    };
+
+    iterator begin() { return (iterator(this, 0)); }
+    iterator end() { return (iterator(this, _capacity)); }
+
+}; // EOF: hash_map_t
+
+
+
+/********************************************************************
+ *
+ * @class: dense_map_t
+ *
+ * @brief: Array indexed by (key - lo), for keys in [lo,hi]. A larger
+ *         key makes the array grow. Iterates in key order.
+ *
+ ********************************************************************/
+
+template <class V>
+class dense_map_t
+{
+public:
+
+    class iterator;
+    friend class iterator;
+
+private:
+
+    arena_t*  _arena;
+    int       _lo;
+    V*        _values;
+    char*     _used;
+    size_t    _range;
+    size_t    _size;
+
+    void _alloc(const size_t range) {
+        _range = range;
+        _values = _arena->alloc_array<V>(_range);
+        _used = _arena->alloc_array<char>(_range);
+        memset(_used, 0, _range);
+    }
+
+    void _grow(const size_t i) {
+        V* values = _values;
+        char* used = _used;
+        size_t range = _range;
+        _alloc((i < 2*range) ? 2*range : i+1);
+        for (size_t j=0; j<range; j++) {
+            if (used[j]) {
+                new (&_values[j]) V(values[j]);
+                _used[j] = 1;
+            }
+        }
+    }
+
+    // no copying
+    dense_map_t(const dense_map_t&);
+    dense_map_t& operator=(const dense_map_t&);
+
+public:
+
+    dense_map_t(arena_t& arena, const int lo, const int hi)
+        : _arena(&arena), _lo(lo), _size(0)
+    {
+        assert (hi >= lo);
+        _alloc(hi - lo + 1);
+    }
+
+    size_t size() const { return (_size); }
+    bool empty() const { return (_size == 0); }
+
+    // NULL if the key is not there
+    V* find(const int key) {
+        size_t i = (size_t)(key - _lo);
+        return (((key >= _lo) && (i < _range) && _used[i]) ? &_values[i] : NULL);
+    }
+
+    bool contains(const int key) const {
+        size_t i = (size_t)(key - _lo);
+        return ((key >= _lo) && (i < _range) && _used[i]);
+    }
+
+    // the value of the key, inserting (init) if the key is not there
+    V& get(const int key, const V& init = V()) {
+        assert (key >= _lo);
+        size_t i = (size_t)(key - _lo);
+        if (i >= _range) _grow(i);
+        if (!_used[i]) {
+            new (&_values[i]) V(init);
+            _used[i] = 1;
+            ++_size;
+        }
+        return (_values[i]);
+    }
+
+    // like std::map::insert(), false and no change if the key is there
+    bool insert(const int key, const V& value) {
+        size_t size = _size;
+        get(key, value);
+        return (_size > size);
+    }
+
+
+    class iterator
+    {
+        dense_map_t* _map;
+        size_t       _i;
+
+        void _skip() {
+            while ((_i < _map->_range) && !_map->_used[_i]) ++_i;
+        }
+
+    public:
+
+        iterator(dense_map_t* map, const size_t i) : _map(map), _i(i) { _skip(); }
+
+        int key() const { return (_map->_lo + (int)_i); }
+        V& value() const { return (_map->_values[_i]); }
+
+        iterator& operator++() { ++_i; _skip(); return (*this); }
+        bool operator==(const iterator& other) const { return (_i == other._i); }
+        bool operator!=(const iterator& other) const { return (_i != other._i); }
+    };
+
+    iterator begin() { return (iterator(this, 0)); }
+    iterator end() { return (iterator(this, _range)); }
+
+}; // EOF: dense_map_t
+
+
+
+/********************************************************************
+ *
+ * @struct: arena_list_t
+ *
+ * @brief:  Singly linked list with its nodes in an arena, newest first.
+ *          Small enough to be the value of a table.
+ *
+ ********************************************************************/
+
+template <class T>
+struct arena_list_t
+{
+    struct node_t {
+        T       _value;
+        node_t* _next;
+    };
+
+    node_t* _head;
+    size_t  _size;
+
+    arena_list_t() : _head(NULL), _size(0) { }
+
+    void push(arena_t& arena, const T& value) {
+        node_t* node = arena.alloc_array<node_t>(1);
+        new (&node->_value) T(value);
+        node->_next = _head;
+        _head = node;
+        ++_size;
+    }
+
+    // the nodes stay in the arena
+    void clear() { _head = NULL; _size = 0; }
+
+    size_t size() const { return (_size); }
+    const node_t* head() const { return (_head); }
+
+}; // EOF: arena_list_t
+
+
+#endif /* __UTIL_QUERY_HASH_H */
@@ -83,6 +83,7 @@ public:
     }
 
     void reserve(int n);
+    int  try_reserve(int n);
     void unreserve(int n);
     void notify_capacity_increase(int diff);
     void notify_idle();
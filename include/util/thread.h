@@ -41,6 +41,7 @@
 #include "util/c_str.h"
 #include "util/exception.h"
 #include "util/randgen.h"
+#include "util/numa.h"
 
 
 DEFINE_EXCEPTION(ThreadException);
@@ -58,9 +59,16 @@ DEFINE_EXCEPTION(ThreadException);
 
 #else
 
-// No-op
-#define TRY_TO_BIND(cpu,boundflag)              \
-    TRACE( TRACE_DEBUG, "Should bind me to (%d)\n", _prs_id);
+// Binds through sched_setaffinity() where available, see util/numa.h
+#define TRY_TO_BIND(cpu,boundflag)                                      \
+    if (cpu == PBIND_NONE) {                                            \
+       boundflag = false; }                                             \
+    else if (numa_bind_cpu(cpu)) {                                      \
+       TRACE( TRACE_CPU_BINDING, "Cannot bind to processor (%d)\n", cpu);  \
+       boundflag = false; }                                             \
+    else {                                                              \
+    TRACE( TRACE_CPU_BINDING, "Binded to processor (%d)\n", cpu);       \
+    boundflag = true; }
     
 #endif
 
@@ -45,6 +45,23 @@ time_t str_to_timet(char const* str);
 void   timet_to_str(char* dst, time_t time);
 
 
+/** Day number functions
+ *
+ *  @note A day number is the number of days since 1970-01-01. It is
+ *        how the date columns are stored, so that the predicates compare
+ *        integers instead of parsing strings. The conversions from and
+ *        to time_t use the local timezone, like str_to_timet().
+ */
+
+int    ymd_to_daynum(int year, int month, int day);
+int    str_to_daynum(char const* str);
+int    timet_to_daynum(time_t time);
+time_t daynum_to_timet(int daynum);
+void   daynum_to_ymd(int daynum, int& year, int& month, int& day);
+int    daynum_year(int daynum);
+void   daynum_to_str(char* dst, int daynum);
+
+
 
 /** time_t manipulation functions
  *
@@ -57,6 +57,9 @@ private:
     int _wh;
     trx_worker_t* _worker;
     double _qf;
+
+    // if set, each request goes to the worker of its warehouse
+    bool _affinity;
     
 
 public:
@@ -63,6 +63,7 @@ public:
       moreToRead=true;
       cnt = 0;
     }
+    ~EgenTupleContainer() { delete [] buffer; }
     T* get(int i){cnt++; return &buffer[i]; }
     void append(T* row) {memcpy(&buffer[size++],row, sizeof(T)); }
     bool hasSpace(){return (size<capacity-2);}
@@ -216,6 +217,67 @@ class ZipCodeBuffer: public EgenTupleContainer<ZIP_CODE_ROW>{
 };
 
 
+
+/******************************************************************** 
+ *
+ * @class: EgenLoader
+ *
+ * @brief: The generator and the buffers of the tables that scale with
+ *         the number of customers, for a range of customers. Each loader
+ *         thread has its own, so that the ranges are generated and
+ *         loaded in parallel. The fixed tables are loaded only once,
+ *         from the global buffers.
+ *
+ ********************************************************************/
+
+class EgenLoader
+{
+  public:
+    TIdent startCustomer;
+    TIdent customerCount;
+    CGenerateAndLoad* pGenerateAndLoad;
+    CBaseLogger* pLogger;          // used by the generator
+    CBaseLogFormatter* pLogFormat; // used by the logger
+
+    AccountPermissionBuffer accountPermissionBuffer;
+    CustomerBuffer customerBuffer;
+    CustomerAccountBuffer customerAccountBuffer;
+    CustomerTaxrateBuffer customerTaxrateBuffer;
+    HoldingBuffer holdingBuffer;
+    HoldingHistoryBuffer holdingHistoryBuffer;
+    HoldingSummaryBuffer holdingSummaryBuffer;
+    WatchItemBuffer watchItemBuffer;
+    WatchListBuffer watchListBuffer;
+
+    BrokerBuffer brokerBuffer;
+    CashTransactionBuffer cashTransactionBuffer;
+    SettlementBuffer settlementBuffer;
+    TradeBuffer tradeBuffer;
+    TradeHistoryBuffer tradeHistoryBuffer;
+
+    CompanyBuffer companyBuffer;
+    CompanyCompetitorBuffer companyCompetitorBuffer;
+    DailyMarketBuffer dailyMarketBuffer;
+    FinancialBuffer financialBuffer;
+    LastTradeBuffer lastTradeBuffer;
+    NewsItemBuffer newsItemBuffer;
+    NewsXRefBuffer newsXRefBuffer;
+    SecurityBuffer securityBuffer;
+
+    AddressBuffer addressBuffer;
+
+    EgenLoader(TIdent start, TIdent count);
+    ~EgenLoader();
+
+    void printCardinality();
+
+  private:
+    // copying not allowed
+    EgenLoader(EgenLoader const &);
+    void operator=(EgenLoader const &);
+};
+
+
 EXIT_NAMESPACE(tpce);
 
 #endif
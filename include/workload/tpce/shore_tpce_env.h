@@ -62,46 +62,21 @@ using namespace TPCE;
 
 int egen_init(int argc, char* argv[]);
 void egen_release();
+CGenerateAndLoad* egen_create_loader(TIdent iStartCustomer, TIdent iCustomers,
+                                     CBaseLogger*& pLogger,
+                                     CBaseLogFormatter*& pLogFormat);
 extern CGenerateAndLoad*  pGenerateAndLoad;
 
 ENTER_NAMESPACE(tpce);
 
 using std::map;
 
-extern AccountPermissionBuffer accountPermissionBuffer;
-extern CustomerBuffer customerBuffer ;
-extern CustomerAccountBuffer customerAccountBuffer ;
-extern CustomerTaxrateBuffer  customerTaxrateBuffer ;
-extern HoldingBuffer holdingBuffer;
-extern HoldingHistoryBuffer holdingHistoryBuffer;
-extern HoldingSummaryBuffer holdingSummaryBuffer;
-extern WatchItemBuffer watchItemBuffer ;
-extern WatchListBuffer watchListBuffer;
-
-extern BrokerBuffer brokerBuffer;
-extern CashTransactionBuffer cashTransactionBuffer;
 extern ChargeBuffer chargeBuffer;
 extern CommissionRateBuffer commissionRateBuffer;
-extern SettlementBuffer settlementBuffer;
-extern TradeBuffer tradeBuffer;
-extern TradeHistoryBuffer tradeHistoryBuffer;
 extern TradeTypeBuffer tradeTypeBuffer;
-
-
-extern CompanyBuffer companyBuffer ;
-extern CompanyCompetitorBuffer companyCompetitorBuffer;
-extern DailyMarketBuffer dailyMarketBuffer;
 extern ExchangeBuffer exchangeBuffer;
-extern FinancialBuffer financialBuffer;
 extern IndustryBuffer industryBuffer;
-extern LastTradeBuffer lastTradeBuffer;
-extern NewsItemBuffer newsItemBuffer;
-extern NewsXRefBuffer newsXRefBuffer;//big
 extern SectorBuffer sectorBuffer;
-extern SecurityBuffer securityBuffer;
-
-
-extern AddressBuffer addressBuffer;
 extern StatusTypeBuffer statusTypeBuffer;
 extern TaxrateBuffer taxrateBuffer ;
 extern ZipCodeBuffer zipCodeBuffer ;
@@ -292,23 +267,23 @@ private:
     void _read_trade();   
     void _read_trade_history();
 
-    void _read_ca_and_ap();
-    void _read_broker();   
-    void _read_company();
-    void _read_customer();   
-    void _read_company_competitor();
-    void _read_security();   
-    void _read_daily_market();   
-    void _read_customer_taxrate();
-    void _read_holding();   
-    void _read_financial();
+    void _read_ca_and_ap(EgenLoader* ld);
+    void _read_broker(EgenLoader* ld);   
+    void _read_company(EgenLoader* ld);
+    void _read_customer(EgenLoader* ld);   
+    void _read_company_competitor(EgenLoader* ld);
+    void _read_security(EgenLoader* ld);   
+    void _read_daily_market(EgenLoader* ld);   
+    void _read_customer_taxrate(EgenLoader* ld);
+    void _read_holding(EgenLoader* ld);   
+    void _read_financial(EgenLoader* ld);
     void _read_holding_history();   
-    void _read_address();
-    void _read_holding_summary();   
-    void _read_last_trade();
-    void _read_wl_and_wi();   
-    void _read_ni_and_nx();
-    void _read_trade_unit();
+    void _read_address(EgenLoader* ld);
+    void _read_holding_summary(EgenLoader* ld);   
+    void _read_last_trade(EgenLoader* ld);
+    void _read_wl_and_wi(EgenLoader* ld);   
+    void _read_ni_and_nx(EgenLoader* ld);
+    void _read_trade_unit(EgenLoader* ld);
 
     
 public:    
@@ -393,23 +368,23 @@ public:
         zipCodeBuffer.release();
     }
     
-    void populate_customer();
-    void populate_address();
-    void populate_ca_and_ap();
-    void populate_wl_and_wi();
-    void populate_ni_and_nx();
-    void populate_last_trade();
-    void populate_company();
-    void populate_company_competitor();
-    void populate_daily_market();
-    void populate_financial();
-    void populate_security();
-    void populate_customer_taxrate();
-    void populate_broker();
-    void populate_holding();
-    void populate_holding_summary();
-    void populate_unit_trade();
-    void populate_growing();
+    void populate_customer(EgenLoader* ld);
+    void populate_address(EgenLoader* ld);
+    void populate_ca_and_ap(EgenLoader* ld);
+    void populate_wl_and_wi(EgenLoader* ld);
+    void populate_ni_and_nx(EgenLoader* ld);
+    void populate_last_trade(EgenLoader* ld);
+    void populate_company(EgenLoader* ld);
+    void populate_company_competitor(EgenLoader* ld);
+    void populate_daily_market(EgenLoader* ld);
+    void populate_financial(EgenLoader* ld);
+    void populate_security(EgenLoader* ld);
+    void populate_customer_taxrate(EgenLoader* ld);
+    void populate_broker(EgenLoader* ld);
+    void populate_holding(EgenLoader* ld);
+    void populate_holding_summary(EgenLoader* ld);
+    void populate_unit_trade(EgenLoader* ld);
+    void populate_growing(EgenLoader* ld);
     void find_maxtrade_id();
     // Public methods //    
 
@@ -472,22 +472,33 @@ trade_cleanup_input_t     create_trade_cleanup_input(int sf, int specificIdx);
 
 
 struct populate_small_input_t{};
-struct populate_customer_input_t{};
-struct populate_address_input_t{};
-struct populate_ca_and_ap_input_t{};
-struct populate_wl_and_wi_input_t{};
-struct populate_company_input_t{};
-struct populate_company_competitor_input_t{};
-struct populate_daily_market_input_t{};
-struct populate_financial_input_t{};
-struct populate_last_trade_input_t{};
-struct populate_ni_and_nx_input_t{};
-struct populate_security_input_t{};
-struct populate_customer_taxrate_input_t{};
-struct populate_broker_input_t{};
-struct populate_holding_input_t{};
-struct populate_holding_summary_input_t{};
-struct populate_unit_trade_input_t{};
+
+// The populate xcts of the scaling and growing tables read the rows from
+// the buffers of the loader that calls them
+class EgenLoader;
+
+struct populate_input_t
+{
+    EgenLoader* _loader;
+    populate_input_t(EgenLoader* aloader=NULL) : _loader(aloader) { }
+};
+
+typedef populate_input_t populate_customer_input_t;
+typedef populate_input_t populate_address_input_t;
+typedef populate_input_t populate_ca_and_ap_input_t;
+typedef populate_input_t populate_wl_and_wi_input_t;
+typedef populate_input_t populate_company_input_t;
+typedef populate_input_t populate_company_competitor_input_t;
+typedef populate_input_t populate_daily_market_input_t;
+typedef populate_input_t populate_financial_input_t;
+typedef populate_input_t populate_last_trade_input_t;
+typedef populate_input_t populate_ni_and_nx_input_t;
+typedef populate_input_t populate_security_input_t;
+typedef populate_input_t populate_customer_taxrate_input_t;
+typedef populate_input_t populate_broker_input_t;
+typedef populate_input_t populate_holding_input_t;
+typedef populate_input_t populate_holding_summary_input_t;
+typedef populate_input_t populate_unit_trade_input_t;
 
 struct find_maxtrade_id_input_t{};
 
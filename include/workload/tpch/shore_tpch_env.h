@@ -349,6 +349,10 @@ public:
     DECLARE_TRX(qsupplier);
     DECLARE_TRX(qpartsupp);
     DECLARE_TRX(qcustomer);
+
+    // Vectorized (column-at-a-time) implementations
+    DECLARE_TRX_IMPL(q1,vec_q1);
+    DECLARE_TRX_IMPL(q6,vec_q6);
     
     // QUERIES for the non-partition aligned benchmark
     DECLARE_TRX(qNP);
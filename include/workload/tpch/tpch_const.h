@@ -109,6 +109,10 @@ const int XCT_TPCH_QPART     = 75;
 const int XCT_TPCH_QPARTSUPP = 76;
 const int XCT_TPCH_QCUSTOMER = 77;
 
+// vectorized implementations
+const int XCT_TPCH_VEC_Q1    = 81;
+const int XCT_TPCH_VEC_Q6    = 86;
+
 const int XCT_QPIPE_TPCH_MIX      = 1040;
 
 
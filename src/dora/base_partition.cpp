@@ -40,7 +40,8 @@ base_partition_t::base_partition_t(ShoreEnv* env, table_desc_t* ptable,
                                    const processorid_t aprsid) 
     : _env(env), _table(ptable), 
       _part_id(apartid), _part_policy(PP_UNDEF), 
-      _prs_id(aprsid)          
+      _prs_id(aprsid), _node(-1),
+      _enqueued(0), _unreleased(0)
 {
     assert (_env);
     assert (_table);
@@ -266,7 +266,8 @@ int dora_notifier_t::_work_ACTIVE_impl()
 
         if (prvp) {
             prvp->upd_committed_stats();
-            prvp->notify_partitions();
+            // with ELR the partitions were notified at commit
+            if (!prvp->released()) prvp->notify_partitions();
             prvp->notify_client();
             prvp->giveback();
             prvp = NULL;
@@ -31,6 +31,7 @@
 
 #include "dora/common.h"
 #include "dora/dora_env.h"
+#include "dora/repartitioner.h"
 
 #include "cpu_info.h"
 
@@ -51,6 +52,9 @@ typedef partition_t<int> irpImpl;
  ********************************************************************/
 
 DoraEnv::DoraEnv()
+    : _num_flushers(0), _numa(false),
+      _rebalance(false), _in_flight(0), _admit_closed(false),
+      _penv(NULL), _elr_used(false)
 { 
     _check_type();
 }
@@ -117,15 +121,31 @@ int DoraEnv::_statistics(ShoreEnv* /* penv */)
     TRACE( TRACE_STATISTICS, "----- DORA -----\n");
     uint sz=_irptp_vec.size();
     TRACE( TRACE_STATISTICS, "Tables  = (%d)\n", sz);
+
+    // with NUMA placement the worker stats are gathered per node as well
+    uint nodes = numa_topology_t::instance()->nodes();
+    std::vector<worker_stats_t> pernode(nodes);
+    std::vector<uint> parts(nodes,0);
     for (uint i=0;i<sz;++i) {
-        _irptp_vec[i]->statistics();
+        if (_numa) _irptp_vec[i]->statistics(&pernode,&parts);
+        else _irptp_vec[i]->statistics();
+    }
+
+    if (_numa) {
+        for (uint n=0; n<nodes; n++) {
+            TRACE( TRACE_STATISTICS, "Node (%d) Parts (%d)\n", n, parts[n]);
+            pernode[n].print_stats();
+        }
     }
 
+    if (_repartitioner.get()) _repartitioner->print_stats();
+
 #ifdef CFG_FLUSHER
     TRACE( TRACE_STATISTICS, "Flushers: (%d)\n", _num_flushers);
 
     for (uint_t i=0; i<_num_flushers; i++)
     {
+        if (_numa) TRACE( TRACE_STATISTICS, "Node (%d)\n", i);
         _vec_flusher[i]->statistics();
     }
 #endif
@@ -176,18 +196,23 @@ uint DoraEnv::_check_type()
 
 int DoraEnv::_post_start(ShoreEnv* penv)
 {
+    _penv = penv;
+
 #ifdef CFG_FLUSHER
     // Start the flusher
     TRACE( TRACE_ALWAYS, "Creating dora-flusher...\n");
 
     // Determine the number of dora-flushers
+    _numa = (envVar::instance()->getVarInt("numa-placement",0) == 1);
     _num_flushers = determineNumFlushers();
     _vec_flusher.reserve(_num_flushers);
 
     // Create flushers, push them into the vector and 
-    // start them
+    // start them. With NUMA placement flusher (i) is created and forked
+    // on node (i), and so is its notifier.
     for (uint_t i=0; i<_num_flushers; i++)
     {
+        numa_local_t local(_numa ? (int)i : -1);
         dora_flusher_t* aFlusher = new dora_flusher_t(penv, c_str("DFlusher-%d",i)); 
         w_assert0(aFlusher);
 
@@ -204,6 +229,18 @@ int DoraEnv::_post_start(ShoreEnv* penv)
         _irptp_vec[i]->reset();
     }
 
+    // Start the online repartitioner. Only plain DORA, the PLP flavors
+    // have to follow the physical partitioning.
+    _in_flight = 0;
+    _admit_closed = false;
+    _rebalance = (is_dora() && 
+                  (envVar::instance()->getVarInt("dora-repartition",0) == 1));
+    if (_rebalance) {
+        TRACE( TRACE_ALWAYS, "Creating dora-repartitioner...\n");
+        _repartitioner = new dora_repartitioner_t(this);
+        _repartitioner->fork();
+    }
+
     penv->set_dbc(DBC_ACTIVE);
     return (0);
 }
@@ -225,6 +262,14 @@ int DoraEnv::_post_stop(ShoreEnv* penv)
     // Stopping/closing the tables
     TRACE( TRACE_ALWAYS, "Stopping...\n");
 
+    // The repartitioner goes first, it works on the tables
+    if (_repartitioner.get()) {
+        TRACE( TRACE_ALWAYS, "Stopping dora-repartitioner...\n");
+        _repartitioner->stop();
+        _repartitioner->join();
+        _repartitioner.done();
+    }
+
     for (uint i=0; i<_irptp_vec.size(); i++) 
     {
         if (_irptp_vec[i] != NULL)
@@ -345,8 +390,11 @@ processorid_t DoraEnv::_next_cpu(const processorid_t& aprd,
                                  const irpTableImpl* /* atable */,
                                  const int step)
 {    
+    // With NUMA placement the tables need a starting cpu even without
+    // binding, see part_table_t::numa_cpu()
     int binding = envVar::instance()->getVarInt("dora-cpu-binding",0);
-    if (binding==0)
+    int numa = envVar::instance()->getVarInt("numa-placement",0);
+    if ((binding==0) && (numa==0))
         return (PBIND_NONE);
 
     int activecpu = envVar::instance()->getVarInt("active-cpu-count",64);
@@ -366,12 +414,22 @@ processorid_t DoraEnv::_next_cpu(const processorid_t& aprd,
  *         equal to the number of sockets. For now we read it from
  *         shore.conf
  *
+ * @note:  With NUMA placement there is one flusher per node
+ *
  ******************************************************************/
 
 uint_t DoraEnv::determineNumFlushers()
 {    
     int numberOfFlushers = 1;
 
+    if (_numa) {
+        numberOfFlushers = numa_topology_t::instance()->nodes();
+        TRACE( TRACE_STATISTICS, 
+               "Number of flushers and NUMA nodes: (%d)\n", 
+               numberOfFlushers);
+        return ((uint_t)numberOfFlushers);
+    }
+
     // Set number of flusher equal to the number of sockets
     long socketCount = cpu_info::socket_count();
     if (socketCount > 0)
@@ -401,6 +459,34 @@ uint_t DoraEnv::determineNumFlushers()
 
 
 
+/****************************************************************** 
+ *
+ * @fn:    elr_lsn
+ *
+ * @brief: Early lock release. Raises the _elr_lsn if the xct releases
+ *         its locks before it is durable, and returns the lsn the xct
+ *         has to wait for.
+ *
+ * @note:  The xcts that read what an early released xct wrote commit
+ *         after it called this, so they wait for its lsn too. They are
+ *         not tracked one by one, every later xct waits.
+ *
+ ******************************************************************/
+
+lsn_t DoraEnv::elr_lsn(const lsn_t& alsn, const bool release)
+{
+    if (!release && !*&_elr_used) return (alsn);
+
+    CRITICAL_SECTION(elr_cs, _elr_lock);
+    if (release) {
+        _elr_used = true;
+        if (_elr_lsn < alsn) _elr_lsn = alsn;
+    }
+    return ((alsn < _elr_lsn) ? _elr_lsn : alsn);
+}
+
+
+
 
 
 EXIT_NAMESPACE(dora);
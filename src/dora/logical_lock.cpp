@@ -52,9 +52,9 @@ int DoraLockModeMatrix[DL_CC_MODES][DL_CC_MODES] = { {1, 1, 1},
 #undef LOCKDEBUG
 #define LOCKDEBUG
 
-typedef PooledList<ActionLockReq>::Type     ActionLockReqList;
-typedef ActionLockReqList::iterator         ActionLockReqListIt;
-typedef ActionLockReqList::const_iterator   ActionLockReqListCit;
+typedef LogicalLock::ActionLockReqList       ActionLockReqList;
+typedef LogicalLock::ActionLockReqListIt     ActionLockReqListIt;
+typedef LogicalLock::ActionLockReqListCit    ActionLockReqListCit;
 
 
 /******************************************************************** 
@@ -114,8 +114,8 @@ char const* db_pretty_print(LogicalLock* ll, int /* i=0 */, char const* /* s=0 *
 
 static void _print_key(std::ostream &out, key_wrapper_t<int> const &key) 
 {    
-    for (uint i=0; i<key._key_v.size(); ++i) {
-        out << key._key_v.at(i) << endl;
+    for (uint i=0; i<key.size(); ++i) {
+        out << key[i] << endl;
     }
 }
 
@@ -139,8 +139,7 @@ char const* db_pretty_print(key_wrapper_t<int> const* key, int /* i=0 */, char c
 LogicalLock::LogicalLock(ActionLockReq& anowner)
     : _dlm(anowner.dlm())
 {
-    // construct a logical lock with an owner already
-    _owners.reserve(1);
+    // construct a logical lock with an owner already (inline)
     _owners.push_back(anowner);
 }
 
@@ -171,8 +170,8 @@ int LogicalLock::release(BaseActionPtr anowner,
    
 
     // 1. Loop over all Owners
-    for (ActionLockReqVecIt it=_owners.begin(); it!=_owners.end(); ++it) {
-        tid_t* ownertid = (*it).tid();
+    for (uint i=0; i<_owners.size(); ++i) {
+        tid_t* ownertid = _owners[i].tid();
         w_assert1 (ownertid);
         TRACE( TRACE_TRX_FLOW, "Checking (%d) - Owner (%d)\n", 
                atid.get_lo(), ownertid->get_lo());
@@ -182,7 +181,7 @@ int LogicalLock::release(BaseActionPtr anowner,
             found = true;
 
             // 3. Remove trx from list of Owners
-            _owners.erase(it);
+            _owners.erase(i);
 
             // 4. Update the LockMode
             if (_upd_dlm()) {
@@ -297,8 +296,8 @@ bool LogicalLock::acquire(ActionLockReq& alr)
     assert (alr.action());
 
     // 1. Check if already possesing this lock
-    for (ActionLockReqVecIt it=_owners.begin(); it!=_owners.end(); ++it) {
-        if (alr.isSame((*it))) {
+    for (uint i=0; i<_owners.size(); ++i) {
+        if (alr.isSame(_owners[i])) {
 
             // if it is the same
             if (_dlm == alr.dlm()) {
@@ -427,8 +426,8 @@ bool LogicalLock::_upd_dlm()
     bool changed = false;    
 
     // 5. Iterate over all Onwers
-    for (ActionLockReqVecIt it=_owners.begin(); it!=_owners.end(); ++it) {
-        odlm = (*it).dlm();
+    for (uint i=0; i<_owners.size(); ++i) {
+        odlm = _owners[i].dlm();
 
         // 6. Assert if two owners have incompatible modes
         if (!DoraLockModeMatrix[new_dlm][odlm]) {
@@ -482,9 +481,9 @@ void LogicalLock::abort_and_reset(vector<xct_t*>& toabort)
     // Push tids for abortion
 
     // Iterate over all Onwers
-    for (ActionLockReqVecIt it=_owners.begin(); it!=_owners.end(); ++it) {
-        xct_t* victim = (*it).action()->xct();
-        cout << (*it) << endl;
+    for (uint i=0; i<_owners.size(); ++i) {
+        xct_t* victim = _owners[i].action()->xct();
+        cout << _owners[i] << endl;
         toabort.push_back(victim);
     }
     
@@ -135,8 +135,15 @@ w_rc_t part_table_t::reset()
     TRACE( TRACE_DEBUG, "Reseting (%s)...\n", _table->name());
     _next_prs_id = _start_prs_id;
 
+    bool numa = (envVar::instance()->getVarInt("numa-placement",0) == 1);
+    uint idx = 0;
     for (BPPMapIt it=_bppmap.begin(); it != _bppmap.end(); it++) {
-        (*it).second->reset(_next_prs_id);
+        if (numa) {
+            (*it).second->reset(numa_cpu(idx++));
+        }
+        else {
+            (*it).second->reset(_next_prs_id);
+        }
         _next_prs_id = next_cpu(_next_prs_id);
     }    
     return (RCOK);
@@ -188,7 +195,8 @@ w_rc_t part_table_t::move(const processorid_t aprs, const uint arange)
 processorid_t part_table_t::next_cpu(const processorid_t& aprd) 
 {
     int binding = envVar::instance()->getVarInt("dora-cpu-binding",0);
-    if (binding==0) {
+    int numa = envVar::instance()->getVarInt("numa-placement",0);
+    if ((binding==0) && (numa==0)) {
         return (PBIND_NONE);
     }
 
@@ -200,6 +208,36 @@ processorid_t part_table_t::next_cpu(const processorid_t& aprd)
 
 
 
+/****************************************************************** 
+ *
+ * @fn:    numa_cpu()
+ *
+ * @brief: The partition distribution function with NUMA placement
+ *
+ * @note:  The partitions are in key order. Consecutive partitions go
+ *         to the same node, so that the partitions of every table that
+ *         cover the same key range (e.g. a warehouse) end up on the 
+ *         same node, and an xct touching them stays on one socket.
+ *         Within a node the partitions take consecutive cpus, starting
+ *         from the starting cpu of the table.
+ *
+ ******************************************************************/
+
+processorid_t part_table_t::numa_cpu(const uint idx) const
+{
+    numa_topology_t* topo = numa_topology_t::instance();
+    uint nodes = topo->nodes();
+    uint cnt = _bppmap.size();
+    assert (idx < cnt);
+
+    uint node = (idx*nodes)/cnt;
+    uint first = (node*cnt + nodes - 1)/nodes; // first partition on node
+    uint offset = (_start_prs_id > 0 ? _start_prs_id : 0);
+    return (topo->cpu_of(node, offset + idx - first));
+}
+
+
+
 /****************************************************************** 
  *
  * Debugging
@@ -207,7 +245,8 @@ processorid_t part_table_t::next_cpu(const processorid_t& aprd)
  ******************************************************************/
 
 
-void part_table_t::statistics() const 
+void part_table_t::statistics(std::vector<worker_stats_t>* pernode,
+                              std::vector<uint>* pernode_parts) const 
 {
     TRACE( TRACE_STATISTICS, "Table (%s)\n", _table->name());
 
@@ -216,7 +255,16 @@ void part_table_t::statistics() const
 
     for (BPPMapCIt it=_bppmap.begin(); it != _bppmap.end(); it++) {
         // gather worker statistics
-        (*it).second->statistics(ws_gathered);
+        worker_stats_t ws;
+        (*it).second->statistics(ws);
+        ws_gathered += ws;
+
+        // and per node
+        int node = (*it).second->node();
+        if (pernode && (node >= 0) && (node < (int)pernode->size())) {
+            (*pernode)[node] += ws;
+            if (pernode_parts) ++(*pernode_parts)[node];
+        }
 
         // gather dora-related structures statistics
         (*it).second->stlsize(stl_sz);
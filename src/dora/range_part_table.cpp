@@ -51,7 +51,8 @@ range_table_t::range_table_t(ShoreEnv* env, table_desc_t* ptable, const uint dty
                              const processorid_t aprs,
                              const uint acpurange,
                              const uint keyEstimation) 
-    : part_table_t(env,ptable,aprs,acpurange,keyEstimation), _dtype(dtype)
+    : part_table_t(env,ptable,aprs,acpurange,keyEstimation), _dtype(dtype),
+      _proute(NULL), _pretired(NULL), _route_version(0)
 {
     _prMap = NULL;
 }
@@ -59,6 +60,8 @@ range_table_t::range_table_t(ShoreEnv* env, table_desc_t* ptable, const uint dty
 
 range_table_t::~range_table_t()
 {
+    if (_proute) delete (_proute);
+    if (_pretired) delete (_pretired);
 }
 
 
@@ -97,6 +100,9 @@ w_rc_t range_table_t::repartition()
     _prMap = drm;    
     assert (_prMap);
 
+    // The routing refers to the old partitions
+    _clear_route();
+
     // Save the old mapping to a temp map
     BasePartitionPtrMap tmpmap = _bppmap;
 
@@ -163,6 +169,17 @@ w_rc_t range_table_t::repartition()
                cnt, _table->name());
         cnt=0;
     }            
+
+    // Flatten the new ranges for the decide_part()
+    vector<int> lo;
+    vector<base_partition_t*> parts;
+    if (_probe_route(lo,parts)) {
+        _install_route(lo,parts);
+    }
+    else {
+        TRACE( TRACE_ALWAYS, "(%s) routed through the key map\n", 
+               _table->name());
+    }
     return (RCOK);
 }
 
@@ -198,6 +215,189 @@ w_rc_t range_table_t::_get_updated_map(dkey_ranges_map*& drm)
 }
 
 
+/****************************************************************** 
+ *
+ * @fn:    get_route()
+ *
+ * @brief: Returns the online routing, or the initial one if the 
+ *         repartitioner has not installed any yet
+ *
+ ******************************************************************/
+
+void range_table_t::get_route(vector<int>& lo, vector<base_partition_t*>& parts)
+{
+    CRITICAL_SECTION(ptcs, _lock);
+
+    lo.clear();
+    parts.clear();
+    if (_proute) {
+        _proute->get(lo,parts);
+        return;
+    }
+
+    // Split [min,max) in equal ranges, one per partition
+    int minKey = 0;
+    int maxKey = 0;
+    memcpy(&minKey,_table->getMinKey(),sizeof(int));
+    memcpy(&maxKey,_table->getMaxKey(),sizeof(int));
+    uint cnt = _bppmap.size();
+    if ((cnt==0) || (maxKey <= minKey)) return;
+
+    long long width = (long long)maxKey - minKey;
+    uint idx = 0;
+    for (BPPMapIt it=_bppmap.begin(); it != _bppmap.end(); ++it, ++idx) {
+        lo.push_back(minKey + (int)(width*idx/cnt));
+        parts.push_back((*it).second);
+    }
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:    set_route()
+ *
+ ******************************************************************/
+
+bool range_table_t::set_route(const vector<int>& lo, 
+                              const vector<base_partition_t*>& parts)
+{
+    assert (lo.size() == parts.size());
+    CRITICAL_SECTION(ptcs, _lock);
+
+    // The partitions may have changed since the get_route()
+    if (parts.size() != _bppmap.size()) return (false);
+    for (uint i=0; i<parts.size(); i++) {
+        bool found = false;
+        for (BPPMapIt it=_bppmap.begin(); it != _bppmap.end(); ++it) {
+            if ((*it).second == parts[i]) { found = true; break; }
+        }
+        if (!found) return (false);
+    }
+
+    _install_route(lo,parts);
+    return (true);
+}
+
+
+
+/****************************************************************** 
+ *
+ * @fn:    _probe()
+ *
+ * @brief: The partition of a key, according to the _prMap
+ *
+ ******************************************************************/
+
+base_partition_t* range_table_t::_probe(const int aid)
+{
+    int key = aid;
+    cvec_t cvkey((char*)&key,sizeof(int));
+    lpid_t pid;
+    if (_prMap->get_partition(cvkey,pid).is_error()) return (NULL);
+    BPPMapIt it = _bppmap.find(pid.page);
+    return ((it != _bppmap.end()) ? (*it).second : NULL);
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:    _probe_route()
+ *
+ * @brief: Reads the ranges of the _prMap, by bisecting the key domain
+ *         for the key where the partition changes
+ *
+ * @return: false if the ranges could not be read, or if a partition
+ *          does not own a single range of the domain
+ *
+ * @note:  The keys are ordered in the _prMap the way the integers are
+ *         (the map unscrambles them). It takes (partitions) x log(domain)
+ *         probes, once per repartition().
+ *
+ ******************************************************************/
+
+bool range_table_t::_probe_route(vector<int>& lo, vector<base_partition_t*>& parts)
+{
+    lo.clear();
+    parts.clear();
+    if (!_prMap) return (false);
+
+    int minKey = 0;
+    int maxKey = 0;
+    memcpy(&minKey,_table->getMinKey(),sizeof(int));
+    memcpy(&maxKey,_table->getMaxKey(),sizeof(int));
+    if (maxKey <= minKey) return (false);
+
+    int key = minKey;
+    base_partition_t* part = _probe(key);
+    base_partition_t* last = _probe(maxKey);
+    if (!part || !last) return (false);
+
+    while (true) {
+        for (uint i=0; i<parts.size(); i++) {
+            if (parts[i] == part) return (false);
+        }
+        lo.push_back(key);
+        parts.push_back(part);
+        if (part == last) break;
+
+        // (a) is in the range of (part), (b) is not
+        long long a = key;
+        long long b = maxKey;
+        while (b - a > 1) {
+            long long mid = a + (b - a)/2;
+            base_partition_t* p = _probe((int)mid);
+            if (!p) return (false);
+            if (p == part) a = mid;
+            else b = mid;
+        }
+        key = (int)b;
+        part = _probe(key);
+        if (!part) return (false);
+    }
+    return (true);
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:    _install_route(), _clear_route()
+ *
+ * @brief: Swap the routing read by the decide_part(). The one replaced
+ *         is freed at the next swap.
+ *
+ ******************************************************************/
+
+void range_table_t::_install_route(const vector<int>& lo, 
+                                   const vector<base_partition_t*>& parts)
+{
+    int minKey = 0;
+    int maxKey = 0;
+    memcpy(&minKey,_table->getMinKey(),sizeof(int));
+    memcpy(&maxKey,_table->getMaxKey(),sizeof(int));
+
+    route_table_t* aroute = new route_table_t(lo,parts,minKey,maxKey,
+                                              ++_route_version);
+    membar_producer();
+
+    if (_pretired) delete (_pretired);
+    _pretired = _proute;
+    _proute = aroute;
+
+    TRACE( TRACE_DEBUG, "(%s) routing (%d) with (%d) ranges%s\n",
+           _table->name(), aroute->version(), aroute->size(),
+           (aroute->is_direct() ? ", direct-mapped" : ""));
+}
+
+
+void range_table_t::_clear_route()
+{
+    if (_pretired) delete (_pretired);
+    _pretired = _proute;
+    _proute = NULL;
+}
+
+
+
 /****************************************************************** 
  *
  * @fn:    create_one_part()
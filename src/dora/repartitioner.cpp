@@ -0,0 +1,360 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   repartitioner.cpp
+ *
+ *  @brief:  Implementation of the dora-repartitioner
+ */
+
+#include "dora/repartitioner.h"
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(dora);
+
+
+/******************************************************************
+ *
+ * Construction
+ *
+ ******************************************************************/
+
+dora_repartitioner_t::dora_repartitioner_t(DoraEnv* denv)
+    : thread_t(c_str("DRepart")), _denv(denv), _stop(false),
+      _migrations(0), _splits(0), _shifts(0), _timeouts(0), 
+      _drain_us(0), _max_drain_us(0)
+{
+    assert (_denv);
+    envVar* ev = envVar::instance();
+    _interval_ms = ev->getVarInt("dora-repartition-interval",1000);
+    _imbalance = ev->getVarInt("dora-repartition-imbalance",200);
+    _drain_ms = ev->getVarInt("dora-repartition-drain",2000);
+    _min_load = ev->getVarInt("dora-repartition-min-load",1000);
+    if (_interval_ms < 1) _interval_ms = 1;
+    if (_imbalance < 100) _imbalance = 100;
+
+    pthread_mutex_init(&_lock, NULL);
+    pthread_cond_init(&_cond, NULL);
+}
+
+dora_repartitioner_t::~dora_repartitioner_t()
+{
+    pthread_mutex_destroy(&_lock);
+    pthread_cond_destroy(&_cond);
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:    work()
+ *
+ * @brief: Every interval looks at all the tables
+ *
+ ******************************************************************/
+
+void dora_repartitioner_t::work()
+{
+    TRACE( TRACE_ALWAYS, "Every (%d) msecs, imbalance (%d%%)\n",
+           _interval_ms, _imbalance);
+
+    pthread_mutex_lock(&_lock);
+    while (!*&_stop) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        static long const BILLION = 1000*1000*1000;
+        long long nsec = ts.tv_nsec + (long long)_interval_ms*1000*1000;
+        ts.tv_sec += nsec / BILLION;
+        ts.tv_nsec = nsec % BILLION;
+        pthread_cond_timedwait(&_cond, &_lock, &ts);
+        if (*&_stop) break;
+
+        pthread_mutex_unlock(&_lock);
+        _tick();
+        pthread_mutex_lock(&_lock);
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+
+void dora_repartitioner_t::stop()
+{
+    pthread_mutex_lock(&_lock);
+    _stop = true;
+    pthread_cond_signal(&_cond);
+    pthread_mutex_unlock(&_lock);
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:    _tick()
+ *
+ * @brief: Plans a move for every table that needs one, and does them
+ *         all with a single drain
+ *
+ ******************************************************************/
+
+void dora_repartitioner_t::_tick()
+{
+    DoraEnv::irpTablePtrVector& tables = _denv->tables();
+    std::vector<move_t> moves;
+    for (uint i=0; i<tables.size(); i++) {
+        if (!tables[i]) continue;
+        move_t move;
+        move._table = tables[i];
+        if (_plan(tables[i], move)) moves.push_back(move);
+    }
+    if (!moves.empty()) _migrate(moves);
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:    _sample()
+ *
+ * @brief: The load of a partition in the last interval is the actions
+ *         it received plus those it has not served yet
+ *
+ * @note:  The stats command resets the stats of the workers, so the
+ *         served actions are accumulated here. A partition that did
+ *         nothing in the interval is taken to have an empty queue.
+ *
+ ******************************************************************/
+
+void dora_repartitioner_t::_sample(const std::vector<base_partition_t*>& parts,
+                                   std::vector<uint_t>& loads)
+{
+    loads.assign(parts.size(),0);
+    for (uint i=0; i<parts.size(); i++) {
+        base_partition_t* part = parts[i];
+        worker_stats_t stats;
+        part->peek_stats(stats);
+        uint served = stats._served_input + stats._served_waiting;
+        uint_t enqueued = part->enqueued();
+
+        std::map<base_partition_t*,sample_t>::iterator it = _samples.find(part);
+        if (it == _samples.end()) {
+            sample_t& s = _samples[part];
+            s._enqueued = s._enqueued_0 = enqueued;
+            s._served = served;
+            continue;
+        }
+
+        sample_t& s = (*it).second;
+        uint_t received = enqueued - s._enqueued;
+        uint done = (served >= s._served ? served - s._served : served);
+        s._enqueued = enqueued;
+        s._served = served;
+        s._served_sum += done;
+
+        if ((received == 0) && (done == 0)) {
+            s._enqueued_0 = enqueued;
+            s._served_sum = 0;
+        }
+        uint_t total = enqueued - s._enqueued_0;
+        uint_t queued = (total > s._served_sum ? total - s._served_sum : 0);
+        loads[i] = received + queued;
+    }
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:    _plan()
+ *
+ * @brief: Splits the range of the hot partition in two. The upper half
+ *         goes to a partition freed by merging the two least loaded
+ *         neighbouring ranges, or else the half next to the least
+ *         loaded neighbour goes to it.
+ *
+ * @note:  Without knowing how the load is spread within the range, the
+ *         split is in the middle. If the hot keys are all in one half,
+ *         a later interval splits that half again.
+ *
+ ******************************************************************/
+
+bool dora_repartitioner_t::_plan(range_table_t* table, move_t& move)
+{
+    std::vector<int>& lo = move._lo;
+    std::vector<base_partition_t*>& parts = move._parts;
+    table->get_route(lo,parts);
+    uint n = parts.size();
+    if (n < 2) return (false);
+
+    std::vector<uint_t> loads;
+    _sample(parts,loads);
+
+    uint h = 0;
+    unsigned long long total = 0;
+    for (uint i=0; i<n; i++) {
+        total += loads[i];
+        if (loads[i] > loads[h]) h = i;
+    }
+    uint_t hot = loads[h];
+    if ((hot < _min_load) ||
+        ((unsigned long long)hot*100*n < (unsigned long long)_imbalance*total)) {
+        return (false);
+    }
+
+    // The range of the hot partition, the last one ends at the max key
+    int maxKey = 0;
+    memcpy(&maxKey,table->table()->getMaxKey(),sizeof(int));
+    long long hi = ((h+1 < n) ? lo[h+1] : maxKey);
+    if (hi - lo[h] < 2) return (false);
+    int mid = lo[h] + (int)((hi - lo[h])/2);
+
+    // split/merge: the coolest pair of neighbours that excludes the hot
+    int best = -1;
+    for (uint j=0; j+1<n; j++) {
+        if ((j == h) || (j+1 == h)) continue;
+        if ((best < 0) ||
+            (loads[j] + loads[j+1] < loads[best] + loads[best+1])) {
+            best = j;
+        }
+    }
+    if ((best >= 0) && (2*(loads[best] + loads[best+1]) <= hot)) {
+        TRACE( TRACE_STATISTICS,
+               "(%s) split (%d) at (%d), merged (%d) to (%d)\n",
+               table->table()->name(), parts[h]->part_id(), mid,
+               parts[best+1]->part_id(), parts[best]->part_id());
+
+        base_partition_t* freed = parts[best+1];
+        lo.erase(lo.begin()+best+1);
+        parts.erase(parts.begin()+best+1);
+        uint nh = ((uint)best+1 < h ? h-1 : h);
+        lo.insert(lo.begin()+nh+1, mid);
+        parts.insert(parts.begin()+nh+1, freed);
+        move._split = true;
+        return (true);
+    }
+
+    // shift: to the least loaded neighbour
+    uint c = h;
+    if (h > 0) c = h-1;
+    if ((h+1 < n) && ((c == h) || (loads[h+1] < loads[c]))) c = h+1;
+    if (2*loads[c] >= hot) return (false);
+
+    TRACE( TRACE_STATISTICS, "(%s) moved half of (%d) to (%d) at (%d)\n",
+           table->table()->name(), parts[h]->part_id(),
+           parts[c]->part_id(), mid);
+
+    if (c == h+1) lo[h+1] = mid;
+    else lo[h] = mid;
+    move._split = false;
+    return (true);
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:    _migrate()
+ *
+ * @brief: Closes the admission, waits for the xcts in flight to finish
+ *         and for the partitions of the tables to release their locks,
+ *         installs the new routings and opens the admission
+ *
+ * @note:  Once no xct is in flight the queues of the partitions are
+ *         empty. Then every key can move to any partition, since no
+ *         partition holds any lock.
+ *
+ * @note:  If the drain takes too long (an xct waits for something) the
+ *         move is given up, and the admission opens as it was.
+ *
+ ******************************************************************/
+
+bool dora_repartitioner_t::_migrate(std::vector<move_t>& moves)
+{
+    stopwatch_t timer;
+    long long start = timer.now();
+    long long waited = 0;
+    bool drained = false;
+
+    _denv->close_admission();
+    while (true) {
+        drained = (_denv->in_flight() == 0);
+        for (uint i=0; drained && (i<moves.size()); i++) {
+            for (uint j=0; drained && (j<moves[i]._parts.size()); j++) {
+                if (moves[i]._parts[j]->unreleased() > 0) drained = false;
+            }
+        }
+        waited = timer.now() - start;
+        if (drained || *&_stop || (waited > (long long)_drain_ms*1000)) break;
+        usleep(50);
+    }
+
+    if (drained) {
+        for (uint i=0; i<moves.size(); i++) {
+            if (!moves[i]._table->set_route(moves[i]._lo, moves[i]._parts)) {
+                TRACE( TRACE_ALWAYS, "(%s) was repartitioned meanwhile\n",
+                       moves[i]._table->table()->name());
+            }
+        }
+    }
+    _denv->open_admission();
+
+    if (!drained) {
+        ++_timeouts;
+        TRACE( TRACE_ALWAYS, "Gave up moving ranges after (%lld) usecs\n",
+               waited);
+        return (false);
+    }
+
+    ++_migrations;
+    _drain_us += waited;
+    if (waited > _max_drain_us) _max_drain_us = waited;
+    for (uint i=0; i<moves.size(); i++) {
+        if (moves[i]._split) ++_splits;
+        else ++_shifts;
+    }
+    TRACE( TRACE_STATISTICS, "Moved ranges of (%d) tables in (%lld) usecs\n",
+           moves.size(), waited);
+    return (true);
+}
+
+
+
+/******************************************************************
+ *
+ * @fn:    print_stats()
+ *
+ ******************************************************************/
+
+void dora_repartitioner_t::print_stats() const
+{
+    TRACE( TRACE_STATISTICS, 
+           "Repartitioner: splits (%d) shifts (%d) drains (%d) gave up (%d)\n",
+           _splits, _shifts, _migrations, _timeouts);
+    if (_migrations) {
+        TRACE( TRACE_STATISTICS, "Drain avg (%.1f) max (%.1f) msecs\n",
+               _drain_us/1000./_migrations, _max_drain_us/1000.);
+    }
+}
+
+
+EXIT_NAMESPACE(dora);
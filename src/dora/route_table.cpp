@@ -0,0 +1,96 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   route_table.cpp
+ *
+ *  @brief:  Flat routing of integer keys to the partitions of a range
+ *           partitioned table in DORA
+ */
+
+#include <climits>
+
+#include "dora/route_table.h"
+
+
+ENTER_NAMESPACE(dora);
+
+
+/******************************************************************
+ *
+ * @fn:    constructor
+ *
+ * @brief: Packs the bounds and the partitions, and fills the direct-
+ *         mapped table if the domain is at most DIRECT_MAX keys
+ *
+ ******************************************************************/
+
+route_table_t::route_table_t(const std::vector<int>& lo,
+                             const std::vector<base_partition_t*>& parts,
+                             const int minKey, const int maxKey,
+                             const uint version)
+    : _buf(NULL), _lo(NULL), _part(NULL), _cnt(lo.size()), _slots(1),
+      _direct(NULL), _dmin(minKey), _dspan(0), _version(version)
+{
+    assert (_cnt > 0);
+    assert (lo.size() == parts.size());
+    while (_slots < _cnt) _slots <<= 1;
+
+    // The partitions first, so that both arrays are aligned
+    _buf = new char[_slots*(sizeof(base_partition_t*) + sizeof(int))];
+    _part = (base_partition_t**)_buf;
+    _lo = (int*)(_buf + _slots*sizeof(base_partition_t*));
+    for (uint i=0; i<_slots; i++) {
+        _lo[i] = ((i < _cnt) ? lo[i] : INT_MAX);
+        _part[i] = ((i < _cnt) ? parts[i] : parts[_cnt-1]);
+    }
+
+    long long span = (long long)maxKey - minKey;
+    if ((span > 0) && (span <= (long long)DIRECT_MAX)) {
+        _dspan = (uint)span;
+        _direct = new unsigned short[_dspan];
+        uint r = 0;
+        for (uint off=0; off<_dspan; off++) {
+            int key = minKey + (int)off;
+            while ((r+1 < _cnt) && (_lo[r+1] <= key)) ++r;
+            _direct[off] = (unsigned short)r;
+        }
+    }
+}
+
+
+route_table_t::~route_table_t()
+{
+    if (_direct) delete [] _direct;
+    if (_buf) delete [] _buf;
+}
+
+
+void route_table_t::get(std::vector<int>& lo,
+                        std::vector<base_partition_t*>& parts) const
+{
+    lo.assign(_lo, _lo + _cnt);
+    parts.assign(_part, _part + _cnt);
+}
+
+
+EXIT_NAMESPACE(dora);
@@ -153,7 +153,7 @@ w_rc_t rvp_t::run()
  ********************************************************************/
 
 terminal_rvp_t::terminal_rvp_t() 
-    : rvp_t(), _db(NULL), _denv(NULL)
+    : rvp_t(), _db(NULL), _denv(NULL), _released(false)
 { 
 }
 
@@ -176,6 +176,7 @@ terminal_rvp_t::terminal_rvp_t(const terminal_rvp_t& rhs)
 { 
     _db = rhs._db;
     _denv = rhs._denv;
+    _released = rhs._released;
 }
 
 terminal_rvp_t& terminal_rvp_t::operator=(const terminal_rvp_t& rhs)
@@ -183,6 +184,7 @@ terminal_rvp_t& terminal_rvp_t::operator=(const terminal_rvp_t& rhs)
     rvp_t::operator=(rhs);
     _db = rhs._db;
     _denv = rhs._denv;
+    _released = rhs._released;
     return (*this);
 }
 
@@ -197,6 +199,9 @@ terminal_rvp_t::~terminal_rvp_t()
  *
  * @brief: Notifies for any committed actions
  *
+ * @note:  It is called once per xct, when the xct is over for the 
+ *         repartitioner as well
+ *
  ******************************************************************/
 
 int terminal_rvp_t::notify_partitions()
@@ -206,6 +211,7 @@ int terminal_rvp_t::notify_partitions()
     for (baseActionsIt it=_actions.begin(); it!=_actions.end(); ++it) {
         (*it)->notify_own_partition();
     }
+    _denv->xct_done();
     return (_actions.size());
 }
 
@@ -261,6 +267,7 @@ w_rc_t terminal_rvp_t::_run()
             TRACE( TRACE_TRX_FLOW, "Xct (%d) aborted\n", _tid.get_lo());
             upd_aborted_stats();
         }
+        _result.set_state(ROLLBACKED);
 
 #ifdef CFG_FLUSHER
         notify_on_abort();
@@ -281,6 +288,7 @@ w_rc_t terminal_rvp_t::_run()
             TRACE( TRACE_ALWAYS, "Xct (%d) commit failed [0x%x]\n",
                    _tid.get_lo(), rcdec.err_num());
             upd_aborted_stats();
+            _result.set_state(ROLLBACKED);
             w_rc_t eabort = _db->abort_xct();
 
             if (eabort.is_error()) {
@@ -294,7 +302,18 @@ w_rc_t terminal_rvp_t::_run()
         }
         else {
 #ifdef CFG_FLUSHER
-            // DF2. Enqueue to the "to flush" queue of DFlusher             
+            // DF2. With ELR, the partitions release the locks of the xct
+            // now that its commit has an lsn. It still waits to be durable,
+            // and after any earlier early released xct it may depend on, 
+            // before the client is notified.
+            bool release = _denv->is_elr();
+            set_last_lsn(_denv->elr_lsn(xctLastLsn,release));
+            if (release) {
+                notify_partitions();
+                _released = true;
+            }
+
+            // DF3. Enqueue to the "to flush" queue of DFlusher             
             _denv->enqueue_toflush(this);
 #else
             (void)_denv;
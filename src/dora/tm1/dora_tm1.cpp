@@ -163,6 +163,94 @@ w_rc_t DoraTM1Env::update_partitioning()
 
 
 
+/******************************************************************** 
+ *
+ *  @fn:    submit_xct()
+ *
+ *  @brief: Submits one DORA TM1 xct, with (spec_id) the subscriber.
+ *          Used by the DORA TM1 clients and the xct server.
+ *
+ *  @note:  The mixes always wake up the partitions
+ *
+ ********************************************************************/
+
+w_rc_t DoraTM1Env::submit_xct(const int xct_type, const int xct_id,
+                              const int spec_id, trx_result_tuple_t& atrt,
+                              const uint /* worker_hint */, const bool bWake)
+{
+    // if DORA TM1 MIX
+    int xcttype = xct_type;
+    bool wake = bWake;
+    if (xcttype == XCT_TM1_DORA_MIX) {        
+        xcttype = XCT_TM1_DORA_MIX + random_tm1_xct_type(smthread_t::rand()%100);
+	if(xcttype == XCT_TM1_DORA_UPD_SUB_DATA) {
+	    xcttype = XCT_TM1_DORA_UPD_SUB_DATA_MIX;
+	}
+        wake = true;
+    }
+    atrt.stamp(xcttype);
+
+    // Waits while the repartitioner migrates key ranges
+    admit();
+    w_rc_t r = RCOK;
+
+    switch (xcttype) {
+
+        // TM1 DORA
+    case XCT_TM1_DORA_GET_SUB_DATA:
+        r = dora_get_sub_data(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_TM1_DORA_GET_NEW_DEST:
+        r = dora_get_new_dest(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_TM1_DORA_GET_ACC_DATA:
+        r = dora_get_acc_data(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_TM1_DORA_UPD_SUB_DATA:
+        r = dora_upd_sub_data(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_TM1_DORA_UPD_LOCATION:
+        r = dora_upd_loc(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_TM1_DORA_INS_CALL_FWD:
+        r = dora_ins_call_fwd(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_TM1_DORA_DEL_CALL_FWD:
+        r = dora_del_call_fwd(xct_id,atrt,spec_id,wake);
+        break;
+
+        // Mix
+    case XCT_TM1_DORA_CALL_FWD_MIX:
+        // evenly pick one of the {Ins/Del}CallFwd
+        if (URand(1,100)>50)
+            r = dora_ins_call_fwd(xct_id,atrt,spec_id,true);
+        else
+            r = dora_del_call_fwd(xct_id,atrt,spec_id,true);
+        break;
+
+    case XCT_TM1_DORA_GET_SUB_NBR:
+        r = dora_get_sub_nbr(xct_id,atrt,spec_id,wake);
+        break;
+
+    case XCT_TM1_DORA_INS_CALL_FWD_BENCH:
+        r = dora_ins_call_fwd_bench(xct_id,atrt,spec_id,true);
+        break;
+
+    case XCT_TM1_DORA_UPD_SUB_DATA_MIX:
+	r = dora_upd_sub_data_mix(xct_id,atrt,spec_id,wake);
+	break;
+
+    default:
+        assert (0); // UNKNOWN TRX-ID
+    }
+
+    // Nothing was enqueued, the xct will not reach a terminal rvp
+    if (r.is_error()) xct_done();
+    return (r);
+}
+
+
+
 /****************************************************************** 
  *
  * @fn:    stop()
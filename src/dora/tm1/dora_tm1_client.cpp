@@ -34,27 +34,6 @@
 ENTER_NAMESPACE(dora);
 
 
-// Look also at include/workload/tm1/tm1_const.h
-// @note: The DORA_XXX should be (DORA_MIX + REGULAR_TRX_ID)
-const int XCT_TM1_DORA_MIX           = 200;
-const int XCT_TM1_DORA_GET_SUB_DATA  = 221;
-const int XCT_TM1_DORA_GET_NEW_DEST  = 222;
-const int XCT_TM1_DORA_GET_ACC_DATA  = 223;
-const int XCT_TM1_DORA_UPD_SUB_DATA  = 224;
-const int XCT_TM1_DORA_UPD_LOCATION  = 225;
-const int XCT_TM1_DORA_CALL_FWD_MIX  = 226;
-
-const int XCT_TM1_DORA_INS_CALL_FWD  = 227;
-const int XCT_TM1_DORA_DEL_CALL_FWD  = 228;
-
-const int XCT_TM1_DORA_GET_SUB_NBR   = 229;
-
-const int XCT_TM1_DORA_CALL_FWD_MIX_BENCH  = 230;
-const int XCT_TM1_DORA_INS_CALL_FWD_BENCH  = 231;
-const int XCT_TM1_DORA_DEL_CALL_FWD_BENCH  = 232;
-
-const int XCT_TM1_DORA_UPD_SUB_DATA_MIX  = 234;
-
 /********************************************************************* 
  *
  *  dora_tm1_client_t
@@ -103,15 +82,7 @@ int dora_tm1_client_t::load_sup_xct(mapSupTrxs& stmap)
  
 w_rc_t dora_tm1_client_t::submit_one(int xct_type, int xctid) 
 {
-    // if DORA TM1 MIX
     bool bWake = false;
-    if (xct_type == XCT_TM1_DORA_MIX) {        
-        xct_type = XCT_TM1_DORA_MIX + random_tm1_xct_type(rand(100));
-	if(xct_type == XCT_TM1_DORA_UPD_SUB_DATA) {
-	    xct_type = XCT_TM1_DORA_UPD_SUB_DATA_MIX;
-	}
-        bWake = true;
-    }
 
     // pick a valid sf
     int selsf = _selid;
@@ -130,46 +101,8 @@ w_rc_t dora_tm1_client_t::submit_one(int xct_type, int xctid)
         atrt.set_notify(c);
         bWake = true;
     }
-    
-    switch (xct_type) {
-
-        // TM1 DORA
-    case XCT_TM1_DORA_GET_SUB_DATA:
-        return (_tm1db->dora_get_sub_data(xctid,atrt,selid,bWake));
-    case XCT_TM1_DORA_GET_NEW_DEST:
-        return (_tm1db->dora_get_new_dest(xctid,atrt,selid,bWake));
-    case XCT_TM1_DORA_GET_ACC_DATA:
-        return (_tm1db->dora_get_acc_data(xctid,atrt,selid,bWake));
-    case XCT_TM1_DORA_UPD_SUB_DATA:
-        return (_tm1db->dora_upd_sub_data(xctid,atrt,selid,bWake));
-    case XCT_TM1_DORA_UPD_LOCATION:
-        return (_tm1db->dora_upd_loc(xctid,atrt,selid,bWake));
-    case XCT_TM1_DORA_INS_CALL_FWD:
-        return (_tm1db->dora_ins_call_fwd(xctid,atrt,selid,bWake));
-    case XCT_TM1_DORA_DEL_CALL_FWD:
-        return (_tm1db->dora_del_call_fwd(xctid,atrt,selid,bWake));
-
-        // Mix
-    case XCT_TM1_DORA_CALL_FWD_MIX:
-        // evenly pick one of the {Ins/Del}CallFwd
-        if (URand(1,100)>50)
-            return (_tm1db->dora_ins_call_fwd(xctid,atrt,selid,true)); // always wake in the mix
-        else
-            return (_tm1db->dora_del_call_fwd(xctid,atrt,selid,true));
-
-    case XCT_TM1_DORA_GET_SUB_NBR:
-        return (_tm1db->dora_get_sub_nbr(xctid,atrt,selid,bWake));
-
-    case XCT_TM1_DORA_INS_CALL_FWD_BENCH:
-        return (_tm1db->dora_ins_call_fwd_bench(xctid,atrt,selid,true));
-
-    case XCT_TM1_DORA_UPD_SUB_DATA_MIX:
-	return (_tm1db->dora_upd_sub_data_mix(xctid,atrt,selid,bWake));
-
-    default:
-        assert (0); // UNKNOWN TRX-ID
-    }
-    return (RCOK);
+
+    return (_tm1db->submit_xct(xct_type,xctid,selid,atrt,_id,bWake));
 }
 
 
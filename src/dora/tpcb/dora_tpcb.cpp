@@ -173,6 +173,43 @@ w_rc_t DoraTPCBEnv::update_partitioning()
 
 
 
+/******************************************************************** 
+ *
+ *  @fn:    submit_xct()
+ *
+ *  @brief: Submits one DORA TPC-B xct, with (spec_id) the branch.
+ *          Used by the DORA TPC-B clients and the xct server.
+ *
+ ********************************************************************/
+
+w_rc_t DoraTPCBEnv::submit_xct(const int xct_type, const int xct_id,
+                               const int spec_id, trx_result_tuple_t& atrt,
+                               const uint /* worker_hint */, const bool bWake)
+{
+    atrt.stamp(xct_type);
+
+    // Waits while the repartitioner migrates key ranges
+    admit();
+    w_rc_t r = RCOK;
+
+    switch (xct_type) {
+
+        // TPCB DORA
+    case XCT_TPCB_DORA_ACCT_UPDATE:
+        r = dora_acct_update(xct_id,atrt,spec_id,bWake);
+        break;
+
+    default:
+        assert (0); // UNKNOWN TRX-ID
+    }
+
+    // Nothing was enqueued, the xct will not reach a terminal rvp
+    if (r.is_error()) xct_done();
+    return (r);
+}
+
+
+
 
 
 /****************************************************************** 
@@ -34,11 +34,6 @@
 ENTER_NAMESPACE(dora);
 
 
-// Look also at include/workload/tpcb/tpcb_const.h
-const int XCT_TPCB_DORA_ACCT_UPDATE   = 331;
-
-
-
 /********************************************************************* 
  *
  *  dora_tpcb_client_t
@@ -69,7 +64,6 @@ int dora_tpcb_client_t::load_sup_xct(mapSupTrxs& stmap)
  
 w_rc_t dora_tpcb_client_t::submit_one(int xct_type, int xctid) 
 {
-    // if DORA TPCB MIX
     bool bWake = false;
 
     // Pick a valid sf
@@ -83,17 +77,8 @@ w_rc_t dora_tpcb_client_t::submit_one(int xct_type, int xctid)
         atrt.set_notify(c);
         bWake = true;
     }
-    
-    switch (xct_type) {
 
-        // TPCB DORA
-    case XCT_TPCB_DORA_ACCT_UPDATE:
-        return (_tpcbdb->dora_acct_update(xctid,atrt,selid,bWake));
-
-    default:
-        assert (0); // UNKNOWN TRX-ID
-    }
-    return (RCOK);
+    return (_tpcbdb->submit_xct(xct_type,xctid,selid,atrt,_id,bWake));
 }
 
 
@@ -220,6 +220,80 @@ w_rc_t DoraTPCCEnv::update_partitioning()
 
 
 
+/******************************************************************** 
+ *
+ *  @fn:    submit_xct()
+ *
+ *  @brief: Submits one DORA TPC-C xct, with (spec_id) the warehouse.
+ *          Used by the DORA TPC-C clients and the xct server.
+ *
+ *  @note:  The mixes always wake up the partitions
+ *
+ ********************************************************************/
+
+w_rc_t DoraTPCCEnv::submit_xct(const int xct_type, const int xct_id,
+                               const int spec_id, trx_result_tuple_t& atrt,
+                               const uint /* worker_hint */, const bool bWake)
+{
+    // if DORA TPC-C MIX
+    int xcttype = xct_type;
+    bool wake = bWake;
+    if (xcttype == XCT_DORA_MIX) {        
+        xcttype = XCT_DORA_MIX + random_xct_type(smthread_t::rand()%100);
+        wake = true;
+    }
+    atrt.stamp(xcttype);
+    
+    // Waits while the repartitioner migrates key ranges
+    admit();
+    w_rc_t r = RCOK;
+
+    switch (xcttype) {
+
+        // TPC-C DORA
+    case XCT_DORA_NEW_ORDER:
+        r = dora_new_order(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_DORA_PAYMENT:
+        r = dora_payment(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_DORA_ORDER_STATUS:
+        r = dora_order_status(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_DORA_DELIVERY:
+        r = dora_delivery(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_DORA_STOCK_LEVEL:
+        r = dora_stock_level(xct_id,atrt,spec_id,wake);
+        break;
+
+        // Little Mix (NewOrder/Payment 50%-50%)
+    case XCT_DORA_LITTLE_MIX:
+        if (URand(1,100)>50)
+            r = dora_new_order(xct_id,atrt,spec_id,true);
+        else
+            r = dora_payment(xct_id,atrt,spec_id,true);
+        break;
+
+        // MBENCH DORA
+    case XCT_DORA_MBENCH_WH:
+        r = dora_mbench_wh(xct_id,atrt,spec_id,wake);
+        break;
+    case XCT_DORA_MBENCH_CUST:
+        r = dora_mbench_cust(xct_id,atrt,spec_id,wake);
+        break;
+
+    default:
+        assert (0); // UNKNOWN TRX-ID
+    }
+
+    // Nothing was enqueued, the xct will not reach a terminal rvp
+    if (r.is_error()) xct_done();
+    return (r);
+}
+
+
+
 /****************************************************************** 
  *
  * @fn:    stop()
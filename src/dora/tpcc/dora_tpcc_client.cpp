@@ -33,20 +33,6 @@
 
 ENTER_NAMESPACE(dora);
 
-// Look also at include/workload/tpcc/tpcc_const.h
-const int XCT_DORA_MIX           = 100;
-const int XCT_DORA_NEW_ORDER     = 101;
-const int XCT_DORA_PAYMENT       = 102;
-const int XCT_DORA_ORDER_STATUS  = 103;
-const int XCT_DORA_DELIVERY      = 104;
-const int XCT_DORA_STOCK_LEVEL   = 105;
-
-const int XCT_DORA_LITTLE_MIX    = 109;
-
-const int XCT_DORA_MBENCH_WH   = 111;
-const int XCT_DORA_MBENCH_CUST = 112;
-
-
 /********************************************************************* 
  *
  *  dora_tpcc_client_t
@@ -89,12 +75,7 @@ int dora_tpcc_client_t::load_sup_xct(mapSupTrxs& stmap)
  
 w_rc_t dora_tpcc_client_t::submit_one(int xct_type, int xctid) 
 {
-    // if DORA TPC-C MIX
     bool bWake = false;
-    if (xct_type == XCT_DORA_MIX) {        
-        xct_type = XCT_DORA_MIX + random_xct_type(rand(100));
-        bWake = true;
-    }
 
     // pick a valid wh id
     int whid = _wh;
@@ -108,38 +89,8 @@ w_rc_t dora_tpcc_client_t::submit_one(int xct_type, int xctid)
         atrt.set_notify(c);
         bWake = true;
     }
-    
-    switch (xct_type) {
-
-        // TPC-C DORA
-    case XCT_DORA_NEW_ORDER:
-        return (_tpccdb->dora_new_order(xctid,atrt,whid,bWake));
-    case XCT_DORA_PAYMENT:
-        return (_tpccdb->dora_payment(xctid,atrt,whid,bWake));
-    case XCT_DORA_ORDER_STATUS:
-        return (_tpccdb->dora_order_status(xctid,atrt,whid,bWake));
-    case XCT_DORA_DELIVERY:
-        return (_tpccdb->dora_delivery(xctid,atrt,whid,bWake));
-    case XCT_DORA_STOCK_LEVEL:
-        return (_tpccdb->dora_stock_level(xctid,atrt,whid,bWake));
-
-        // Little Mix (NewOrder/Payment 50%-50%)
-    case XCT_DORA_LITTLE_MIX:
-        if (URand(1,100)>50)
-            return (_tpccdb->dora_new_order(xctid,atrt,whid,true));
-        else
-            return (_tpccdb->dora_payment(xctid,atrt,whid,true));
-
-        // MBENCH DORA
-    case XCT_DORA_MBENCH_WH:
-        return (_tpccdb->dora_mbench_wh(xctid,atrt,whid,bWake));
-    case XCT_DORA_MBENCH_CUST:
-        return (_tpccdb->dora_mbench_cust(xctid,atrt,whid,bWake));
-
-    default:
-        assert (0); // UNKNOWN TRX-ID
-    }
-    return (RCOK);
+
+    return (_tpccdb->submit_xct(xct_type,xctid,whid,atrt,_id,bWake));
 }
 
 EXIT_NAMESPACE(dora);
@@ -142,6 +142,7 @@ int dora_worker_t::_work_ACTIVE_impl()
             // 2c. the action has done its cycle, and can be deleted
             apa->giveback();
             apa = NULL;
+            _partition->released();
 
             // 2d. serve any ready to execute actions 
             //     (those actions became ready due to apa's lock releases)
@@ -0,0 +1,52 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+#include "qpipe/core/functors.h"
+#include "qpipe/core/tuple_fifo.h"
+
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+void tuple_filter_t::select_batch(page &p, selection_t &sel) {
+    sel.clear();
+    size_t count = p.tuple_count();
+    for(size_t i=0; i < count; i++) {
+        if(select(p.get_tuple(i)))
+            sel.push_back(i);
+    }
+}
+
+
+void tuple_filter_t::project_batch(tuple_fifo* out, page &p,
+                                   const selection_t &sel)
+{
+    for(size_t i=0; i < sel.size(); i++) {
+        tuple_t out_tup = out->allocate();
+        project(out_tup, p.get_tuple(sel[i]));
+    }
+}
+
+
+EXIT_NAMESPACE(qpipe);
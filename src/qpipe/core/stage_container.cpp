@@ -159,6 +159,42 @@ void stage_container_t::container_queue_enqueue_no_merge(packet_t* packet)
 
 
 
+/**
+ *  @brief Helper function used to merge a list of unfinished circular
+ *  packets (see packet_t::is_circular) into a compatible list in the
+ *  _container_queue, instead of starting one more pass over the same
+ *  input. The packets only need the input up to their
+ *  _next_tuple_needed, which any pass from the beginning produces.
+ *
+ *  @return true if the packets were merged. The list is deleted.
+ *
+ *  THE CALLER MUST BE HOLDING THE _container_lock MUTEX.
+ */
+bool stage_container_t::container_queue_merge_circular(packet_list_t* packets) 
+{
+    packet_t* packet = packets->front();
+    if (!packet->is_circular() || !packet->is_merge_enabled())
+        return false;
+
+    ContainerQueue::iterator cit = _container_queue.begin();
+    for ( ; cit != _container_queue.end(); ++cit) {
+        packet_list_t* cq_plist = *cit;
+        if ( cq_plist->front()->is_mergeable(packet) ) {
+            cq_plist->splice(cq_plist->end(), *packets);
+            delete packets;
+
+            // the queued list has its own worker reserved
+            if (packet->unreserve_worker_on_completion())
+                _rp.unreserve(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+
 /**
  *  @brief Helper function used to remove the next packet in this
  *  container queue. If no packets are available, wait for one to
@@ -685,18 +721,26 @@ void stage_container_t::stage_adaptor_t::output_page(page* p) {
             
             // Drain all tuples in output page into the current packet's
             // output buffer.
-            page::iterator page_it = p->begin();
-            while(page_it != pend) {
+            if(output_filter->batched()) {
+
+                // select the whole page, then project the survivors
+                output_filter->select_batch(*p, _selection);
+                output_filter->project_batch(output_buffer, *p, _selection);
+            }
+            else {
+                page::iterator page_it = p->begin();
+                while(page_it != pend) {
 
-                // apply current packet's filter to this tuple
-                tuple_t in_tup = page_it.advance();
-                if(output_filter->select(in_tup)) {
+                    // apply current packet's filter to this tuple
+                    tuple_t in_tup = page_it.advance();
+                    if(output_filter->select(in_tup)) {
 
-                    // this tuple selected by filter!
+                        // this tuple selected by filter!
 
-                    // allocate space in the output buffer and project into it
-                    tuple_t out_tup = output_buffer->allocate();
-                    output_filter->project(out_tup, in_tup);
+                        // allocate space in the output buffer and project into it
+                        tuple_t out_tup = output_buffer->allocate();
+                        output_filter->project(out_tup, in_tup);
+                    }
                 }
             }
             
@@ -775,6 +819,42 @@ void stage_container_t::stage_adaptor_t::finish_packet(packet_t* packet) {
 
 
 
+/**
+ *  @brief Reserve up to n idle workers of the container for the
+ *  packets of this adaptor, without waiting. The stage runs its
+ *  helpers on their behalf, so the container never has more busy
+ *  workers than its capacity.
+ *
+ *  @return The number of workers reserved.
+ *
+ *  THE CALLER MUST NOT BE HOLDING THE _container_lock MUTEX.
+ */
+int stage_container_t::stage_adaptor_t::reserve_helpers(int n) {
+
+    if (n <= 0)
+        return 0;
+
+    critical_section_t cs(_container->_container_lock);
+    return _container->_rp.try_reserve(n);
+}
+
+
+/**
+ *  @brief Give back the workers taken by reserve_helpers().
+ *
+ *  THE CALLER MUST NOT BE HOLDING THE _container_lock MUTEX.
+ */
+void stage_container_t::stage_adaptor_t::release_helpers(int n) {
+
+    if (n <= 0)
+        return;
+
+    critical_section_t cs(_container->_container_lock);
+    _container->_rp.unreserve(n);
+}
+
+
+
 /**
  *  @brief When a worker thread dequeues a new packet list from the
  *  container queue, it should create a stage_adaptor_t around that
@@ -894,7 +974,7 @@ void stage_container_t::stage_adaptor_t::cleanup() {
     // Re-enqueue incomplete packets if we have them
     if ( _packet_list->empty() )
 	delete _packet_list;
-    else
+    else if ( !_container->container_queue_merge_circular(_packet_list) )
         _container->container_queue_enqueue_no_merge(_packet_list);
 
     
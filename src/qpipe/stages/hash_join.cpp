@@ -94,8 +94,7 @@ void hash_join_stage_t::process_packet() {
 
         /* Identify the partition that needs this tuple. */
         size_t hash_code = hashfcn(extract_right(right.data));
-        int    hash_int  = (int)hash_code;
-        int    partition = hash_int % partitions.size();
+        int    partition = hash_code % partitions.size();
 
         /* Simple optimization: Flush _before_ inserting into a full
            page, not after we fill a page. This can avoid one
@@ -181,8 +180,8 @@ void hash_join_stage_t::process_packet() {
      
         // which partition?
         const char* left_key = left_key_extractor(left.data);
-        int hash_code = hasher(left_key);
-        int partition = hash_code % partitions.size();
+        size_t hash_code = hasher(left_key);
+        int    partition = hash_code % partitions.size();
         partition_t &p = partitions[partition];
 
         // empty partition?
@@ -0,0 +1,482 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   radix_hash_join.cpp
+ *
+ *  @brief:  Implementation of the RADIX_HASH_JOIN operator
+ */
+
+#include "qpipe/stages/radix_hash_join.h"
+#include "qpipe/stages/hash_join.h"
+
+#include <cstring>
+#include <algorithm>
+
+
+ENTER_NAMESPACE(qpipe);
+
+
+const c_str radix_hash_join_packet_t::PACKET_TYPE = "RADIX_HASH_JOIN";
+
+const c_str radix_hash_join_stage_t::DEFAULT_STAGE_NAME = "RADIX_HASH_JOIN";
+
+
+
+/* A helper thread that probes a range of the partitions of a batch.
+   Its output goes through a bounded fifo that the stage thread reads. */
+class radix_hash_join_stage_t::prober_t : public thread_t {
+
+    radix_hash_join_stage_t* _stage;
+    relation_t* _right;
+    std::vector<relation_t>* _left;
+    probe_range_t _range;
+
+public:
+
+    guard<tuple_fifo> _out;
+
+    prober_t(radix_hash_join_stage_t* stage, relation_t* right,
+             std::vector<relation_t>* left, const probe_range_t &range,
+             size_t out_size, int id)
+        : thread_t(c_str("rhj-probe-%d", id)),
+          _stage(stage), _right(right), _left(left), _range(range),
+          _out(new tuple_fifo(out_size, RHJ_PROBER_PAGES, RHJ_PROBER_PAGES/4))
+    {
+    }
+
+    void work() {
+        _out->writer_init();
+        try {
+            _stage->probe_range(*_right, *_left, _range, _out);
+            _out->send_eof();
+        }
+        catch(TerminatedBufferException &e) {
+            // the stage thread stopped reading
+        }
+    }
+};
+
+
+
+void radix_hash_join_stage_t::process_packet() {
+
+    radix_hash_join_packet_t* packet =
+        (radix_hash_join_packet_t *)_adaptor->get_packet();
+
+    _join = packet->_join;
+    _outer = packet->_outer;
+    _distinct = packet->_distinct;
+
+
+    /* TERMINOLOGY: As in the HASH_JOIN stage, the 'right' relation
+       is the inner (build) relation and the 'left' relation is the
+       outer (probe) relation. */
+    tuple_fifo *right_buffer = packet->_right_buffer;
+    dispatcher_t::dispatch_packet(packet->_right);
+    tuple_fifo *left_buffer = packet->_left_buffer;
+    dispatcher_t::dispatch_packet(packet->_left);
+
+
+    /* 1. Materialize the right relation and decide the number of
+       partitions, so that the right side of each fits in the cache */
+    relation_t right(_join->right_tuple_size());
+    if(right_buffer->ensure_read_ready())
+        read_right(right_buffer, right);
+
+    if(right._count == 0 && !_outer)
+        return;
+
+    size_t right_bytes = right._count * right._tuple_size;
+    _bits = 0;
+    while((_bits < RHJ_MAX_BITS) && ((right_bytes >> _bits) > RHJ_CACHE_BYTES))
+        _bits++;
+
+    partition(right, _right_bounds);
+    build(right);
+
+
+    /* 2. Stream the left relation into the same partitions. They are
+       probed whenever they hold a batch, so that the left relation is
+       never in memory as a whole. */
+    if(!left_buffer->ensure_read_ready())
+        // No left-side tuples... no join tuples.
+        return;
+
+    envVar* ev = envVar::instance();
+    int parts = 1 << _bits;
+    _threads = ev->getVarInt("qpipe-rhj-threads", 1);
+    _threads = std::max(1, std::min(std::min(_threads, RHJ_MAX_THREADS), parts));
+    size_t batch_bytes =
+        (size_t)std::max(1, ev->getVarInt("qpipe-rhj-batch-mb",
+                                          RHJ_DEFAULT_BATCH_MB)) << 20;
+
+    size_t lsize = _join->left_tuple_size();
+    size_t ksize = _join->key_size();
+    uint32_t mask = parts - 1;
+    std::vector<relation_t> left(parts, relation_t(lsize));
+    size_t buffered = 0;
+    size_t left_count = 0;
+    int batches = 0;
+
+    tuple_t tup(NULL, lsize);
+    while(left_buffer->get_tuple(tup)) {
+        uint32_t h = fnv_hash(_join->left_key_bytes(tup.data), ksize);
+        left[h & mask].append(tup.data, h);
+        left_count++;
+        buffered += lsize;
+        if(buffered >= batch_bytes) {
+            probe_batch(right, left);
+            for(int p=0; p < parts; p++)
+                left[p].clear();
+            buffered = 0;
+            batches++;
+        }
+    }
+    if(buffered > 0) {
+        probe_batch(right, left);
+        batches++;
+    }
+
+    TRACE(TRACE_DEBUG, "Radix join (%d) bits. Right (%d). Left (%d) in (%d) batches\n",
+          _bits, right._count, left_count, batches);
+}
+
+
+
+/**
+ *  @brief Reads all the tuples of the right input, keeping the hash of
+ *  the join key of each tuple.
+ */
+void radix_hash_join_stage_t::read_right(tuple_fifo* buffer, relation_t &rel)
+{
+    size_t ksize = _join->key_size();
+    tuple_t tup(NULL, rel._tuple_size);
+    while(buffer->get_tuple(tup))
+        rel.append(tup.data, fnv_hash(_join->right_key_bytes(tup.data), ksize));
+}
+
+
+
+/**
+ *  @brief Radix-partitions a relation on the low (_bits) bits of the
+ *  hash. With more than RHJ_PASS_BITS bits, the first pass uses the
+ *  high ones and the second pass splits each partition of the first.
+ *  So, the partition of a tuple is (hash & ((1<<_bits)-1)).
+ */
+void radix_hash_join_stage_t::partition(relation_t &rel,
+                                        std::vector<size_t> &bounds)
+{
+    bounds.clear();
+    if(_bits == 0) {
+        bounds.push_back(0);
+        bounds.push_back(rel._count);
+        return;
+    }
+
+    int bits1 = std::min(_bits, RHJ_PASS_BITS);
+    int bits2 = _bits - bits1;
+
+    relation_t tmp(rel._tuple_size);
+    tmp._data.resize(rel._data.size());
+    tmp._hash.resize(rel._count);
+    tmp._count = rel._count;
+
+    std::vector<size_t> first;
+    radix_pass(rel, tmp, 0, rel._count, bits2, bits1, first);
+    first.push_back(rel._count);
+
+    if(bits2 == 0) {
+        rel._data.swap(tmp._data);
+        rel._hash.swap(tmp._hash);
+        bounds.swap(first);
+        return;
+    }
+
+    for(size_t i=0; i+1 < first.size(); i++)
+        radix_pass(tmp, rel, first[i], first[i+1], 0, bits2, bounds);
+    bounds.push_back(rel._count);
+}
+
+
+void radix_hash_join_stage_t::radix_pass(relation_t &src, relation_t &dst,
+                                         size_t begin, size_t end,
+                                         int shift, int bits,
+                                         std::vector<size_t> &bounds)
+{
+    size_t fanout = 1 << bits;
+    uint32_t mask = fanout - 1;
+    size_t tsize = src._tuple_size;
+
+    // histogram
+    std::vector<size_t> pos(fanout, 0);
+    for(size_t i=begin; i < end; i++)
+        pos[(src._hash[i] >> shift) & mask]++;
+
+    // prefix sum
+    size_t offset = begin;
+    for(size_t p=0; p < fanout; p++) {
+        size_t cnt = pos[p];
+        pos[p] = offset;
+        bounds.push_back(offset);
+        offset += cnt;
+    }
+
+    // scatter
+    for(size_t i=begin; i < end; i++) {
+        size_t d = pos[(src._hash[i] >> shift) & mask]++;
+        memcpy(dst.tuple(d), src.tuple(i), tsize);
+        dst._hash[d] = src._hash[i];
+    }
+}
+
+
+
+/**
+ *  @brief Builds the hash table of each right partition, once for all
+ *  the batches of the left relation. The buckets of a partition are
+ *  chained through the (_next) array.
+ */
+void radix_hash_join_stage_t::build(relation_t &right)
+{
+    int parts = 1 << _bits;
+    _bucket_bounds.assign(1, 0);
+    for(int part=0; part < parts; part++) {
+        size_t nr = _right_bounds[part+1] - _right_bounds[part];
+        size_t nbuckets = 1;
+        while(nbuckets < nr) nbuckets <<= 1;
+        _bucket_bounds.push_back(_bucket_bounds.back() + nbuckets);
+    }
+    _buckets.assign(_bucket_bounds.back(), -1);
+    _next.assign(right._count, -1);
+
+    size_t rsize = right._tuple_size;
+    for(int part=0; part < parts; part++) {
+        size_t rb = _right_bounds[part];
+        size_t nr = _right_bounds[part+1] - rb;
+        int* buckets = &_buckets[_bucket_bounds[part]];
+        uint32_t mask = (_bucket_bounds[part+1] - _bucket_bounds[part]) - 1;
+
+        for(size_t i=0; i < nr; i++) {
+            int b = (right._hash[rb+i] >> _bits) & mask;
+            if(_distinct) {
+                // DISTINCT join, as the HASH_JOIN stage does
+                bool dup = false;
+                for(int k=buckets[b]; k >= 0; k = _next[rb+k]) {
+                    if(!memcmp(right.tuple(rb+k), right.tuple(rb+i), rsize)) {
+                        dup = true;
+                        break;
+                    }
+                }
+                if(dup) continue;
+            }
+            _next[rb+i] = buckets[b];
+            buckets[b] = i;
+        }
+    }
+}
+
+
+
+/**
+ *  @brief Probes the partitions of a batch of the left relation. With
+ *  one thread the stage thread probes them and outputs directly. With
+ *  more, each thread probes a range of partitions with about the same
+ *  number of left tuples, and the stage thread outputs from their
+ *  bounded fifos as they fill.
+ */
+void radix_hash_join_stage_t::probe_batch(relation_t &right,
+                                          std::vector<relation_t> &left)
+{
+    int parts = 1 << _bits;
+    if(_threads == 1) {
+        probe_range_t all;
+        all._last = parts;
+        probe_range(right, left, all, NULL);
+        return;
+    }
+
+    size_t count = 0;
+    for(int p=0; p < parts; p++)
+        count += left[p]._count;
+
+    size_t out_size = _join->output_tuple_size();
+    size_t target = (count + _threads - 1) / _threads;
+    std::vector<prober_t*> probers;
+    int part = 0;
+    try {
+        for(int t=0; t < _threads; t++) {
+            probe_range_t range;
+            range._first = part;
+            size_t sum = 0;
+            while((part < parts) && ((t == _threads-1) || (sum < target))) {
+                sum += left[part]._count;
+                part++;
+            }
+            range._last = part;
+
+            prober_t* prober = new prober_t(this, &right, &left, range,
+                                            out_size, t);
+            probers.push_back(prober);
+            prober->fork();
+        }
+
+        // output what the probers produce, in any order
+        std::vector<bool> done(probers.size(), false);
+        size_t running = probers.size();
+        tuple_t outtup(NULL, out_size);
+        while(running > 0) {
+            bool any = false;
+            for(size_t t=0; t < probers.size(); t++) {
+                if(done[t]) continue;
+                tuple_fifo* out = probers[t]->_out;
+                int ready;
+                while((ready = out->check_read_ready()) == 1) {
+                    out->get_tuple(outtup);
+                    _adaptor->output(outtup);
+                    any = true;
+                }
+                if(ready < 0) {
+                    done[t] = true;
+                    running--;
+                }
+            }
+
+            // nothing ready, wait a little on a running prober
+            if(!any && (running > 0)) {
+                size_t t = 0;
+                while(done[t]) t++;
+                probers[t]->_out->ensure_read_ready(1);
+            }
+        }
+    }
+    catch(...) {
+        stop_probers(probers);
+        throw;
+    }
+    stop_probers(probers);
+}
+
+
+/**
+ *  @brief Stops and deletes the probers. Those still writing are woken
+ *  up by terminating their fifos, which are deleted only after the
+ *  probers are joined.
+ */
+void radix_hash_join_stage_t::stop_probers(std::vector<prober_t*> &probers)
+{
+    for(size_t t=0; t < probers.size(); t++)
+        probers[t]->_out->terminate();
+    for(size_t t=0; t < probers.size(); t++) {
+        probers[t]->join();
+        delete (probers[t]);
+    }
+    probers.clear();
+}
+
+
+
+void radix_hash_join_stage_t::probe_range(relation_t &right,
+                                          std::vector<relation_t> &left,
+                                          const probe_range_t &range,
+                                          tuple_fifo* out)
+{
+    for(int part=range._first; part < range._last; part++)
+        probe_partition(right, left[part], part, out);
+}
+
+
+/**
+ *  @brief Probes the hash table of a right partition with the left
+ *  tuples of the same partition. The output goes to (out), or to the
+ *  stage output if it is NULL.
+ */
+void radix_hash_join_stage_t::probe_partition(relation_t &right,
+                                              relation_t &left, int part,
+                                              tuple_fifo* out)
+{
+    size_t rb = _right_bounds[part];
+    size_t nr = _right_bounds[part+1] - rb;
+
+    if(left._count == 0) return;
+    if((nr == 0) && !_outer) return;
+
+    const int* buckets = &_buckets[_bucket_bounds[part]];
+    uint32_t mask = (_bucket_bounds[part+1] - _bucket_bounds[part]) - 1;
+
+    size_t out_size = _join->output_tuple_size();
+    size_t rsize = right._tuple_size;
+    size_t ksize = _join->key_size();
+    array_guard_t<char> data = new char[out_size];
+    tuple_t outtup(data, out_size);
+    tuple_t lefttup(NULL, left._tuple_size);
+    tuple_t righttup(NULL, rsize);
+
+    for(size_t j=0; j < left._count; j++) {
+        uint32_t h = left._hash[j];
+        lefttup.data = left.tuple(j);
+        const char* key = _join->left_key_bytes(lefttup.data);
+        bool hit = false;
+
+        int b = (h >> _bits) & mask;
+        for(int k=((nr > 0) ? buckets[b] : -1); k >= 0; k = _next[rb+k]) {
+            if(right._hash[rb+k] != h)
+                continue;
+            righttup.data = right.tuple(rb+k);
+            if(memcmp(key, _join->right_key_bytes(righttup.data), ksize))
+                continue;
+
+            hit = true;
+            _join->join(outtup, lefttup, righttup);
+            if(out) out->append(outtup);
+            else    _adaptor->output(outtup);
+        }
+
+        if(!hit && _outer) {
+            _join->left_outer_join(outtup, lefttup);
+            if(out) out->append(outtup);
+            else    _adaptor->output(outtup);
+        }
+    }
+}
+
+
+
+packet_t* create_hash_join_packet(const c_str &packet_id,
+                                  tuple_fifo* out_buffer,
+                                  tuple_filter_t *output_filter,
+                                  packet_t* left,
+                                  packet_t* right,
+                                  tuple_join_t *join,
+                                  bool outer,
+                                  bool distinct)
+{
+    if(envVar::instance()->getVar("qpipe-join", "hash") == "radix")
+        return new radix_hash_join_packet_t(packet_id, out_buffer, output_filter,
+                                            left, right, join, outer, distinct);
+
+    return new hash_join_packet_t(packet_id, out_buffer, output_filter,
+                                  left, right, join, outer, distinct);
+}
+
+
+EXIT_NAMESPACE(qpipe);
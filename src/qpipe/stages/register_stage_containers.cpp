@@ -54,6 +54,7 @@ void register_stage_containers()
     register_stage<partial_aggregate_stage_t>(MAX_NUM_PARTIAL_AGGREGATE_THREADS, true);
     register_stage<hash_aggregate_stage_t>(MAX_NUM_AGGREGATE_THREADS, true);
     register_stage<hash_join_stage_t>(MAX_NUM_HASH_JOIN_THREADS, true);
+    register_stage<radix_hash_join_stage_t>(MAX_NUM_HASH_JOIN_THREADS, true);
     register_stage<sort_merge_join_stage_t>(MAX_NUM_SORT_MERGE_JOIN_THREADS, true);
     register_stage<pipe_hash_join_stage_t>(MAX_NUM_CLIENTS, true);
     register_stage<func_call_stage_t>(MAX_NUM_FUNC_CALL_THREADS, true);
@@ -22,20 +22,17 @@
 */
 
 #include "qpipe/stages/sort.h"
-#include "qpipe/stages/merge.h"
-#include "qpipe/stages/fdump.h"
-#include "qpipe/stages/fscan.h"
 
 #include <algorithm>
 #include <string>
 #include <cstdlib>
+#include <cerrno>
+#include <cstring>
 #include <deque>
-#include <map>
 #include <list>
 
 using std::string;
 using std::deque;
-using std::map;
 using std::list;
 
 
@@ -47,10 +44,13 @@ const c_str sort_packet_t::PACKET_TYPE = "SORT";
 
 const c_str sort_stage_t::DEFAULT_STAGE_NAME = "SORT_STAGE";
 
-const unsigned int sort_stage_t::MERGE_FACTOR = 8;
+// bounded by the number of open files
+const unsigned int sort_stage_t::MAX_MERGE_FACTOR = 512;
 
 const unsigned int sort_stage_t::PAGES_PER_INITIAL_SORTED_RUN = 8 * 1024;
 
+const unsigned int sort_stage_t::MAX_SORT_THREADS = 16;
+
 
 
 static void flush_page(qpipe::page* pg, FILE* file);
@@ -58,325 +58,258 @@ static void flush_page(qpipe::page* pg, FILE* file);
 
 
 /**
- *  @brief At any point in our merge sort, we have a set of "runs"
- *  (sorted output files) and a set of active merge operations. This
- *  function checks the set of active merges to see if any of them
- *  have completed. If so, we promote the resulting sorted file to the
- *  "run set".
+ *  @brief Reads a sorted run from its file, one page at a time, and
+ *  keeps the (hint,tuple) pair of its current tuple.
  */
-void sort_stage_t::check_finished_merges() {
+struct run_reader_t {
 
-    
-    /* The merge operations required to complete the sort form a
-       tree. The lowest level (0) The _merge_map contains one entry
-       per level in the merge tree.  0 being the lowest) to a
-       merge_list_t (a list of merge operations happening at that
-       level). */
-
-    merge_map_t::iterator level_it = _merge_map.begin();
-    while(level_it != _merge_map.end()) {
-        int level = level_it->first;
-        merge_list_t &merges = level_it->second;
-        merge_list_t::iterator it = merges.begin();
-        while(it != merges.end()) {
-            // finished? 
-            if(it->_signal_buffer->eof()) {
-
-                // move it to the finished run list
-                _run_map[level].push_back(it->_output);
-                TRACE(TRACE_DEBUG, "Added finished merge file %s to _run_map[%d]\n",
-                      it->_output.data(),
-                      level);
-
-                // delete the merge record and any input files it used
-                remove_input_files(it->_inputs);
-                it = merges.erase(it);
-            }
-            else {
-                // next!
-                ++it;
+    FILE*               _file;
+    qpipe::page*        _page;
+    size_t              _pos;
+    hint_tuple_pair_t   _item;
+    bool                _done;
+    key_extractor_t*    _extract;
+
+    run_reader_t()
+        : _file(NULL), _page(NULL), _pos(0), _done(true), _extract(NULL)
+    {
+    }
+
+    ~run_reader_t() {
+        if(_file) fclose(_file);
+        if(_page) _page->free();
+    }
+
+    void open(const c_str &file_name, size_t tuple_size,
+              key_extractor_t* extract)
+    {
+        _file = fopen(file_name.data(), "r");
+        if(!_file)
+            THROW2(FileException, "::fopen failed %s", strerror(errno));
+        _page = qpipe::page::alloc(tuple_size);
+        _extract = extract;
+        _done = false;
+        advance();
+    }
+
+    void advance() {
+        if(_pos == _page->tuple_count()) {
+            if(!_page->fread_full_page(_file) || _page->empty()) {
+                _done = true;
+                return;
             }
+            _pos = 0;
         }
-
-        // if that was the last merge at this level, remove it
-        merge_map_t::iterator old_level_it = level_it++;
-        if(merges.empty())
-            _merge_map.erase(old_level_it);
+        tuple_t tuple = _page->get_tuple(_pos++);
+        _item.data = tuple.data;
+        _item.hint = _extract->extract_hint(tuple);
     }
-}
+};
 
 
 
-void sort_stage_t::start_merge(int new_level, run_list_t& runs, int merge_factor)
-{
+/**
+ *  @brief Tournament (loser) tree over the runs of a merge. The
+ *  internal nodes keep the loser of each match, so replacing the
+ *  winner takes a single leaf-to-root pass with one comparison per
+ *  level. Exhausted runs lose every match.
+ */
+class loser_tree_t {
+
+    run_reader_t*       _readers;
+    int                 _k;
+    std::vector<int>    _tree;
+    int                 _winner;
+    tuple_comparator_t  _compare;
+
+    bool less(int a, int b) {
+        if(_readers[a]._done) return false;
+        if(_readers[b]._done) return true;
+        int diff = _compare(_readers[a]._item, _readers[b]._item);
+        return (diff < 0) || ((diff == 0) && (a < b));
+    }
 
-    assert(merge_factor > 0);
-    assert(runs.size() >= (unsigned int)merge_factor);
+    int build(int node) {
+        if(node >= _k)
+            return node - _k;
+        int l = build(2*node);
+        int r = build(2*node+1);
+        if(less(r, l)) {
+            _tree[node] = l;
+            return r;
+        }
+        _tree[node] = r;
+        return l;
+    }
 
+public:
 
-    // allocate a new merge
-    merge_list_t &merges = _merge_map[new_level];
-    merges.resize(merges.size()+1);
-    merge_t &merge = merges.back();
+    loser_tree_t(run_reader_t* readers, int k,
+                 key_extractor_t* extract, key_compare_t* compare)
+        : _readers(readers), _k(k), _tree(k, 0), _winner(0),
+          _compare(extract, compare)
+    {
+        if(_k > 1)
+            _winner = build(1);
+    }
 
+    bool empty() const { return _readers[_winner]._done; }
 
-    run_list_t merge_inputs;
-    buffer_list_t fscan_buffers;
+    run_reader_t &top() { return _readers[_winner]; }
 
+    // advances the winning run and replays its matches
+    void pop() {
+        int w = _winner;
+        _readers[w].advance();
+        for(int node=(w+_k)/2; node >= 1; node /= 2) {
+            if(less(_tree[node], w))
+                std::swap(_tree[node], w);
+        }
+        _winner = w;
+    }
+};
 
-    run_list_t::iterator it = runs.begin();
-    for(int i = 0; i < merge_factor; i++) {
 
-        // grab one of our runs
-	c_str run_filename = *it;
-        it = runs.erase(it);
-	
-        fscan_packet_t* p;
-        tuple_fifo* buf = new tuple_fifo(_tuple_size);
 
+/**
+ *  @brief Sorts a run on the (hint,pointer) pairs and writes the
+ *  tuples to a new temporary file
+ */
+void sort_stage_t::run_t::sort_and_write(size_t tuple_size) {
 
-        c_str fscan_packet_id("SORT_FSCAN_PACKET_%d", i);
+    std::sort(_array.begin(), _array.end(), tuple_less_t(_extract, _compare));
 
-        p = new fscan_packet_t(fscan_packet_id,
-			       buf,
-                               new trivial_filter_t(_tuple_size),
-                               run_filename.data());
-        dispatcher_t::dispatch_packet(p);
+    guard<FILE> file = create_tmp_file(_file_name, "sorted-run");
+    guard<qpipe::page> out_page = qpipe::page::alloc(tuple_size);
 
-	merge._inputs.push_back(run_filename.data());
-	fscan_buffers.push_back(buf);
+    for(hint_vector_t::iterator it=_array.begin(); it != _array.end(); ++it) {
+        tuple_t out(it->data, tuple_size);
+        out_page->append_tuple(out);
+        if(out_page->full())
+            flush_page(out_page, file);
     }
 
+    // make sure to pick up the stragglers
+    if(!out_page->empty())
+        flush_page(out_page, file);
 
-    // create a merge packet to consume the fscans
-    merge_packet_t* mp;
-    tuple_fifo* merge_out = new tuple_fifo(_tuple_size);
+    _array.clear();
+}
 
-    TRACE(TRACE_ALWAYS,
-          "Argh! Sending merge packet... This means we need to get serial merges working\n");
-    assert(0);
-    mp = new merge_packet_t("SORT_MERGE_PACKET",
-                            merge_out,
-                            new trivial_filter_t(_tuple_size),
-                            fscan_buffers,
-                            _extract->clone(), _compare->clone());
-    dispatcher_t::dispatch_packet(mp);
 
 
-    // if this is the last merge run, send output to SORT worker
-    // thread, not to an FDUMP
-    if(new_level < 0) {
-        merge._signal_buffer = merge_out;
-        return;
-    }
-    
-    
-    // otherwise, redirect merge to an FDUMP so we create a new run on
-    // disk
-    fdump_packet_t* fp;
-    tuple_fifo* fdump_out;
-    c_str file_name;
+/**
+ *  @brief Helper thread that sorts and writes one run, while the SORT
+ *  worker reads the next one
+ */
+class sort_stage_t::run_writer_t : public thread_t {
 
+    run_t* _run;
+    size_t _tuple_size;
 
-    // KLUDGE! the fdump stage will reopen the file
-    fclose(create_tmp_file(file_name, "merged-run"));
-    fdump_out = new tuple_fifo(_tuple_size);
-    
-    fp = new fdump_packet_t("SORT_FDUMP_PACKET",
-                            fdump_out,
-                            new trivial_filter_t(merge_out->tuple_size()),
-                            merge_out,
-                            file_name.data(), 
-                            &_monitor);
-    dispatcher_t::dispatch_packet(fp);
+public:
 
+    run_writer_t(run_t* run, size_t tuple_size, int id)
+        : thread_t(c_str("SORT_RUN_WRITER_%d", id)),
+          _run(run), _tuple_size(tuple_size)
+    {
+    }
 
-    merge._output = file_name;
-    merge._signal_buffer = fdump_out;
-}
+    void work() {
+        _run->sort_and_write(_tuple_size);
+    }
+
+    run_t* run() { return _run; }
+};
 
 
 
 /**
- * @brief searches each level of the merge hierarchy and fires off a
- * new merge whenever there are MERGE_FACTOR finished runs.
+ *  @brief Reads up to (pages) pages of input to a run.
+ *
+ *  @return true if there is more input to read
  */
-void sort_stage_t::start_new_merges() {
+bool sort_stage_t::read_run(run_t* run, unsigned int pages) {
 
-    
-    TRACE(TRACE_DEBUG, "_run_map has size %zd\n",
-	  _run_map.size());
-    
+    int capacity =
+        qpipe::page::capacity(_input_buffer->page_size(), _tuple_size);
+    run->_array.reserve(pages * capacity);
 
-    // start up as many new runs as possible
-    run_map_t::iterator level_it = _run_map.begin();
-    while(level_it != _run_map.end()) {
+    for(unsigned int i=0; i < pages; i++) {
 
-	int level = level_it->first;
-	TRACE(TRACE_DEBUG, "Running on level %d\n", level);
+        // read in a run of pages
+        qpipe::page* p = qpipe::page::alloc(_input_buffer->tuple_size());
+        if (!_input_buffer->copy_page(p)) {
+            p->free();
+            break;
+        }
 
-        
-        run_list_t &runs = level_it->second;
-        bool started_merges = false;
-	while(runs.size() >= MERGE_FACTOR) {
-	    // "normal" k-way merges
-            start_merge(level+1, runs, MERGE_FACTOR);
-            started_merges = true;
+        // add new page to the list
+        run->_pages.add(p);
+
+        // add the tuples in the page into the key array
+        for(qpipe::page::iterator it=p->begin(); it != p->end(); ++it) {
+            int hint = _extract->extract_hint(*it);
+            run->_array.push_back(hint_tuple_pair_t(hint, it->data));
         }
+    }
 
-        // increment the iterator. rename for clarity
-        run_map_t::iterator curr_level_it = level_it++;
-        run_map_t::iterator next_level_it = level_it;
+    return (_input_buffer->ensure_read_ready());
+}
 
-	TRACE(TRACE_DEBUG, "curr_level = %d ; next_level = %d\n",
-	      curr_level_it->first,
-	      next_level_it->first);
-        
 
-        // If we have no runs on this level, erase this level's
-        // _run_map entry. Now a level has no runs if no mapping
-        // exists, not if a mapping exists to a set of size 0.
-        if(runs.empty()) {
-            _run_map.erase(curr_level_it);
-            continue;
-        }
-        
-        // special case -- if sorting has finished, we can't
-        // necessarily wait for MERGE_FACTOR runs to arrive (they may
-        // never come)
-        if(!_sorting_finished || started_merges)
-            continue;
-
-
-	// Try to find (materialized) runs above this
-        // level. 'next_level_it' is set to -1 if no runs exist.
-        // Otherwise, it is set to the lowest level (above us) with
-        // such runs available.
-        int next_run_level =
-	    (next_level_it == _run_map.end()) ? -1 : next_level_it->first;
-
-	
-        // Try to find in-progress merges at or below this
-        // level. 'lowest_merge_level' is set to -1 if no merges are
-        // found. Otherwise, it is set to the lowest level where a
-        // merge is taking place.
-        merge_map_t::iterator merges = _merge_map.begin();
-        int lowest_merge_level = (merges == _merge_map.end())? -1 : merges->first;
-
-
-	TRACE(TRACE_DEBUG, "lowest_merge_level = %d ; next_run_level = %d\n",
-	      lowest_merge_level,
-	      next_run_level);
-
-	
-        // We reduce system I/O when we merge small files together
-        // before moving them up the merge hierarchy.
-
-
-        int next_size, next_level;
-	if ((lowest_merge_level >= 0) && (lowest_merge_level <= level)) {
-	    // There are merges happening below us. Wait for them to
-	    // finish. We really want to merge with the result of
-	    // every merge below before shipping work to higher levels
-	    // of merge hierarchy.
-	    continue;
-	}
-	else if ((lowest_merge_level < 0) && (next_run_level < 0)) {
-	    // No merges taking place in the system and no runs above
-	    // us. Submit one final merge request. start_merge()
-	    // should redirect output to the SORT worker thread and
-	    // optimize for the single-merge case.
-	    start_merge(-1, runs, runs.size());
-	    _run_map.erase(curr_level_it);
-	    continue;
-	}
-	else if (next_run_level < 0) {
-	    // No runs above us, but there are merges taking place!
-	    // Move up to the output level of the lowest merge.
-	    next_level = lowest_merge_level;
-	    next_size  = merges->second.size();
-	}
-        else if (lowest_merge_level < 0) {
-            // No merges taking place, but there are runs above us
-            next_level = next_run_level;
-            next_size  = next_level_it->second.size();
-        }
-        else if(lowest_merge_level > next_run_level) {
-            // only runs at the next level
-            next_level = next_run_level;
-            next_size  = next_level_it->second.size();
-        }
-        else if(lowest_merge_level < next_run_level) {
-            // only merges at the next level
-            next_level = lowest_merge_level;
-            next_size  = merges->second.size();
-        }
-        else {
-            // both runs and merges at the next level
-            next_level = lowest_merge_level;
-            next_size = merges->second.size() + next_level_it->second.size(); 
-	}
-
-
-	TRACE(TRACE_DEBUG, "next_size = %d ; next_level = %d\n",
-	      next_size,
-	      next_level);
-
-                
-        // promote or partial merge?
-        int required_merges = (next_size + MERGE_FACTOR-1)/MERGE_FACTOR;
-        int potential_merges = (next_size + runs.size() + MERGE_FACTOR-1)/MERGE_FACTOR;
-        if(potential_merges > required_merges) {
-            // partial merge
-            start_merge(next_level, runs, runs.size());
-        }
-        else {
-            // promote up
-            run_list_t &next_runs = _run_map[next_level];
-            next_runs.insert(next_runs.end(), runs.begin(), runs.end());
-        }
 
-        // no more runs at this level. Erase it so the special case
-        // check works right
-        _run_map.erase(curr_level_it);
-    }
+/**
+ *  @brief Records a run written to disk and releases its memory
+ */
+void sort_stage_t::add_run(run_t* run) {
+    _runs.push_back(run->_file_name);
+    TRACE(TRACE_DEBUG, "Added run %s (%zd)\n",
+          run->_file_name.data(), _runs.size());
+    delete (run);
 }
 
 
 
 /**
- * @brief Executed by a separate thread to manage the hierachical
- * merge. Spends most of its time blocked, so very little overhead --
- * we just need a way to detect asynchronous merge completions and
- * handle them.
+ *  @brief Merges the (inputs) runs. The output goes to (file) if it
+ *  is not NULL, otherwise to the output of the stage.
  */
-tuple_fifo *sort_stage_t::monitor_merge_packets() {
-    // always in a critical section, but usually blocked on cond_wait
-    critical_section_t cs(_monitor._lock);
-    while(1) {
-        // wait for a merge to finish
-        if(_monitor.wait_holding_lock())
-	{
-	    pthread_exit(NULL);
-#warning "MA: Seems to be working but we have to verify nothing breaks, also changed the next return to pthread_exit"
-	    //return NULL;
-	}
-        // find the finished merge run(s)
-        check_finished_merges();
-
-        // fire off new merges as needed
-        start_new_merges();
-
-        // have we started the final merge? The worker thread will take care of it
-        merge_map_t::iterator merge = _merge_map.begin();
-
-        if(merge != _merge_map.end() && merge->first < 0)
-	{
-	    pthread_exit(&merge->second.front()._signal_buffer);
-	    //return merge->second.front()._signal_buffer;
-	}
+void sort_stage_t::merge_runs(run_list_t& inputs, FILE* file) {
+
+    int merge_factor = inputs.size();
+    TRACE(TRACE_DEBUG, "Processing %d-way merge\n", merge_factor);
+
+    array_guard_t<run_reader_t> readers = new run_reader_t[merge_factor];
+    int i = 0;
+    for(run_list_t::iterator it=inputs.begin(); it != inputs.end(); ++it)
+        readers[i++].open(*it, _tuple_size, _extract);
+
+    loser_tree_t tree(readers, merge_factor, _extract, _compare);
+
+    guard<qpipe::page> out_page;
+    if(file)
+        out_page = qpipe::page::alloc(_tuple_size);
+
+    tuple_t out(NULL, _tuple_size);
+    while(!tree.empty()) {
+
+        // the tuple is valid until its run advances
+        out.data = tree.top()._item.data;
+        if(file) {
+            out_page->append_tuple(out);
+            if(out_page->full())
+                flush_page(out_page, file);
+        }
+        else {
+            _adaptor->output(out);
+        }
+
+        tree.pop();
     }
-    return NULL;//Put here to be able to compile
+
+    if(file && !out_page->empty())
+        flush_page(out_page, file);
 }
 
 
@@ -389,7 +322,7 @@ void sort_stage_t::process_packet() {
     _tuple_size = _input_buffer->tuple_size();
     _compare = packet->_compare;
     _extract = packet->_extract;
-    _sorting_finished = false;
+    _runs.clear();
 
 
     dispatcher_t::dispatch_packet(packet->_input);
@@ -398,120 +331,111 @@ void sort_stage_t::process_packet() {
     // quick optimization: if no input tuples, simply return
     if(!_input_buffer->ensure_read_ready())
         return;
-    
-    // create a buffer page for writing to file
-    guard<qpipe::page> out_page = qpipe::page::alloc(_tuple_size);
-    
-    // create a key array 
-    int capacity =
-        qpipe::page::capacity(_input_buffer->page_size(), _tuple_size);
-    int tuple_count = PAGES_PER_INITIAL_SORTED_RUN * capacity;
-    hint_vector_t array;
-    array.reserve(tuple_count);
 
 
+    // the memory budget, in pages, of the run generation and the merge
+    envVar* ev = envVar::instance();
+    unsigned int pages_per_run =
+        ev->getVarInt("qpipe-sort-pages", PAGES_PER_INITIAL_SORTED_RUN);
+    pages_per_run = std::max(pages_per_run, 3U);
+    unsigned int threads = ev->getVarInt("qpipe-sort-threads", 1);
+    threads = std::max(1U, std::min(threads, MAX_SORT_THREADS));
 
-    // use a monitor thread to control the hierarchical merge
-    thread_t *monitor;
-    monitor = member_func_thread(this,
-                                 &sort_stage_t::monitor_merge_packets,
-                                 "MERGE_MONITOR_THREAD");
-    _monitor_thread = thread_create(monitor);
+    
+    // read the first run
+    run_t* run = new run_t(_extract, _compare);
+    bool more = read_run(run, pages_per_run);
+
+    // shortcut if we fit in memory...
+    if(!more) {
+        guard<run_t> only = run;
+        std::sort(only->_array.begin(), only->_array.end(),
+                  tuple_less_t(_extract, _compare));
+        tuple_t out(NULL, packet->_output_filter->input_tuple_size());
+        for(hint_vector_t::iterator it=only->_array.begin(); it != only->_array.end(); ++it) {
+            out.data = it->data;
+            _adaptor->output(out);
+        }
+        return;
+    }
 
 
-    // create sorted runs
-    bool first_run = true;
-    do {
+    // create sorted runs. With multiple threads, the runs are sorted
+    // and written by helpers while the next runs are read
+    deque<run_writer_t*> writers;
+    int run_id = 0;
+    while(run) {
         // TODO: check for stage cancellation at regular intervals
-        
-        page_trash_stack pages;
-        array.clear();
-        for(unsigned int i=0; i < PAGES_PER_INITIAL_SORTED_RUN; i++) {
-
-            // read in a run of pages
-            qpipe::page* p = qpipe::page::alloc(_input_buffer->tuple_size());
-            if (!_input_buffer->copy_page(p)) {
-                p->free();
-                break;
-            }
 
-            // add new page to the list
-            pages.add(p);
-
-            // add the tuples in the page into the key array
-            for(qpipe::page::iterator it=p->begin(); it != p->end(); ++it) {
-                int hint = _extract->extract_hint(*it);
-                array.push_back(hint_tuple_pair_t(hint, it->data));
-            }
+        if(threads == 1) {
+            run->sort_and_write(_tuple_size);
+            add_run(run);
         }
-
-        // sort the key array (gotta love the STL!)
-        std::sort(array.begin(), array.end(), tuple_less_t(_extract, _compare));
-
-         // are we done?
-        bool eof = !_input_buffer->ensure_read_ready();
-
-        // shortcut if we fit in memory...
-        if(first_run && eof) {
-            _monitor.cancel();
-            tuple_t out(NULL, packet->_output_filter->input_tuple_size());
-            for(hint_vector_t::iterator it=array.begin(); it != array.end(); ++it) {
-                out.data = it->data;
-                _adaptor->output(out);
+        else {
+            if(writers.size() == threads) {
+                run_writer_t* writer = writers.front();
+                writers.pop_front();
+                writer->join();
+                add_run(writer->run());
+                delete (writer);
             }
-
-            return;
+            run_writer_t* writer = new run_writer_t(run, _tuple_size, run_id);
+            writer->fork();
+            writers.push_back(writer);
         }
-
-        first_run = false;
+        ++run_id;
         
-        // open a temp file to hold the run
-        c_str file_name;
-        guard<FILE> file = create_tmp_file(file_name, "sorted-run");
-
-        // dump the run to file
-        //        for(int i=0; i < index; i++) {
-        for(hint_vector_t::iterator it=array.begin(); it != array.end(); ++it) {
-            // write the tuple
-            tuple_t out(it->data, _tuple_size);
-            out_page->append_tuple(out);
-
-            // flush?
-            if(out_page->full())
-                flush_page(out_page, file);
+        run = NULL;
+        if(more) {
+            run = new run_t(_extract, _compare);
+            more = read_run(run, pages_per_run);
+            if(run->_array.empty()) {
+                delete (run);
+                run = NULL;
+            }
         }
+    }
 
-        // make sure to pick up the stragglers
-        if(!out_page->empty())
-            flush_page(out_page, file);
-
-        // notify the merge monitor thread that another run is ready
-        critical_section_t cs(_monitor._lock);
-	run_list_t &runs = _run_map[0];
-        runs.push_back(file_name);
-        _sorting_finished = eof;
-        _monitor.notify_holding_lock();
+    while(!writers.empty()) {
+        run_writer_t* writer = writers.front();
+        writers.pop_front();
+        writer->join();
+        add_run(writer->run());
+        delete (writer);
+    }
 
-	TRACE(TRACE_DEBUG, "Added file %s to _run_map[0]\n", file_name.data());
 
-    } while(!_sorting_finished);
-    
-    // wait for the output buffer from the final merge to arrive
-    tuple_fifo* merge_output = thread_join<tuple_fifo>(_monitor_thread);
+    // Intermediate merges, until there are at most (merge_factor)
+    // runs. A merge of k runs removes (k-1) of them, so the first merge
+    // takes ((runs - merge_factor - 1) % (merge_factor - 1)) + 2 runs,
+    // and every merge after it, the final one included, is a full
+    // (merge_factor)-way merge.
+    unsigned int merge_factor =
+        std::min(pages_per_run - 1, MAX_MERGE_FACTOR);
+    while(_runs.size() > merge_factor) {
+        unsigned int count =
+            ((unsigned int)_runs.size() - merge_factor - 1) % (merge_factor - 1) + 2;
+
+        run_list_t inputs;
+        for(unsigned int i=0; i < count; i++) {
+            inputs.push_back(_runs.front());
+            _runs.pop_front();
+        }
 
-    {
-        critical_section_t cs(_monitor._lock);
-        _monitor_thread = 0;
+        c_str file_name;
+        {
+            guard<FILE> file = create_tmp_file(file_name, "merged-run");
+            merge_runs(inputs, file);
+        }
+        remove_input_files(inputs);
+        _runs.push_back(file_name);
     }
-    if(merge_output == NULL)
-        THROW1(QPipeException, "Merge failed. Terminating Sort");
-    
 
-    // transfer the output of the last merge to the stage output
-    tuple_t out;
-    while (merge_output->get_tuple(out))
-        _adaptor->output(out);
-    
+
+    // the final merge goes to the stage output
+    merge_runs(_runs, NULL);
+    remove_input_files(_runs);
+    _runs.clear();
 }
 
 
@@ -527,34 +451,10 @@ static void flush_page(qpipe::page* pg, FILE* file) {
 
 
 int sort_stage_t::print_runs() {
-    run_map_t::iterator level_it = _run_map.begin();
-    for( ; level_it != _run_map.end(); ++level_it) {
-        int level = level_it->first;
-        run_list_t &runs = level_it->second;
-        TRACE(TRACE_ALWAYS, "Level %d (%zd):\n", level, runs.size());
-        run_list_t::iterator it = runs.begin();
-        for( ; it != runs.end(); ++it)
-            TRACE(TRACE_ALWAYS, "\t%s\n", it->data());
-    }
-    return 0;
-}
-
-
-
-int sort_stage_t::print_merges() {
-    merge_map_t::iterator level_it = _merge_map.begin();
-    for( ; level_it != _merge_map.end(); ++level_it) {
-        int level = level_it->first;
-        merge_list_t &merges = level_it->second;
-        TRACE(TRACE_ALWAYS, "Level %d (%zd)\n", level, merges.size());
-        merge_list_t::iterator it = merges.begin();
-        for( ; it != merges.end(); ++it) {
-            TRACE(TRACE_ALWAYS, "\t%s <=\n", it->_output.data());
-            run_list_t::iterator run_it = it->_inputs.begin();
-            for( ; run_it != it->_inputs.end(); ++run_it) 
-                TRACE(TRACE_ALWAYS, "\t\t%s\n", run_it->data());
-        }
-    }
+    TRACE(TRACE_ALWAYS, "Runs (%zd):\n", _runs.size());
+    run_list_t::iterator it = _runs.begin();
+    for( ; it != _runs.end(); ++it)
+        TRACE(TRACE_ALWAYS, "\t%s\n", it->data());
     return 0;
 }
 
@@ -31,6 +31,8 @@
 
 #include "qpipe/stages/tscan.h"
 #include <unistd.h>
+#include <vector>
+#include <algorithm>
 
 #include "sm_vas.h"
 
@@ -49,9 +51,6 @@ const c_str tscan_packet_t::PACKET_TYPE = "TSCAN";
 
 const c_str tscan_stage_t::DEFAULT_STAGE_NAME = "TSCAN_STAGE";
 
-#define KB 1024
-#define MB (1024*KB)
-
 tscan_packet_t::tscan_packet_t(const c_str&    packet_id,
                                tuple_fifo*     output_buffer,
                                tuple_filter_t* output_filter,
@@ -69,6 +68,12 @@ tscan_packet_t::tscan_packet_t(const c_str&    packet_id,
     assert(_db);
     assert(_table);
     assert(_xct);
+
+    _circular = (envVar::instance()->getVarInt("qpipe-tscan-circular", 1) != 0);
+    if (!_circular) {
+        // independent scans
+        disable_merging();
+    }
 }
 
 
@@ -86,10 +91,372 @@ void tscan_packet_t::declare_worker_needs(resource_declare_t* declare)
 }
 
 
-// Ideally, we would like to allocate a large blob and do bulk reading. 
-// The blob must be aligned for int accesses and a multiple of 1024 bytes long.
+const uint tscan_stage_t::DEFAULT_MORSEL_PAGES = 64;
+const uint tscan_stage_t::MAX_TSCAN_HELPERS = 16;
+
+pthread_mutex_t tscan_stage_t::_stats_mutex = thread_mutex_create();
+std::map<c_str, tscan_stats_t> tscan_stage_t::_stats;
+
+
+
+/******************************************************************
+ * 
+ * @struct: morsel_t
+ *
+ * @brief:  A run of pages of the file, from the record (_start) up to
+ *          the first page of the next morsel, read into (_fifo)
+ *
+ ******************************************************************/
+
+struct tscan_stage_t::morsel_t 
+{
+    rid_t       _start;
+    shpid_t     _end_page;
+    bool        _last;      // up to the end of the file
+    tuple_fifo* _fifo;
+    ulong_t     _pages;     // set by the helper before the EOF
+
+    morsel_t(const rid_t& start, tuple_fifo* fifo)
+        : _start(start), _end_page(0), _last(false), _fifo(fifo), _pages(0)
+    { }
+
+    ~morsel_t() { if (_fifo) delete (_fifo); }
+};
+
+
+
+/******************************************************************
+ * 
+ * @class:  morsel_queue_t
+ *
+ * @brief:  The morsels of a parallel scan. The helpers claim them in
+ *          file order, by moving a cursor (_pages) pages ahead. The
+ *          TSCAN worker reads them in the same order.
+ *
+ * @note:   At most (_window) morsels are claimed and not yet read, so
+ *          that the helpers do not run away from the worker.
+ *
+ ******************************************************************/
+
+class tscan_stage_t::morsel_queue_t 
+{
+    tscan_packet_t*          _packet;
+    stage_t::adaptor_t*      _adaptor;
+    int                      _helpers;
+    uint                     _pages;
+    uint                     _window;
+    uint                     _tuple_size;
+
+    pthread_mutex_t          _lock;
+    pthread_cond_t           _claimed;
+    pthread_cond_t           _consumed;
+
+    guard<scan_file_i>       _cursor;
+    pin_i*                   _cursor_pin;
+
+    std::vector<morsel_t*>       _morsels;
+    std::vector<morsel_reader_t*> _readers;
+    uint                     _next_read;
+    bool                     _done;     // no more morsels to claim
+    bool                     _stop;     // the worker stopped reading
+
+    void _finish(const w_rc_t& e);
+
+public:
+
+    morsel_queue_t(tscan_packet_t* packet, stage_t::adaptor_t* adaptor,
+                   int helpers, uint pages);
+    ~morsel_queue_t();
+
+    tscan_packet_t* packet() { return (_packet); }
+    uint tuple_size() const { return (_tuple_size); }
+
+    void start();
+
+    // helper side
+    morsel_t* claim();
+    void fail(const w_rc_t& e);
+
+    // worker side, NULL when the file is over
+    morsel_t* next();
+    void consumed(morsel_t* morsel);
+    
+}; // EOF: morsel_queue_t
+
+
+
+/******************************************************************
+ * 
+ * @class:  morsel_reader_t
+ *
+ * @brief:  Helper thread that reads the morsels it claims, inside the
+ *          xct of the packet
+ *
+ ******************************************************************/
+
+class tscan_stage_t::morsel_reader_t : public thread_t 
+{
+    morsel_queue_t* _queue;
+
+    bool _read(morsel_t* morsel);
+
+public:
+
+    morsel_reader_t(morsel_queue_t* queue, int id)
+        : thread_t(c_str("TSCAN_MORSEL_READER_%d", id)), _queue(queue)
+    { }
+
+    void work();
+
+}; // EOF: morsel_reader_t
+
+
+
+tscan_stage_t::morsel_queue_t::morsel_queue_t(tscan_packet_t* packet, 
+                                              stage_t::adaptor_t* adaptor,
+                                              int helpers, uint pages)
+    : _packet(packet), _adaptor(adaptor), _helpers(helpers), 
+      _pages(pages), _window(2*helpers), 
+      _tuple_size(packet->_table->maxsize()),
+      _lock(thread_mutex_create()), 
+      _claimed(thread_cond_create()), _consumed(thread_cond_create()),
+      _cursor_pin(NULL), _next_read(0), _done(false), _stop(false)
+{
+    assert (_helpers > 0);
+    assert (_pages > 0);
+}
+
+
+/******************************************************************
+ * 
+ * @fn:     ~morsel_queue_t
+ *
+ * @brief:  Stops the helpers, also when the worker leaves early with
+ *          a stop_exception. The fifos are terminated so that helpers
+ *          waiting on a full fifo wake up, and they are deleted only
+ *          after the helpers are joined.
+ *
+ ******************************************************************/
+
+tscan_stage_t::morsel_queue_t::~morsel_queue_t()
+{
+    {
+        critical_section_t cs(_lock);
+        _stop = true;
+        for (uint i=_next_read; i<_morsels.size(); i++) {
+            _morsels[i]->_fifo->terminate();
+        }
+        thread_cond_broadcast(_claimed);
+        thread_cond_broadcast(_consumed);
+    }
 
-const size_t tscan_stage_t::TSCAN_BULK_READ_BUFFER_SIZE=256*KB;
+    for (uint i=0; i<_readers.size(); i++) {
+        _readers[i]->join();
+        delete (_readers[i]);
+    }
+    _readers.clear();
+
+    for (uint i=0; i<_morsels.size(); i++) {
+        delete (_morsels[i]);
+    }
+    _morsels.clear();
+
+    // the cursor is closed while the worker is attached to the xct
+    _cursor.done();
+    _adaptor->release_helpers(_helpers);
+
+    thread_cond_destroy(_claimed);
+    thread_cond_destroy(_consumed);
+    thread_mutex_destroy(_lock);
+}
+
+
+void tscan_stage_t::morsel_queue_t::start()
+{
+    for (int i=0; i<_helpers; i++) {
+        morsel_reader_t* reader = new morsel_reader_t(this, i);
+        _readers.push_back(reader);
+        reader->fork();
+    }
+}
+
+
+/******************************************************************
+ * 
+ * @fn:     claim
+ *
+ * @brief:  Cuts the next morsel. It starts at the record the cursor is
+ *          on and ends where the cursor is (_pages) pages later.
+ *
+ * @return: NULL if there is nothing left to read
+ *
+ ******************************************************************/
+
+tscan_stage_t::morsel_t* tscan_stage_t::morsel_queue_t::claim()
+{
+    critical_section_t cs(_lock);
+    while (!_done && !_stop && (_morsels.size() - _next_read >= _window)) {
+        thread_cond_wait(_consumed, _lock);
+    }
+    if (_done || _stop) return (NULL);
+
+    w_rc_t e = RCOK;
+    bool eof = false;
+    if (!_cursor.get()) {
+        _cursor = new scan_file_i(_packet->_table->fid(), 
+                                  ss_m::t_cc_none, false);
+        e = _cursor->next(_cursor_pin, 0, eof);
+    }
+    if (e.is_error() || eof) {
+        _finish(e);
+        return (NULL);
+    }
+
+    rid_t start = _cursor_pin->rid();
+    for (uint i=0; (i<_pages) && !eof; i++) {
+        e = _cursor->next_page(_cursor_pin, 0, eof);
+        if (e.is_error()) {
+            _finish(e);
+            return (NULL);
+        }
+    }
+
+    morsel_t* morsel = new morsel_t(start, new tuple_fifo(_tuple_size));
+    if (eof) {
+        morsel->_last = true;
+        _done = true;
+    }
+    else {
+        morsel->_end_page = _cursor_pin->rid().pid.page;
+    }
+    _morsels.push_back(morsel);
+    thread_cond_broadcast(_claimed);
+    return (morsel);
+}
+
+
+// THE CALLER MUST BE HOLDING _lock
+void tscan_stage_t::morsel_queue_t::_finish(const w_rc_t& e)
+{
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "Cursor of (%s) failed (%d)\n",
+               _packet->_table->name(), e.err_num());
+    }
+    _done = true;
+    thread_cond_broadcast(_claimed);
+}
+
+
+void tscan_stage_t::morsel_queue_t::fail(const w_rc_t& e)
+{
+    TRACE( TRACE_ALWAYS, "Morsel of (%s) failed (%d)\n",
+           _packet->_table->name(), e.err_num());
+    critical_section_t cs(_lock);
+    _done = true;
+    thread_cond_broadcast(_claimed);
+}
+
+
+tscan_stage_t::morsel_t* tscan_stage_t::morsel_queue_t::next()
+{
+    critical_section_t cs(_lock);
+    while ((_next_read >= _morsels.size()) && !_done) {
+        thread_cond_wait(_claimed, _lock);
+    }
+    if (_next_read >= _morsels.size()) return (NULL);
+    return (_morsels[_next_read]);
+}
+
+
+void tscan_stage_t::morsel_queue_t::consumed(morsel_t* morsel)
+{
+    critical_section_t cs(_lock);
+    assert (_morsels[_next_read] == morsel);
+
+    // the helper sent the EOF, it does not touch the fifo anymore
+    delete (morsel->_fifo);
+    morsel->_fifo = NULL;
+    _next_read++;
+    thread_cond_broadcast(_consumed);
+}
+
+
+
+/******************************************************************
+ * 
+ * @fn:     morsel_reader_t::work
+ *
+ * @brief:  Claims and reads morsels until there are none left or the
+ *          worker stops
+ *
+ ******************************************************************/
+
+void tscan_stage_t::morsel_reader_t::work()
+{
+    xct_t* pxct = _queue->packet()->_xct;
+    smthread_t::me()->attach_xct(pxct);
+
+    morsel_t* morsel;
+    while ((morsel = _queue->claim()) != NULL) {
+        if (!_read(morsel)) break;
+    }
+
+    smthread_t::me()->detach_xct(pxct);
+}
+
+
+/******************************************************************
+ * 
+ * @fn:     morsel_reader_t::_read
+ *
+ * @brief:  Reads the records of a morsel into its fifo, with the same
+ *          concurrency control as a serial scan
+ *
+ * @return: false if the helper should stop
+ *
+ ******************************************************************/
+
+bool tscan_stage_t::morsel_reader_t::_read(morsel_t* morsel)
+{
+    tscan_packet_t* packet = _queue->packet();
+    tuple_fifo* fifo = morsel->_fifo;
+    uint tsz = _queue->tuple_size();
+    fifo->writer_init();
+
+    try {
+        scan_file_i scan(packet->_table->fid(), morsel->_start, 
+                         ss_m::t_cc_record, false, packet->_lm);
+        bool eof(false);
+        pin_i* handle(NULL);
+        shpid_t last_page(0);
+        ulong_t pages(0);
+
+        w_rc_t e = scan.next(handle, 0, eof);
+        while (!e.is_error() && !eof) {
+            shpid_t page = handle->rid().pid.page;
+            if (!morsel->_last && (page == morsel->_end_page)) break;
+            if ((pages == 0) || (page != last_page)) {
+                last_page = page;
+                pages++;
+            }
+
+            fifo->append(tuple_t((char*)handle->body(), tsz));
+            e = scan.next(handle, 0, eof);
+        }
+
+        morsel->_pages = pages;
+        if (e.is_error()) {
+            _queue->fail(e);
+            fifo->terminate();
+            return (false);
+        }
+        return (fifo->send_eof());
+    }
+    catch (TerminatedBufferException &e) {
+        // the worker stopped reading
+        return (false);
+    }
+}
 
 
 
@@ -105,7 +472,8 @@ const size_t tscan_stage_t::TSCAN_BULK_READ_BUFFER_SIZE=256*KB;
  * 
  * @fn:     Stage for table scans
  *
- * @brief:  Read the specified table.
+ * @brief:  Read the specified table. If there are idle TSCAN workers
+ *          the table is read by them in morsels, else by this thread.
  *
  * @return: 0 on success. Non-zero on unrecoverable error. The stage
  *          should terminate all queries it is processing.
@@ -116,14 +484,49 @@ void tscan_stage_t::process_packet()
 {
     adaptor_t* adaptor = _adaptor;
     tscan_packet_t* packet = (tscan_packet_t*)adaptor->get_packet();
-    smthread_t::me()->attach_xct(packet->_xct);
+
+    // Detaches the xct and records the pages of this scan, also when 
+    // the adaptor stops it early because every packet has wrapped
+    struct scan_pass_t {
+        tscan_packet_t* _packet;
+        tscan_stats_t   _stats;
+
+        scan_pass_t(tscan_packet_t* packet) : _packet(packet) {
+            smthread_t::me()->attach_xct(_packet->_xct);
+            _stats._scans = 1;
+        }
+        ~scan_pass_t() {
+            smthread_t::me()->detach_xct(_packet->_xct);
+            tscan_stage_t::add_stats(_packet->_table->name(), _stats);
+        }
+    } pass(packet);
+
+    envVar* ev = envVar::instance();
+    int helpers = ev->getVarInt("qpipe-tscan-helpers", 0);
+    helpers = std::max(0, std::min(helpers, (int)MAX_TSCAN_HELPERS));
+    helpers = adaptor->reserve_helpers(helpers);
+
+    if (helpers == 0) {
+        scan_serial(packet, pass._stats);
+    }
+    else {
+        int pages = ev->getVarInt("qpipe-tscan-morsel-pages", 
+                                  DEFAULT_MORSEL_PAGES);
+        scan_parallel(packet, helpers, std::max(1, pages), pass._stats);
+    }
+}
+
+
+void tscan_stage_t::scan_serial(tscan_packet_t* packet, tscan_stats_t& stats)
+{
+    adaptor_t* adaptor = _adaptor;
     
     // Create and open scan
     simple_table_iter_t tscanner(packet->_db, packet->_table, packet->_lm);
     bool eof(false);
     pin_i* handle(NULL);
-    uint pcnt=0;
     uint  tsz(packet->_table->maxsize());
+    shpid_t last_page(0);
     //char* tbd=0;
 
     w_rc_t e = tscanner.next(eof,handle);
@@ -131,6 +534,13 @@ void tscan_stage_t::process_packet()
         //assert (tsz == handle.body_size());
         //TRACE( TRACE_ALWAYS, "(%d) (%d)\n", tsz, handle->body_size());
 
+        // On every new page, count it once for each attached packet
+        if ((stats._pages_read == 0) || (handle->rid().pid.page != last_page)) {
+            last_page = handle->rid().pid.page;
+            stats._pages_read++;
+            stats._pages_delivered += adaptor->packet_count();
+        }
+
         // Copy the record out of the SM
         //tbd = new char[tsz];        
         //memcpy(tbd,handle->body(),tsz);
@@ -145,8 +555,87 @@ void tscan_stage_t::process_packet()
     // for(page_list::iterator it=table->begin(); it != table->end(); ++it) {
     //     adaptor->output(*it);
     // }
+}
+
+
+/******************************************************************
+ * 
+ * @fn:     scan_parallel
+ *
+ * @brief:  The helpers read the morsels, this thread outputs them in
+ *          order. The filters of the packets are applied here, since
+ *          each merged packet has its own.
+ *
+ * @note:   The helpers were reserved by the caller, the queue gives
+ *          them back
+ *
+ ******************************************************************/
+
+void tscan_stage_t::scan_parallel(tscan_packet_t* packet, int helpers, 
+                                  uint pages, tscan_stats_t& stats)
+{
+    adaptor_t* adaptor = _adaptor;
+    morsel_queue_t queue(packet, adaptor, helpers, pages);
+    queue.start();
+
+    guard<qpipe::page> out = qpipe::page::alloc(queue.tuple_size());
+    morsel_t* morsel;
+    while ((morsel = queue.next()) != NULL) {
+        try {
+            while (morsel->_fifo->copy_page(out)) {
+                adaptor->output(out);
+            }
+        }
+        catch (TerminatedBufferException &e) {
+            // the helper failed, like a serial scan we stop here
+            break;
+        }
+
+        stats._morsels++;
+        stats._pages_read += morsel->_pages;
+        stats._pages_delivered += morsel->_pages * adaptor->packet_count();
+        queue.consumed(morsel);
+    }
+}
+
+
+
+/******************************************************************
+ * 
+ * @fn:     add_stats/clear_stats/trace_stats
+ *
+ * @brief:  The statistics of the scans, per table
+ *
+ ******************************************************************/
+
+void tscan_stage_t::add_stats(const c_str& table, const tscan_stats_t& stats)
+{
+    critical_section_t cs(_stats_mutex);
+    tscan_stats_t& s = _stats[table];
+    s._scans += stats._scans;
+    s._pages_read += stats._pages_read;
+    s._pages_delivered += stats._pages_delivered;
+    s._morsels += stats._morsels;
+}
+
 
-    smthread_t::me()->detach_xct(packet->_xct);
+void tscan_stage_t::clear_stats()
+{
+    critical_section_t cs(_stats_mutex);
+    _stats.clear();
+}
+
+
+void tscan_stage_t::trace_stats()
+{
+    critical_section_t cs(_stats_mutex);
+    std::map<c_str, tscan_stats_t>::iterator it;
+    for (it = _stats.begin(); it != _stats.end(); ++it) {
+        const tscan_stats_t& s = it->second;
+        TRACE( TRACE_ALWAYS, "TSCAN %s: Scans (%lu) Read (%lu) Delivered (%lu) Saved (%lu) Morsels (%lu)\n",
+               it->first.data(), s._scans, s._pages_read, 
+               s._pages_delivered, s.pages_saved(), s._morsels);
+    }
 }
 
 
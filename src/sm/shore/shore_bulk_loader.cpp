@@ -0,0 +1,456 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_bulk_loader.cpp
+ *
+ *  @brief:  Implementation of the sorted runs used for building the
+ *           indexes bottom-up
+ */
+
+#include "sm/shore/shore_bulk_loader.h"
+#include "sm/shore/shore_table.h"
+
+#include <algorithm>
+
+
+using namespace shore;
+
+
+
+/******************************************************************
+ *
+ *  @struct: run_entry_less
+ *
+ *  @brief:  Orders the pointers to the entries of a run, by their key
+ *
+ ******************************************************************/
+
+struct run_entry_less
+{
+    const bulk_runs_t* _runs;
+    run_entry_less(const bulk_runs_t* aruns) : _runs(aruns) { }
+    bool operator()(const char* a, const char* b) const {
+        return (_runs->compare(a,b) < 0);
+    }
+};
+
+
+
+/******************************************************************
+ *
+ *  class bulk_runs_t
+ *
+ ******************************************************************/
+
+bulk_runs_t::bulk_runs_t(table_desc_t* ptable, index_desc_t* pindex,
+                         const int pnum, const uint_t run_bytes)
+    : _pindex(pindex), _pnum(pnum), _key_sz(0), _entry_sz(0),
+      _buf(NULL), _run_entries(0), _entries(0), _total(0)
+{
+    assert (ptable);
+    assert (_pindex);
+
+    // The key description of each field, as in field_desc_t::keydesc()
+    uint_t offset = 0;
+    for (uint_t i=0; i<_pindex->field_count(); i++) {
+        field_desc_t* pfd = ptable->desc(_pindex->key_index(i));
+        key_field_t kf;
+        switch (pfd->type()) {
+        case SQL_BIT:
+        case SQL_SMALLINT:
+        case SQL_CHAR:
+        case SQL_INT:
+            kf._kind = 'i'; break;
+        case SQL_FLOAT:
+        case SQL_LONG:
+            kf._kind = 'f'; break;
+        default:
+            kf._kind = 'b'; break;
+        }
+        kf._offset = offset;
+        kf._size = pfd->fieldmaxsize();
+        _fields.push_back(kf);
+        offset += kf._size;
+    }
+    _key_sz = ptable->index_maxkeysize(_pindex);
+    assert (_key_sz == offset);
+    _entry_sz = _key_sz + sizeof(rid_t);
+
+    _run_entries = run_bytes / _entry_sz;
+    if (_run_entries == 0) _run_entries = 1;
+}
+
+
+bulk_runs_t::~bulk_runs_t()
+{
+    if (_buf) free (_buf);
+    for (uint_t i=0; i<_runs.size(); i++) {
+        fclose(_runs[i]);
+    }
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:     compare
+ *
+ *  @brief:  Compares two keys field by field
+ *
+ *  @note:   The fields of the key are at fixed offsets (see format_key)
+ *
+ ******************************************************************/
+
+template<class T>
+static inline int _cmp_native(const char* a, const char* b)
+{
+    T va, vb;
+    memcpy(&va, a, sizeof(T));
+    memcpy(&vb, b, sizeof(T));
+    return ((va < vb) ? -1 : ((vb < va) ? 1 : 0));
+}
+
+int bulk_runs_t::compare(const char* akey, const char* bkey) const
+{
+    int r = 0;
+    for (uint_t i=0; i<_fields.size(); i++) {
+        const key_field_t& kf = _fields[i];
+        const char* a = akey + kf._offset;
+        const char* b = bkey + kf._offset;
+
+        if (kf._kind == 'i') {
+            switch (kf._size) {
+            case 1: r = _cmp_native<char>(a,b); break;
+            case 2: r = _cmp_native<short>(a,b); break;
+            case 4: r = _cmp_native<int>(a,b); break;
+            default: r = _cmp_native<int64_t>(a,b); break;
+            }
+        }
+        else if (kf._kind == 'f') {
+            if (kf._size == sizeof(float))
+                r = _cmp_native<float>(a,b);
+            else
+                r = _cmp_native<double>(a,b);
+        }
+        else {
+            r = memcmp(a, b, kf._size);
+        }
+        if (r) return (r);
+    }
+    return (0);
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:     append
+ *
+ *  @brief:  Adds a (key,rid) pair to the run in memory. If the run
+ *           is full it is sorted and spilled first.
+ *
+ ******************************************************************/
+
+w_rc_t bulk_runs_t::append(const char* key, const rid_t& rid)
+{
+    assert (key);
+    if (!_buf) {
+        _buf = (char*)malloc(_run_entries*_entry_sz);
+        if (!_buf) return RC(se_ERROR_IN_IDX_LOAD);
+    }
+    if (_entries == _run_entries) {
+        W_DO(_spill());
+    }
+    char* pos = _buf + _entries*_entry_sz;
+    memcpy(pos, key, _key_sz);
+    memcpy(pos + _key_sz, &rid, sizeof(rid_t));
+    ++_entries;
+    return (RCOK);
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:     _spill
+ *
+ *  @brief:  Sorts the run in memory and writes it to a temporary file
+ *
+ ******************************************************************/
+
+w_rc_t bulk_runs_t::_spill()
+{
+    if (_entries == 0) return (RCOK);
+
+    std::vector<char*> order(_entries);
+    for (uint_t i=0; i<_entries; i++) {
+        order[i] = _buf + i*_entry_sz;
+    }
+    std::sort(order.begin(), order.end(), run_entry_less(this));
+
+    FILE* fd = tmpfile();
+    if (!fd) {
+        TRACE( TRACE_ALWAYS, "Could not create run for (%s)\n",
+               _pindex->name());
+        return RC(se_ERROR_IN_IDX_LOAD);
+    }
+    for (uint_t i=0; i<_entries; i++) {
+        if (fwrite(order[i], _entry_sz, 1, fd) != 1) {
+            fclose(fd);
+            return RC(se_ERROR_IN_IDX_LOAD);
+        }
+    }
+    _runs.push_back(fd);
+
+    TRACE( TRACE_TRX_FLOW, "Run (%d) of (%s) (%d): %d entries\n",
+           _runs.size(), _pindex->name(), _pnum, _entries);
+
+    _total += _entries;
+    _entries = 0;
+    return (RCOK);
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:     build
+ *
+ *  @brief:  Loads the index partition from the sorted runs. It first
+ *           tries the bulk-loading of the B-tree and, if the index
+ *           cannot be bulk-loaded, inserts the entries in key order.
+ *
+ *  @note:   Each phase runs in its own trxs
+ *
+ ******************************************************************/
+
+w_rc_t bulk_runs_t::build(ss_m* db, const vid_t& vid)
+{
+    assert (db);
+    W_DO(_spill());
+    if (_buf) {
+        free (_buf);
+        _buf = NULL;
+    }
+    if (_total == 0) return (RCOK);
+
+    TRACE( TRACE_DEBUG, "Building (%s) (%d) from (%d) runs - (%d) entries\n",
+           _pindex->name(), _pnum, _runs.size(), _total);
+
+    if (!_pindex->is_mr()) {
+        w_rc_t e = _build_bulk(db, vid);
+        if (!e.is_error()) return (RCOK);
+
+        TRACE( TRACE_ALWAYS,
+               "Bulk-loading (%s) (%d) failed [0x%x]. Inserting...\n",
+               _pindex->name(), _pnum, e.err_num());
+    }
+    return (_build_inserts(db));
+}
+
+
+w_rc_t bulk_runs_t::_build_bulk(ss_m* db, const vid_t& vid)
+{
+    // 1. merge the runs to a temporary file, with the key on the header
+    //    and the rid on the body of each record
+    stid_t tmpfid;
+    W_DO(db->begin_xct());
+    W_DO(db->create_file(vid, tmpfid, smlevel_3::t_temporary));
+    W_DO(db->commit_xct());
+    W_DO(db->begin_xct());
+
+    bulk_merge_t merge(this, _runs, _entry_sz);
+    const char* key = NULL;
+    rid_t rid;
+    rid_t tmprid;
+    uint_t cnt = 0;
+    w_rc_t e;
+    while (merge.next(key, rid)) {
+        e = db->create_rec(tmpfid,
+                           vec_t(key, _key_sz),
+                           sizeof(rid_t),
+                           vec_t(&rid, sizeof(rid_t)),
+                           tmprid,
+                           true);
+        if (e.is_error()) break;
+        if ((++cnt % COMMIT_ACTION_COUNT) == 0) {
+            e = db->commit_xct();
+            if (e.is_error()) break;
+            e = db->begin_xct();
+            if (e.is_error()) break;
+        }
+    }
+
+    // 2. build the B-tree
+    if (!e.is_error()) {
+        sm_du_stats_t stats;
+        e = db->bulkld_index(_pindex->fid(_pnum), 1, &tmpfid, stats,
+                             true, true);
+    }
+    if (e.is_error()) {
+        W_DO(db->abort_xct());
+        W_DO(db->begin_xct());
+    }
+
+    // 3. drop the temporary file
+    W_DO(db->destroy_file(tmpfid));
+    W_DO(db->commit_xct());
+    return (e);
+}
+
+
+w_rc_t bulk_runs_t::_build_inserts(ss_m* db)
+{
+    bulk_merge_t merge(this, _runs, _entry_sz);
+    const char* key = NULL;
+    rid_t rid;
+    uint_t cnt = 0;
+    w_rc_t e;
+
+    W_DO(db->begin_xct());
+    while (merge.next(key, rid)) {
+        if (_pindex->is_mr()) {
+	    ss_m::RELOCATE_RECORD_CALLBACK_FUNC reloc_func =
+                &table_man_t::relocate_records;
+            el_filler ef;
+            ef._el.put(vec_t(&rid, sizeof(rid_t)));
+            e = db->create_mr_assoc(_pindex->fid(_pnum),
+                                    vec_t(key, _key_sz),
+                                    ef,
+                                    true,
+                                    _pindex->is_latchless(),
+                                    reloc_func);
+        }
+        else {
+            e = db->create_assoc(_pindex->fid(_pnum),
+                                 vec_t(key, _key_sz),
+                                 vec_t(&rid, sizeof(rid_t)),
+                                 true);
+        }
+        if (e.is_error()) {
+            W_COERCE(db->abort_xct());
+            return (e);
+        }
+        if ((++cnt % COMMIT_ACTION_COUNT) == 0) {
+            W_DO(db->commit_xct());
+            W_DO(db->begin_xct());
+        }
+    }
+    W_DO(db->commit_xct());
+    return (RCOK);
+}
+
+
+
+/******************************************************************
+ *
+ *  class bulk_merge_t
+ *
+ ******************************************************************/
+
+bulk_merge_t::bulk_merge_t(const bulk_runs_t* runs,
+                           const std::vector<FILE*>& files,
+                           const uint_t entry_sz)
+    : _runs(runs), _files(files), _entry_sz(entry_sz)
+{
+    assert (_runs);
+    _last = new char[_entry_sz];
+    _heads.resize(_files.size());
+    for (uint_t i=0; i<_files.size(); i++) {
+        rewind(_files[i]);
+        _heads[i] = new char[_entry_sz];
+        if (_read(i)) _heap.push_back(i);
+    }
+    // heapify
+    for (int i=(int)_heap.size()/2-1; i>=0; i--) {
+        _sift_down(i);
+    }
+}
+
+
+bulk_merge_t::~bulk_merge_t()
+{
+    for (uint_t i=0; i<_heads.size(); i++) {
+        delete [] _heads[i];
+    }
+    delete [] _last;
+}
+
+
+bool bulk_merge_t::_read(const int run)
+{
+    return (fread(_heads[run], _entry_sz, 1, _files[run]) == 1);
+}
+
+
+bool bulk_merge_t::_less(const int a, const int b) const
+{
+    return (_runs->compare(_heads[a], _heads[b]) < 0);
+}
+
+
+void bulk_merge_t::_sift_down(uint_t pos)
+{
+    uint_t sz = _heap.size();
+    while (true) {
+        uint_t min = pos;
+        uint_t l = 2*pos+1;
+        uint_t r = l+1;
+        if ((l < sz) && _less(_heap[l], _heap[min])) min = l;
+        if ((r < sz) && _less(_heap[r], _heap[min])) min = r;
+        if (min == pos) return;
+        std::swap(_heap[pos], _heap[min]);
+        pos = min;
+    }
+}
+
+
+/******************************************************************
+ *
+ *  @fn:     next
+ *
+ *  @brief:  Returns the smallest entry among the heads of the runs
+ *
+ *  @note:   The returned key is valid until the next call
+ *
+ ******************************************************************/
+
+bool bulk_merge_t::next(const char*& key, rid_t& rid)
+{
+    if (_heap.empty()) return (false);
+
+    int run = _heap[0];
+    uint_t key_sz = _entry_sz - sizeof(rid_t);
+    memcpy(&rid, _heads[run] + key_sz, sizeof(rid_t));
+
+    // keep the key, before the head of the run gets replaced
+    memcpy(_last, _heads[run], key_sz);
+    key = _last;
+
+    if (!_read(run)) {
+        _heap[0] = _heap.back();
+        _heap.pop_back();
+    }
+    if (!_heap.empty()) _sift_down(0);
+    return (true);
+}
@@ -28,6 +28,8 @@
  *  @author: Ippokratis Pandis, July 2008
  */
 
+#include <cmath>
+
 #include "sm/shore/shore_client.h"
 
 ENTER_NAMESPACE(shore);
@@ -81,6 +83,93 @@ w_rc_t base_client_t::submit_batch(int xct_type, int& trx_cnt, const int batch_s
     return (RCOK);
 }
 
+/********************************************************************* 
+ *
+ *  @class: open_loop_t
+ *
+ *  @brief: The arrivals of an open-loop run
+ *
+ *********************************************************************/
+
+open_loop_stats_t& open_loop_stats_t::operator-=(const open_loop_stats_t& rhs)
+{
+    _arrived -= rhs._arrived;
+    _dropped -= rhs._dropped;
+    _done -= rhs._done;
+    _aborted -= rhs._aborted;
+    return (*this);
+}
+
+
+open_loop_t::open_loop_t(const double rate, const uint max_out)
+    : _rate(rate), _max_out(max_out), _running(false), _next(0), 
+      _arrived(0), _dropped(0), _done(0), _aborted(0), _out(0)
+{
+    assert (_rate > 0);
+    assert (_max_out > 0);
+}
+
+void open_loop_t::start()
+{
+    CRITICAL_SECTION(cs, _lock);
+    _next = trx_latency_now();
+    _running = true;
+}
+
+void open_loop_t::stop()
+{
+    CRITICAL_SECTION(cs, _lock);
+    _running = false;
+}
+
+long long open_loop_t::next_arrival(bool& admitted)
+{
+    CRITICAL_SECTION(cs, _lock);
+    if (!_running) return (0);
+
+    // exponential inter-arrival times, -ln(U)/rate, with U in (0,1]
+    long long at = (long long)_next;
+    double u = 1.0 - sthread_t::drand();
+    _next += -log(u)*1000000./_rate;
+
+    ++_arrived;
+    admitted = (*&_out < _max_out);
+    if (admitted) atomic_inc_uint(&_out);
+    else ++_dropped;
+    return (at);
+}
+
+void open_loop_t::trx_done(const uint_t /* tag */, const TrxState state)
+{
+    if (state == ROLLBACKED) atomic_inc_64(&_aborted);
+    atomic_inc_64(&_done);
+    atomic_dec_uint(&_out);
+}
+
+void open_loop_t::cancel()
+{
+    atomic_dec_uint(&_out);
+}
+
+bool open_loop_t::drain(const int secs)
+{
+    for (int i=0; (i<secs*1000) && (*&_out > 0); i++) {
+        usleep(1000);
+    }
+    return (*&_out == 0);
+}
+
+void open_loop_t::get_stats(open_loop_stats_t& stats)
+{
+    CRITICAL_SECTION(cs, _lock);
+    stats._arrived = _arrived;
+    stats._dropped = _dropped;
+    stats._done = *&_done;
+    stats._aborted = *&_aborted;
+}
+
+
+
 static pthread_mutex_t client_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_cond_t client_cond = PTHREAD_COND_INITIALIZER;
 static int client_needed_count;
@@ -168,6 +257,31 @@ w_rc_t base_client_t::run_xcts(int xct_type, int num_xct)
 	_cp->wait();	
         break;
 
+        // case of open-loop measurement
+    case (MT_OPEN_LOOP):
+
+        // take the arrivals until the driver stops, and submit them
+        // without waiting. The driver waits for the trxs in flight.
+        assert (_driver);
+        while (true) {
+            bool admitted = false;
+            long long at = _driver->next_arrival(admitted);
+            if (at == 0) break;
+
+            long long wait = at - trx_latency_now();
+            if (wait > 0) usleep(wait);
+
+            if (_abort_test || _env->get_measure() == MST_DONE) {
+                if (admitted) _driver->cancel();
+                break;
+            }
+            if (!admitted) continue;
+
+            set_trx_arrival(at, _driver);
+            W_COERCE(submit_one(xct_type, i++));
+        }
+        break;
+
     default:
         assert (0); // UNSUPPORTED MEASUREMENT TYPE
         break;
@@ -0,0 +1,135 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_column_scan.cpp
+ *
+ *  @brief:  Implementation of the column-at-a-time table scan
+ */
+
+#include "sm/shore/shore_column_scan.h"
+#include "sm/shore/shore_table.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+/******************************************************************
+ *
+ *  @fn:    fixed_field_offset
+ *
+ *  @brief: Calculates the offset of a field the same way
+ *          table_row_t::setup() does. The fixed-length fields are
+ *          stored in order, after the NULL bitmap.
+ *
+ ******************************************************************/
+
+offset_t fixed_field_offset(table_desc_t* ptable, const uint_t fid)
+{
+    assert (ptable);
+    assert (fid < ptable->field_count());
+
+    table_row_t arow(ptable);
+    assert (!arow._pvalues[fid].is_variable_length());
+    assert (!arow._pvalues[fid].field_desc()->allow_null());
+
+    offset_t offset = arow.get_fixed_offset();
+    for (uint_t i=0; i<fid; i++) {
+        if (!arow._pvalues[i].is_variable_length()) {
+            offset += arow._pvalues[i].maxsize();
+        }
+    }
+    return (offset);
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:    Constructor
+ *
+ *  @brief: Calculates the offsets of the requested fields and
+ *          allocates the columns
+ *
+ ******************************************************************/
+
+column_scan_t::column_scan_t(ss_m* db, table_desc_t* ptable,
+                             const uint_t* fields, const uint_t nfields,
+                             lock_mode_t alm)
+    : _ptable(ptable), _iter(db, ptable, alm), _ncols(nfields)
+{
+    assert (_ptable);
+    assert (fields);
+
+    table_row_t arow(_ptable);
+
+    for (uint_t i=0; i<_ncols; i++) {
+        uint_t fid = fields[i];
+        _offsets.push_back(fixed_field_offset(_ptable, fid));
+        _sizes.push_back(arow._pvalues[fid].maxsize());
+        _cols.push_back((char*)malloc(COLUMN_BATCH_ROWS*_sizes[i]));
+    }
+}
+
+
+column_scan_t::~column_scan_t()
+{
+    for (uint_t i=0; i<_ncols; i++) {
+        free (_cols[i]);
+    }
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:    next_batch
+ *
+ *  @brief: Copies the requested fields of the next (up to)
+ *          COLUMN_BATCH_ROWS records to the columns
+ *
+ ******************************************************************/
+
+w_rc_t column_scan_t::next_batch(uint_t& rows, bool& eof)
+{
+    rows = 0;
+    eof = false;
+
+    pin_i* handle = NULL;
+    while (rows < COLUMN_BATCH_ROWS) {
+        W_DO(_iter.next(eof, handle));
+        if (eof) break;
+
+        const char* body = handle->body();
+        for (uint_t i=0; i<_ncols; i++) {
+            memcpy(_cols[i] + rows*_sizes[i], body + _offsets[i], _sizes[i]);
+        }
+        rows++;
+    }
+
+    // report eof only with the last (empty) batch
+    if (rows) eof = false;
+    return (RCOK);
+}
+
+
+EXIT_NAMESPACE(shore);
@@ -97,7 +97,6 @@ ShoreEnv::ShoreEnv()
       _measure(MST_UNDEF),
       _pd(PD_NORMAL),
       _insert_freq(0),_delete_freq(0),_probe_freq(100),
-      _request_pool(sizeof(trx_request_t)),
       _bUseSLI(false),_bUseELR(false),_bUseFlusher(false),
       _bAlarmSet(false), _start_imbalance(0), _skew_type(SKEW_NONE)
 {
@@ -392,6 +391,33 @@ trx_worker_t* ShoreEnv::worker(const uint idx)
 
 
 
+/****************************************************************** 
+ *
+ *  @fn:    submit_xct
+ *
+ *  @brief: Enqueues a request for a trx to one of the workers, the
+ *          same way the baseline clients do. The (spec_id) selects
+ *          the input of the trx, as the selected id of the clients.
+ *
+ ******************************************************************/
+
+w_rc_t ShoreEnv::submit_xct(const int xct_type, const int xct_id,
+                            const int spec_id, trx_result_tuple_t& atrt,
+                            const uint worker_hint, const bool bWake)
+{
+    assert (!_workers.empty());
+
+    // Get one action from the trash stack
+    trx_request_t* arequest = _request_pool.borrow();
+    tid_t atid;
+    arequest->set(NULL,atid,xct_id,atrt,xct_type,spec_id);
+
+    worker(worker_hint)->enqueue(arequest,bWake);
+    return (RCOK);
+}
+
+
+
 
 /********
  ******** Caution: The functions below should be invoked inside
@@ -504,13 +530,28 @@ int ShoreEnv::start()
     _start_flusher();
 #endif
 
+    // with numa-placement the workers are spread round-robin over the
+    // nodes. Each one is created and forked on its node, so it runs
+    // there and its queue is allocated there.
+    bool numa = (envVar::instance()->getVarInt("numa-placement",0) == 1);
+    uint nodes = numa_topology_t::instance()->nodes();
+
+    // with db-worker-steal the idle workers steal requests from the
+    // queues of the others. All the workers are created before any
+    // one is forked, so that the pool they steal from does not change.
+    bool steal = (envVar::instance()->getVarInt("db-worker-steal",0) == 1);
+
     WorkerPtr aworker;
     for (uint i=0; i<_worker_cnt; i++) {
+        numa_local_t local(numa ? (int)(i % nodes) : -1);
         aworker = new Worker(this,c_str("work-%d", i),PBIND_NONE,_bUseSLI);
         _workers.push_back(aworker);
-        aworker->init(lc);
-        aworker->start();
-        aworker->fork();
+        aworker->init(lc, (steal ? &_workers : NULL));
+    }
+    for (uint i=0; i<_worker_cnt; i++) {
+        numa_local_t local(numa ? (int)(i % nodes) : -1);
+        _workers[i]->start();
+        _workers[i]->fork();
     }
     return (0);
 }
@@ -548,7 +589,8 @@ int ShoreEnv::stop()
         return (1);
     }
 
-    // Stop workers
+    // Stop workers. All of them are joined before any one is deleted,
+    // because a worker that steals may still look at the others.
     int i=0;
     for (WorkerIt it = _workers.begin(); it != _workers.end(); ++it) {
         i++;
@@ -556,9 +598,11 @@ int ShoreEnv::stop()
         if (*it) {
             (*it)->stop();
             (*it)->join();
-            delete (*it);
         }
     }
+    for (WorkerIt it = _workers.begin(); it != _workers.end(); ++it) {
+        if (*it) delete (*it);
+    }
     _workers.clear();
 
 #ifdef CFG_FLUSHER
@@ -626,6 +670,42 @@ int ShoreEnv::statistics()
     if (_base_flusher) _base_flusher->statistics();
 #endif    
 
+    bool numa = (envVar::instance()->getVarInt("numa-placement",0) == 1);
+
+    // Worker stats over all the workers, if they steal from each other
+    if ((envVar::instance()->getVarInt("db-worker-steal",0) == 1) &&
+        (!_workers.empty())) 
+    {
+        worker_stats_t total;
+        for (uint i=0; i<_workers.size(); i++) {
+            total += _workers[i]->get_stats();
+            if (!numa) _workers[i]->reset_stats();
+        }
+        TRACE( TRACE_STATISTICS, "Workers (%d)\n", _workers.size());
+        total.print_stats();
+    }
+
+    // Per-node worker stats, if the workers are spread over the nodes
+    if (numa &&
+        (!_workers.empty())) 
+    {
+        uint nodes = numa_topology_t::instance()->nodes();
+        std::vector<worker_stats_t> pernode(nodes);
+        std::vector<uint> workers(nodes,0);
+        for (uint i=0; i<_workers.size(); i++) {
+            pernode[i % nodes] += _workers[i]->get_stats();
+            ++workers[i % nodes];
+            _workers[i]->reset_stats();
+        }
+        for (uint n=0; n<nodes; n++) {
+            TRACE( TRACE_STATISTICS, "Node (%d) Workers (%d)\n", n, workers[n]);
+            pernode[n].print_stats();
+        }
+    }
+
+    // Object caches (requests, and the DORA actions and rvps) and memory
+    cache_stats_t::instance()->print_stats();
+
     // If reached this point the Shore environment is closed
     //gatherstats_sm();
     return (0);
@@ -943,6 +1023,94 @@ int ShoreEnv::checkpoint()
 
 
 
+/*********************************************************************
+ *
+ *  @fn:      bulkload_begin/end()
+ *
+ *  @brief:   Enables the bulk loading mode on all the registered tables,
+ *            and at the end of the loading it builds their indexes,
+ *            using one thread per table
+ *
+ *  @note:    Controlled by the "db-bulkload" option. The memory for the
+ *            sorted runs ("db-bulkload-run-mb") is split among the tables.
+ *            The indexes are checked afterwards if "db-bulkload-check"
+ *            is set.
+ *
+ *********************************************************************/
+
+bool ShoreEnv::is_bulkload_enabled() const
+{
+    return (envVar::instance()->getVarInt("db-bulkload",0) == 1);
+}
+
+
+void ShoreEnv::bulkload_begin()
+{
+    CRITICAL_SECTION(regtablecs, table_man_t::register_table_lock);
+    std::map<stid_t, table_man_t*>::iterator it;
+    for (it = table_man_t::stid_to_tableman.begin();
+         it != table_man_t::stid_to_tableman.end(); ++it) {
+        it->second->set_bulkload(true);
+    }
+    TRACE( TRACE_ALWAYS, "Bulk loading (%d) tables\n",
+           table_man_t::stid_to_tableman.size());
+}
+
+
+w_rc_t ShoreEnv::bulkload_end()
+{
+    std::vector<table_man_t*> managers;
+    {
+        CRITICAL_SECTION(regtablecs, table_man_t::register_table_lock);
+        std::map<stid_t, table_man_t*>::iterator it;
+        for (it = table_man_t::stid_to_tableman.begin();
+             it != table_man_t::stid_to_tableman.end(); ++it) {
+            if (it->second->is_bulkload()) {
+                it->second->set_bulkload(false);
+                managers.push_back(it->second);
+            }
+        }
+    }
+    if (managers.empty()) return (RCOK);
+
+    envVar* ev = envVar::instance();
+    uint_t run_mb = ev->getVarInt("db-bulkload-run-mb",BULK_RUN_MB);
+    bool bCheck = (ev->getVarInt("db-bulkload-check",1) == 1);
+    uint_t run_bytes = (run_mb*1024*1024) / managers.size();
+
+    TRACE( TRACE_ALWAYS, "Building the indexes of (%d) tables...\n",
+           managers.size());
+    time_t tstart = time(NULL);
+
+    array_guard_t<index_bulkload_smt_t*> builders =
+        new index_bulkload_smt_t*[managers.size()];
+    for (uint_t i=0; i<managers.size(); i++) {
+        builders[i] = new index_bulkload_smt_t(c_str("ibld-%d",i), _pssm,
+                                               managers[i], run_bytes,
+                                               bCheck);
+        builders[i]->fork();
+    }
+
+    int failed = 0;
+    for (uint_t i=0; i<managers.size(); i++) {
+        builders[i]->join();
+        if (builders[i]->rv()) ++failed;
+        delete (builders[i]);
+    }
+
+    if (failed) {
+        TRACE( TRACE_ALWAYS, "Building the indexes failed for (%d) tables\n",
+               failed);
+        return RC(se_ERROR_IN_IDX_LOAD);
+    }
+
+    TRACE( TRACE_ALWAYS, "Indexes built in (%d) secs...\n",
+           time(NULL)-tstart);
+    return (RCOK);
+}
+
+
+
 /****************************************************************** 
  *
  *  @fn:    get_trx_{att,com}()
@@ -47,7 +47,9 @@ const uint smSEGMENT_SIZE=128*smBLOCK_SIZE;
 
 flusher_stats_t::flusher_stats_t()
     : served(0), flushes(0), logsize(0), alreadyFlushed(0), waiting(0),
-      trigByXcts(0), trigBySize(0), trigByTimeout(0)
+      trigByXcts(0), trigBySize(0), trigByTimeout(0), trigByPipeline(0),
+      adaptive(false), pipeline(false), groupTarget(0), timeoutTarget(0),
+      adjustments(0), flushUsec(0), arrivalRate(0)
 {
 
     // Calculates the partition size
@@ -83,6 +85,16 @@ void flusher_stats_t::print() const
            trigBySize,(double)(100*trigBySize)/(double)flushes);
     TRACE( TRACE_STATISTICS, "By Timeout:  (%d)\t(%.2f%%)\n", 
            trigByTimeout,(double)(100*trigByTimeout)/(double)flushes);
+    TRACE( TRACE_STATISTICS, "By Pipeline: (%d)\t(%.2f%%)\n", 
+           trigByPipeline,(double)(100*trigByPipeline)/(double)flushes);
+
+    TRACE( TRACE_STATISTICS, "Policy:      (%s)%s\n", 
+           (adaptive ? "Adaptive" : "Static"), (pipeline ? " (Pipelined)" : ""));
+    TRACE( TRACE_STATISTICS, "Targets:     (%d) xcts\t(%d) usec\n", 
+           groupTarget, timeoutTarget);
+    TRACE( TRACE_STATISTICS, "Measured:    (%.1f) usec/flush\t(%.2f) xcts/msec\n", 
+           flushUsec, arrivalRate);
+    TRACE( TRACE_STATISTICS, "Adjustments: (%d)\n", adjustments);
 }
 
 void flusher_stats_t::reset()
@@ -97,6 +109,10 @@ void flusher_stats_t::reset()
     trigByXcts = 0;
     trigBySize = 0;
     trigByTimeout = 0;
+    trigByPipeline = 0;
+
+    // the policy and its targets stay
+    adjustments = 0;
 }
 
 
@@ -122,6 +138,96 @@ long flusher_stats_t::_log_diff(const lsn_t& head, const lsn_t& tail)
 
 
 
+/******************************************************************** 
+ *
+ * @class: group_commit_ctrl_t
+ * 
+ ********************************************************************/
+
+group_commit_ctrl_t::group_commit_ctrl_t(const bool adaptive, 
+                                         const bool pipeline,
+                                         const uint max_group, 
+                                         const uint max_timeout)
+    : _adaptive(adaptive), _pipeline(pipeline),
+      _max_group(std::max(max_group,1U)), _max_timeout(max_timeout),
+      _flush_usec(0), _arrival_rate(0),
+      _group(_max_group), _timeout(_max_timeout)
+{
+    // Until there are measurements, flush every xct 
+    if (_adaptive) _group = 1;
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:     flushed()
+ *
+ * @brief:  Updates the moving averages with a flush, and picks the
+ *          new targets
+ *
+ * @note:   The group is as many xcts as arrive during one flush, so 
+ *          that a group is ready when the previous flush completes.
+ *          The timeout is the time to gather such a group. The
+ *          configured thresholds are the upper bounds. (interval_usec) 
+ *          is from the start of the previous flush to the start of
+ *          this one, the time in which the (xcts) arrived.
+ * 
+ ******************************************************************/
+
+bool group_commit_ctrl_t::flushed(const uint xcts, 
+                                  const double flush_usec, 
+                                  const double interval_usec)
+{
+    if (!_adaptive) return (false);
+
+    double rate = (double)xcts / std::max(interval_usec, 1.0);
+    if (_flush_usec == 0) {
+        _flush_usec = flush_usec;
+        _arrival_rate = rate;
+    }
+    else {
+        _flush_usec += FLUSHER_EWMA_WEIGHT * (flush_usec - _flush_usec);
+        _arrival_rate += FLUSHER_EWMA_WEIGHT * (rate - _arrival_rate);
+    }
+
+    uint group = (uint)(_arrival_rate * _flush_usec + 0.5);
+    group = std::min(std::max(group,1U), _max_group);
+
+    uint timeout = _max_timeout;
+    if (_arrival_rate > 0) {
+        double gather = (double)group / _arrival_rate;
+        if (gather < _max_timeout) timeout = (uint)gather;
+    }
+    timeout = std::max(timeout, std::min((uint)FLUSHER_MIN_TIMEOUT, _max_timeout));
+
+    bool changed = ((group != _group) || (timeout != _timeout));
+    _group = group;
+    _timeout = timeout;
+    return (changed);
+}
+
+
+void group_commit_ctrl_t::export_stats(flusher_stats_t& stats) const
+{
+    stats.adaptive = _adaptive;
+    stats.pipeline = _pipeline;
+    stats.groupTarget = _group;
+    stats.timeoutTarget = _timeout;
+    stats.flushUsec = _flush_usec;
+    stats.arrivalRate = _arrival_rate * 1000;
+}
+
+
+// usecs from (start) to (end)
+static double _usec_diff(const struct timespec& end, const struct timespec& start)
+{
+    return ((end.tv_sec - start.tv_sec) * 1000000.0 + 
+            (end.tv_nsec - start.tv_nsec) / 1000.0);
+}
+
+
+
+
 /******************************************************************** 
  *
  * @struct: flusher_t
@@ -191,16 +297,23 @@ int flusher_t::_work_ACTIVE_impl()
     uint maxGroupSize = ev->getVarInt("flusher-group-size",FLUSHER_GROUP_SIZE_THRESHOLD);
     uint maxLogSize = ev->getVarInt("flusher-log-size",FLUSHER_LOG_SIZE_THRESHOLD);
     uint maxTimeIntervalusec = ev->getVarInt("flusher-timeout",FLUSHER_TIME_THRESHOLD);
+    group_commit_ctrl_t ctrl((ev->getVar("flusher-policy","static") == "adaptive"),
+                             (ev->getVarInt("flusher-pipeline",0) != 0),
+                             maxGroupSize, maxTimeIntervalusec);
+    ctrl.export_stats(_stats);
 
     uint waiting = 0;
     lsn_t durablelsn, maxlsn;
     bool bShouldFlush = false;
+    bool bJustFlushed = false;
     long logWaiting = 0;
-    struct timespec start, ts;
+    struct timespec start, ts, flushstart, lastflush, lastflushstart;
     static long const BILLION = 1000*1000*1000;
     bool bSleepNext = false;
 
     clock_gettime(CLOCK_REALTIME, &start);
+    lastflush = start;
+    lastflushstart = start;
 
     // set timeout
     ts = start;
@@ -217,26 +330,47 @@ int flusher_t::_work_ACTIVE_impl()
         set_ws(WS_LOOP);
         bShouldFlush = false;
 
-        // Read the durable lsn
+        // Read the durable lsn. The maxlsn is reset only after a flush,
+        // so that it covers also a group that waits unflushed
         _env->db()->get_durable_lsn(durablelsn);
-        maxlsn = durablelsn;
+        if (maxlsn < durablelsn) maxlsn = durablelsn;
 
         // Check the list of waiting to flush xcts
         _check_waiting(bSleepNext,durablelsn,maxlsn,waiting);
+        logWaiting = _stats._log_diff(maxlsn,durablelsn);
 
         // Decide whether to flush or not
-        if (waiting >= maxGroupSize) {
+        if (waiting >= ctrl.group()) {
             // Do we have already too many waiting?
             bShouldFlush = true;
             _stats.trigByXcts++;
         }
+        else if (ctrl.pipeline() && bJustFlushed && waiting) {
+            // Flush the xcts that arrived during the previous flush
+            bShouldFlush = true;
+            _stats.trigByPipeline++;
+        }
         else {
-            logWaiting = _stats._log_diff(maxlsn,durablelsn);
             if (logWaiting >= maxLogSize) {
                 // Is the log to be flushed already big?
                 bShouldFlush = true;
                 _stats.trigBySize++;
             }
+            else if (ctrl.adaptive()) {
+                // Not enough requests or log to flush the group 
+
+                // The timeout counts from the last flush
+                clock_gettime(CLOCK_REALTIME, &start);
+                if (!waiting) {
+                    // Nothing to flush. Sleep until a request arrives.
+                    bSleepNext = true;
+                }
+                else if (_usec_diff(start,lastflush) >= ctrl.timeout()) {
+                    bShouldFlush = true;
+                    _stats.trigByTimeout++;
+                }
+                // Otherwise, spin until the group fills or the timeout
+            }
             else {
                 // Not enough requests or log to flush the group 
 
@@ -264,6 +398,7 @@ int flusher_t::_work_ACTIVE_impl()
                 }
             }
         }
+        bJustFlushed = false;
 
         if (get_control() != WC_ACTIVE) return(0);
 
@@ -276,12 +411,28 @@ int flusher_t::_work_ACTIVE_impl()
             _stats.flushes++;
             _stats.waiting += waiting;
             _stats.logsize += logWaiting;
+
+            clock_gettime(CLOCK_REALTIME, &flushstart);
             _env->db()->sync_log(); // it will block
+            clock_gettime(CLOCK_REALTIME, &lastflush);
+
+            // Feed the policy with the latency and the arrivals
+            if (ctrl.flushed(waiting, _usec_diff(lastflush,flushstart),
+                             _usec_diff(flushstart,lastflushstart))) {
+                _stats.adjustments++;
+            }
+            ctrl.export_stats(_stats);
+            lastflushstart = flushstart;
+            bJustFlushed = true;
             
             waiting = 0;
             logWaiting = 0;
+            maxlsn = durablelsn;
         }
 
+        // The adaptive policy lets a group wait unflushed
+        if (ctrl.adaptive() && waiting) continue;
+
         // At this point we know that everyone on the "flushing" queue is durable
         // Notify all the clients
         
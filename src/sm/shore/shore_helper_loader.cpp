@@ -96,7 +96,7 @@ void db_log_smt_t::work()
 }
 
 
-void db_load_smt_t::work() 
+void db_load_smt_t::work()
 {
     _rc = _env->loaddata();
     _rv = 0;
@@ -104,6 +104,31 @@ void db_load_smt_t::work()
 
 
 
+void index_bulkload_smt_t::work()
+{
+    table_desc_t* ptable = _pmanager->table();
+    w_rc_t e = _pmanager->bulkload_indexes(_pssm, _run_bytes);
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "Index building for (%s) failed [0x%x]\n",
+               ptable->name(), e.err_num());
+        _rv = 1;
+        return;
+    }
+
+    if (_check) {
+        if (!_pmanager->check_all_indexes(_pssm)) {
+            TRACE( TRACE_ALWAYS, "Inconsistent indexes in (%s)\n",
+                   ptable->name());
+            _rv = 1;
+            return;
+        }
+        TRACE( TRACE_DEBUG, "(%s) OK...\n", ptable->name());
+    }
+    _rv = 0;
+}
+
+
+
 void close_smt_t::work() 
 {
     TRACE( TRACE_ALWAYS, "Closing Shore...\n");
@@ -0,0 +1,171 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_latency.cpp
+ *
+ *  @brief:  Per-thread latency histograms of the trxs
+ */
+
+#include "sm/shore/shore_latency.h"
+
+#include <vector>
+
+#include "util/trace.h"
+#include "util/c_str.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+/******************************************************************** 
+ *
+ * @struct: trx_latency_t
+ *
+ * @brief:  The latency histograms of one thread, one per trx type
+ *
+ * @note:   Only the owner thread adds types and records. The gatherer
+ *          reads _cnt before the entries, and the owner publishes an
+ *          entry before incrementing _cnt.
+ *
+ ********************************************************************/
+
+struct trx_latency_t
+{
+    int          _type[LAT_MAX_TYPES];
+    histogram_t* _hist[LAT_MAX_TYPES];
+    uint volatile _cnt;
+
+    trx_latency_t() : _cnt(0) { }
+    ~trx_latency_t() { 
+        for (uint i=0; i<_cnt; i++) delete (_hist[i]);
+    }
+
+    histogram_t* get(const int xct_type) {
+        for (uint i=0; i<_cnt; i++) {
+            if (_type[i]==xct_type) return (_hist[i]);
+        }
+        if (_cnt == LAT_MAX_TYPES) return (NULL);
+        _type[_cnt] = xct_type;
+        _hist[_cnt] = new histogram_t();
+        membar_producer();
+        ++_cnt;
+        return (_hist[_cnt-1]);
+    }
+
+}; // EOF: trx_latency_t
+
+
+typedef std::map<int,histogram_t> latmap_t;
+
+// the histograms of all the threads that ever recorded a latency
+// @note: they are not released when the threads exit, because the
+//        threads that notify the clients (workers, flushers) live
+//        as long as the environment
+static pthread_mutex_t _latlist_mutex = PTHREAD_MUTEX_INITIALIZER;
+static std::vector<trx_latency_t*> _latlist;
+
+// the merged histograms at the last reset
+static pthread_mutex_t _last_lat_mutex = PTHREAD_MUTEX_INITIALIZER;
+static latmap_t _last_lat;
+
+static __thread trx_latency_t* my_latency = NULL;
+
+
+void trx_latency_record(const int xct_type, const long long usecs)
+{
+    if (!my_latency) {
+        my_latency = new trx_latency_t();
+        CRITICAL_SECTION(cs, _latlist_mutex);
+        _latlist.push_back(my_latency);
+    }
+    histogram_t* h = my_latency->get(xct_type);
+    if (h) h->record(usecs>0 ? usecs : 0);
+}
+
+
+// merges the histograms of all the threads, per trx type
+static void _gather(latmap_t& out)
+{
+    CRITICAL_SECTION(cs, _latlist_mutex);
+    for (uint i=0; i<_latlist.size(); i++) {
+        trx_latency_t* tl = _latlist[i];
+        uint cnt = *&tl->_cnt;
+        membar_consumer();
+        for (uint j=0; j<cnt; j++) {
+            out[tl->_type[j]] += *tl->_hist[j];
+        }
+    }
+}
+
+
+void trx_latency_reset()
+{
+    CRITICAL_SECTION(last_cs, _last_lat_mutex);
+    _last_lat.clear();
+    _gather(_last_lat);
+}
+
+
+void trx_latency_print(const std::map<int,std::string>& names)
+{
+    CRITICAL_SECTION(last_cs, _last_lat_mutex);
+    latmap_t current;
+    _gather(current);
+
+    TRACE( TRACE_ALWAYS, "Latency (usecs)\n");
+    for (latmap_t::iterator it=current.begin(); it!=current.end(); ++it) {
+        histogram_t& h = it->second;
+        latmap_t::iterator lit = _last_lat.find(it->first);
+        if (lit != _last_lat.end()) h -= lit->second;
+        if (h.count() == 0) continue;
+
+        std::map<int,std::string>::const_iterator nit = names.find(it->first);
+        std::string name = (nit!=names.end()) ? nit->second 
+            : std::string(c_str("Trx-%d",it->first));
+
+        TRACE( TRACE_ALWAYS, 
+               "%s: Trxs (%lld) p50 (%lld) p90 (%lld) p99 (%lld) p99.9 (%lld) Max (%lld)\n",
+               name.c_str(), (long long)h.count(), 
+               (long long)h.percentile(50), (long long)h.percentile(90), 
+               (long long)h.percentile(99), (long long)h.percentile(99.9), 
+               (long long)h.max());
+    }
+}
+
+
+void trx_latency_total(histogram_t& out)
+{
+    CRITICAL_SECTION(last_cs, _last_lat_mutex);
+    latmap_t current;
+    _gather(current);
+
+    for (latmap_t::iterator it=current.begin(); it!=current.end(); ++it) {
+        histogram_t& h = it->second;
+        latmap_t::iterator lit = _last_lat.find(it->first);
+        if (lit != _last_lat.end()) h -= lit->second;
+        out += h;
+    }
+}
+
+
+EXIT_NAMESPACE(shore);
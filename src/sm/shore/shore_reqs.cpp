@@ -35,16 +35,72 @@
 ENTER_NAMESPACE(shore);
 
 
+// The request cache of each thread
+struct request_cache_t {
+    guard< object_cache_t<trx_request_t> > _cache;
+    request_cache_t() { _cache = new object_cache_t<trx_request_t>(); }
+    ~request_cache_t() { _cache.release()->retire(); } };
+
+DECLARE_TLS(request_cache_t,my_request_cache);
+
+
+// The arrival of the next trx the thread submits, 0 if not set
+static __thread long long my_arrival = 0;
+static __thread trx_done_t* my_arrival_done = NULL;
+
+void set_trx_arrival(const long long usecs, trx_done_t* done)
+{
+    my_arrival = usecs;
+    my_arrival_done = done;
+}
+
+bool take_trx_arrival(long long& usecs, trx_done_t*& done)
+{
+    if (my_arrival == 0) return (false);
+    usecs = my_arrival;
+    done = my_arrival_done;
+    my_arrival = 0;
+    my_arrival_done = NULL;
+    return (true);
+}
+
+
+trx_request_t* request_pool_t::borrow()
+{
+    trx_request_t* prequest = my_request_cache->_cache->borrow();
+    assert (prequest);
+    prequest->_cache = my_request_cache->_cache.get();
+    return (prequest);
+}
+
+
 /****************************************************************** 
  *
  * @fn:    notify_client()
  *
  * @brief: If it is time, notifies the client (signals client's cond var) 
+ *         Records the latency of the trx in either case
+ *
+ * @note:  A trx whose result was not set to ROLLBACKED is reported
+ *         as COMMITTED to the asynchronous client
  *
  ******************************************************************/
 
 void base_request_t::notify_client() 
 {
+    // the trx is done, as far as the client is concerned
+    _result.record_latency();
+
+    // asynchronous completion
+    trx_done_t* pdone = _result.get_done();
+    if (pdone) {
+        TrxState state = COMMITTED;
+        if (_result.get_state() == ROLLBACKED) state = ROLLBACKED;
+        uint_t tag = _result.get_tag();
+        _result.set_done(NULL, 0);
+        pdone->trx_done(tag, state);
+    }
+
     // signal cond var
     condex* pcondex = _result.get_notify();
     if (pcondex) {
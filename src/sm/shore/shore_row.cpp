@@ -130,6 +130,9 @@ table_row_t::table_row_t()
       _field_cnt(0), _is_setup(false), 
       _rid(rid_t::null), _pvalues(NULL), 
       _fixed_offset(0),_var_slot_offset(0),_var_offset(0),_null_count(0),
+      _lazy(false), _decoded(NULL), _field_offset(NULL), _null_index(NULL),
+      _lazy_buf(NULL), _lazy_buf_size(0),
+      _tracked(false), _dirty(NULL),
       _rep(NULL), _rep_key(NULL)
 { 
 }
@@ -193,6 +196,33 @@ int table_row_t::setup(table_desc_t* ptd)
     // offset for variable length field values
     _var_offset = _var_slot_offset + sizeof(offset_t)*var_count;
 
+    // per field offsets, used by the lazy decoding. The fields are at
+    // the same positions table_man_t::format() writes them
+    _decoded = new bool[_field_cnt];
+    _field_offset = new offset_t[_field_cnt];
+    _null_index = new int[_field_cnt];
+    _dirty = new bool[_field_cnt];
+    memset(_dirty, 0, _field_cnt*sizeof(bool));
+
+    offset_t fixed_offset = _fixed_offset;
+    offset_t var_slot_offset = _var_slot_offset;
+    int null_index = -1;
+    for (uint i=0; i<_field_cnt; i++) {
+        _decoded[i] = false;
+        _null_index[i] = -1;
+        if (_pvalues[i].field_desc()->allow_null())
+            _null_index[i] = ++null_index;
+
+        if (_pvalues[i].is_variable_length()) {
+            _field_offset[i] = var_slot_offset;
+            var_slot_offset += sizeof(offset_t);
+        }
+        else {
+            _field_offset[i] = fixed_offset;
+            fixed_offset += _pvalues[i].maxsize();
+        }
+    }
+
     _is_setup = true;
     return (0);
 }
@@ -209,6 +239,7 @@ int table_row_t::setup(table_desc_t* ptd)
 uint table_row_t::size() const
 {
     assert (_is_setup);
+    materialize();
 
     uint size = 0;
 
@@ -238,6 +269,142 @@ uint table_row_t::size() const
 
 
 
+/******************************************************************
+ *
+ *  @fn:    set_lazy
+ *
+ *  @brief: Keeps a copy of the record body in disk format. The fields
+ *          are decoded to _pvalues only when they are accessed.
+ *
+ *  @note:  The record is copied, instead of pointed at, so that the
+ *          caller can unpin it right away. A tuple that has been read
+ *          is often updated by the same thread, which has to pin the
+ *          same page in EX mode. The (len) is the length of the
+ *          pinned part of the record, pin_i::length().
+ *
+ ******************************************************************/
+
+void table_row_t::set_lazy(const char* data, const uint_t len)
+{
+    assert (_is_setup);
+    assert (data);
+
+    if (_lazy_buf_size < len) {
+        if (_lazy_buf) free (_lazy_buf);
+        _lazy_buf = (char*)malloc(len);
+        _lazy_buf_size = len;
+    }
+    memcpy(_lazy_buf, data, len);
+    memset(_decoded, 0, _field_cnt*sizeof(bool));
+    _lazy = true;
+    clean();
+}
+
+
+
+/******************************************************************
+ *
+ *  @fn:    clean
+ *
+ *  @brief: Marks every field as clean. Called when the values are
+ *          the ones of the record at _rid, after it was loaded or
+ *          written.
+ *
+ ******************************************************************/
+
+void table_row_t::clean()
+{
+    assert (_is_setup);
+    memset(_dirty, 0, _field_cnt*sizeof(bool));
+    _tracked = true;
+}
+
+
+/******************************************************************
+ *
+ *  @fn:    is_delta_updatable
+ *
+ *  @brief: Returns true if only fixed-length, not NULL-able, fields
+ *          have been set since the row was read or written. Those
+ *          are stored at fixed offsets of the record, so they can
+ *          be overwritten in place. Any other change (a variable
+ *          length value, a NULL flag) needs the whole record.
+ *
+ ******************************************************************/
+
+bool table_row_t::is_delta_updatable() const
+{
+    if (!_tracked) return (false);
+    for (uint i=0; i<_field_cnt; i++) {
+        if (_dirty[i] && 
+            (_pvalues[i].is_variable_length() || 
+             _pvalues[i].field_desc()->allow_null())) 
+            return (false);
+    }
+    return (true);
+}
+
+
+/******************************************************************
+ *
+ *  @fn:    materialize
+ *
+ *  @brief: Decodes all the fields that have not been accessed yet.
+ *          It has to be called before any code that reads _pvalues
+ *          directly (format, format_key, printing).
+ *
+ ******************************************************************/
+
+void table_row_t::materialize() const
+{
+    if (!_lazy) return;
+    for (uint i=0; i<_field_cnt; i++) {
+        if (!_decoded[i]) _decode_field(i);
+    }
+    _lazy = false;
+}
+
+
+/******************************************************************
+ *
+ *  @fn:    _decode_field
+ *
+ *  @brief: Decodes one field from the copy of the record body
+ *
+ ******************************************************************/
+
+void table_row_t::_decode_field(const uint idx) const
+{
+    assert (_lazy);
+    assert (idx < _field_cnt);
+
+    field_value_t& fv = _pvalues[idx];
+    _decoded[idx] = true;
+
+    if ((_null_index[idx] >= 0) && (IS_NULL_FLAG(_lazy_buf, _null_index[idx]))) {
+        fv.set_null();
+        return;
+    }
+
+    if (fv.is_variable_length()) {
+        // the value follows the values of the previous var fields
+        offset_t var_offset = _var_offset;
+        offset_t var_len;
+        for (offset_t slot=_var_slot_offset; slot<_field_offset[idx];
+             slot+=sizeof(offset_t)) {
+            memcpy(&var_len, VAR_SLOT(_lazy_buf, slot), sizeof(offset_t));
+            var_offset += var_len;
+        }
+        memcpy(&var_len, VAR_SLOT(_lazy_buf, _field_offset[idx]), sizeof(offset_t));
+        fv.set_value(_lazy_buf+var_offset, var_len);
+    }
+    else {
+        fv.set_value(_lazy_buf+_field_offset[idx], fv.maxsize());
+    }
+}
+
+
+
 /* ----------------- */
 /* --- debugging --- */
 /* ----------------- */
@@ -246,6 +413,7 @@ uint table_row_t::size() const
 void table_row_t::print_values(ostream& os)
 {
     assert (_is_setup);
+    materialize();
     //  cout << "Number of fields: " << _field_count << endl;
     for (uint i=0; i<_field_cnt; i++) {
 	_pvalues[i].print_value(os);
@@ -260,6 +428,7 @@ void table_row_t::print_values(ostream& os)
 void table_row_t::print_tuple()
 {
     assert (_is_setup);
+    materialize();
     
     char* sbuf = NULL;
     int sz = 0;
@@ -278,6 +447,7 @@ void table_row_t::print_tuple()
 void table_row_t::print_tuple_no_tracing()
 {
     assert (_is_setup);
+    materialize();
     
     char* sbuf = NULL;
     int sz = 0;
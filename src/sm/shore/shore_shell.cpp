@@ -29,6 +29,7 @@
  */
 
 #include "sm/shore/shore_shell.h"
+#include "sm/shore/shore_qbench.h"
 #include "k_defines.h"
 
 
@@ -79,6 +80,12 @@ shore_shell_t::shore_shell_t(const char* prompt,
 
 shore_shell_t::~shore_shell_t() 
 { 
+    if (_xct_server.get()) {
+        _xct_server->stop();
+        _xct_server->join();
+        _xct_server.done();
+    }
+
     if (_env) {
         _env->stop();
         close_smt_t* clt = new close_smt_t(_env, c_str("clt"));
@@ -330,6 +337,120 @@ int shore_shell_t::process_cmd_LOAD(const char* /* command */)
 }
 
 
+
+/******************************************************************** 
+ *
+ *  @fn:    process_cmd_XCTSERVER
+ *
+ *  @brief: Starts/stops the network front-end. While it runs the env
+ *          is in MST_MEASURE, so that the stats count its trxs.
+ *
+ ********************************************************************/
+
+int shore_shell_t::process_cmd_XCTSERVER(const char* command)
+{
+    assert (_env);
+    assert (_env->is_initialized());
+
+    char command_tag[SERVER_COMMAND_BUFFER_SIZE];
+    char action[SERVER_COMMAND_BUFFER_SIZE];
+    int port = envVar::instance()->getVarInt("xct-server-port",XS_DEFAULT_PORT);
+    if (sscanf(command, "%s %s %d", command_tag, action, &port) < 2) {
+        TRACE( TRACE_ALWAYS, "Wrong input. Type (help xctserver)\n"); 
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    if (strcasecmp(action, "start") == 0) {
+        if (_xct_server.get()) {
+            TRACE( TRACE_ALWAYS, "Already running on port (%d)\n",
+                   _xct_server->port());
+            return (SHELL_NEXT_CONTINUE);
+        }
+        w_rc_t rcl = _env->loaddata();
+        if (rcl.is_error()) {
+            return (SHELL_NEXT_QUIT);
+        }
+
+        _xct_server = new xct_server_t(_env, _sup_trxs, port);
+        if (_xct_server->open()) {
+            _xct_server.done();
+            return (SHELL_NEXT_CONTINUE);
+        }
+
+        _env->reset_stats();
+        trx_latency_reset();
+        _env->set_measure(MST_MEASURE);
+        _xct_server->fork();
+    }
+    else if (strcasecmp(action, "stop") == 0) {
+        if (!_xct_server.get()) {
+            TRACE( TRACE_ALWAYS, "Not running\n");
+            return (SHELL_NEXT_CONTINUE);
+        }
+        _xct_server->stop();
+        _xct_server->join();
+        _env->set_measure(MST_DONE);
+        _xct_server->print_stats();
+        trx_latency_print(_sup_trxs);
+        _xct_server.done();
+    }
+    else if (strcasecmp(action, "stats") == 0) {
+        if (!_xct_server.get()) {
+            TRACE( TRACE_ALWAYS, "Not running\n");
+            return (SHELL_NEXT_CONTINUE);
+        }
+        _xct_server->print_stats();
+        trx_latency_print(_sup_trxs);
+    }
+    else {
+        TRACE( TRACE_ALWAYS, "Wrong input. Type (help xctserver)\n"); 
+    }
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
+
+/******************************************************************** 
+ *
+ *  @fn:    process_cmd_NETLOAD
+ *
+ *  @brief: Drives the running network front-end over loopback
+ *
+ ********************************************************************/
+
+int shore_shell_t::process_cmd_NETLOAD(const char* command)
+{
+    if (!_xct_server.get()) {
+        TRACE( TRACE_ALWAYS, "Start the server first. Type (help xctserver)\n");
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    char command_tag[SERVER_COMMAND_BUFFER_SIZE];
+    int conns = 0;
+    int depth = 0;
+    int duration = 0;
+    int xct_type = 0;
+    int spec_id = 0;
+    if ( (sscanf(command, "%s %d %d %d %d %d", command_tag, &conns, &depth,
+                 &duration, &xct_type, &spec_id) < 5) ||
+         (conns<1) || (depth<1) || (duration<1) )
+    {
+        TRACE( TRACE_ALWAYS, "Wrong input. Type (help netload)\n"); 
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    TRACE( TRACE_ALWAYS, "\n" \
+           "Trx          : %s\n" \
+           "Connections  : %d\n" \
+           "Depth        : %d\n" \
+           "Duration     : %d\n",
+           translate_trx(xct_type), conns, depth, duration);
+
+    xct_load_run(_xct_server->port(), conns, depth, duration, xct_type, spec_id);
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    process_cmd_WARMUP
@@ -675,6 +796,86 @@ int shore_shell_t::process_cmd_MEASURE(const char* command)
 }
 
 
+/******************************************************************** 
+ *
+ *  @fn:    process_cmd_SWEEP
+ *
+ *  @brief: Parses the SWEEP cmd and calls the virtual impl function
+ *
+ ********************************************************************/
+
+int shore_shell_t::process_cmd_SWEEP(const char* command)
+{
+    assert (_env);
+    assert (_env->is_initialized());
+
+    // first check if env initialized and loaded
+    // try to load and abort on error
+    w_rc_t rcl = _env->loaddata();
+    if (rcl.is_error()) {
+        return (SHELL_NEXT_QUIT);
+    }
+
+    // 0. Parse Parameters
+    envVar* ev = envVar::instance();
+    double numOfQueriedSF = ev->getVarDouble("measure-num-queried",DF_NUM_OF_QUERIED_SF);
+    int rateFrom          = ev->getVarInt("sweep-rate-from",DF_SWEEP_RATE_FROM);
+    int rateTo            = ev->getVarInt("sweep-rate-to",DF_SWEEP_RATE_TO);
+    int rateStep          = ev->getVarInt("sweep-rate-step",DF_SWEEP_RATE_STEP);
+    int numOfThreads      = ev->getVarInt("measure-num-threads",DF_NUM_OF_THR);
+    int duration          = ev->getVarInt("measure-duration",DF_DURATION);
+    int selectedTrxID     = ev->getVarInt("measure-trx-id",DF_TRX_ID);
+    int spreadThreads     = ev->getVarInt("measure-spread",DF_SPREAD_THREADS);
+
+    char command_tag[SERVER_COMMAND_BUFFER_SIZE];
+    if ( sscanf(command, "%s %lf %d %d %d %d %d %d %d",
+                command_tag,
+                &numOfQueriedSF,
+                &rateFrom,
+                &rateTo,
+                &rateStep,
+                &numOfThreads,
+                &duration,
+                &selectedTrxID,
+                &spreadThreads) < 2 ) 
+    {
+        TRACE( TRACE_ALWAYS, "Wrong input. Type (help sweep)\n"); 
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    // update the SF
+    double tmp_sf = ev->getSysVarDouble("sf");
+    if (tmp_sf>0) {
+        TRACE( TRACE_DEBUG, "Updated SF (%.1f)\n", tmp_sf);
+        _theSF = tmp_sf;
+    }
+
+    if ((numOfQueriedSF<=0) || (numOfQueriedSF>_theSF)) {
+        numOfQueriedSF = _theSF;
+    }
+    if ((rateFrom<=0) || (rateTo<rateFrom) || (rateStep<=0)) {
+        TRACE( TRACE_ALWAYS, "Wrong rates (%d..%d step %d)\n",
+               rateFrom, rateTo, rateStep);
+        return (SHELL_NEXT_CONTINUE);
+    }
+    if ((numOfThreads<=0) || (numOfThreads>MAX_NUM_OF_THR)) {
+        numOfThreads = numOfQueriedSF;
+    }
+    if (duration<=0) {
+        duration = DF_DURATION;
+    }
+    if (_sup_trxs.find(selectedTrxID) == _sup_trxs.end()) {
+        TRACE( TRACE_ALWAYS, "Unsupported TRX\n");
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    // call the virtual function that implements the sweep
+    return (_cmd_SWEEP_impl(numOfQueriedSF, spreadThreads, numOfThreads,
+                            duration, selectedTrxID, 
+                            rateFrom, rateTo, rateStep));
+}
+
+
 /******************************************************************** 
  *
  *  @fn:    SIGINT_handler
@@ -769,6 +970,7 @@ int shore_shell_t::register_commands()
     REGISTER_CMD_PARAM(db_fetch_cmd_t,_db_fetch,_env);
 
     REGISTER_CMD_PARAM(log_cmd_t,_logger,_env);
+    REGISTER_CMD_PARAM(qbench_cmd_t,_qbencher,_env);
     REGISTER_CMD_PARAM(asynch_cmd_t,_asyncher,_env);
 
     REGISTER_CMD_PARAM(sli_cmd_t,_slier,_env);
@@ -783,6 +985,9 @@ int shore_shell_t::register_commands()
     REGISTER_CMD_PARAM(warmup_cmd_t,_warmuper,this);
     REGISTER_CMD_PARAM(load_cmd_t,_loader,this);
     REGISTER_CMD_PARAM(trxs_cmd_t,_trxser,this);
+    REGISTER_CMD_PARAM(xctserver_cmd_t,_xctserverer,this);
+    REGISTER_CMD_PARAM(netload_cmd_t,_netloader,this);
+    REGISTER_CMD_PARAM(sweep_cmd_t,_sweeper,this);
 
     return (0);
 }
@@ -1331,6 +1536,63 @@ string log_cmd_t::desc() const
 }
 
 
+/*********************************************************************
+ *
+ *  "qbench" command
+ *
+ *  Compares the mcs_lock-based srmwqueue with the lock-free lfqueue
+ *  for 1,2,4,...,<MAX_PRODUCERS> writers
+ *
+ *********************************************************************/
+
+void qbench_cmd_t::setaliases() 
+{ 
+    _name = string("qbench"); 
+    _aliases.push_back("qbench"); 
+}
+
+int qbench_cmd_t::handle(const char* cmd)
+{
+    int maxProducers = QBENCH_MAX_PRODUCERS;
+    int pushes = QBENCH_PUSHES;
+    if (sscanf(cmd, "%*s %d %d", &maxProducers, &pushes) < 0) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+    if ((maxProducers<1) || (pushes<1)) {
+        usage();
+        return (SHELL_NEXT_CONTINUE);
+    }
+
+    assert (_env);
+    int lc = envVar::instance()->getVarInt("db-worker-queueloops",0);
+
+    TRACE( TRACE_ALWAYS, "Producers\tsrmwqueue (Kpush/s)\tlfqueue (Kpush/s)\tSpeedup\n");
+    for (int prods=1; prods<=maxProducers; prods*=2) {
+        double locked = qbench_run< srmwqueue<qbench_item_t> >(_env,prods,pushes,lc);
+        double lockfree = qbench_run< lfqueue<qbench_item_t> >(_env,prods,pushes,lc);
+        TRACE( TRACE_ALWAYS, "%d\t\t%.1f\t\t\t%.1f\t\t\t%.2f\n",
+               prods, locked/1000., lockfree/1000., lockfree/locked);
+    }
+    return (SHELL_NEXT_CONTINUE);
+}
+
+void qbench_cmd_t::usage(void)
+{
+    TRACE( TRACE_ALWAYS, "QBENCH Usage:\n\n"                            \
+           "*** qbench [<MAX_PRODUCERS> <PUSHES>]\n"                   \
+           "\nParameters:\n"                                            \
+           "<MAX_PRODUCERS> - Maximum number of writer threads (Default=128)\n" \
+           "<PUSHES>        - Elements pushed by each writer (Default=100000)\n\n");
+}
+
+string qbench_cmd_t::desc() const 
+{ 
+    return (string("Microbenchmark of the worker queues")); 
+}
+
+
+
 /*********************************************************************
  *
  *  "asynch" command
@@ -1680,5 +1942,116 @@ string trxs_cmd_t::desc() const
 
 
 
+
+/*********************************************************************
+ *
+ *  "xctserver" command
+ *
+ *********************************************************************/
+
+void xctserver_cmd_t::setaliases()
+{
+    _name = string("xctserver"); 
+    _aliases.push_back("xctserver");
+}
+
+int xctserver_cmd_t::handle(const char* cmd) 
+{ 
+    return (_kit->process_cmd_XCTSERVER(cmd)); 
+}
+
+void xctserver_cmd_t::usage() 
+{ 
+    TRACE( TRACE_ALWAYS, "XCTSERVER Usage:\n\n" \
+           "*** xctserver start [<PORT>] | stop | stats\n" \
+           "\nParameters:\n" \
+           "<PORT> : Port to listen to (Default=xct-server-port) (optional)\n\n");
+}
+
+string xctserver_cmd_t::desc() const 
+{
+    return string("Serves trxs over the network (binary, pipelined)");
+}
+
+
+
+
+/*********************************************************************
+ *
+ *  "netload" command
+ *
+ *********************************************************************/
+
+void netload_cmd_t::setaliases()
+{
+    _name = string("netload"); 
+    _aliases.push_back("netload");
+}
+
+int netload_cmd_t::handle(const char* cmd) 
+{ 
+    return (_kit->process_cmd_NETLOAD(cmd)); 
+}
+
+void netload_cmd_t::usage() 
+{ 
+    TRACE( TRACE_ALWAYS, "NETLOAD Usage:\n\n" \
+           "*** netload <CONNS> <DEPTH> <DURATION> <TRX_ID> [<SPEC_ID>]\n" \
+           "\nParameters:\n" \
+           "<CONNS>    : Number of connections\n" \
+           "<DEPTH>    : Requests in flight per connection\n" \
+           "<DURATION> : Duration of experiment in secs\n" \
+           "<TRX_ID>   : Transaction ID to be executed (0=mix)\n" \
+           "<SPEC_ID>  : Selected id passed to the trxs (Default=0) (optional)\n\n");
+}
+
+string netload_cmd_t::desc() const 
+{
+    return string("Loopback load against the xct server");
+}
+
+
+
+
+/*********************************************************************
+ *
+ *  "sweep" command
+ *
+ *********************************************************************/
+
+void sweep_cmd_t::setaliases()
+{
+    _name = string("sweep"); 
+    _aliases.push_back("sweep");
+}
+
+int sweep_cmd_t::handle(const char* cmd) 
+{ 
+    _kit->pre_process_cmd();
+    return (_kit->process_cmd_SWEEP(cmd)); 
+}
+
+void sweep_cmd_t::usage() 
+{ 
+    TRACE( TRACE_ALWAYS, "SWEEP Usage:\n\n" \
+           "*** sweep <NUM_QUERIED> [<RATE_FROM> <RATE_TO> <RATE_STEP> <NUM_THRS> <DURATION> <TRX_ID> <SPREAD>]\n" \
+           "\nParameters:\n" \
+           "<NUM_QUERIED> : The SF queried (queried factor)\n" \
+           "<RATE_FROM>   : Offered rate of the first step in trxs/sec (optional)\n" \
+           "<RATE_TO>     : Offered rate of the last step in trxs/sec (optional)\n" \
+           "<RATE_STEP>   : Increase of the offered rate per step (optional)\n" \
+           "<NUM_THRS>    : Number of client threads used (optional)\n" \
+           "<DURATION>    : Duration of each step in secs (Default=20) (optional)\n" \
+           "<TRX_ID>      : Transaction ID to be executed (0=mix) (optional)\n" \
+           "<SPREAD>      : Whether to spread threads (0=No, Other=Yes) (optional)\n\n");
+}
+
+string sweep_cmd_t::desc() const 
+{
+    return string("Open-loop latency vs load sweep (Poisson arrivals)");
+}
+
+
+
 EXIT_NAMESPACE(shore);
 
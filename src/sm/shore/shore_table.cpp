@@ -34,22 +34,6 @@
 using namespace shore;
 
 
-/* ---------------------------------------------------------------
- *
- * @brief: Macros for correct offset calculation
- *
- * --------------------------------------------------------------- */
-
-//#define VAR_SLOT(start, offset)   ((offset_t*)((start)+(offset)))
-#define VAR_SLOT(start, offset)   ((start)+(offset))
-#define SET_NULL_FLAG(start, offset)                            \
-    (*(char*)((start)+((offset)>>3))) &= (1<<((offset)>>3))
-#define IS_NULL_FLAG(start, offset)                     \
-    (*(char*)((start)+((offset)>>3)))&(1<<((offset)>>3))
-
-
-
-
 /****************************************************************** 
  *
  *  class table_desc_t methods 
@@ -558,6 +542,9 @@ int table_man_t::format(table_tuple* ptuple,
 {
     // Format the data field by field
 
+    // 0. Decode the fields of a lazily loaded tuple
+    ptuple->materialize();
+
 
     // 1. Get the pre-calculated offsets
 
@@ -680,6 +667,9 @@ bool table_man_t::load(table_tuple* ptuple,
     assert (ptuple);
     assert (data);
 
+    // all the fields are decoded here
+    ptuple->_lazy = false;
+
     // 1. Get the pre-calculated offsets
 
     // current offset for fixed length field values
@@ -732,6 +722,9 @@ bool table_man_t::load(table_tuple* ptuple,
 	    fixed_offset += ptuple->_pvalues[i].maxsize();
 	}
     }
+
+    // the values are the ones of the record
+    ptuple->clean();
     return (true);
 }
 
@@ -774,6 +767,7 @@ int table_man_t::format_key(index_desc_t* pindex,
     offset_t offset = 0;
     for (uint_t i=0; i<pindex->field_count(); i++) {
         int ix = pindex->key_index(i);
+        ptuple->decode(ix);
         field_value_t* pfv = &ptuple->_pvalues[ix];
 
         // copy value
@@ -820,6 +814,7 @@ bool table_man_t::load_key(const char* string,
     for (uint_t i=0; i<pindex->field_count(); i++) {
         uint_t field_index = pindex->key_index(i);
         uint_t size = ptuple->_pvalues[field_index].maxsize();
+        ptuple->touch(field_index);
         ptuple->_pvalues[field_index].set_value(string + offset, size);
         offset += size;
     }
@@ -846,6 +841,7 @@ int table_man_t::min_key(index_desc_t* pindex,
     assert (_ptable);
     for (uint_t i=0; i<pindex->field_count(); i++) {
 	uint_t field_index = pindex->key_index(i);
+	ptuple->touch(field_index);
 	ptuple->_pvalues[field_index].set_min_value();
     }
     return (format_key(pindex, ptuple, arep));
@@ -859,6 +855,7 @@ int table_man_t::max_key(index_desc_t* pindex,
     assert (_ptable);
     for (uint_t i=0; i<pindex->field_count(); i++) {
 	uint_t field_index = pindex->key_index(i);
+	ptuple->touch(field_index);
 	ptuple->_pvalues[field_index].set_max_value();
     }
     return (format_key(pindex, ptuple, arep));
@@ -909,6 +906,28 @@ int table_man_t::get_pnum(index_desc_t* pindex,
 
 
 
+/****************************************************************** 
+ *
+ *  @fn:    can_bulkload
+ *
+ *  @brief: Returns true if the indexes of the table can be built
+ *          after its heap file. The PLP designs insert through
+ *          their primary index, so they always load tuple-by-tuple.
+ *
+ ******************************************************************/
+
+bool table_man_t::can_bulkload() const
+{
+    assert (_ptable);
+    if ((_ptable->get_pd() & (PD_MRBT_PART | PD_MRBT_LEAF)) &&
+	(_ptable->primary_idx() && _ptable->primary_idx()->is_latchless())) {
+        return (false);
+    }
+    return (true);
+}
+
+
+
 mcs_lock table_man_t::register_table_lock;
 std::map<stid_t, table_man_t*> table_man_t::stid_to_tableman;
 
@@ -1020,10 +1039,8 @@ w_rc_t table_man_t::index_probe(ss_m* db,
     if (system_mode & (PD_MRBT_PART | PD_MRBT_LEAF)) heap_latch_mode = LATCH_NLS;
     W_DO(pin.pin(ptuple->rid(), 0, lock_mode, heap_latch_mode));
 
-    if (!load(ptuple, pin.body())) {
-        pin.unpin();
-        return RC(se_WRONG_DISK_DATA);
-    }
+    // the fields are decoded as they are accessed
+    ptuple->set_lazy(pin.body(), pin.length());
     pin.unpin();
     return (RCOK);
 }
@@ -1065,8 +1082,10 @@ w_rc_t table_man_t::add_tuple(ss_m* db,
     }
 
     // figure out what mode will be used
+    // In bulk loading mode nobody else reads the new records before the
+    // indexes are built, so the heap inserts do not need to lock them
     bool bIgnoreLocks = false;
-    if (lock_mode==NL) bIgnoreLocks = true;
+    if ((lock_mode==NL) || _bulkload) bIgnoreLocks = true;
 
 
     // append the tuple
@@ -1081,6 +1100,9 @@ w_rc_t table_man_t::add_tuple(ss_m* db,
                         bIgnoreLocks
                         ));
 
+    // in bulk loading mode the indexes are built after the heap file
+    if (_bulkload) return (RCOK);
+
     // update the indexes
     index_desc_t* index = _ptable->indexes();
     int ksz = 0;
@@ -1580,6 +1602,15 @@ w_rc_t table_man_t::update_tuple(ss_m* /* db */,
     // pin record
     pin_i pin;
     W_DO(pin.pin(ptuple->rid(), 0, lock_mode, heap_latch_mode));
+
+    // if only fixed-length fields changed, write just those
+    if (ptuple->is_delta_updatable()) {
+        w_rc_t rc = update_fields(pin, ptuple, bIgnoreLocks, no_heap_latch);
+        if (!rc.is_error()) ptuple->clean();
+        pin.unpin();
+        return (rc);
+    }
+
     int current_size = pin.body_size();
 
 
@@ -1617,6 +1648,7 @@ w_rc_t table_man_t::update_tuple(ss_m* /* db */,
     }
 
     if (rc.is_error()) TRACE( TRACE_DEBUG, "Error updating record\n");
+    else ptuple->clean();
 
     // 3. unpin
     pin.unpin();
@@ -1625,6 +1657,85 @@ w_rc_t table_man_t::update_tuple(ss_m* /* db */,
 
 
 
+/********************************************************************* 
+ *
+ *  @fn:    update_fields
+ *
+ *  @brief: Overwrites in the pinned record only the fields of the
+ *          tuple that are dirty. They are fixed-length fields, so they
+ *          are at the same offsets in the record as in the tuple, and
+ *          the record size does not change.
+ *
+ *  @note:  The dirty fields that are adjacent in the record are
+ *          written with one update_rec() call, so that they produce
+ *          one log record. If no field is dirty nothing is written.
+ *
+ *********************************************************************/
+
+w_rc_t table_man_t::update_fields(pin_i& pin,
+                                  table_tuple* ptuple,
+                                  const bool bIgnoreLocks,
+                                  const bool no_heap_latch)
+{
+    assert (ptuple->is_delta_updatable());
+
+    // the fixed-length fields are stored before the var slots
+    rep_row_t* arep = ptuple->_rep;
+    arep->set(ptuple->get_var_slot_offset());
+    assert (arep->_dest); // if NULL invalid
+
+    // the fields are in the order they are stored, so each run of
+    // adjacent dirty fields is one range of the record
+    int start = -1;
+    int end = -1;
+    for (uint_t i=0; i<=_ptable->field_count(); i++) {
+        bool last = (i==_ptable->field_count());
+        bool dirty = (!last && ptuple->is_dirty(i));
+
+        if (dirty) {
+            field_value_t& afv = ptuple->_pvalues[i];
+            offset_t offset = ptuple->_field_offset[i];
+            memset(arep->_dest + offset, 0, afv.maxsize());
+            afv.copy_value(arep->_dest + offset);
+
+            if (start < 0) start = offset;
+            else if (end != offset) {
+                // not adjacent to the previous run, write that one
+                W_DO(_update_range(pin, arep->_dest, start, end,
+                                   bIgnoreLocks, no_heap_latch));
+                start = offset;
+            }
+            end = offset + afv.maxsize();
+        }
+        else if (last && (start >= 0)) {
+            W_DO(_update_range(pin, arep->_dest, start, end,
+                               bIgnoreLocks, no_heap_latch));
+        }
+    }
+    return (RCOK);
+}
+
+
+w_rc_t table_man_t::_update_range(pin_i& pin, const char* data,
+                                  const int start, const int end,
+                                  const bool bIgnoreLocks,
+                                  const bool no_heap_latch)
+{
+    assert (start < end);
+    w_rc_t rc;
+    if (no_heap_latch) {
+        rc = pin.update_mrbt_rec(start, vec_t(data + start, end - start),
+                                 bIgnoreLocks, true);
+    } else {
+        rc = pin.update_rec(start, vec_t(data + start, end - start), 
+                            bIgnoreLocks);
+    }
+    if (rc.is_error()) TRACE( TRACE_DEBUG, "Error updating record fields\n");
+    return (rc);
+}
+
+
+
 /********************************************************************* 
  *
  *  @fn:    read_tuple
@@ -1655,10 +1766,9 @@ w_rc_t table_man_t::read_tuple(table_tuple* ptuple,
 
     pin_i  pin;
     W_DO(pin.pin(ptuple->rid(), 0, lock_mode, heap_latch_mode));
-    if (!load(ptuple, pin.body())) {
-        pin.unpin();
-        return RC(se_WRONG_DISK_DATA);
-    }
+
+    // the fields are decoded as they are accessed
+    ptuple->set_lazy(pin.body(), pin.length());
     pin.unpin();
 
     return (RCOK);
@@ -47,7 +47,8 @@ ENTER_NAMESPACE(shore);
 trx_worker_t::trx_worker_t(ShoreEnv* env, c_str tname, 
                            processorid_t aprsid,
                            const int use_sli) 
-    : base_worker_t(env, tname, aprsid, use_sli)
+    : base_worker_t(env, tname, aprsid, use_sli),
+      _peers(NULL), _loops(0), _thres(0)
 { 
     assert (env);
     _actionpool = new Pool(sizeof(Request*),REQUESTS_PER_WORKER_POOL_SZ);
@@ -57,13 +58,20 @@ trx_worker_t::trx_worker_t(ShoreEnv* env, c_str tname,
 trx_worker_t::~trx_worker_t() 
 { 
     _pqueue = NULL;
+    _pdeque = NULL;
     _actionpool = NULL;
 }
 
 
-void trx_worker_t::init(const int lc) 
+void trx_worker_t::init(const int lc, const Peers* peers) 
 {
     _pqueue->setqueue(WS_INPUT_Q,this,lc,0);
+    _loops = lc;
+    _thres = 0;
+    if (peers) {
+        _pdeque = new Deque();
+        _peers = peers;
+    }
 }
 
 
@@ -83,6 +91,8 @@ int trx_worker_t::_work_ACTIVE_impl()
     _prs_id = PBIND_NONE;
     TRY_TO_BIND(_prs_id,_is_bound);
 
+    if (_peers) return (_work_ACTIVE_steal());
+
     w_rc_t e;
     Request* ar = NULL;
 
@@ -112,6 +122,141 @@ int trx_worker_t::_work_ACTIVE_impl()
 
 
 
+/****************************************************************** 
+ *
+ * @fn:     _work_ACTIVE_steal()
+ *
+ * @brief:  The ACTIVE state with work stealing. The requests come
+ *          from the deque of this worker, or from the deques of the
+ *          others when this one is empty.
+ * 
+ ******************************************************************/
+
+int trx_worker_t::_work_ACTIVE_steal()
+{
+    Request* ar = NULL;
+
+    while (get_control() == WC_ACTIVE) {
+
+        set_ws(WS_LOOP);
+
+        ar = _pdeque->pop();
+        if (!ar) ar = _wait_or_steal();
+
+        if (ar) {
+            _serve_action(ar);
+            ++_stats._served_input;
+
+#ifndef CFG_FLUSHER
+            _env->_request_pool.destroy(ar);
+#endif
+        }
+    }
+    return (0);
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:     _wait_or_steal()
+ *
+ * @brief:  Spins on the deque for (_loops), then tries to steal one
+ *          request, and if there is none sleeps on the condex. The time
+ *          until a request is found counts as idle.
+ *
+ * @return: NULL if signalled to stop
+ *
+ * @note:   The ws is set to WS_LOOP before each look at the deque. A
+ *          push after the look changes it, so that the condex_sleep()
+ *          fails and the worker looks again.
+ * 
+ ******************************************************************/
+
+trx_worker_t::Request* trx_worker_t::_wait_or_steal()
+{
+    stopwatch_t idle;
+    Request* ar = NULL;
+    int loopcnt = 0;
+
+    while (true) {
+        if (get_control() != WC_ACTIVE) {
+            set_ws(WS_FINISHED);
+            break;
+        }
+
+        set_ws(WS_LOOP);
+        if ((ar = _pdeque->pop())) break;
+
+        if (++loopcnt > _loops) {
+            if ((ar = _steal())) {
+                ++_stats._steals;
+                break;
+            }
+            ++_stats._failed_steals;
+            loopcnt = 0;
+            condex_sleep();
+        }
+    }
+
+    _stats._idle_time += idle.time_ms();
+    return (ar);
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:     _steal()
+ *
+ * @brief:  Takes the oldest request of the peer with the longest deque
+ *
+ * @note:   The lengths are read without locks, so the victim may have
+ *          been emptied meanwhile. Then it is a failed steal.
+ * 
+ ******************************************************************/
+
+trx_worker_t::Request* trx_worker_t::_steal()
+{
+    trx_worker_t* victim = NULL;
+    uint longest = 0;
+    for (uint i=0; i<_peers->size(); i++) {
+        trx_worker_t* peer = (*_peers)[i];
+        if (peer == this) continue;
+        uint backlog = peer->backlog();
+        if (backlog > longest) {
+            longest = backlog;
+            victim = peer;
+        }
+    }
+    return (victim ? victim->steal_one() : NULL);
+}
+
+
+/****************************************************************** 
+ *
+ * @fn:     _wake_thief()
+ *
+ * @brief:  Called by a client that found this worker busy with
+ *          requests already queued. Wakes the first sleeping peer
+ *          after this one.
+ * 
+ ******************************************************************/
+
+void trx_worker_t::_wake_thief()
+{
+    uint n = _peers->size();
+    uint self = 0;
+    while ((self < n) && ((*_peers)[self] != this)) ++self;
+    for (uint i=1; i<n; i++) {
+        trx_worker_t* peer = (*_peers)[(self+i)%n];
+        if (peer->is_sleeping()) {
+            peer->set_ws(WS_INPUT_Q);
+            return;
+        }
+    }
+}
+
+
+
 /****************************************************************** 
  *
  * @fn:     _serve_action()
@@ -175,31 +320,19 @@ int trx_worker_t::_serve_action(Request* prequest)
 
 int trx_worker_t::_pre_STOP_impl()
 {
-    Request* pr;
+    std::vector<Request*> pending;
     int reqs_read  = 0;
     int reqs_write = 0;
     int reqs_abt   = 0;
 
     assert (_pqueue);
 
-    // Go over the readers list
-    for (; _pqueue->_read_pos != _pqueue->_for_readers->end(); _pqueue->_read_pos++) {
-        pr = *(_pqueue->_read_pos);
-        ++reqs_read;
-        if (abort_one_trx(pr->_xct)) ++reqs_abt;
-    }
-
-    // Go over the writers list
-    {
-        CRITICAL_SECTION(q_cs, _pqueue->_lock);
-        for (_pqueue->_read_pos = _pqueue->_for_writers->begin();
-             _pqueue->_read_pos != _pqueue->_for_writers->end();
-             _pqueue->_read_pos++) 
-            {
-                pr = *(_pqueue->_read_pos);
-                ++reqs_write;
-                if (abort_one_trx(pr->_xct)) ++reqs_abt;
-            }
+    // Go over the readers and the writers list
+    reqs_read  = _pqueue->pending(pending);
+    if (_pdeque.get()) reqs_read += _pdeque->pending(pending);
+    reqs_write = pending.size() - reqs_read;
+    for (uint i=0; i<pending.size(); i++) {
+        if (abort_one_trx(pending[i]->_xct)) ++reqs_abt;
     }
 
     if ((reqs_read + reqs_write) > 0) {
@@ -104,6 +104,20 @@ void worker_stats_t::print_stats() const
     TRACE( TRACE_STATISTICS, "Failed sleep   (%d) \t%.1f%%\n", 
            _failed_sleep, (double)(100*_failed_sleep)/(double)_processed);
 
+    // How many requests this worker took from the queue of another worker,
+    // and how many times it looked for one and found none. With the 
+    // affinity on the steals should be rare
+    if (_steals || _failed_steals) {
+        TRACE( TRACE_STATISTICS, "Steals         (%d) \t%.1f%%\n", 
+               _steals, (double)(100*_steals)/(double)_processed);
+        TRACE( TRACE_STATISTICS, "Failed steals  (%d)\n", _failed_steals);
+    }
+
+    // Time spent without a request to serve (spinning, stealing or sleeping)
+    if (_idle_time > 0) {
+        TRACE( TRACE_STATISTICS, "Idle           (%.1fms)\n", _idle_time);
+    }
+
 
 #ifdef WORKER_VERBOSE_STATS
 
@@ -149,6 +163,10 @@ worker_stats_t::operator+= (worker_stats_t const& rhs)
     _early_aborts += rhs._early_aborts;
     _mid_aborts += rhs._mid_aborts;
 
+    _steals += rhs._steals;
+    _failed_steals += rhs._failed_steals;
+    _idle_time += rhs._idle_time;
+
 #ifdef WORKER_VERBOSE_STATS
     _waiting_total += rhs._waiting_total;
     _serving_total += rhs._serving_total;
@@ -182,6 +200,10 @@ void worker_stats_t::reset()
     _early_aborts = 0;
     _mid_aborts = 0;
 
+    _steals = 0;
+    _failed_steals = 0;
+    _idle_time = 0;
+
 #ifdef WORKER_VERBOSE_STATS
     _waiting_total = 0;
     _serving_total = 0;
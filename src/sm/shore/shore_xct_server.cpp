@@ -0,0 +1,760 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_xct_server.cpp
+ *
+ *  @brief:  Implementation of the network front-end for submitting
+ *           trxs and of its loopback load driver
+ */
+
+#include "sm/shore/shore_xct_server.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "util/tcp.h"
+#include "util/histogram.h"
+#include "sm/shore/shore_latency.h"
+
+
+ENTER_NAMESPACE(shore);
+
+
+static int set_nonblocking(const int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) return (-1);
+    return (fcntl(fd, F_SETFL, flags | O_NONBLOCK));
+}
+
+static void set_nodelay(const int fd)
+{
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+
+
+/********************************************************************
+ *
+ *  xct_conn_t
+ *
+ ********************************************************************/
+
+void xct_conn_t::trx_done(const uint_t tag, const TrxState state)
+{
+    _server->complete(this, tag, state);
+}
+
+
+
+/********************************************************************
+ *
+ *  xct_server_stats_t
+ *
+ ********************************************************************/
+
+void xct_server_stats_t::print(const double secs) const
+{
+    TRACE( TRACE_STATISTICS, "Connections: (%d)\n", _accepted);
+    TRACE( TRACE_STATISTICS, "Requests:    (%d)\n", _requests);
+    TRACE( TRACE_STATISTICS, "Committed:   (%d)\n", _committed);
+    TRACE( TRACE_STATISTICS, "Aborted:     (%d)\n", _aborted);
+    TRACE( TRACE_STATISTICS, "Rejected:    (%d)\n", _rejected);
+    TRACE( TRACE_STATISTICS, "MaxInFlight: (%d)\n", _max_pending);
+    if (secs > 0) {
+        TRACE( TRACE_STATISTICS, "TPS:         (%.1f)\n",
+               (double)_committed/secs);
+    }
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    Construction/destruction
+ *
+ ********************************************************************/
+
+xct_server_t::xct_server_t(ShoreEnv* env,
+                           const std::map<int,string>& sup_trxs,
+                           const int port)
+    : thread_t(c_str("xct-server")),
+      _env(env), _sup_trxs(sup_trxs), _port(port),
+      _listen_fd(-1), _epoll_fd(-1), _stop(false),
+      _closing(false), _pending(0), _xct_id(0), _next_worker(0),
+      _stats_start(trx_latency_now())
+{
+    assert (_env);
+    _wake_fd[0] = _wake_fd[1] = -1;
+    _max_pending = envVar::instance()->getVarInt("xct-server-max-pending",
+                                                 XS_DEFAULT_MAX_PENDING);
+    if (_max_pending < 1) _max_pending = 1;
+    pthread_mutex_init(&_done_lock, NULL);
+    pthread_mutex_init(&_stats_lock, NULL);
+}
+
+xct_server_t::~xct_server_t()
+{
+    assert (_pending == 0);
+    if (_listen_fd >= 0) close(_listen_fd);
+    if (_epoll_fd >= 0) close(_epoll_fd);
+    if (_wake_fd[0] >= 0) close(_wake_fd[0]);
+    if (_wake_fd[1] >= 0) close(_wake_fd[1]);
+    pthread_mutex_destroy(&_done_lock);
+    pthread_mutex_destroy(&_stats_lock);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    open
+ *
+ *  @brief: Opens the listening socket, the epoll set and the wake-up
+ *          pipe. Called before fork().
+ *
+ ********************************************************************/
+
+int xct_server_t::open()
+{
+    _listen_fd = open_listenfd(_port);
+    if (_listen_fd < 0) {
+        TRACE( TRACE_ALWAYS, "Cannot listen to port (%d)\n", _port);
+        return (1);
+    }
+    if ((_epoll_fd = epoll_create(XS_MAX_EVENTS)) < 0) {
+        TRACE( TRACE_ALWAYS, "Cannot create epoll set\n");
+        return (1);
+    }
+    if (pipe(_wake_fd) < 0) {
+        TRACE( TRACE_ALWAYS, "Cannot create wake-up pipe\n");
+        return (1);
+    }
+    set_nonblocking(_listen_fd);
+    set_nonblocking(_wake_fd[0]);
+    set_nonblocking(_wake_fd[1]);
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = _listen_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _listen_fd, &ev);
+    ev.data.fd = _wake_fd[0];
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd[0], &ev);
+    return (0);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    work
+ *
+ *  @brief: The epoll loop. After stop() it closes the connections,
+ *          but returns only when the xcts in flight have completed,
+ *          since they point to their connections.
+ *
+ ********************************************************************/
+
+void xct_server_t::work()
+{
+    struct epoll_event events[XS_MAX_EVENTS];
+
+    TRACE( TRACE_ALWAYS, "Listening to port (%d)\n", _port);
+
+    while (!_closing || (_pending > 0)) {
+
+        int n = epoll_wait(_epoll_fd, events, XS_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            TRACE( TRACE_ALWAYS, "epoll_wait failed (%d)\n", errno);
+            break;
+        }
+
+        for (int i=0; i<n; i++) {
+            int fd = events[i].data.fd;
+
+            if (fd == _listen_fd) {
+                _accept();
+            }
+            else if (fd == _wake_fd[0]) {
+                char buf[64];
+                while (read(_wake_fd[0], buf, sizeof(buf)) > 0) { }
+                _drain();
+            }
+            else {
+                std::map<int,xct_conn_t*>::iterator it = _conns.find(fd);
+                if (it == _conns.end()) continue;
+                xct_conn_t* conn = it->second;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    // A throttled connection is not read, so it has to
+                    // be closed here. Its xcts in flight keep it alive.
+                    _close(conn);
+                    continue;
+                }
+                if (events[i].events & EPOLLIN) {
+                    _read(conn);
+                }
+                if (!conn->_closed && (events[i].events & EPOLLOUT)) {
+                    _flush(conn);
+                    if (!conn->_closed) _update_events(conn);
+                }
+            }
+        }
+
+        // stop accepting, close every connection
+        if (_stop && !_closing) {
+            _closing = true;
+            epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, _listen_fd, NULL);
+            while (!_conns.empty()) _close(_conns.begin()->second);
+        }
+
+        for (uint i=0; i<_trash.size(); i++) delete (_trash[i]);
+        _trash.clear();
+    }
+
+    TRACE( TRACE_ALWAYS, "Stopped\n");
+}
+
+
+void xct_server_t::stop()
+{
+    _stop = true;
+    char c = 0;
+    write(_wake_fd[1], &c, 1);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    _accept
+ *
+ ********************************************************************/
+
+void xct_server_t::_accept()
+{
+    while (true) {
+        int fd = accept(_listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+                TRACE( TRACE_ALWAYS, "Error accepting connection (%d)\n", errno);
+            }
+            return;
+        }
+        set_nonblocking(fd);
+        set_nodelay(fd);
+
+        xct_conn_t* conn = new xct_conn_t(this, fd);
+        _conns[fd] = conn;
+        {
+            CRITICAL_SECTION(scs, _stats_lock);
+            ++_stats._accepted;
+        }
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+
+        TRACE( TRACE_DEBUG, "Connection (%d)\n", fd);
+    }
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    _read
+ *
+ *  @brief: Reads what is available from a connection and submits the
+ *          complete requests. It stops reading when the connection
+ *          has "xct-server-max-pending" xcts in flight, the rest of
+ *          the requests wait in the socket.
+ *
+ ********************************************************************/
+
+void xct_server_t::_read(xct_conn_t* conn)
+{
+    while (conn->_pending < _max_pending) {
+        int space = XS_INPUT_BUF_SIZE - conn->_in_len;
+        assert (space >= XS_REQUEST_SIZE);
+        ssize_t r = read(conn->_fd, conn->_in + conn->_in_len, space);
+        if (r == 0) {
+            _close(conn);
+            return;
+        }
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+            _close(conn);
+            return;
+        }
+        conn->_in_len += r;
+        _parse(conn);
+    }
+
+    _flush(conn);
+    if (!conn->_closed) _update_events(conn);
+}
+
+
+void xct_server_t::_parse(xct_conn_t* conn)
+{
+    int pos = 0;
+    while ((conn->_in_len - pos >= XS_REQUEST_SIZE) &&
+           (conn->_pending < _max_pending)) {
+        _submit(conn, conn->_in + pos);
+        pos += XS_REQUEST_SIZE;
+    }
+    if (pos > 0) {
+        conn->_in_len -= pos;
+        memmove(conn->_in, conn->_in + pos, conn->_in_len);
+    }
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    _submit
+ *
+ *  @brief: Submits the xct of a request frame. The requests of all
+ *          the connections are spread over the workers.
+ *
+ ********************************************************************/
+
+void xct_server_t::_submit(xct_conn_t* conn, const char* frame)
+{
+    uint32_t f[3];
+    memcpy(f, frame, sizeof(f));
+    uint_t tag = ntohl(f[0]);
+    int xct_type = (int)ntohl(f[1]);
+    int spec_id = (int)ntohl(f[2]);
+
+    {
+        CRITICAL_SECTION(scs, _stats_lock);
+        ++_stats._requests;
+    }
+
+    if (_sup_trxs.find(xct_type) == _sup_trxs.end()) {
+        TRACE( TRACE_DEBUG, "Unknown xct type (%d)\n", xct_type);
+        _respond(conn, tag, XS_REJECTED);
+        return;
+    }
+
+    trx_result_tuple_t atrt;
+    atrt.set_done(conn, tag);
+
+    ++conn->_pending;
+    ++_pending;
+    {
+        CRITICAL_SECTION(scs, _stats_lock);
+        if (_pending > (int)_stats._max_pending) _stats._max_pending = _pending;
+    }
+
+    w_rc_t e = _env->submit_xct(xct_type, ++_xct_id, spec_id, atrt,
+                                _next_worker++, true);
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "Cannot submit xct (%d) [0x%x]\n",
+               xct_type, e.err_num());
+        --conn->_pending;
+        --_pending;
+        _respond(conn, tag, XS_REJECTED);
+    }
+}
+
+
+void xct_server_t::_respond(xct_conn_t* conn, const uint_t tag,
+                            const int status)
+{
+    {
+        CRITICAL_SECTION(scs, _stats_lock);
+        switch (status) {
+        case XS_COMMITTED: ++_stats._committed; break;
+        case XS_ABORTED:   ++_stats._aborted; break;
+        default:           ++_stats._rejected; break;
+        }
+    }
+
+    uint32_t f[2];
+    f[0] = htonl(tag);
+    f[1] = htonl((uint32_t)status);
+    const char* p = (const char*)f;
+    conn->_out.insert(conn->_out.end(), p, p + XS_RESPONSE_SIZE);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    _flush
+ *
+ *  @brief: Writes the pending responses of a connection, as much as
+ *          the socket takes. The rest is written on EPOLLOUT.
+ *
+ ********************************************************************/
+
+void xct_server_t::_flush(xct_conn_t* conn)
+{
+    size_t sent = 0;
+    while (sent < conn->_out.size()) {
+        ssize_t w = send(conn->_fd, &conn->_out[sent],
+                         conn->_out.size() - sent, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+            _close(conn);
+            return;
+        }
+        sent += w;
+    }
+    conn->_out.erase(conn->_out.begin(), conn->_out.begin() + sent);
+}
+
+
+void xct_server_t::_update_events(xct_conn_t* conn)
+{
+    assert (!conn->_closed);
+    bool reading = (conn->_pending < _max_pending);
+    bool writing = !conn->_out.empty();
+    if ((reading == conn->_reading) && (writing == conn->_writing)) return;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = (reading ? EPOLLIN : 0) | (writing ? EPOLLOUT : 0);
+    ev.data.fd = conn->_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, conn->_fd, &ev);
+    conn->_reading = reading;
+    conn->_writing = writing;
+}
+
+
+void xct_server_t::_close(xct_conn_t* conn)
+{
+    if (conn->_closed) return;
+    TRACE( TRACE_DEBUG, "Closing (%d) in flight (%d)\n",
+           conn->_fd, conn->_pending);
+
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, conn->_fd, NULL);
+    _conns.erase(conn->_fd);
+    close(conn->_fd);
+    conn->_closed = true;
+    if (conn->_pending == 0) _trash.push_back(conn);
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    complete
+ *
+ *  @brief: Hands a completion over to the server thread. Runs in the
+ *          thread that completed the xct. The pipe is written only if
+ *          the server has not been woken up already.
+ *
+ ********************************************************************/
+
+void xct_server_t::complete(xct_conn_t* conn, const uint_t tag,
+                            const TrxState state)
+{
+    completion_t c;
+    c._conn = conn;
+    c._tag = tag;
+    c._state = state;
+
+    bool wake = false;
+    {
+        CRITICAL_SECTION(cs, _done_lock);
+        wake = _done.empty();
+        _done.push_back(c);
+    }
+    if (wake) {
+        char b = 0;
+        write(_wake_fd[1], &b, 1);
+    }
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    _drain
+ *
+ *  @brief: Queues the responses of the completed xcts and sends them.
+ *          A connection that was throttled resumes reading.
+ *
+ ********************************************************************/
+
+void xct_server_t::_drain()
+{
+    {
+        CRITICAL_SECTION(cs, _done_lock);
+        _done.swap(_done_drain);
+    }
+
+    std::vector<xct_conn_t*> touched;
+    for (uint i=0; i<_done_drain.size(); i++) {
+        completion_t& c = _done_drain[i];
+        xct_conn_t* conn = c._conn;
+        --conn->_pending;
+        --_pending;
+        if (conn->_closed) {
+            if (conn->_pending == 0) _trash.push_back(conn);
+            continue;
+        }
+        _respond(conn, c._tag,
+                 (c._state == ROLLBACKED) ? XS_ABORTED : XS_COMMITTED);
+        touched.push_back(conn);
+    }
+    _done_drain.clear();
+
+    for (uint i=0; i<touched.size(); i++) {
+        xct_conn_t* conn = touched[i];
+        if (conn->_closed) continue;
+        _parse(conn);
+        _flush(conn);
+        if (!conn->_closed) _update_events(conn);
+    }
+}
+
+
+
+void xct_server_t::print_stats()
+{
+    xct_server_stats_t stats;
+    double secs = 0;
+    {
+        CRITICAL_SECTION(scs, _stats_lock);
+        stats = _stats;
+        secs = (trx_latency_now() - _stats_start)/1000000.;
+    }
+    TRACE( TRACE_STATISTICS, "Xct server on port (%d) for (%.1f) secs\n",
+           _port, secs);
+    stats.print(secs);
+}
+
+void xct_server_t::reset_stats()
+{
+    CRITICAL_SECTION(scs, _stats_lock);
+    _stats.reset();
+    _stats_start = trx_latency_now();
+}
+
+
+
+
+/********************************************************************
+ *
+ *  @class: xct_load_conn_t
+ *
+ *  @brief: One connection of the load driver. It keeps (depth)
+ *          requests in flight: it sends a new one for every response.
+ *
+ *  @note:  The tags of the requests in flight fall to different
+ *          slots (tag % depth), since the request that replaces
+ *          tag T gets tag T+depth.
+ *
+ ********************************************************************/
+
+class xct_load_conn_t : public thread_t
+{
+private:
+
+    int        _fd;
+    int        _depth;
+    long long  _end;       // usecs
+    int        _xct_type;
+    int        _spec_id;
+
+    std::vector<long long> _sent;   // per slot, when it was sent
+
+    bool _send(std::vector<char>& buf);
+    void _add(std::vector<char>& buf, const uint_t tag);
+
+public:
+
+    histogram_t _latency;
+    uint_t      _committed;
+    uint_t      _aborted;
+    uint_t      _rejected;
+    bool        _failed;
+
+    xct_load_conn_t(const int id, const int fd, const int depth,
+                    const long long end, const int xct_type, const int spec_id)
+        : thread_t(c_str("xct-load-%d", id)),
+          _fd(fd), _depth(depth), _end(end),
+          _xct_type(xct_type), _spec_id(spec_id), _sent(depth, 0),
+          _committed(0), _aborted(0), _rejected(0), _failed(false)
+    { }
+    ~xct_load_conn_t() { close(_fd); }
+
+    void work();
+
+}; // EOF: xct_load_conn_t
+
+
+void xct_load_conn_t::_add(std::vector<char>& buf, const uint_t tag)
+{
+    uint32_t f[3];
+    f[0] = htonl(tag);
+    f[1] = htonl((uint32_t)_xct_type);
+    f[2] = htonl((uint32_t)_spec_id);
+    const char* p = (const char*)f;
+    buf.insert(buf.end(), p, p + XS_REQUEST_SIZE);
+    _sent[tag % _depth] = trx_latency_now();
+}
+
+
+bool xct_load_conn_t::_send(std::vector<char>& buf)
+{
+    size_t sent = 0;
+    while (sent < buf.size()) {
+        ssize_t w = send(_fd, &buf[sent], buf.size() - sent, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return (false);
+        }
+        sent += w;
+    }
+    buf.clear();
+    return (true);
+}
+
+
+void xct_load_conn_t::work()
+{
+    std::vector<char> out;
+    char in[XS_INPUT_BUF_SIZE];
+    int in_len = 0;
+
+    // fill the pipeline
+    for (int i=0; i<_depth; i++) _add(out, i);
+    if (!_send(out)) { _failed = true; return; }
+    int in_flight = _depth;
+
+    while (in_flight > 0) {
+        ssize_t r = read(_fd, in + in_len, sizeof(in) - in_len);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) { _failed = true; return; }
+        in_len += r;
+
+        long long now = trx_latency_now();
+        bool more = (now < _end);
+        int pos = 0;
+        while (in_len - pos >= XS_RESPONSE_SIZE) {
+            uint32_t f[2];
+            memcpy(f, in + pos, sizeof(f));
+            pos += XS_RESPONSE_SIZE;
+            uint_t tag = ntohl(f[0]);
+            int status = (int)ntohl(f[1]);
+
+            switch (status) {
+            case XS_COMMITTED: ++_committed; break;
+            case XS_ABORTED:   ++_aborted; break;
+            default:           ++_rejected; break;
+            }
+            _latency.record(now - _sent[tag % _depth]);
+            --in_flight;
+
+            if (more) {
+                _add(out, tag + _depth);
+                ++in_flight;
+            }
+        }
+        in_len -= pos;
+        memmove(in, in + pos, in_len);
+
+        if (!out.empty() && !_send(out)) { _failed = true; return; }
+    }
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    xct_load_run
+ *
+ ********************************************************************/
+
+int xct_load_run(const int port, const int conns, const int depth,
+                 const int secs, const int xct_type, const int spec_id)
+{
+    assert ((conns>0) && (depth>0) && (secs>0));
+
+    // open_clientfd() is not thread-safe, so the connections are
+    // opened here
+    std::vector<xct_load_conn_t*> drivers;
+    long long start = trx_latency_now();
+    long long end = start + secs*1000000ll;
+    for (int i=0; i<conns; i++) {
+        int fd = open_clientfd("localhost", port);
+        if (fd < 0) {
+            TRACE( TRACE_ALWAYS, "Cannot connect to port (%d)\n", port);
+            break;
+        }
+        set_nodelay(fd);
+        drivers.push_back(new xct_load_conn_t(i, fd, depth, end,
+                                              xct_type, spec_id));
+    }
+
+    for (uint i=0; i<drivers.size(); i++) drivers[i]->fork();
+
+    histogram_t latency;
+    uint_t committed = 0, aborted = 0, rejected = 0;
+    int failed = 0;
+    for (uint i=0; i<drivers.size(); i++) {
+        drivers[i]->join();
+        latency += drivers[i]->_latency;
+        committed += drivers[i]->_committed;
+        aborted += drivers[i]->_aborted;
+        rejected += drivers[i]->_rejected;
+        if (drivers[i]->_failed) ++failed;
+        delete (drivers[i]);
+    }
+    double elapsed = (trx_latency_now() - start)/1000000.;
+
+    TRACE( TRACE_ALWAYS, "Connections: (%d) Depth: (%d) Secs: (%.1f)\n",
+           (int)drivers.size(), depth, elapsed);
+    TRACE( TRACE_ALWAYS, "Committed: (%d) Aborted: (%d) Rejected: (%d)\n",
+           committed, aborted, rejected);
+    TRACE( TRACE_ALWAYS, "TPS: (%.1f)\n", (double)committed/elapsed);
+    TRACE( TRACE_ALWAYS, "Latency (usecs) p50 (%lld) p90 (%lld) p99 (%lld) p99.9 (%lld) max (%lld)\n",
+           (long long)latency.percentile(50), (long long)latency.percentile(90),
+           (long long)latency.percentile(99), (long long)latency.percentile(99.9),
+           (long long)latency.max());
+    if (failed) {
+        TRACE( TRACE_ALWAYS, "Connections lost: (%d)\n", failed);
+    }
+    return ((drivers.size() == (uint)conns) && !failed) ? 0 : 1;
+}
+
+
+EXIT_NAMESPACE(shore);
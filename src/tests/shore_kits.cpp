@@ -188,6 +188,10 @@ public:
                                   const int iNumOfThreads, const int iDuration,
                                   const int iSelectedTrx, const int iIterations,
                                   const eBindingType abt);
+    virtual int _cmd_SWEEP_impl(const double iQueriedSF, const int iSpread,
+                                const int iNumOfThreads, const int iDuration,
+                                const int iSelectedTrx, const int iRateFrom,
+                                const int iRateTo, const int iRateStep);
 
     virtual w_rc_t prepareNewRun() { assert(_dbinst); return(_dbinst->newrun()); }
 
@@ -334,6 +338,7 @@ int kit_t<Client,DB>::_cmd_TEST_impl(const double iQueriedSF,
         int wh_id = 0;
 
         _env->reset_stats();
+        trx_latency_reset();
 
         // reset monitor stats
 #ifdef HAVE_CPUMON
@@ -384,6 +389,7 @@ int kit_t<Client,DB>::_cmd_TEST_impl(const double iQueriedSF,
 	TRACE(TRACE_ALWAYS, "end measurement\n");
         _env->print_throughput(iQueriedSF,iSpread,iNumOfThreads,delay,
                                miochs, usage);
+        trx_latency_print(_sup_trxs);
         
 #ifdef HAVE_CPUMON
         _g_mon->print_load(delay);
@@ -479,6 +485,7 @@ int kit_t<Client,DB>::_cmd_MEASURE_impl(const double iQueriedSF,
 	    _env->set_measure(MST_MEASURE);
 
 	    _env->reset_stats();
+	    trx_latency_reset();
 	    delay = 0;
 	    remaining = iDuration;
 	}
@@ -501,6 +508,7 @@ int kit_t<Client,DB>::_cmd_MEASURE_impl(const double iQueriedSF,
 	TRACE(TRACE_ALWAYS, "end measurement\n");
         _env->print_throughput(iQueriedSF,iSpread,iNumOfThreads,delay,
                                miochs, usage);
+        trx_latency_print(_sup_trxs);
 
 #ifdef HAVE_CPUMON
         _g_mon->print_load(delay);
@@ -547,6 +555,158 @@ int kit_t<Client,DB>::_cmd_MEASURE_impl(const double iQueriedSF,
 }
 
 
+
+// cmd: SWEEP
+
+// The outcome of one step of a sweep
+struct sweep_step_t
+{
+    int      _offered;   // trxs/sec
+    double   _arrived;   // trxs/sec
+    double   _achieved;  // trxs/sec
+    uint64_t _dropped;
+    uint64_t _aborted;
+    uint64_t _p50, _p90, _p99, _p999;
+};
+
+template<class Client,class DB>
+int kit_t<Client,DB>::_cmd_SWEEP_impl(const double iQueriedSF, 
+                                      const int iSpread,
+                                      const int iNumOfThreads, 
+                                      const int iDuration,
+                                      const int iSelectedTrx, 
+                                      const int iRateFrom,
+                                      const int iRateTo,
+                                      const int iRateStep)
+{
+    TRACE( TRACE_ALWAYS, "\n" \
+           "QueriedSF:     (%.1f)\n" \
+           "SpreadThreads: (%s)\n" \
+           "NumOfThreads:  (%d)\n" \
+           "Duration:      (%d)\n" \
+           "Trx:           (%s)\n" \
+           "Rates:         (%d..%d step %d)\n",
+           iQueriedSF, (iSpread ? "Yes" : "No"), iNumOfThreads, iDuration,
+           translate_trx(iSelectedTrx), iRateFrom, iRateTo, iRateStep);
+
+    _dbinst->upd_sf();
+    _dbinst->set_qf(iQueriedSF);
+
+    int max_out = envVar::instance()->getVarInt("db-cl-openloop-max",
+                                                DF_OPEN_LOOP_MAX_OUT);
+    std::vector<sweep_step_t> steps;
+
+    Client* testers[MAX_NUM_OF_THR];
+    for (int rate=iRateFrom; 
+         (rate<=iRateTo) && !base_client_t::is_test_aborted(); 
+         rate+=iRateStep) 
+    {
+        TRACE( TRACE_ALWAYS, "Offered rate (%d)\n", rate);
+
+        open_loop_t* driver = new open_loop_t(rate, max_out);
+        _current_prs_id = _start_prs_id;
+        int wh_id = 0;
+
+        // 1. fork the clients, which take the arrivals of the driver
+        _env->set_measure(MST_WARMUP);
+        shell_expect_clients(iNumOfThreads);
+        driver->start();
+        for (int i=0; i<iNumOfThreads; i++) {
+            if (iSpread) {
+                wh_id = (i%(int)iQueriedSF)+1;
+            }
+            testers[i] = new Client(c_str("CL-%d",i), i, _dbinst, 
+                                    MT_OPEN_LOOP, iSelectedTrx, 0,
+                                    _current_prs_id, wh_id, iQueriedSF);
+            assert (testers[i]);
+            testers[i]->set_driver(driver);
+            testers[i]->fork();
+            _current_prs_id = next_cpu(BT_NONE, _current_prs_id);
+        }
+        shell_await_clients();
+        sleep(1);
+
+        // 2. measure
+        TRACE(TRACE_ALWAYS, "begin measurement\n");
+        _env->set_measure(MST_MEASURE);
+        _env->reset_stats();
+        trx_latency_reset();
+        open_loop_stats_t before;
+        driver->get_stats(before);
+        stopwatch_t timer;
+        int remaining = iDuration;
+        while ((remaining = sleep(remaining)) && 
+               !base_client_t::is_test_aborted()) ;
+        double delay = timer.time();
+        open_loop_stats_t stats;
+        driver->get_stats(stats);
+        stats -= before;
+        histogram_t lat;
+        trx_latency_total(lat);
+        TRACE(TRACE_ALWAYS, "end measurement\n");
+
+        // 3. stop the arrivals and wait for the trxs in flight
+        _env->set_measure(MST_DONE);
+        driver->stop();
+        for (int i=0; i<iNumOfThreads; i++) {
+            testers[i]->join();
+            if (testers[i]->rv()) {
+                TRACE( TRACE_ALWAYS, "Error in testing...\n");
+                assert (false);
+            }    
+            delete (testers[i]);
+        }
+        // the trxs still in flight would complete to a deleted driver
+        if (driver->drain(60)) {
+            delete (driver);
+        }
+        else {
+            TRACE( TRACE_ALWAYS, "(%d) trxs still in flight\n", 
+                   driver->outstanding());
+        }
+
+        _env->print_throughput(iQueriedSF,iSpread,iNumOfThreads,delay,0,0);
+        trx_latency_print(_sup_trxs);
+
+        sweep_step_t step;
+        step._offered = rate;
+        step._arrived = stats._arrived/delay;
+        step._achieved = stats._done/delay;
+        step._dropped = stats._dropped;
+        step._aborted = stats._aborted;
+        step._p50 = lat.percentile(50);
+        step._p90 = lat.percentile(90);
+        step._p99 = lat.percentile(99);
+        step._p999 = lat.percentile(99.9);
+        steps.push_back(step);
+
+        // flush the log before the next step
+	_env->set_measure(MST_PAUSE);
+        _env->checkpoint();
+        TRACE( TRACE_ALWAYS, "Checkpoint\n");
+    }
+
+    // 4. the latency-vs-load curve
+    TRACE( TRACE_ALWAYS, "Sweep (rates in trxs/sec, latencies in usecs)\n");
+    TRACE( TRACE_ALWAYS, "Offered  Arrived  Achieved  Dropped  Aborted  "
+           "p50  p90  p99  p99.9\n");
+    for (uint i=0; i<steps.size(); i++) {
+        TRACE( TRACE_ALWAYS, "%d  %.1f  %.1f  %lld  %lld  %lld  %lld  %lld  %lld\n",
+               steps[i]._offered, steps[i]._arrived, steps[i]._achieved,
+               (long long)steps[i]._dropped, (long long)steps[i]._aborted,
+               (long long)steps[i]._p50, (long long)steps[i]._p90, 
+               (long long)steps[i]._p99, (long long)steps[i]._p999);
+    }
+
+    _env->set_measure(MST_DONE);
+    w_rc_t e = prepareNewRun();
+    if (e.is_error()) {
+        TRACE( TRACE_ALWAYS, "!!! Problem preparing for the next run\n");
+    }
+    return (SHELL_NEXT_CONTINUE);
+}
+
+
 ///////////////////////////////
 // Declare the possible kits //
 
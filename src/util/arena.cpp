@@ -0,0 +1,90 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+
+/** @file:   arena.cpp
+ *
+ *  @brief:  Implementation of the arena allocator
+ */
+
+#include "util/arena.h"
+
+#include <cstdlib>
+
+
+arena_t::arena_t(const size_t chunk_size)
+    : _chunks(NULL), _next(NULL), _end(NULL), 
+      _chunk_size(chunk_size), _allocated(0), _reserved(0)
+{
+    if (_chunk_size < 4096) _chunk_size = 4096;
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    _alloc_chunk
+ *
+ *  @brief: Takes a new chunk from malloc. A request larger than a
+ *          quarter of a chunk gets a chunk of its own, linked after the
+ *          current one, so that the free space of the current chunk is
+ *          not lost.
+ *
+ ********************************************************************/
+
+void* arena_t::_alloc_chunk(const size_t size)
+{
+    const size_t header = (sizeof(chunk_t) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    const bool own = (size > _chunk_size/4);
+    const size_t csize = header + (own ? size : _chunk_size);
+
+    chunk_t* chunk = (chunk_t*)malloc(csize);
+    if (!chunk) throw std::bad_alloc();
+    chunk->_size = csize;
+    _reserved += csize;
+    _allocated += size;
+
+    char* p = ((char*)chunk) + header;
+    if (own && _chunks) {
+        chunk->_next = _chunks->_next;
+        _chunks->_next = chunk;
+        return (p);
+    }
+
+    chunk->_next = _chunks;
+    _chunks = chunk;
+    _next = p + size;
+    _end = ((char*)chunk) + csize;
+    return (p);
+}
+
+
+void arena_t::release()
+{
+    while (_chunks) {
+        chunk_t* next = _chunks->_next;
+        free(_chunks);
+        _chunks = next;
+    }
+    _next = _end = NULL;
+    _allocated = _reserved = 0;
+}
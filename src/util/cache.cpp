@@ -0,0 +1,77 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   cache.cpp
+ *
+ *  @brief:  Statistics of the object caches
+ */
+
+#include <unistd.h>
+
+#include "util/cache.h"
+#include "util/trace.h"
+
+
+/******************************************************************** 
+ *
+ *  @fn:    print_stats()
+ *
+ *  @brief: Prints the totals of the caches, the borrows per sec since
+ *          the last call and the resident set size of the process
+ *
+ *  @note:  The caches add their counts every RECLAIM_BATCH borrows, so
+ *          the last few borrows of each thread may be missing
+ *
+ ********************************************************************/
+
+void cache_stats_t::print_stats()
+{
+    uint64_t borrowed = *&_borrowed;
+    double secs = _timer.time();
+    double rate = (secs > 0 ? (borrowed - _last_borrowed)/secs : 0);
+    _last_borrowed = borrowed;
+
+    TRACE( TRACE_STATISTICS, "Cache borrows   (%lld) \t%.0f/sec\n", 
+           (long long)borrowed, rate);
+    TRACE( TRACE_STATISTICS, "Remote returns  (%lld) \t%.1f%% \t(%lld) batches\n", 
+           (long long)*&_remote, 
+           (borrowed ? (double)(100*(*&_remote))/(double)borrowed : 0.0), 
+           (long long)*&_reclaims);
+    TRACE( TRACE_STATISTICS, "Cache high-water (%lld) objects\n", 
+           (long long)*&_high_water);
+    TRACE( TRACE_STATISTICS, "Cache trimmed   (%lld) \torphaned (%lld)\n", 
+           (long long)*&_trimmed, (long long)*&_orphaned);
+
+    // The second field of statm is the resident pages
+    long pages = 0;
+    FILE* fd = fopen("/proc/self/statm", "r");
+    if (fd) {
+        long size = 0;
+        if (fscanf(fd, "%ld %ld", &size, &pages) != 2) pages = 0;
+        fclose(fd);
+    }
+    if (pages > 0) {
+        TRACE( TRACE_STATISTICS, "RSS             (%.1fMB)\n", 
+               (double)pages*sysconf(_SC_PAGESIZE)/(1024*1024));
+    }
+}
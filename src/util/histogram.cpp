@@ -0,0 +1,81 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+   
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+   
+                         All Rights Reserved.
+   
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+   
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   histogram.cpp
+ *
+ *  @brief:  Log-bucketed (HDR-style) histogram of 64-bit values
+ */
+
+#include "util/histogram.h"
+
+
+uint64_t histogram_t::bucket_value(const uint idx)
+{
+    if (idx < 2*HIST_SUB_BUCKETS) return (idx);
+    uint shift = idx/HIST_SUB_BUCKETS - 1;
+    uint64_t sub = idx%HIST_SUB_BUCKETS + HIST_SUB_BUCKETS;
+    return (((sub+1)<<shift) - 1);
+}
+
+
+uint64_t histogram_t::percentile(const double p) const
+{
+    if (_total == 0) return (0);
+
+    // the rank of the value we are looking for
+    uint64_t rank = (uint64_t)((p/100.0)*_total + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank > _total) rank = _total;
+
+    uint64_t seen = 0;
+    for (uint i=0; i<HIST_BUCKETS; i++) {
+        seen += _counts[i];
+        if (seen >= rank) return (bucket_value(i));
+    }
+    return (max());
+}
+
+
+uint64_t histogram_t::max() const
+{
+    for (uint i=HIST_BUCKETS; i>0; i--) {
+        if (_counts[i-1]) return (bucket_value(i-1));
+    }
+    return (0);
+}
+
+
+histogram_t& histogram_t::operator+=(const histogram_t& rhs)
+{
+    for (uint i=0; i<HIST_BUCKETS; i++) _counts[i] += rhs._counts[i];
+    _total += rhs._total;
+    return (*this);
+}
+
+
+histogram_t& histogram_t::operator-=(const histogram_t& rhs)
+{
+    for (uint i=0; i<HIST_BUCKETS; i++) _counts[i] -= rhs._counts[i];
+    _total -= rhs._total;
+    return (*this);
+}
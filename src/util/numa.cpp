@@ -0,0 +1,301 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   numa.cpp
+ *
+ *  @brief:  Implementation of the NUMA topology discovery and of the
+ *           thread/memory placement helpers
+ */
+
+#include "util/numa.h"
+#include "util/trace.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+
+// from <numaif.h>, which comes with libnuma
+const int KITS_MPOL_DEFAULT   = 0;
+const int KITS_MPOL_PREFERRED = 1;
+#endif
+
+
+/********************************************************************
+ *
+ *  @fn:    Construction
+ *
+ *  @brief: Reads the topology. Falls back to a single node with all
+ *          the online cpus.
+ *
+ ********************************************************************/
+
+numa_topology_t::numa_topology_t()
+    : _discovered(false)
+{
+    _discovered = _read_sysfs();
+    if (!_discovered) {
+        _node_cpus.clear();
+        _cpu_node.clear();
+        _sys_ids.clear();
+        _sys_ids.push_back(0);
+        long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (ncpus < 1) ncpus = 1;
+        for (long i=0; i<ncpus; i++) {
+            _add(0,i);
+        }
+    }
+}
+
+
+void numa_topology_t::_add(const int node, const processorid_t cpu)
+{
+    if ((int)_node_cpus.size() <= node) _node_cpus.resize(node+1);
+    _node_cpus[node].push_back(cpu);
+    if ((int)_cpu_node.size() <= cpu) _cpu_node.resize(cpu+1,-1);
+    _cpu_node[cpu] = node;
+}
+
+
+/********************************************************************
+ *
+ *  @fn:    _read_sysfs
+ *
+ *  @brief: Parses /sys/devices/system/node/node<N>/cpulist, which is
+ *          a list of ranges such as "0-5,12-17"
+ *
+ *  @note:  Nodes without cpus are skipped, the remaining ones are
+ *          renumbered densely
+ *
+ ********************************************************************/
+
+bool numa_topology_t::_read_sysfs()
+{
+#ifdef __linux__
+    const char* base = "/sys/devices/system/node";
+    DIR* dir = opendir(base);
+    if (!dir) return (false);
+
+    std::vector<int> ids;
+    struct dirent* de;
+    while ((de = readdir(dir)) != NULL) {
+        int id;
+        if ((strncmp(de->d_name, "node", 4) == 0) &&
+            (sscanf(de->d_name + 4, "%d", &id) == 1)) {
+            ids.push_back(id);
+        }
+    }
+    closedir(dir);
+    std::sort(ids.begin(), ids.end());
+
+    int node = 0;
+    for (uint i=0; i<ids.size(); i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/node%d/cpulist", base, ids[i]);
+        FILE* f = fopen(path, "r");
+        if (!f) continue;
+
+        char list[4096];
+        bool any = false;
+        if (fgets(list, sizeof(list), f)) {
+            char* save = NULL;
+            for (char* tok = strtok_r(list, ",\n", &save); tok;
+                 tok = strtok_r(NULL, ",\n", &save)) {
+                int lo, hi;
+                int n = sscanf(tok, "%d-%d", &lo, &hi);
+                if (n < 1) continue;
+                if (n == 1) hi = lo;
+                for (int c=lo; c<=hi; c++) {
+                    _add(node,c);
+                    any = true;
+                }
+            }
+        }
+        fclose(f);
+        if (any) {
+            _sys_ids.push_back(ids[i]);
+            ++node;
+        }
+    }
+    return (node > 0);
+#else
+    return (false);
+#endif
+}
+
+
+
+int numa_topology_t::node_of(const processorid_t cpu) const
+{
+    if ((cpu < 0) || (cpu >= (int)_cpu_node.size()) || (_cpu_node[cpu] < 0))
+        return (0);
+    return (_cpu_node[cpu]);
+}
+
+
+processorid_t numa_topology_t::cpu_of(const uint node, const uint idx) const
+{
+    const std::vector<processorid_t>& cpus = _node_cpus[node % nodes()];
+    return (cpus[idx % cpus.size()]);
+}
+
+
+int numa_topology_t::current_node() const
+{
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0) return (node_of(cpu));
+#endif
+    return (0);
+}
+
+
+void numa_topology_t::print() const
+{
+    TRACE( TRACE_ALWAYS, "NUMA nodes: (%d) %s\n", nodes(),
+           (_discovered ? "" : "(not discovered)"));
+    for (uint i=0; i<nodes(); i++) {
+        TRACE( TRACE_ALWAYS, "Node (%d) cpus (%d) first (%d) last (%d)\n",
+               i, cpus(i), _node_cpus[i].front(), _node_cpus[i].back());
+    }
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    numa_bind_{cpu,node}
+ *
+ ********************************************************************/
+
+#ifdef __linux__
+static int _set_affinity(const std::vector<processorid_t>& cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint i=0; i<cpus.size(); i++) {
+        CPU_SET(cpus[i], &set);
+    }
+    return (sched_setaffinity(0, sizeof(set), &set));
+}
+#endif
+
+
+int numa_bind_cpu(const processorid_t cpu)
+{
+#ifdef __linux__
+    if (cpu < 0) return (1);
+    std::vector<processorid_t> cpus(1,cpu);
+    return (_set_affinity(cpus) ? 1 : 0);
+#else
+    return (1);
+#endif
+}
+
+
+int numa_bind_node(const int node)
+{
+#ifdef __linux__
+    numa_topology_t* topo = numa_topology_t::instance();
+    if ((node < 0) || (node >= (int)topo->nodes())) return (1);
+    std::vector<processorid_t> cpus;
+    for (uint i=0; i<topo->cpus(node); i++) {
+        cpus.push_back(topo->cpu_of(node,i));
+    }
+    return (_set_affinity(cpus) ? 1 : 0);
+#else
+    return (1);
+#endif
+}
+
+
+
+/********************************************************************
+ *
+ *  @fn:    numa_local_t
+ *
+ *  @brief: Saves the affinity and the memory policy of the calling
+ *          thread, moves it to the node and prefers the node for its
+ *          new pages. The destructor restores both.
+ *
+ *  @note:  With a single node there is nothing to place, so it is a
+ *          no-op.
+ *
+ ********************************************************************/
+
+numa_local_t::numa_local_t(const int node)
+    : _node(node), _old_policy(-1), _old_nodemask(0)
+{
+#ifdef __linux__
+    numa_topology_t* topo = numa_topology_t::instance();
+    if ((_node < 0) || (topo->nodes() < 2) || (_node >= (int)topo->nodes())) {
+        _node = -1;
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c=0; c<CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &set)) _old_cpus.push_back(c);
+        }
+    }
+    numa_bind_node(_node);
+
+    int sys_id = topo->sys_id(_node);
+    if (sys_id < (int)(8*sizeof(unsigned long))) {
+        int policy = KITS_MPOL_DEFAULT;
+        unsigned long mask = 0;
+        if (syscall(SYS_get_mempolicy, &policy, &mask, 8*sizeof(mask), 0, 0) == 0) {
+            unsigned long nodemask = (1UL << sys_id);
+            if (syscall(SYS_set_mempolicy, KITS_MPOL_PREFERRED,
+                        &nodemask, 8*sizeof(nodemask)) == 0) {
+                _old_policy = policy;
+                _old_nodemask = mask;
+            }
+        }
+    }
+#else
+    _node = -1;
+#endif
+}
+
+
+numa_local_t::~numa_local_t()
+{
+#ifdef __linux__
+    if (_node < 0) return;
+    if (!_old_cpus.empty()) _set_affinity(_old_cpus);
+    if (_old_policy >= 0) {
+        syscall(SYS_set_mempolicy, _old_policy,
+                (_old_policy == KITS_MPOL_DEFAULT ? NULL : &_old_nodemask),
+                8*sizeof(_old_nodemask));
+    }
+#endif
+}
@@ -138,6 +138,41 @@ void resource_pool_t::reserve(int n)
 
 
 
+/** 
+ *  @brief Reserve up to the specified number of resources, without
+ *  waiting. Nothing is reserved while there are waiters, so that they
+ *  keep their FIFO turn.
+ *
+ *  THE CALLER MUST BE HOLDING THE INTERNAL MUTEX ('mutexp' used to
+ *  initialize 'rp') WHEN CALLING THIS FUNCTION. THE CALLER WILL HOLD
+ *  THIS MUTEX WHEN THE FUNCTION RETURNS.
+ *
+ *  @return The number of resources reserved, between 0 and n.
+ */
+
+int resource_pool_t::try_reserve(int n)
+{
+    if (!static_list_is_empty(&_waiters))
+        return 0;
+
+    int num_unreserved = _capacity - _reserved;
+    if (n > num_unreserved)
+        n = num_unreserved;
+    if (n <= 0)
+        return 0;
+
+    _reserved += n;
+  
+    TRACE(TRACE_RESOURCE_POOL & TRACE_ALWAYS, "%s try_reserve %d:%d:%d\n",
+          _name.data(),
+          _capacity,
+          _reserved,
+          _non_idle);
+    return n;
+}
+
+
+
 /** 
  *  @brief Unreserve the specified number of resources.
  *
@@ -107,6 +107,141 @@ void timet_to_str(char* dst, time_t time)
 
 
 
+/******************************************************************** 
+ *
+ *  @fn:     ymd_to_daynum
+ *
+ *  @brief:  Converts a (proleptic Gregorian) date to the number of
+ *           days since 1970-01-01
+ *
+ *  @note:   Pure arithmetic, it does not call mktime()
+ *
+ ********************************************************************/
+
+int ymd_to_daynum(int year, int month, int day)
+{
+    // count the years from March, so that Feb 29 is the last day
+    year -= (month <= 2);
+    const int era = (year >= 0 ? year : year-399) / 400;
+    const int yoe = year - era*400;
+    const int doy = (153*(month + (month > 2 ? -3 : 9)) + 2)/5 + day-1;
+    const int doe = yoe*365 + yoe/4 - yoe/100 + doy;
+    return (era*146097 + doe - 719468);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     str_to_daynum
+ *
+ *  @brief:  Converts a string in format YYYY-MM-DD to a day number
+ *
+ ********************************************************************/
+
+int str_to_daynum(char const* str)
+{
+    assert (str);
+    assert (isdigit(str[0]) && (str[4] == '-') && (str[7] == '-'));
+    const int year  = (str[0]-'0')*1000 + (str[1]-'0')*100 + 
+        (str[2]-'0')*10 + (str[3]-'0');
+    const int month = (str[5]-'0')*10 + (str[6]-'0');
+    const int day   = (str[8]-'0')*10 + (str[9]-'0');
+    return (ymd_to_daynum(year, month, day));
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     timet_to_daynum
+ *
+ *  @brief:  Returns the day number of the (local) day of a time_t
+ *
+ ********************************************************************/
+
+int timet_to_daynum(time_t time)
+{
+    struct tm atm;
+    localtime_r(&time, &atm);
+    return (ymd_to_daynum(atm.tm_year+1900, atm.tm_mon+1, atm.tm_mday));
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     daynum_to_timet
+ *
+ *  @brief:  Returns the (local) midnight of a day number, the same
+ *           value str_to_timet() returns for that day
+ *
+ ********************************************************************/
+
+time_t daynum_to_timet(int daynum)
+{
+    tm time_str;
+    memset(&time_str, 0, sizeof(time_str));
+    time_str.tm_year = 70;
+    time_str.tm_mday = 1 + daynum; // mktime() normalizes the day
+    time_str.tm_isdst = -1;
+    return mktime(&time_str);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     daynum_to_ymd
+ *
+ *  @brief:  Converts a day number back to a (year,month,day) date
+ *
+ ********************************************************************/
+
+void daynum_to_ymd(int daynum, int& year, int& month, int& day)
+{
+    // inverse of ymd_to_daynum()
+    const int z   = daynum + 719468;
+    const int era = (z >= 0 ? z : z-146096) / 146097;
+    const int doe = z - era*146097;
+    const int yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    const int doy = doe - (365*yoe + yoe/4 - yoe/100);
+    const int mp  = (5*doy + 2)/153;
+    day   = doy - (153*mp + 2)/5 + 1;
+    month = mp + (mp < 10 ? 3 : -9);
+    year  = yoe + era*400 + (month <= 2);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     daynum_year
+ *
+ *  @brief:  Returns the year of a day number
+ *
+ ********************************************************************/
+
+int daynum_year(int daynum)
+{
+    int year, month, day;
+    daynum_to_ymd(daynum, year, month, day);
+    return (year);
+}
+
+
+/******************************************************************** 
+ *
+ *  @fn:     daynum_to_str
+ *
+ *  @brief:  Converts a day number to a string with format YYYY-MM-DD
+ *
+ ********************************************************************/
+
+void daynum_to_str(char* dst, int daynum)
+{
+    int year, month, day;
+    daynum_to_ymd(daynum, year, month, day);
+    sprintf(dst, "%04d-%02d-%02d", year, month, day);
+}
+
+
+
 
 
 /******************************************************************** 
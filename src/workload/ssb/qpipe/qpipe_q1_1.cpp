@@ -30,6 +30,7 @@
  */
 
 #include "workload/ssb/shore_ssb_env.h"
+#include "sm/shore/shore_column_scan.h"
 #include "qpipe.h"
 
 using namespace shore;
@@ -106,6 +107,12 @@ private:
     int DISCOUNT_2;
     int QUANTITY;
 
+    /* Offsets of the fields in the lineorder records, for the batches */
+    offset_t _orderdate_off;
+    offset_t _quantity_off;
+    offset_t _extendedprice_off;
+    offset_t _discount_off;
+
 public:
 
     q11_lineorder_tscan_filter_t(ShoreSSBEnv* ssbdb)//,q1_1_input_t &in) 
@@ -117,6 +124,11 @@ public:
         _rr.set_ts(_ssbdb->lineorder_man()->ts(),
                    _ssbdb->lineorder_desc()->maxsize());
         _prline->_rep = &_rr;
+
+        _orderdate_off = fixed_field_offset(_ssbdb->lineorder_desc(), 5);
+        _quantity_off = fixed_field_offset(_ssbdb->lineorder_desc(), 8);
+        _extendedprice_off = fixed_field_offset(_ssbdb->lineorder_desc(), 9);
+        _discount_off = fixed_field_offset(_ssbdb->lineorder_desc(), 11);
         
         DISCOUNT_1=1;
         DISCOUNT_2=3;
@@ -179,6 +191,46 @@ public:
 
     }
 
+    // The batches read the fields straight from the lineorder records
+    bool batched() const {
+        return (true);
+    }
+
+    // The predicates of the batches, on the lineorder records
+    struct batch_pred_t {
+        offset_t _discount_off;
+        offset_t _quantity_off;
+        int _discount_1;
+        int _discount_2;
+        int _quantity;
+        bool operator()(const char* rec) const {
+            int discount = fixed_field<int>(rec, _discount_off);
+            int quantity = fixed_field<int>(rec, _quantity_off);
+            return ((discount >= _discount_1) & (discount <= _discount_2) &
+                    (quantity < _quantity));
+        }
+    };
+
+    // Batch predication, without loading the records
+    void select_batch(page &p, selection_t &sel) {
+        batch_pred_t pred = { _discount_off, _quantity_off,
+                              DISCOUNT_1, DISCOUNT_2, QUANTITY };
+        select_batch_if(p, sel, pred);
+    }
+
+    // Batch projection of the survivors
+    void project_batch(tuple_fifo* out, page &p, const selection_t &sel) {
+        for (size_t i=0; i<sel.size(); i++) {
+            const char* rec = p.get_tuple(sel[i]).data;
+            tuple_t d = out->allocate();
+            q11_lo_tuple *dest;
+            dest = aligned_cast<q11_lo_tuple>(d.data);
+            dest->LO_ORDERDATE = fixed_field<int>(rec, _orderdate_off);
+            dest->LO_EXTENDEDPRICE = fixed_field<int>(rec, _extendedprice_off);
+            dest->LO_DISCOUNT = fixed_field<int>(rec, _discount_off);
+        }
+    }
+
     q11_lineorder_tscan_filter_t* clone() const {
         return new q11_lineorder_tscan_filter_t(*this);
     }
@@ -425,7 +477,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q1_1(const int xct_id,
 	//JOIN Lineorder and Date
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q11_join_tuple));
 	packet_t* q11_join_packet =
-	    new hash_join_packet_t("Lineorder - Date JOIN",
+	    create_hash_join_packet("Lineorder - Date JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q11_join_tuple)),
 				   q11_lo_tscan_packet,
@@ -800,7 +800,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q2_1(const int xct_id,
     //JOIN Lineorder and Supplier
     tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof (q21_join_s_tuple));
     packet_t* join_lo_s_packet =
-            new hash_join_packet_t("Lineorder - Supplier JOIN",
+            create_hash_join_packet("Lineorder - Supplier JOIN",
             join_lo_s_out,
             new trivial_filter_t(sizeof (q21_join_s_tuple)),
             lo_tscan_packet,
@@ -810,7 +810,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q2_1(const int xct_id,
     //JOIN Lineorder and Supplier and Part
     tuple_fifo* join_lo_s_p_out = new tuple_fifo(sizeof (q21_join_s_p_tuple));
     packet_t* join_lo_s_p_packet =
-            new hash_join_packet_t("Lineorder - Supplier - Part JOIN",
+            create_hash_join_packet("Lineorder - Supplier - Part JOIN",
             join_lo_s_p_out,
             new trivial_filter_t(sizeof (q21_join_s_p_tuple)),
             join_lo_s_packet,
@@ -820,7 +820,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q2_1(const int xct_id,
     //JOIN Lineorder and Supplier and Part and Date
     tuple_fifo* join_out = new tuple_fifo(sizeof (q21_join_tuple));
     packet_t* join_packet =
-            new hash_join_packet_t("Lineorder - Supplier - Part - Date JOIN",
+            create_hash_join_packet("Lineorder - Supplier - Part - Date JOIN",
             join_out,
             new trivial_filter_t(sizeof (q21_join_tuple)),
             join_lo_s_p_packet,
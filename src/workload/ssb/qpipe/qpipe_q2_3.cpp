@@ -844,7 +844,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q2_3(const int xct_id,
 	//JOIN Lineorder and Supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q23_join_s_tuple));
 	packet_t* q23_join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q23_join_s_tuple)),
 				   q23_lo_tscan_packet,
@@ -854,7 +854,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q2_3(const int xct_id,
 	//JOIN Lineorder and Supplier and Part
 	tuple_fifo* join_lo_s_p_out = new tuple_fifo(sizeof(q23_join_s_p_tuple));
 	packet_t* q23_join_lo_s_p_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Part JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Part JOIN",
 				   join_lo_s_p_out,
 				   new trivial_filter_t(sizeof(q23_join_s_p_tuple)),
 				   q23_join_lo_s_packet,
@@ -864,7 +864,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q2_3(const int xct_id,
 	//JOIN Lineorder and Supplier and Part and Date
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q23_join_tuple));
 	packet_t* q23_join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Part - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Part - Date JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q23_join_tuple)),
 				   q23_join_lo_s_p_packet,
@@ -885,7 +885,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_1(const int xct_id,
 	//JOIN Lineorder and Supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q31_join_s_tuple));
 	packet_t* join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q31_join_s_tuple)),
 				   lo_tscan_packet,
@@ -895,7 +895,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_1(const int xct_id,
 	//JOIN Lineorder and Supplier and Customer
 	tuple_fifo* join_lo_s_c_out = new tuple_fifo(sizeof(q31_join_s_c_tuple));
 	packet_t* join_lo_s_c_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer JOIN",
 				   join_lo_s_c_out,
 				   new trivial_filter_t(sizeof(q31_join_s_c_tuple)),
 				   join_lo_s_packet,
@@ -905,7 +905,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_1(const int xct_id,
 	//JOIN Lineorder and Supplier and Customer and Date
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q31_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer - Date JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q31_join_tuple)),
 				   join_lo_s_c_packet,
@@ -872,7 +872,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_2(const int xct_id,
 	//JOIN Lineorder and Date
 	tuple_fifo* join_lo_d_out = new tuple_fifo(sizeof(q32_join_d_tuple));
 	packet_t* join_lo_d_packet =
-	    new hash_join_packet_t("Lineorder - Date JOIN",
+	    create_hash_join_packet("Lineorder - Date JOIN",
 				   join_lo_d_out,
 				   new trivial_filter_t(sizeof(q32_join_d_tuple)),
 				   lo_tscan_packet,
@@ -882,7 +882,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_2(const int xct_id,
 	//JOIN Lineorder and Date and Supplier
 	tuple_fifo* join_lo_d_s_out = new tuple_fifo(sizeof(q32_join_d_s_tuple));
 	packet_t* join_lo_d_s_packet =
-	    new hash_join_packet_t("Lineorder - Date - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Date - Supplier JOIN",
 				   join_lo_d_s_out,
 				   new trivial_filter_t(sizeof(q32_join_d_s_tuple)),
 				   join_lo_d_packet,
@@ -892,7 +892,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_2(const int xct_id,
 	//JOIN Lineorder and Date and Supplier and Customer
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q32_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Date - Supplier - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Date - Supplier - Customer JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q32_join_tuple)),
 				   join_lo_d_s_packet,
@@ -882,7 +882,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_3(const int xct_id,
 	//JOIN Lineorder and Supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q33_join_s_tuple));
 	packet_t* join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q33_join_s_tuple)),
 				   lo_tscan_packet,
@@ -892,7 +892,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_3(const int xct_id,
 	//JOIN Lineorder and Supplier and Customer
 	tuple_fifo* join_lo_s_c_out = new tuple_fifo(sizeof(q33_join_s_c_tuple));
 	packet_t* join_lo_s_c_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer JOIN",
 				   join_lo_s_c_out,
 				   new trivial_filter_t(sizeof(q33_join_s_c_tuple)),
 				   join_lo_s_packet,
@@ -902,7 +902,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_3(const int xct_id,
 	//JOIN Lineorder and Supplier and Customer and Date
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q33_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer - Date JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q33_join_tuple)),
 				   join_lo_s_c_packet,
@@ -931,7 +931,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_4(const int xct_id,
 	//JOIN Lineorder and Supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q34_join_s_tuple));
 	packet_t* join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q34_join_s_tuple)),
 				   lo_tscan_packet,
@@ -941,7 +941,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_4(const int xct_id,
 	//JOIN Lineorder and Supplier and Date
 	tuple_fifo* join_lo_s_d_out = new tuple_fifo(sizeof(q34_join_s_d_tuple));
 	packet_t* join_lo_s_d_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Date JOIN",
 				   join_lo_s_d_out,
 				   new trivial_filter_t(sizeof(q34_join_s_d_tuple)),
 				   join_lo_s_packet,
@@ -951,7 +951,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q3_4(const int xct_id,
 	//JOIN Lineorder and Supplier and Date and Customer
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q34_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Date - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Date - Customer JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q34_join_tuple)),
 				   join_lo_s_d_packet,
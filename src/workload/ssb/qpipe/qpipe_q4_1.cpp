@@ -1016,7 +1016,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_1(const int xct_id,
 	//JOIN Lineorder and supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q41_join_s_tuple));
 	packet_t* join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q41_join_s_tuple)),
 				   lo_tscan_packet,
@@ -1026,7 +1026,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_1(const int xct_id,
 	//JOIN Lineorder and Supplier and Customer
 	tuple_fifo* join_lo_s_c_out = new tuple_fifo(sizeof(q41_join_s_c_tuple));
 	packet_t* join_lo_s_c_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer JOIN",
 				   join_lo_s_c_out,
 				   new trivial_filter_t(sizeof(q41_join_s_c_tuple)),
 				   join_lo_s_packet,
@@ -1036,7 +1036,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_1(const int xct_id,
         //JOIN Lineorder and Supplier and Customer and Part
 	tuple_fifo* join_lo_s_c_p_out = new tuple_fifo(sizeof(q41_join_s_c_p_tuple));
 	packet_t* join_lo_s_c_p_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer - Part JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer - Part JOIN",
 				   join_lo_s_c_p_out,
 				   new trivial_filter_t(sizeof(q41_join_s_c_p_tuple)),
 				   join_lo_s_c_packet,
@@ -1046,7 +1046,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_1(const int xct_id,
 	//JOIN Lineorder and Supplier and Customer and Part and Date
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q41_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Customer - Part - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Customer - Part - Date JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q41_join_tuple)),
 				   join_lo_s_c_p_packet,
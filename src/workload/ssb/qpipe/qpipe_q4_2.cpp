@@ -1058,7 +1058,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_2(const int xct_id,
 	//JOIN Lineorder and supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q42_join_s_tuple));
 	packet_t* join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q42_join_s_tuple)),
 				   lo_tscan_packet,
@@ -1068,7 +1068,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_2(const int xct_id,
 	//JOIN Lineorder and Supplier and Date
 	tuple_fifo* join_lo_s_d_out = new tuple_fifo(sizeof(q42_join_s_d_tuple));
 	packet_t* join_lo_s_d_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Date JOIN",
 				   join_lo_s_d_out,
 				   new trivial_filter_t(sizeof(q42_join_s_d_tuple)),
 				   join_lo_s_packet,
@@ -1078,7 +1078,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_2(const int xct_id,
         //JOIN Lineorder and Supplier and Date and Part
 	tuple_fifo* join_lo_s_d_p_out = new tuple_fifo(sizeof(q42_join_s_d_p_tuple));
 	packet_t* join_lo_s_d_p_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Date - Part JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Date - Part JOIN",
 				   join_lo_s_d_p_out,
 				   new trivial_filter_t(sizeof(q42_join_s_d_p_tuple)),
 				   join_lo_s_d_packet,
@@ -1088,7 +1088,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_2(const int xct_id,
 	//JOIN Lineorder and Supplier and Date and Part and Customer
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q42_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Date - Part - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Date - Part - Customer JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q42_join_tuple)),
 				   join_lo_s_d_p_packet,
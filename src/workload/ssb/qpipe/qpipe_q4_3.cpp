@@ -1046,7 +1046,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_3(const int xct_id,
 	//JOIN Lineorder and supplier
 	tuple_fifo* join_lo_s_out = new tuple_fifo(sizeof(q43_join_s_tuple));
 	packet_t* join_lo_s_packet =
-	    new hash_join_packet_t("Lineorder - Supplier JOIN",
+	    create_hash_join_packet("Lineorder - Supplier JOIN",
 				   join_lo_s_out,
 				   new trivial_filter_t(sizeof(q43_join_s_tuple)),
 				   lo_tscan_packet,
@@ -1056,7 +1056,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_3(const int xct_id,
 	//JOIN Lineorder and Supplier and Date
 	tuple_fifo* join_lo_s_p_out = new tuple_fifo(sizeof(q43_join_s_p_tuple));
 	packet_t* join_lo_s_p_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Part JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Part JOIN",
 				   join_lo_s_p_out,
 				   new trivial_filter_t(sizeof(q43_join_s_p_tuple)),
 				   join_lo_s_packet,
@@ -1066,7 +1066,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_3(const int xct_id,
         //JOIN Lineorder and Supplier and Date and Part
 	tuple_fifo* join_lo_s_p_d_out = new tuple_fifo(sizeof(q43_join_s_p_d_tuple));
 	packet_t* join_lo_s_p_d_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Part - Date JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Part - Date JOIN",
 				   join_lo_s_p_d_out,
 				   new trivial_filter_t(sizeof(q43_join_s_p_d_tuple)),
 				   join_lo_s_p_packet,
@@ -1076,7 +1076,7 @@ w_rc_t ShoreSSBEnv::xct_qpipe_q4_3(const int xct_id,
 	//JOIN Lineorder and Supplier and Date and Part and Customer
 	tuple_fifo* join_out = new tuple_fifo(sizeof(q43_join_tuple));
 	packet_t* join_packet =
-	    new hash_join_packet_t("Lineorder - Supplier - Part - Date - Customer JOIN",
+	    create_hash_join_packet("Lineorder - Supplier - Part - Date - Customer JOIN",
 				   join_out,
 				   new trivial_filter_t(sizeof(q43_join_tuple)),
 				   join_lo_s_p_d_packet,
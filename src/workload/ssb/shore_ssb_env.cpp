@@ -165,6 +165,9 @@ void ShoreSSBEnv::table_creator_t::work()
     _env->_pcustomer_man->register_table_man();
     _env->_plineorder_man->register_table_man();
 
+    // In bulk loading mode also the baseline goes only to the heap files
+    if (_env->is_bulkload_enabled()) _env->bulkload_begin();
+
 
 
     // Do the baseline transaction
@@ -517,6 +520,16 @@ w_rc_t ShoreSSBEnv::loaddata()
 	loaders[i]->join();
     }
 
+    if (is_bulkload_enabled()) {
+        w_rc_t e = bulkload_end();
+        if (e.is_error()) {
+            dbgenssb::free_asc_date();
+            _loaded = true;
+            chk->join();
+            return (e);
+        }
+    }
+
     time_t tstop = time(NULL);
 
     // 5. Print stats
@@ -106,6 +106,7 @@ void ShoreSSBEnv::reset_stats()
 {
     CRITICAL_SECTION(last_stats_cs, _last_stats_mutex);
     _last_stats = _get_stats();
+    qpipe::tscan_stage_t::clear_stats();
 }
 
 
@@ -153,6 +154,9 @@ void ShoreSSBEnv::print_throughput(const double iQueriedSF,
            delay, mioch/delay, avgcpuusage, 
            100*avgcpuusage/get_max_cpu_count(),
            (trxs_att-trxs_abt-trxs_dld)/delay);
+
+    // pages saved by the shared scans of the QPipe queries
+    qpipe::tscan_stage_t::trace_stats();
 }
 
 
@@ -364,6 +364,9 @@ void  ShoreTM1Env::table_creator_t::work()
     _env->_psf_man->register_table_man();
     _env->_pcf_man->register_table_man();
 
+    // In bulk loading mode also the preloads go only to the heap files
+    if (_env->is_bulkload_enabled()) _env->bulkload_begin();
+
 
     // Preload (preloads_per_worker) records for each of the loaders
     int sub_id = 0;
@@ -577,6 +580,14 @@ w_rc_t ShoreTM1Env::loaddata()
 	loaders[i]->join();        
     }
 
+    if (is_bulkload_enabled()) {
+        w_rc_t e = bulkload_end();
+        if (e.is_error()) {
+            _loaded = true;
+            return (e);
+        }
+    }
+
 
     // 3. Join the loading threads
     time_t tstop = time(NULL);
@@ -463,6 +463,15 @@ void ShoreTPCBEnv::table_creator_t::work()
     _env->_pteller_man->register_table_man();
     _env->_paccount_man->register_table_man();
     _env->_phistory_man->register_table_man();
+
+    // In bulk loading mode the accounts go only to the heap files. The
+    // BRANCHES and TELLERS are small and they are padded through their
+    // indexes after they are loaded, so they are loaded with them.
+    if (_env->is_bulkload_enabled()) {
+        _env->bulkload_begin();
+        _env->_pbranch_man->set_bulkload(false);
+        _env->_pteller_man->set_bulkload(false);
+    }
     
     // Create 10k accounts in each partition to buffer 
     // workers from each other
@@ -563,6 +572,15 @@ w_rc_t ShoreTPCBEnv::loaddata()
 	loaders[i]->join();        
     }
 
+    if (is_bulkload_enabled()) {
+        w_rc_t e = bulkload_end();
+        if (e.is_error()) {
+            _loaded = true;
+            chk->join();
+            return (e);
+        }
+    }
+
     time_t tstop = time(NULL);
 
     // 5. Print stats
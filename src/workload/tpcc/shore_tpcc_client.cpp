@@ -56,6 +56,11 @@ baseline_tpcc_client_t::baseline_tpcc_client_t(c_str tname, const int id,
     // pick worker thread
     _worker = _env->worker(_id);
     assert (_worker);
+
+    // with db-worker-affinity the requests of the same warehouse go to
+    // the same worker, whichever client submits them. Combined with
+    // db-worker-steal the workers steal only when they run out of work.
+    _affinity = (envVar::instance()->getVarInt("db-worker-affinity",0) == 1);
 }
 
 
@@ -110,13 +115,14 @@ w_rc_t baseline_tpcc_client_t::submit_one(int xct_type, int xctid)
         whid = URand(1,_qf); 
 
     // Get one action from the trash stack
-    trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+    trx_request_t* arequest = _env->_request_pool.borrow();
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,whid);    
 
     // Enqueue to worker thread
-    assert (_worker);
-    _worker->enqueue(arequest,bWake);
+    trx_worker_t* aworker = (_affinity ? _env->worker(whid-1) : _worker);
+    assert (aworker);
+    aworker->enqueue(arequest,bWake);
     return (RCOK);
 }
 
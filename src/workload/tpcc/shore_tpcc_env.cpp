@@ -549,6 +549,16 @@ w_rc_t ShoreTPCCEnv::loaddata()
 	tc->join();
     }
 
+    // In bulk loading mode the loaders append only to the heap files, 
+    // and the indexes are built after them. The WAREHOUSE and DISTRICT
+    // tables are already loaded by the table creator.
+    bool bBulkload = is_bulkload_enabled();
+    if (bBulkload) {
+        bulkload_begin();
+        _pwarehouse_man->set_bulkload(false);
+        _pdistrict_man->set_bulkload(false);
+    }
+
     // 2. Fire up a checkpointer thread
     guard<checkpointer_t> chk(new checkpointer_t(this));
     chk->fork();
@@ -574,6 +584,15 @@ w_rc_t ShoreTPCCEnv::loaddata()
 	loaders[i]->join();
     }
 
+    if (bBulkload) {
+        w_rc_t e = bulkload_end();
+        if (e.is_error()) {
+            _loaded = true;
+            chk->join();
+            return (e);
+        }
+    }
+
     time_t tstop = time(NULL);
 
     // 4. Print stats
@@ -653,6 +653,33 @@ CMEE* market_init(INT32 TradingTimeSoFar, CMEESUTInterface *pSUT, UINT32 UniqueI
 	return mee;
 }
 
+// Creates a generator for a range of customers. Each loader thread uses its
+// own generator, the loaders are run with disjoint customer ranges.
+// The caller owns the generator, and the logger and formatter it uses.
+CGenerateAndLoad* egen_create_loader(TIdent iStartCustomer, TIdent iCustomers,
+				     CBaseLogger*& pLogger,
+				     CBaseLogFormatter*& pLogFormat)
+{
+	assert(inputFiles!=NULL);
+
+	char szLogFileName[64];
+	snprintf(&szLogFileName[0], sizeof(szLogFileName),
+		 "EGenLoaderFrom%lldTo%lld.log",
+		 iStartCustomer, (iStartCustomer + iCustomers)-1);
+
+	// Create log formatter and logger instance
+	CLogFormatTab * fmt= new CLogFormatTab();
+	CEGenLogger* log = new CEGenLogger(eDriverEGenLoader, 0, szLogFileName, fmt);
+	pLogFormat = fmt;
+	pLogger = log;
+
+	return (new CGenerateAndLoad(*inputFiles, iCustomers, iStartCustomer,
+				     iTotalCustomerCount, iLoadUnitSize,
+				     iScaleFactor, iDaysOfInitialTrades,
+				     pLoaderFactory, log, Output, szInDir,
+				     bGenerateUsingCache));
+}
+
 void egen_release()
 {
 	delete pGenerateAndLoad;	// don't really need to do that, but just for good style
@@ -111,7 +111,7 @@ w_rc_t baseline_tpce_client_t::submit_one(int xct_type, int xctid)
     //     selid = URand(1,_qf); 
 
     // Get one action from the trash stack
-    trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+    trx_request_t* arequest = _env->_request_pool.borrow();
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,selid);    
 
@@ -152,42 +152,15 @@ void setRNGSeeds(CCETxnInputGenerator* gen, unsigned int UniqueId )
 }
 
 
-//check the cardinality of all tables to see if it is correctly generated
+//check the cardinality of the fixed tables, the rest are printed by each loader
 void printCardinality()
 {
-   printf("accountPermissionBuffer.getCnt()  %d\n",accountPermissionBuffer.getCnt() );
-   printf("customerAccountBuffer.getCnt()  %d\n",customerAccountBuffer.getCnt() );
-   printf("customerTaxrateBuffer.getCnt()  %d\n",customerTaxrateBuffer.getCnt() );
-   printf("customerBuffer.getCnt()  %d\n",customerBuffer.getCnt() );
-   printf("holdingBuffer.getCnt()  %d\n",holdingBuffer.getCnt() );
-   printf("watchItemBuffer.getCnt()  %d\n",watchItemBuffer.getCnt() );
-   printf("watchListBuffer.getCnt()  %d\n",watchListBuffer.getCnt() );
-   printf("brokerBuffer.getCnt()  %d\n",brokerBuffer.getCnt() );
-   printf("cashTransactionBuffer.getCnt()  %d\n",cashTransactionBuffer.getCnt() );
    printf("chargeBuffer.getCnt()  %d\n",chargeBuffer.getCnt() );
-   printf("holdingHistoryBuffer.getCnt()  %d\n",holdingHistoryBuffer.getCnt() );
-   printf("holdingSummaryBuffer.getCnt()  %d\n",holdingSummaryBuffer.getCnt() );
    printf("commissionRateBuffer.getCnt()  %d\n",commissionRateBuffer.getCnt() );
-   printf("companyBuffer.getCnt()  %d\n",companyBuffer.getCnt() );
-   printf("companyCompetitorBuffer.getCnt()  %d\n",companyCompetitorBuffer.getCnt() );
-   printf("dailyMarketBuffer.getCnt()  %d\n",dailyMarketBuffer.getCnt() );
-  
-
-   printf("settlementBuffer.getCnt()  %d\n",settlementBuffer.getCnt() );
-   printf("tradeBuffer.getCnt()  %d\n",tradeBuffer.getCnt() );
-   printf("tradeHistoryBuffer.getCnt()  %d\n",tradeHistoryBuffer.getCnt() );
    printf("tradeTypeBuffer.getCnt()  %d\n",tradeTypeBuffer.getCnt() );
-
-
    printf("exchangeBuffer.getCnt()  %d\n",exchangeBuffer.getCnt() );
-   printf("financialBuffer.getCnt()  %d\n",financialBuffer.getCnt() );
    printf("industryBuffer.getCnt()  %d\n",industryBuffer.getCnt() );
-   printf("newsItemBuffer.getCnt()  %d\n",newsItemBuffer.getCnt() );
-   printf("lastTradeBuffer.getCnt()  %d\n",lastTradeBuffer.getCnt() );
-   printf("newsXRefBuffer.getCnt()  %d\n",newsXRefBuffer.getCnt() );
    printf("sectorBuffer.getCnt()  %d\n",sectorBuffer.getCnt() );
-   printf("securityBuffer.getCnt()  %d\n",securityBuffer.getCnt() );
-   printf("addressBuffer.getCnt()  %d\n",addressBuffer.getCnt() );
    printf("statusTypeBuffer.getCnt()  %d\n",statusTypeBuffer.getCnt() );
    printf("taxrateBuffer.getCnt()  %d\n",taxrateBuffer.getCnt() );
    printf("zipCodeBuffer.getCnt()  %d\n",zipCodeBuffer.getCnt() );
@@ -602,75 +575,62 @@ struct ShoreTPCEEnv::checkpointer_t : public thread_t {
 
 /****************************************************************** 
  *
- * @struct: table_creator_t
+ * @class: table_builder_t
  *
- * @brief:  Helper class for creating the environment tables and
- *          loading a number of records in a single-threaded fashion
+ * @brief:  Helper class for loading the scaling and growing tables
+ *          for a range of customers. Each builder has its own egen
+ *          generator and buffers, and commits every batch of rows
+ *          it reads for a table.
  *
  ******************************************************************/
 
 class ShoreTPCEEnv::table_builder_t : public thread_t {
     ShoreTPCEEnv* _env;
-    int my_load_unit;
+    int    _loader_id;
+    TIdent _start;
+    TIdent _count;
 public:
-    table_builder_t(ShoreTPCEEnv* env)
-	: thread_t("TPC-E loader"), _env(env) { }
+    table_builder_t(ShoreTPCEEnv* env, int id, TIdent start, TIdent count)
+	: thread_t(c_str("TPC-E loader %d", id)), _env(env), _loader_id(id),
+          _start(start), _count(count) { }
     virtual void work();
 };
 
 void ShoreTPCEEnv::table_builder_t::work() 
 {
-    w_rc_t e = RCOK;
-
-    //populating fixed
-    populate_small_input_t in;
-    long log_space_needed = 0;
-    _env->read_small();
- retry:
-    W_COERCE(_env->db()->begin_xct());
-
-    if(log_space_needed > 0) {
-        W_COERCE(_env->db()->xct_reserve_log_space(log_space_needed));
-    }
+    TRACE( TRACE_ALWAYS, "Loader (%d) customers [%lld,%lld]\n",
+           _loader_id, _start, _start+_count-1);
 
-    e = _env->xct_populate_small(1, in);    
-    CHECK_XCT_RETURN(e,log_space_needed,retry,_env);
-    _env->release_small();
+    EgenLoader ld(_start, _count);
 
     //populating scaling tables
-    _env->populate_address(); 
-    _env->populate_customer();
-    _env->populate_ca_and_ap();
-    _env->populate_customer_taxrate();
-    _env->populate_wl_and_wi(); 
-
-    _env->populate_company(); 
-    _env->populate_company_competitor();
-    _env->populate_daily_market();
-    _env->populate_financial();
-    _env->populate_last_trade();
-    _env-> populate_ni_and_nx();
-    _env->populate_security();
+    _env->populate_address(&ld); 
+    _env->populate_customer(&ld);
+    _env->populate_ca_and_ap(&ld);
+    _env->populate_customer_taxrate(&ld);
+    _env->populate_wl_and_wi(&ld); 
+
+    _env->populate_company(&ld); 
+    _env->populate_company_competitor(&ld);
+    _env->populate_daily_market(&ld);
+    _env->populate_financial(&ld);
+    _env->populate_last_trade(&ld);
+    _env->populate_ni_and_nx(&ld);
+    _env->populate_security(&ld);
 
     //populate growing tables
-    _env-> populate_growing();
-    printCardinality();
-#ifdef COMPILE_FLAT_FILE_LOAD 
-    fclose(fshs);
-    fclose(fssec);
-#endif
-    //  testInputs();
-    _env->find_maxtrade_id();
-
+    _env->populate_growing(&ld);
+    ld.printCardinality();
 }
 
 
 
 /****************************************************************** 
  *
- * @class: table_builder_t
+ * @struct: table_creator_t
  *
- * @brief:  Helper class for loading the environment tables
+ * @brief:  Helper class for creating the environment tables and
+ *          loading the fixed tables in a single-threaded fashion
  *
  ******************************************************************/
 
@@ -737,6 +697,61 @@ void  ShoreTPCEEnv::table_creator_t::work()
      W_COERCE(_env->_ptaxrate_desc->create_physical_table(_env->db()));
      W_COERCE(_env->_pzip_code_desc->create_physical_table(_env->db()));
      W_COERCE(_env->db()->commit_xct());
+
+     /* after they obtained their fid, register managers */
+     _env->_paccount_permission_man->register_table_man();
+     _env->_pcustomer_man->register_table_man();
+     _env->_pcustomer_account_man->register_table_man();
+     _env->_pcustomer_taxrate_man->register_table_man();
+     _env->_pholding_man->register_table_man();
+     _env->_pholding_history_man->register_table_man();
+     _env->_pholding_summary_man->register_table_man();
+     _env->_pwatch_item_man->register_table_man();
+     _env->_pwatch_list_man->register_table_man();
+     _env->_pbroker_man->register_table_man();
+     _env->_pcash_transaction_man->register_table_man();
+     _env->_pcharge_man->register_table_man();
+     _env->_pcommission_rate_man->register_table_man();
+     _env->_psettlement_man->register_table_man();
+     _env->_ptrade_man->register_table_man();
+     _env->_ptrade_history_man->register_table_man();
+     _env->_ptrade_request_man->register_table_man();
+     _env->_ptrade_type_man->register_table_man();
+     _env->_pcompany_man->register_table_man();
+     _env->_pcompany_competitor_man->register_table_man();
+     _env->_pdaily_market_man->register_table_man();
+     _env->_pexchange_man->register_table_man();
+     _env->_pfinancial_man->register_table_man();
+     _env->_pindustry_man->register_table_man();
+     _env->_plast_trade_man->register_table_man();
+     _env->_pnews_item_man->register_table_man();
+     _env->_pnews_xref_man->register_table_man();
+     _env->_psector_man->register_table_man();
+     _env->_psecurity_man->register_table_man();
+     _env->_paddress_man->register_table_man();
+     _env->_pstatus_type_man->register_table_man();
+     _env->_ptaxrate_man->register_table_man();
+     _env->_pzip_code_man->register_table_man();
+
+     /* in bulk loading mode all the tables go only to the heap files */
+     if (_env->is_bulkload_enabled()) _env->bulkload_begin();
+
+     /* populate the fixed tables */
+     populate_small_input_t in;
+     long log_space_needed = 0;
+     w_rc_t e = RCOK;
+     _env->read_small();
+ retry:
+     W_COERCE(_env->db()->begin_xct());
+
+     if(log_space_needed > 0) {
+         W_COERCE(_env->db()->xct_reserve_log_space(log_space_needed));
+     }
+
+     e = _env->xct_populate_small(1, in);
+     CHECK_XCT_RETURN(e,log_space_needed,retry,_env);
+     _env->release_small();
+     printCardinality();
  
 //     /*
 //       create 10k accounts in each partition to buffer workers from each other
@@ -797,14 +812,47 @@ w_rc_t ShoreTPCEEnv::loaddata()
     chk->fork();
  
 
-    // 4. Fire up the loaders
-    TRACE( TRACE_ALWAYS, "Firing up %d loaders ..\n", 1);
+    // 4. Fire up the loaders, each one loads a range of customers.
+    //    The ranges should be multiple of the egen load unit
+    int loaders_to_use = envVar::instance()->getVarInt("db-loaders",10);
+    TIdent total_units = _customers/iDefaultLoadUnitSize;
+    if (loaders_to_use > total_units) loaders_to_use = total_units;
+    if (loaders_to_use < 1) loaders_to_use = 1;
+    TIdent units_per_thread = (total_units + loaders_to_use-1)/loaders_to_use;
+    if (units_per_thread < 1) units_per_thread = 1;
+    loaders_to_use = (total_units + units_per_thread-1)/units_per_thread;
+
+    TRACE( TRACE_ALWAYS, "Firing up %d loaders ..\n", loaders_to_use);
     {
-      guard<table_builder_t>loader = new table_builder_t(this);
-      // array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
-      loader->fork();
-      loader->join();
-    }  
+	array_guard_t< guard<table_builder_t> > loaders(new guard<table_builder_t>[loaders_to_use]);
+	for(int i=0; i < loaders_to_use; i++) {
+	    TIdent start = i*units_per_thread;
+	    TIdent count = (start+units_per_thread > total_units)? total_units-start : units_per_thread;
+	    loaders[i] = new table_builder_t(this, i,
+					     iDefaultStartFromCustomer + start*iDefaultLoadUnitSize,
+					     count*iDefaultLoadUnitSize);
+	    loaders[i]->fork();
+	}
+
+	for(int i=0; i < loaders_to_use; i++) {
+	    loaders[i]->join();
+	}
+    }
+#ifdef COMPILE_FLAT_FILE_LOAD 
+    fclose(fshs);
+    fclose(fssec);
+#endif
+
+    // the indexes are needed for finding the last trade id
+    if (is_bulkload_enabled()) {
+        e = bulkload_end();
+        if (e.is_error()) {
+            _loaded = true;
+            chk->join();
+            return (e);
+        }
+    }
+    find_maxtrade_id();
 
     // 5. Print stats
     time_t tstop = time(NULL);
@@ -71,45 +71,91 @@ int TradeOrderCnt;
 
 unsigned long lastTradeId = 0;
 
-//buffers for Egen data
-AccountPermissionBuffer accountPermissionBuffer (3015);
-CustomerBuffer customerBuffer (1005);
-CustomerAccountBuffer customerAccountBuffer (1005);
-CustomerTaxrateBuffer  customerTaxrateBuffer (2010);
-HoldingBuffer holdingBuffer(10000);
-HoldingHistoryBuffer holdingHistoryBuffer(2*loadUnit);
-HoldingSummaryBuffer holdingSummaryBuffer(6000);
-WatchItemBuffer watchItemBuffer (iMaxItemsInWL*1020+5000);
-WatchListBuffer watchListBuffer (1020);
-
-BrokerBuffer brokerBuffer(100);
-CashTransactionBuffer cashTransactionBuffer(loadUnit);
+//buffers for Egen data of the fixed tables, loaded only once
 ChargeBuffer chargeBuffer(20);
 CommissionRateBuffer commissionRateBuffer (245);
-SettlementBuffer settlementBuffer(loadUnit);
-TradeBuffer tradeBuffer(loadUnit);
-TradeHistoryBuffer tradeHistoryBuffer(3*loadUnit);
 TradeTypeBuffer tradeTypeBuffer (10);
-
-
-CompanyBuffer companyBuffer (1000);
-CompanyCompetitorBuffer companyCompetitorBuffer(3000);
-DailyMarketBuffer dailyMarketBuffer(3000);
 ExchangeBuffer exchangeBuffer(9);
-FinancialBuffer financialBuffer (1500);
 IndustryBuffer industryBuffer(107);
-LastTradeBuffer lastTradeBuffer (1005);
-NewsItemBuffer newsItemBuffer(200); 
-NewsXRefBuffer newsXRefBuffer(200);//big
 SectorBuffer sectorBuffer(17);
-SecurityBuffer securityBuffer(1005);
-
-
-AddressBuffer addressBuffer(1005);
 StatusTypeBuffer statusTypeBuffer (10);
 TaxrateBuffer taxrateBuffer (325);
 ZipCodeBuffer zipCodeBuffer (14850);
 
+
+/******************************************************************** 
+ *
+ * EgenLoader - The generator and the buffers of one loader
+ *
+ ********************************************************************/
+
+EgenLoader::EgenLoader(TIdent start, TIdent count)
+    : startCustomer(start), customerCount(count),
+      pGenerateAndLoad(NULL), pLogger(NULL), pLogFormat(NULL),
+      accountPermissionBuffer (3015),
+      customerBuffer (1005),
+      customerAccountBuffer (1005),
+      customerTaxrateBuffer (2010),
+      holdingBuffer(10000),
+      holdingHistoryBuffer(2*loadUnit),
+      holdingSummaryBuffer(6000),
+      watchItemBuffer (iMaxItemsInWL*1020+5000),
+      watchListBuffer (1020),
+      brokerBuffer(100),
+      cashTransactionBuffer(loadUnit),
+      settlementBuffer(loadUnit),
+      tradeBuffer(loadUnit),
+      tradeHistoryBuffer(3*loadUnit),
+      companyBuffer (1000),
+      companyCompetitorBuffer(3000),
+      dailyMarketBuffer(3000),
+      financialBuffer (1500),
+      lastTradeBuffer (1005),
+      newsItemBuffer(200),
+      newsXRefBuffer(200),//big
+      securityBuffer(1005),
+      addressBuffer(1005)
+{
+    pGenerateAndLoad = egen_create_loader(start, count, pLogger, pLogFormat);
+    assert (pGenerateAndLoad);
+}
+
+EgenLoader::~EgenLoader()
+{
+    delete pGenerateAndLoad;
+    delete pLogger;
+    delete pLogFormat;
+}
+
+//check the cardinality of the tables of this range of customers
+void EgenLoader::printCardinality()
+{
+    printf("Customers [%lld,%lld]\n", startCustomer, startCustomer+customerCount-1);
+    printf("accountPermissionBuffer.getCnt()  %ld\n",accountPermissionBuffer.getCnt() );
+    printf("customerAccountBuffer.getCnt()  %ld\n",customerAccountBuffer.getCnt() );
+    printf("customerTaxrateBuffer.getCnt()  %ld\n",customerTaxrateBuffer.getCnt() );
+    printf("customerBuffer.getCnt()  %ld\n",customerBuffer.getCnt() );
+    printf("holdingBuffer.getCnt()  %ld\n",holdingBuffer.getCnt() );
+    printf("watchItemBuffer.getCnt()  %ld\n",watchItemBuffer.getCnt() );
+    printf("watchListBuffer.getCnt()  %ld\n",watchListBuffer.getCnt() );
+    printf("brokerBuffer.getCnt()  %ld\n",brokerBuffer.getCnt() );
+    printf("cashTransactionBuffer.getCnt()  %ld\n",cashTransactionBuffer.getCnt() );
+    printf("holdingHistoryBuffer.getCnt()  %ld\n",holdingHistoryBuffer.getCnt() );
+    printf("holdingSummaryBuffer.getCnt()  %ld\n",holdingSummaryBuffer.getCnt() );
+    printf("companyBuffer.getCnt()  %ld\n",companyBuffer.getCnt() );
+    printf("companyCompetitorBuffer.getCnt()  %ld\n",companyCompetitorBuffer.getCnt() );
+    printf("dailyMarketBuffer.getCnt()  %ld\n",dailyMarketBuffer.getCnt() );
+    printf("settlementBuffer.getCnt()  %ld\n",settlementBuffer.getCnt() );
+    printf("tradeBuffer.getCnt()  %ld\n",tradeBuffer.getCnt() );
+    printf("tradeHistoryBuffer.getCnt()  %ld\n",tradeHistoryBuffer.getCnt() );
+    printf("financialBuffer.getCnt()  %ld\n",financialBuffer.getCnt() );
+    printf("newsItemBuffer.getCnt()  %ld\n",newsItemBuffer.getCnt() );
+    printf("lastTradeBuffer.getCnt()  %ld\n",lastTradeBuffer.getCnt() );
+    printf("newsXRefBuffer.getCnt()  %ld\n",newsXRefBuffer.getCnt() );
+    printf("securityBuffer.getCnt()  %ld\n",securityBuffer.getCnt() );
+    printf("addressBuffer.getCnt()  %ld\n",addressBuffer.getCnt() );
+}
+
 /******************************************************************** 
  *
  * Thread-local TPC-E TRXS Stats
@@ -622,15 +668,15 @@ w_rc_t ShoreTPCEEnv::_load_one_customer(rep_row_t& areprow, PCUSTOMER_ROW record
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_customer()
+void ShoreTPCEEnv::_read_customer(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCustomer();
-	PCUSTOMER_ROW record = pGenerateAndLoad->getCustomerRow();
-	customerBuffer.append(record);
-    } while((hasNext && customerBuffer.hasSpace()));
-    customerBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextCustomer();
+	PCUSTOMER_ROW record = ld->pGenerateAndLoad->getCustomerRow();
+	ld->customerBuffer.append(record);
+    } while((hasNext && ld->customerBuffer.hasSpace()));
+    ld->customerBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one CUSTOMER_TAXRATE
@@ -647,19 +693,19 @@ w_rc_t ShoreTPCEEnv::_load_one_customer_taxrate(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_customer_taxrate()
+void ShoreTPCEEnv::_read_customer_taxrate(EgenLoader* ld)
 {
     bool hasNext;
-    int taxrates=pGenerateAndLoad->getTaxratesCount();
+    int taxrates=ld->pGenerateAndLoad->getTaxratesCount();
     do {
-	hasNext= pGenerateAndLoad->hasNextCustomerTaxrate();
+	hasNext= ld->pGenerateAndLoad->hasNextCustomerTaxrate();
 	for(int i=0; i<taxrates; i++) {
 	    PCUSTOMER_TAXRATE_ROW record =
-		pGenerateAndLoad->getCustomerTaxrateRow(i);
-	    customerTaxrateBuffer.append(record);
+		ld->pGenerateAndLoad->getCustomerTaxrateRow(i);
+	    ld->customerTaxrateBuffer.append(record);
 	}
-    } while((hasNext && customerTaxrateBuffer.hasSpace()));    
-    customerTaxrateBuffer.setMoreToRead(hasNext);
+    } while((hasNext && ld->customerTaxrateBuffer.hasSpace()));    
+    ld->customerTaxrateBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one CUSTOMER_ACCOUNT
@@ -697,21 +743,21 @@ w_rc_t ShoreTPCEEnv::_load_one_account_permission(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_ca_and_ap()
+void ShoreTPCEEnv::_read_ca_and_ap(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCustomerAccount();
-	PCUSTOMER_ACCOUNT_ROW record = pGenerateAndLoad->getCustomerAccountRow();
-	customerAccountBuffer.append(record);
-	int perms = pGenerateAndLoad->PermissionsPerCustomer();
+	hasNext= ld->pGenerateAndLoad->hasNextCustomerAccount();
+	PCUSTOMER_ACCOUNT_ROW record = ld->pGenerateAndLoad->getCustomerAccountRow();
+	ld->customerAccountBuffer.append(record);
+	int perms = ld->pGenerateAndLoad->PermissionsPerCustomer();
 	for(int i=0; i<perms; i++) {
 	    PACCOUNT_PERMISSION_ROW row =
-		pGenerateAndLoad->getAccountPermissionRow(i);
-	    accountPermissionBuffer.append(row);
+		ld->pGenerateAndLoad->getAccountPermissionRow(i);
+	    ld->accountPermissionBuffer.append(row);
 	}
-    } while((hasNext && customerAccountBuffer.hasSpace()));
-    customerAccountBuffer.setMoreToRead(hasNext);
+    } while((hasNext && ld->customerAccountBuffer.hasSpace()));
+    ld->customerAccountBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one ADDRESS
@@ -730,15 +776,15 @@ w_rc_t ShoreTPCEEnv::_load_one_address(rep_row_t& areprow, PADDRESS_ROW record)
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_address()
+void ShoreTPCEEnv::_read_address(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextAddress();
-	PADDRESS_ROW record = pGenerateAndLoad->getAddressRow();
-	addressBuffer.append(record);
-    } while((hasNext && addressBuffer.hasSpace()));
-    addressBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextAddress();
+	PADDRESS_ROW record = ld->pGenerateAndLoad->getAddressRow();
+	ld->addressBuffer.append(record);
+    } while((hasNext && ld->addressBuffer.hasSpace()));
+    ld->addressBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one WATCH_LIST
@@ -769,20 +815,20 @@ w_rc_t ShoreTPCEEnv::_load_one_watch_item(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_wl_and_wi()
+void ShoreTPCEEnv::_read_wl_and_wi(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextWatchList();
-	PWATCH_LIST_ROW record = pGenerateAndLoad->getWatchListRow();
-	watchListBuffer.append(record);
-	int items = pGenerateAndLoad->ItemsPerWatchList();
+	hasNext= ld->pGenerateAndLoad->hasNextWatchList();
+	PWATCH_LIST_ROW record = ld->pGenerateAndLoad->getWatchListRow();
+	ld->watchListBuffer.append(record);
+	int items = ld->pGenerateAndLoad->ItemsPerWatchList();
 	for(int i=0; i<items; ++i) {
-	    PWATCH_ITEM_ROW row = pGenerateAndLoad->getWatchItemRow(i);
-	    watchItemBuffer.append(row);
+	    PWATCH_ITEM_ROW row = ld->pGenerateAndLoad->getWatchItemRow(i);
+	    ld->watchItemBuffer.append(row);
 	}
-    } while(hasNext && watchListBuffer.hasSpace());
-    watchListBuffer.setMoreToRead(hasNext);
+    } while(hasNext && ld->watchListBuffer.hasSpace());
+    ld->watchListBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one COMPANY
@@ -805,15 +851,15 @@ w_rc_t ShoreTPCEEnv::_load_one_company(rep_row_t& areprow, PCOMPANY_ROW record)
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_company()
+void ShoreTPCEEnv::_read_company(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCompany();
-	PCOMPANY_ROW record = pGenerateAndLoad->getCompanyRow();
-	companyBuffer.append(record);
-    } while((hasNext && companyBuffer.hasSpace()));
-    companyBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextCompany();
+	PCOMPANY_ROW record = ld->pGenerateAndLoad->getCompanyRow();
+	ld->companyBuffer.append(record);
+    } while((hasNext && ld->companyBuffer.hasSpace()));
+    ld->companyBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one COMPANY_COMPETITOR
@@ -831,16 +877,16 @@ w_rc_t ShoreTPCEEnv::_load_one_company_competitor(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_company_competitor()
+void ShoreTPCEEnv::_read_company_competitor(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextCompanyCompetitor();
+	hasNext= ld->pGenerateAndLoad->hasNextCompanyCompetitor();
 	PCOMPANY_COMPETITOR_ROW record =
-	    pGenerateAndLoad->getCompanyCompetitorRow();
-	companyCompetitorBuffer.append(record);
-    } while((hasNext && companyCompetitorBuffer.hasSpace()));
-    companyCompetitorBuffer.setMoreToRead(hasNext);
+	    ld->pGenerateAndLoad->getCompanyCompetitorRow();
+	ld->companyCompetitorBuffer.append(record);
+    } while((hasNext && ld->companyCompetitorBuffer.hasSpace()));
+    ld->companyCompetitorBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one DAILY_MARKET
@@ -861,15 +907,15 @@ w_rc_t ShoreTPCEEnv::_load_one_daily_market(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_daily_market()
+void ShoreTPCEEnv::_read_daily_market(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextDailyMarket();
-	PDAILY_MARKET_ROW record = pGenerateAndLoad->getDailyMarketRow();
-	dailyMarketBuffer.append(record);
-    } while((hasNext && dailyMarketBuffer.hasSpace()));
-    dailyMarketBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextDailyMarket();
+	PDAILY_MARKET_ROW record = ld->pGenerateAndLoad->getDailyMarketRow();
+	ld->dailyMarketBuffer.append(record);
+    } while((hasNext && ld->dailyMarketBuffer.hasSpace()));
+    ld->dailyMarketBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one FINANCIAL
@@ -897,15 +943,15 @@ w_rc_t ShoreTPCEEnv::_load_one_financial(rep_row_t& areprow, PFINANCIAL_ROW reco
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_financial()
+void ShoreTPCEEnv::_read_financial(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextFinancial();
-	PFINANCIAL_ROW record = pGenerateAndLoad->getFinancialRow();
-	financialBuffer.append(record);
-    } while((hasNext && financialBuffer.hasSpace()));
-    financialBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextFinancial();
+	PFINANCIAL_ROW record = ld->pGenerateAndLoad->getFinancialRow();
+	ld->financialBuffer.append(record);
+    } while((hasNext && ld->financialBuffer.hasSpace()));
+    ld->financialBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one LAST_TRADE
@@ -925,15 +971,15 @@ w_rc_t ShoreTPCEEnv::_load_one_last_trade(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_last_trade()
+void ShoreTPCEEnv::_read_last_trade(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextLastTrade();
-	PLAST_TRADE_ROW record = pGenerateAndLoad->getLastTradeRow();
-	lastTradeBuffer.append(record);
-    } while((hasNext && lastTradeBuffer.hasSpace()));
-    lastTradeBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextLastTrade();
+	PLAST_TRADE_ROW record = ld->pGenerateAndLoad->getLastTradeRow();
+	ld->lastTradeBuffer.append(record);
+    } while((hasNext && ld->lastTradeBuffer.hasSpace()));
+    ld->lastTradeBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one NEWS_ITEM
@@ -969,18 +1015,18 @@ w_rc_t ShoreTPCEEnv::_load_one_news_xref(rep_row_t& areprow, PNEWS_XREF_ROW reco
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_ni_and_nx()
+void ShoreTPCEEnv::_read_ni_and_nx(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextNewsItemAndNewsXRef();
-	PNEWS_ITEM_ROW record1 = pGenerateAndLoad->getNewsItemRow();
-	PNEWS_XREF_ROW record2 = pGenerateAndLoad->getNewsXRefRow();
-	newsItemBuffer.append(record1);
-	newsXRefBuffer.append(record2);
-    } while((hasNext && newsItemBuffer.hasSpace()));
-    newsItemBuffer.setMoreToRead(hasNext);
-    newsXRefBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextNewsItemAndNewsXRef();
+	PNEWS_ITEM_ROW record1 = ld->pGenerateAndLoad->getNewsItemRow();
+	PNEWS_XREF_ROW record2 = ld->pGenerateAndLoad->getNewsXRefRow();
+	ld->newsItemBuffer.append(record1);
+	ld->newsXRefBuffer.append(record2);
+    } while((hasNext && ld->newsItemBuffer.hasSpace()));
+    ld->newsItemBuffer.setMoreToRead(hasNext);
+    ld->newsXRefBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one SECURITY
@@ -1014,15 +1060,15 @@ w_rc_t ShoreTPCEEnv::_load_one_security(rep_row_t& areprow, PSECURITY_ROW record
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_security()
+void ShoreTPCEEnv::_read_security(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextSecurity();
-	PSECURITY_ROW record = pGenerateAndLoad->getSecurityRow();
-	securityBuffer.append(record);
-    } while((hasNext && securityBuffer.hasSpace()));
-    securityBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextSecurity();
+	PSECURITY_ROW record = ld->pGenerateAndLoad->getSecurityRow();
+	ld->securityBuffer.append(record);
+    } while((hasNext && ld->securityBuffer.hasSpace()));
+    ld->securityBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one TRADE
@@ -1114,33 +1160,33 @@ w_rc_t ShoreTPCEEnv::_load_one_holding_history(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_trade_unit()
+void ShoreTPCEEnv::_read_trade_unit(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextTrade();
-	PTRADE_ROW row = pGenerateAndLoad->getTradeRow();
-	tradeBuffer.append(row);
-	int hist = pGenerateAndLoad->getTradeHistoryRowCount();
+	hasNext= ld->pGenerateAndLoad->hasNextTrade();
+	PTRADE_ROW row = ld->pGenerateAndLoad->getTradeRow();
+	ld->tradeBuffer.append(row);
+	int hist = ld->pGenerateAndLoad->getTradeHistoryRowCount();
 	for(int i=0; i<hist; i++) {
-	    PTRADE_HISTORY_ROW record = pGenerateAndLoad->getTradeHistoryRow(i);
-	    tradeHistoryBuffer.append(record);
+	    PTRADE_HISTORY_ROW record = ld->pGenerateAndLoad->getTradeHistoryRow(i);
+	    ld->tradeHistoryBuffer.append(record);
 	}
-	if(pGenerateAndLoad->shouldProcessSettlementRow()) {
-	    PSETTLEMENT_ROW record = pGenerateAndLoad->getSettlementRow();
-	    settlementBuffer.append(record);
+	if(ld->pGenerateAndLoad->shouldProcessSettlementRow()) {
+	    PSETTLEMENT_ROW record = ld->pGenerateAndLoad->getSettlementRow();
+	    ld->settlementBuffer.append(record);
 	}
-	if(pGenerateAndLoad->shouldProcessCashTransactionRow()) {
-	    PCASH_TRANSACTION_ROW record=pGenerateAndLoad->getCashTransactionRow();
-	    cashTransactionBuffer.append(record);
+	if(ld->pGenerateAndLoad->shouldProcessCashTransactionRow()) {
+	    PCASH_TRANSACTION_ROW record=ld->pGenerateAndLoad->getCashTransactionRow();
+	    ld->cashTransactionBuffer.append(record);
 	}
-	hist = pGenerateAndLoad->getHoldingHistoryRowCount();
+	hist = ld->pGenerateAndLoad->getHoldingHistoryRowCount();
 	for(int i=0; i<hist; i++) {
-	    PHOLDING_HISTORY_ROW record=pGenerateAndLoad->getHoldingHistoryRow(i);
-	    holdingHistoryBuffer.append(record);
+	    PHOLDING_HISTORY_ROW record=ld->pGenerateAndLoad->getHoldingHistoryRow(i);
+	    ld->holdingHistoryBuffer.append(record);
 	}
-    } while((hasNext && tradeBuffer.hasSpace()));
-    tradeBuffer.setMoreToRead(hasNext);
+    } while((hasNext && ld->tradeBuffer.hasSpace()));
+    ld->tradeBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one BROKER
@@ -1159,15 +1205,15 @@ w_rc_t ShoreTPCEEnv::_load_one_broker(rep_row_t& areprow, PBROKER_ROW record)
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_broker()
+void ShoreTPCEEnv::_read_broker(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextBroker();
-	PBROKER_ROW record = pGenerateAndLoad->getBrokerRow();
-	brokerBuffer.append(record);
-    } while((hasNext && brokerBuffer.hasSpace()));
-    brokerBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextBroker();
+	PBROKER_ROW record = ld->pGenerateAndLoad->getBrokerRow();
+	ld->brokerBuffer.append(record);
+    } while((hasNext && ld->brokerBuffer.hasSpace()));
+    ld->brokerBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one HOLDING
@@ -1187,15 +1233,15 @@ w_rc_t ShoreTPCEEnv::_load_one_holding(rep_row_t& areprow, PHOLDING_ROW record)
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_holding()
+void ShoreTPCEEnv::_read_holding(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextHolding();
-	PHOLDING_ROW record = pGenerateAndLoad->getHoldingRow();
-	holdingBuffer.append(record);
-    } while((hasNext && holdingBuffer.hasSpace()));
-    holdingBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextHolding();
+	PHOLDING_ROW record = ld->pGenerateAndLoad->getHoldingRow();
+	ld->holdingBuffer.append(record);
+    } while((hasNext && ld->holdingBuffer.hasSpace()));
+    ld->holdingBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one HOLDING_SUMMARY
@@ -1217,15 +1263,15 @@ w_rc_t ShoreTPCEEnv::_load_one_holding_summary(rep_row_t& areprow,
     return RCOK;
 }
 
-void ShoreTPCEEnv::_read_holding_summary()
+void ShoreTPCEEnv::_read_holding_summary(EgenLoader* ld)
 {
     bool hasNext;
     do {
-	hasNext= pGenerateAndLoad->hasNextHoldingSummary();
-	PHOLDING_SUMMARY_ROW record = pGenerateAndLoad->getHoldingSummaryRow();
-	holdingSummaryBuffer.append(record);
-    } while((hasNext && holdingSummaryBuffer.hasSpace()));
-    holdingSummaryBuffer.setMoreToRead(hasNext);
+	hasNext= ld->pGenerateAndLoad->hasNextHoldingSummary();
+	PHOLDING_SUMMARY_ROW record = ld->pGenerateAndLoad->getHoldingSummaryRow();
+	ld->holdingSummaryBuffer.append(record);
+    } while((hasNext && ld->holdingSummaryBuffer.hasSpace()));
+    ld->holdingSummaryBuffer.setMoreToRead(hasNext);
 }
 
 // Populates one TRADE_REQUEST
@@ -1332,35 +1378,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_customer(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pcustomer_man->ts());
     areprow.set(_pcustomer_desc->maxsize());
 
-    int rows=customerBuffer.getSize();
+    int rows=ld->customerBuffer.getSize();
     for(int i=0; i<rows; i++) {
-	PCUSTOMER_ROW record = customerBuffer.get(i);
+	PCUSTOMER_ROW record = ld->customerBuffer.get(i);
 	W_DO(_load_one_customer(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_customer()
+void ShoreTPCEEnv::populate_customer(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitCustomer();
+    ld->pGenerateAndLoad->InitCustomer();
     TRACE( TRACE_ALWAYS, "Building CUSTOMER !!!\n");
-    while(customerBuffer.hasMoreToRead()){
+    while(ld->customerBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	customerBuffer.reset();
-	_read_customer();
-	populate_customer_input_t in;
+	ld->customerBuffer.reset();
+	_read_customer(ld);
+	populate_customer_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_customer(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCustomer();
-    customerBuffer.release();
+    ld->pGenerateAndLoad->ReleaseCustomer();
+    ld->customerBuffer.release();
 }
 
 //address
@@ -1369,35 +1417,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_address(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_paddress_man->ts());
     areprow.set(_paddress_desc->maxsize());
 
-    int rows=addressBuffer.getSize();
+    int rows=ld->addressBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PADDRESS_ROW record = addressBuffer.get(i);
+	PADDRESS_ROW record = ld->addressBuffer.get(i);
 	W_DO(_load_one_address(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_address()
+void ShoreTPCEEnv::populate_address(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitAddress();
+    ld->pGenerateAndLoad->InitAddress();
     TRACE( TRACE_ALWAYS, "Building ADDRESS !!!\n");
-    while(addressBuffer.hasMoreToRead()){
+    while(ld->addressBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	addressBuffer.reset();
-	_read_address();
-	populate_address_input_t in;
+	ld->addressBuffer.reset();
+	_read_address(ld);
+	populate_address_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_address(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseAddress();
-    addressBuffer.release();
+    ld->pGenerateAndLoad->ReleaseAddress();
+    ld->addressBuffer.release();
 }
 
 //CustomerAccount and AccountPermission
@@ -1406,42 +1456,44 @@ w_rc_t ShoreTPCEEnv::xct_populate_ca_and_ap(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pcustomer_account_man->ts());
     areprow.set(_pcustomer_account_desc->maxsize());
 
-    int rows=customerAccountBuffer.getSize();
+    int rows=ld->customerAccountBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCUSTOMER_ACCOUNT_ROW record = customerAccountBuffer.get(i);
+	PCUSTOMER_ACCOUNT_ROW record = ld->customerAccountBuffer.get(i);
 	W_DO(_load_one_customer_account(areprow, record));
     }
-    rows=accountPermissionBuffer.getSize();
+    rows=ld->accountPermissionBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PACCOUNT_PERMISSION_ROW record = accountPermissionBuffer.get(i);
+	PACCOUNT_PERMISSION_ROW record = ld->accountPermissionBuffer.get(i);
 	W_DO(_load_one_account_permission(areprow, record));
     }
     
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_ca_and_ap()
+void ShoreTPCEEnv::populate_ca_and_ap(EgenLoader* ld)
 {
-    pGenerateAndLoad->InitCustomerAccountAndAccountPermission();
+    ld->pGenerateAndLoad->InitCustomerAccountAndAccountPermission();
     TRACE( TRACE_ALWAYS, "Building CustomerAccount and AccountPermission !!!\n");
-    while(customerAccountBuffer.hasMoreToRead()){
+    while(ld->customerAccountBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	customerAccountBuffer.reset();
-	accountPermissionBuffer.reset();
-	_read_ca_and_ap();
-	populate_ca_and_ap_input_t in;
+	ld->customerAccountBuffer.reset();
+	ld->accountPermissionBuffer.reset();
+	_read_ca_and_ap(ld);
+	populate_ca_and_ap_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_ca_and_ap(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCustomerAccountAndAccountPermission();
-    customerAccountBuffer.release();
-    accountPermissionBuffer.release();
+    ld->pGenerateAndLoad->ReleaseCustomerAccountAndAccountPermission();
+    ld->customerAccountBuffer.release();
+    ld->accountPermissionBuffer.release();
 }
 
 //Watch List and Watch Item
@@ -1450,42 +1502,44 @@ w_rc_t ShoreTPCEEnv::xct_populate_wl_and_wi(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pwatch_item_man->ts());
     areprow.set(_pwatch_item_desc->maxsize());
 
-    int rows=watchListBuffer.getSize();
+    int rows=ld->watchListBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PWATCH_LIST_ROW record = watchListBuffer.get(i);
+	PWATCH_LIST_ROW record = ld->watchListBuffer.get(i);
 	W_DO(_load_one_watch_list(areprow, record));
     }
-    rows=watchItemBuffer.getSize();
+    rows=ld->watchItemBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PWATCH_ITEM_ROW record = watchItemBuffer.get(i);
+	PWATCH_ITEM_ROW record = ld->watchItemBuffer.get(i);
 	W_DO(_load_one_watch_item(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_wl_and_wi()
+void ShoreTPCEEnv::populate_wl_and_wi(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitWatchListAndWatchItem();
+    ld->pGenerateAndLoad->InitWatchListAndWatchItem();
     TRACE( TRACE_ALWAYS, "Building WATCH_LIST table and WATCH_ITEM !!!\n");
-    while(watchListBuffer.hasMoreToRead()){
+    while(ld->watchListBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	watchItemBuffer.reset();
-	watchListBuffer.reset();
-	_read_wl_and_wi();
-	populate_wl_and_wi_input_t in;
+	ld->watchItemBuffer.reset();
+	ld->watchListBuffer.reset();
+	_read_wl_and_wi(ld);
+	populate_wl_and_wi_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_wl_and_wi(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseWatchListAndWatchItem();
-    watchItemBuffer.release();
-    watchListBuffer.release();
+    ld->pGenerateAndLoad->ReleaseWatchListAndWatchItem();
+    ld->watchItemBuffer.release();
+    ld->watchListBuffer.release();
 }
 
 //CUSTOMER_TAXRATE
@@ -1494,35 +1548,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_customer_taxrate(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pcustomer_taxrate_man->ts());
     areprow.set(_pcustomer_taxrate_desc->maxsize());
 
-    int rows=customerTaxrateBuffer.getSize();
+    int rows=ld->customerTaxrateBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCUSTOMER_TAXRATE_ROW record = customerTaxrateBuffer.get(i);
+	PCUSTOMER_TAXRATE_ROW record = ld->customerTaxrateBuffer.get(i);
 	W_DO(_load_one_customer_taxrate(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_customer_taxrate()
+void ShoreTPCEEnv::populate_customer_taxrate(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitCustomerTaxrate();
+    ld->pGenerateAndLoad->InitCustomerTaxrate();
     TRACE( TRACE_ALWAYS, "Building CUSTOMER_TAXRATE !!!\n");
-    while(customerTaxrateBuffer.hasMoreToRead()){
+    while(ld->customerTaxrateBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	customerTaxrateBuffer.reset();
-	_read_customer_taxrate();
-	populate_customer_taxrate_input_t in;
+	ld->customerTaxrateBuffer.reset();
+	_read_customer_taxrate(ld);
+	populate_customer_taxrate_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_customer_taxrate(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCustomerTaxrate();
-    customerTaxrateBuffer.release();
+    ld->pGenerateAndLoad->ReleaseCustomerTaxrate();
+    ld->customerTaxrateBuffer.release();
 }
 
 //COMPANY
@@ -1531,35 +1587,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_company(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pcompany_man->ts());
     areprow.set(_pcompany_desc->maxsize());
 
-    int rows=companyBuffer.getSize();
+    int rows=ld->companyBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCOMPANY_ROW record = companyBuffer.get(i);
+	PCOMPANY_ROW record = ld->companyBuffer.get(i);
 	W_DO(_load_one_company(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_company()
+void ShoreTPCEEnv::populate_company(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitCompany();
+    ld->pGenerateAndLoad->InitCompany();
     TRACE( TRACE_ALWAYS, "Building COMPANY  !!!\n");
-    while(companyBuffer.hasMoreToRead()){
+    while(ld->companyBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	companyBuffer.reset();
-	_read_company();
-	populate_company_input_t in;
+	ld->companyBuffer.reset();
+	_read_company(ld);
+	populate_company_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_company(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCompany();
-    companyBuffer.release();
+    ld->pGenerateAndLoad->ReleaseCompany();
+    ld->companyBuffer.release();
 }
 
 //COMPANY COMPETITOR
@@ -1568,35 +1626,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_company_competitor(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pcompany_competitor_man->ts());
     areprow.set(_pcompany_competitor_desc->maxsize());
 
-    int rows=companyCompetitorBuffer.getSize();
+    int rows=ld->companyCompetitorBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCOMPANY_COMPETITOR_ROW record = companyCompetitorBuffer.get(i);
+	PCOMPANY_COMPETITOR_ROW record = ld->companyCompetitorBuffer.get(i);
 	W_DO(_load_one_company_competitor(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_company_competitor()
+void ShoreTPCEEnv::populate_company_competitor(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitCompanyCompetitor();
+    ld->pGenerateAndLoad->InitCompanyCompetitor();
     TRACE( TRACE_ALWAYS, "Building COMPANY COMPETITOR !!!\n");
-    while(companyCompetitorBuffer.hasMoreToRead()){
+    while(ld->companyCompetitorBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	companyCompetitorBuffer.reset();
-	_read_company_competitor();
-	populate_company_competitor_input_t in;
+	ld->companyCompetitorBuffer.reset();
+	_read_company_competitor(ld);
+	populate_company_competitor_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_company_competitor(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseCompanyCompetitor();
-    companyCompetitorBuffer.release();
+    ld->pGenerateAndLoad->ReleaseCompanyCompetitor();
+    ld->companyCompetitorBuffer.release();
 }
 
 //COMPANY
@@ -1605,35 +1665,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_daily_market(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pdaily_market_man->ts());
     areprow.set(_pdaily_market_desc->maxsize());
 
-    int rows=dailyMarketBuffer.getSize();
+    int rows=ld->dailyMarketBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PDAILY_MARKET_ROW record = dailyMarketBuffer.get(i);
+	PDAILY_MARKET_ROW record = ld->dailyMarketBuffer.get(i);
 	W_DO(_load_one_daily_market(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_daily_market()
+void ShoreTPCEEnv::populate_daily_market(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitDailyMarket();
+    ld->pGenerateAndLoad->InitDailyMarket();
     TRACE( TRACE_ALWAYS, "DAILY_MARKET   !!!\n");
-    while(dailyMarketBuffer.hasMoreToRead()){
+    while(ld->dailyMarketBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	dailyMarketBuffer.reset();
-	_read_daily_market();
-	populate_daily_market_input_t in;
+	ld->dailyMarketBuffer.reset();
+	_read_daily_market(ld);
+	populate_daily_market_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_daily_market(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseDailyMarket();
-    dailyMarketBuffer.release();
+    ld->pGenerateAndLoad->ReleaseDailyMarket();
+    ld->dailyMarketBuffer.release();
 }
 
 //FINANCIAL
@@ -1642,35 +1704,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_financial(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pfinancial_man->ts());
     areprow.set(_pfinancial_desc->maxsize());
 
-    int rows=financialBuffer.getSize();
+    int rows=ld->financialBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PFINANCIAL_ROW record = financialBuffer.get(i);
+	PFINANCIAL_ROW record = ld->financialBuffer.get(i);
 	W_DO(_load_one_financial(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_financial()
+void ShoreTPCEEnv::populate_financial(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitFinancial();
+    ld->pGenerateAndLoad->InitFinancial();
     TRACE( TRACE_ALWAYS, "Building FINANCIAL  !!!\n");
-    while(financialBuffer.hasMoreToRead()){
+    while(ld->financialBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	financialBuffer.reset();
-	_read_financial();
-	populate_financial_input_t in;
+	ld->financialBuffer.reset();
+	_read_financial(ld);
+	populate_financial_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_financial(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseFinancial();
-    financialBuffer.release();
+    ld->pGenerateAndLoad->ReleaseFinancial();
+    ld->financialBuffer.release();
 }
 
 //SECURITY
@@ -1679,35 +1743,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_security(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_psecurity_man->ts());
     areprow.set(_psecurity_desc->maxsize());
 
-    int rows=securityBuffer.getSize();
+    int rows=ld->securityBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PSECURITY_ROW record = securityBuffer.get(i);
+	PSECURITY_ROW record = ld->securityBuffer.get(i);
 	W_DO(_load_one_security(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_security()
+void ShoreTPCEEnv::populate_security(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitSecurity();
+    ld->pGenerateAndLoad->InitSecurity();
     TRACE( TRACE_ALWAYS, "Building SECURITY  !!!\n");
-    while(securityBuffer.hasMoreToRead()){
+    while(ld->securityBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	securityBuffer.reset();
-	_read_security();
-	populate_security_input_t in;
+	ld->securityBuffer.reset();
+	_read_security(ld);
+	populate_security_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());	
 	CHECK_XCT_RETURN(this->xct_populate_security(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseSecurity();
-    securityBuffer.release();
+    ld->pGenerateAndLoad->ReleaseSecurity();
+    ld->securityBuffer.release();
 }
 
 //LAST_TRADE
@@ -1716,35 +1782,37 @@ w_rc_t ShoreTPCEEnv::xct_populate_last_trade(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_plast_trade_man->ts());
     areprow.set(_plast_trade_desc->maxsize());
 
-    int rows=lastTradeBuffer.getSize();
+    int rows=ld->lastTradeBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PLAST_TRADE_ROW record = lastTradeBuffer.get(i);
+	PLAST_TRADE_ROW record = ld->lastTradeBuffer.get(i);
 	W_DO(_load_one_last_trade(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_last_trade()
+void ShoreTPCEEnv::populate_last_trade(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitLastTrade();
+    ld->pGenerateAndLoad->InitLastTrade();
     TRACE( TRACE_ALWAYS, "Building LAST_TRADE  !!!\n");
-    while(lastTradeBuffer.hasMoreToRead()){
+    while(ld->lastTradeBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	lastTradeBuffer.reset();
-	_read_last_trade();
-	populate_last_trade_input_t in;
+	ld->lastTradeBuffer.reset();
+	_read_last_trade(ld);
+	populate_last_trade_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_last_trade(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseLastTrade();
-    lastTradeBuffer.release();
+    ld->pGenerateAndLoad->ReleaseLastTrade();
+    ld->lastTradeBuffer.release();
 }
 
 //Watch List and Watch Item
@@ -1753,42 +1821,44 @@ w_rc_t ShoreTPCEEnv::xct_populate_ni_and_nx(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pnews_item_man->ts());
     areprow.set(_pnews_item_desc->maxsize());
 
-    int rows=newsXRefBuffer.getSize();
+    int rows=ld->newsXRefBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PNEWS_XREF_ROW record = newsXRefBuffer.get(i);
+	PNEWS_XREF_ROW record = ld->newsXRefBuffer.get(i);
 	W_DO(_load_one_news_xref(areprow, record));
     }
-    rows=newsItemBuffer.getSize();
+    rows=ld->newsItemBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PNEWS_ITEM_ROW record = newsItemBuffer.get(i);
+	PNEWS_ITEM_ROW record = ld->newsItemBuffer.get(i);
 	W_DO(_load_one_news_item(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_ni_and_nx()
+void ShoreTPCEEnv::populate_ni_and_nx(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitNewsItemAndNewsXRef();
+    ld->pGenerateAndLoad->InitNewsItemAndNewsXRef();
     TRACE( TRACE_ALWAYS, "Building NEWS_ITEM and NEWS_XREF !!!\n");
-    while(newsItemBuffer.hasMoreToRead()){
+    while(ld->newsItemBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	newsItemBuffer.reset();
-	newsXRefBuffer.reset();
-	_read_ni_and_nx();
-	populate_ni_and_nx_input_t in;
+	ld->newsItemBuffer.reset();
+	ld->newsXRefBuffer.reset();
+	_read_ni_and_nx(ld);
+	populate_ni_and_nx_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_ni_and_nx(1, in),
 			 log_space_needed, retry, this);
     }
-    pGenerateAndLoad->ReleaseNewsItemAndNewsXRef();
-    newsItemBuffer.release();
-    newsXRefBuffer.release();
+    ld->pGenerateAndLoad->ReleaseNewsItemAndNewsXRef();
+    ld->newsItemBuffer.release();
+    ld->newsXRefBuffer.release();
 }
 
 //populating growing tables
@@ -1797,33 +1867,35 @@ w_rc_t ShoreTPCEEnv::xct_populate_unit_trade(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pnews_item_man->ts());
     areprow.set(_pnews_item_desc->maxsize());
 
-    int rows=tradeBuffer.getSize();
+    int rows=ld->tradeBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PTRADE_ROW record = tradeBuffer.get(i);
+	PTRADE_ROW record = ld->tradeBuffer.get(i);
 	W_DO(_load_one_trade(areprow, record));
     }
-    rows=tradeHistoryBuffer.getSize();
+    rows=ld->tradeHistoryBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PTRADE_HISTORY_ROW record = tradeHistoryBuffer.get(i);
+	PTRADE_HISTORY_ROW record = ld->tradeHistoryBuffer.get(i);
 	W_DO(_load_one_trade_history(areprow, record));
     }
-    rows=settlementBuffer.getSize();
+    rows=ld->settlementBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PSETTLEMENT_ROW record = settlementBuffer.get(i);
+	PSETTLEMENT_ROW record = ld->settlementBuffer.get(i);
 	W_DO(_load_one_settlement(areprow, record));
     }
-    rows=cashTransactionBuffer.getSize();
+    rows=ld->cashTransactionBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PCASH_TRANSACTION_ROW record = cashTransactionBuffer.get(i);
+	PCASH_TRANSACTION_ROW record = ld->cashTransactionBuffer.get(i);
 	W_DO(_load_one_cash_transaction(areprow, record));
     }
-    rows=holdingHistoryBuffer.getSize();
+    rows=ld->holdingHistoryBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PHOLDING_HISTORY_ROW record = holdingHistoryBuffer.get(i);
+	PHOLDING_HISTORY_ROW record = ld->holdingHistoryBuffer.get(i);
 	W_DO(_load_one_holding_history(areprow, record));
     }
 
@@ -1836,26 +1908,28 @@ w_rc_t ShoreTPCEEnv::xct_populate_broker(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pbroker_man->ts());
     areprow.set(_pbroker_desc->maxsize());
 
-    int rows=brokerBuffer.getSize();
+    int rows=ld->brokerBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PBROKER_ROW record = brokerBuffer.get(i);
+	PBROKER_ROW record = ld->brokerBuffer.get(i);
 	W_DO(_load_one_broker(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_broker()
+void ShoreTPCEEnv::populate_broker(EgenLoader* ld)
 {	
-    while(brokerBuffer.hasMoreToRead()) {
+    while(ld->brokerBuffer.hasMoreToRead()) {
 	long log_space_needed = 0;
-	brokerBuffer.reset();
-	_read_broker();
-	populate_broker_input_t in;
+	ld->brokerBuffer.reset();
+	_read_broker(ld);
+	populate_broker_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_broker(1, in),
@@ -1869,26 +1943,28 @@ w_rc_t ShoreTPCEEnv::xct_populate_holding_summary(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pholding_summary_man->ts());
     areprow.set(_pholding_summary_desc->maxsize());
 
-    int rows=holdingSummaryBuffer.getSize();
+    int rows=ld->holdingSummaryBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PHOLDING_SUMMARY_ROW record = holdingSummaryBuffer.get(i);
+	PHOLDING_SUMMARY_ROW record = ld->holdingSummaryBuffer.get(i);
 	W_DO(_load_one_holding_summary(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_holding_summary()
+void ShoreTPCEEnv::populate_holding_summary(EgenLoader* ld)
 {	
-    while(holdingSummaryBuffer.hasMoreToRead()){
+    while(ld->holdingSummaryBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	holdingSummaryBuffer.reset();
-	_read_holding_summary();
-	populate_holding_summary_input_t in;
+	ld->holdingSummaryBuffer.reset();
+	_read_holding_summary(ld);
+	populate_holding_summary_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_holding_summary(1, in),
@@ -1902,26 +1978,28 @@ w_rc_t ShoreTPCEEnv::xct_populate_holding(const int xct_id,
 {
     assert (_pssm);
     assert (_initialized);
+    EgenLoader* ld = ptoin._loader;
+    assert (ld);
 
     rep_row_t areprow(_pholding_man->ts());
     areprow.set(_pholding_desc->maxsize());
 
-    int rows=holdingBuffer.getSize();
+    int rows=ld->holdingBuffer.getSize();
     for(int i=0; i<rows; i++){
-	PHOLDING_ROW record = holdingBuffer.get(i);
+	PHOLDING_ROW record = ld->holdingBuffer.get(i);
 	W_DO(_load_one_holding(areprow, record));
     }
 
     return (_pssm->commit_xct());
 }
 
-void ShoreTPCEEnv::populate_holding()
+void ShoreTPCEEnv::populate_holding(EgenLoader* ld)
 {	
-    while(holdingBuffer.hasMoreToRead()){
+    while(ld->holdingBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	holdingBuffer.reset();
-	_read_holding();
-	populate_holding_input_t in;
+	ld->holdingBuffer.reset();
+	_read_holding(ld);
+	populate_holding_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_holding(1, in),
@@ -1929,18 +2007,18 @@ void ShoreTPCEEnv::populate_holding()
     }
 }
 
-void ShoreTPCEEnv::populate_unit_trade()
+void ShoreTPCEEnv::populate_unit_trade(EgenLoader* ld)
 {
-     while(tradeBuffer.hasMoreToRead()){
+     while(ld->tradeBuffer.hasMoreToRead()){
 	long log_space_needed = 0;
-	tradeBuffer.reset();
-	tradeHistoryBuffer.reset();
-	settlementBuffer.reset();
-	cashTransactionBuffer.reset();
-	holdingHistoryBuffer.reset();
-	_read_trade_unit();
+	ld->tradeBuffer.reset();
+	ld->tradeHistoryBuffer.reset();
+	ld->settlementBuffer.reset();
+	ld->cashTransactionBuffer.reset();
+	ld->holdingHistoryBuffer.reset();
+	_read_trade_unit(ld);
 	printf("\n\n Populating trade unit\n\n" );
-	populate_unit_trade_input_t in;
+	populate_unit_trade_input_t in(ld);
     retry:
 	W_COERCE(this->db()->begin_xct());
 	CHECK_XCT_RETURN(this->xct_populate_unit_trade(1, in),
@@ -1948,35 +2026,35 @@ void ShoreTPCEEnv::populate_unit_trade()
     }
 }
 
-void ShoreTPCEEnv::populate_growing()
+void ShoreTPCEEnv::populate_growing(EgenLoader* ld)
 {	
-    pGenerateAndLoad->InitHoldingAndTrade();
+    ld->pGenerateAndLoad->InitHoldingAndTrade();
     TRACE( TRACE_ALWAYS, "Building growing tables  !!!\n");
     int cnt =0;
     do {
-	populate_unit_trade();
-	populate_broker();
-	populate_holding_summary();
-	populate_holding();
+	populate_unit_trade(ld);
+	populate_broker(ld);
+	populate_holding_summary(ld);
+	populate_holding(ld);
 	printf("\nload unit %d\n",++cnt);
-	tradeBuffer.newLoadUnit();
-	tradeHistoryBuffer.newLoadUnit();
-	settlementBuffer.newLoadUnit();
-	cashTransactionBuffer.newLoadUnit();
-	holdingHistoryBuffer.newLoadUnit();
-	brokerBuffer.newLoadUnit();
-	holdingSummaryBuffer.newLoadUnit();
-	holdingBuffer.newLoadUnit();	
-    } while(pGenerateAndLoad->hasNextLoadUnit());
-    pGenerateAndLoad->ReleaseHoldingAndTrade();
-    tradeBuffer.release();
-    tradeHistoryBuffer.release();
-    settlementBuffer.release();
-    cashTransactionBuffer.release();
-    holdingHistoryBuffer.release();
-    brokerBuffer.release();
-    holdingSummaryBuffer.release();
-    holdingBuffer.release();
+	ld->tradeBuffer.newLoadUnit();
+	ld->tradeHistoryBuffer.newLoadUnit();
+	ld->settlementBuffer.newLoadUnit();
+	ld->cashTransactionBuffer.newLoadUnit();
+	ld->holdingHistoryBuffer.newLoadUnit();
+	ld->brokerBuffer.newLoadUnit();
+	ld->holdingSummaryBuffer.newLoadUnit();
+	ld->holdingBuffer.newLoadUnit();	
+    } while(ld->pGenerateAndLoad->hasNextLoadUnit());
+    ld->pGenerateAndLoad->ReleaseHoldingAndTrade();
+    ld->tradeBuffer.release();
+    ld->tradeHistoryBuffer.release();
+    ld->settlementBuffer.release();
+    ld->cashTransactionBuffer.release();
+    ld->holdingHistoryBuffer.release();
+    ld->brokerBuffer.release();
+    ld->holdingSummaryBuffer.release();
+    ld->holdingBuffer.release();
 }
 
 w_rc_t ShoreTPCEEnv::xct_find_maxtrade_id(const int xct_id,
@@ -30,6 +30,7 @@
  */
 
 #include "workload/tpch/shore_tpch_env.h"
+#include "sm/shore/shore_column_scan.h"
 #include "qpipe.h"
 
 using namespace shore;
@@ -82,13 +83,16 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
+	int _last_l_shipdate;
 
 	/* Random Predicates */
 	/* TPC-H Specification 2.3.0 */
 	/* DELTA random within [60 .. 120] */
 	/*Random predicates computed in src/workload/tpch/tpch_input.cpp*/
 	q1_input_t* q1_input;
+
+	/* Offsets of the fields in the lineitem records, for the batches */
+	offset_t _off[7];
 public:
 
 	q1_tscan_filter_t(ShoreTPCHEnv* tpchdb, q1_input_t &in)
@@ -106,6 +110,11 @@ public:
 	   L_SHIPDATE <= 1998-12-01 - DELTA DAYS
 		 */
 		q1_input=&in;
+		_last_l_shipdate = timet_to_daynum(q1_input->l_shipdate);
+
+		// L_QUANTITY .. L_SHIPDATE (fields 4 to 10)
+		for (int i=0; i<7; i++)
+			_off[i] = fixed_field_offset(_tpchdb->lineitem_desc(), 4+i);
 
 		char date[15];
 		timet_to_str(date,q1_input->l_shipdate);
@@ -128,16 +137,15 @@ public:
 		}
 
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
 
 		// Return true if it passes the filter
-		if  ( _shipdate <= q1_input->l_shipdate ) {
-			//TRACE(TRACE_RECORD_FLOW, "+ %s\n", _lineitem.L_SHIPDATE);
+		if  ( _lineitem.L_SHIPDATE <= _last_l_shipdate ) {
+			//TRACE(TRACE_RECORD_FLOW, "+ %d\n", _lineitem.L_SHIPDATE);
 			return (true);
 		}
 		else {
-			//TRACE(TRACE_RECORD_FLOW, ". %s\n", _lineitem.L_SHIPDATE);
+			//TRACE(TRACE_RECORD_FLOW, ". %d\n", _lineitem.L_SHIPDATE);
 			return (false);
 		}
 	}
@@ -173,6 +181,42 @@ public:
 
 	}
 
+	// The batches read the fields straight from the lineitem records
+	bool batched() const {
+		return (true);
+	}
+
+	// The predicate of the batches, on the lineitem records
+	struct batch_pred_t {
+		offset_t _shipdate_off;
+		int _last_l_shipdate;
+		bool operator()(const char* rec) const {
+			return (fixed_field<int>(rec, _shipdate_off) <= _last_l_shipdate);
+		}
+	};
+
+	// Batch predication, without loading the records
+	void select_batch(page &p, selection_t &sel) {
+		batch_pred_t pred = { _off[6], _last_l_shipdate };
+		select_batch_if(p, sel, pred);
+	}
+
+	// Batch projection of the survivors
+	void project_batch(tuple_fifo* out, page &p, const selection_t &sel) {
+		for (size_t i=0; i<sel.size(); i++) {
+			const char* rec = p.get_tuple(sel[i]).data;
+			tuple_t d = out->allocate();
+			q1_projected_lineitem_tuple *dest;
+			dest = aligned_cast<q1_projected_lineitem_tuple>(d.data);
+			dest->L_QUANTITY = fixed_field<double>(rec, _off[0]);
+			dest->L_EXTENDEDPRICE = fixed_field<double>(rec, _off[1]) / 100.0;
+			dest->L_DISCOUNT = fixed_field<double>(rec, _off[2]) / 100.0;
+			dest->L_TAX = fixed_field<double>(rec, _off[3]) / 100.0;
+			dest->L_RETURNFLAG = fixed_field<char>(rec, _off[4]);
+			dest->L_LINESTATUS = fixed_field<char>(rec, _off[5]);
+		}
+	}
+
 	q1_tscan_filter_t* clone() const {
 		return new q1_tscan_filter_t(*this);
 	}
@@ -204,10 +204,11 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
 
 	time_t _first_orderdate;
 	time_t _last_orderdate;
+	int _first_day;
+	int _last_day;
 
 public:
 	q10_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q10_input_t &in)
@@ -222,6 +223,8 @@ public:
 		struct tm *tm = gmtime(&_first_orderdate);
 		tm->tm_mon += 3;
 		_last_orderdate = mktime(tm);
+		_first_day = timet_to_daynum(_first_orderdate);
+		_last_day = timet_to_daynum(_last_orderdate);
 
 		char f_orderdate[STRSIZE(10)];
 		char l_orderdate[STRSIZE(10)];
@@ -243,10 +246,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		return _orderdate >= _first_orderdate && _orderdate < _last_orderdate;
+		return _orders.O_ORDERDATE >= _first_day && _orders.O_ORDERDATE < _last_day;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -681,7 +683,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q10(const int xct_id,
 	//LINEITEM JOIN ORDERS
 	tuple_fifo* q10_l_join_o_buffer = new tuple_fifo(sizeof(q10_l_join_o_tuple));
 	packet_t* q10_l_join_o_packet =
-			new hash_join_packet_t("lineitem - orders HJOIN",
+			create_hash_join_packet("lineitem - orders HJOIN",
 					q10_l_join_o_buffer,
 					new trivial_filter_t(sizeof(q10_l_join_o_tuple)),
 					q10_lineitem_tscan_packet,
@@ -691,7 +693,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q10(const int xct_id,
 	//CUSTOMER JOIN LINEITEM_ORDERS
 	tuple_fifo* q10_c_join_l_o_buffer = new tuple_fifo(sizeof(q10_c_join_l_o_tuple));
 	packet_t* q10_c_join_l_o_packet =
-			new hash_join_packet_t("customer - lineitem_orders HJOIN",
+			create_hash_join_packet("customer - lineitem_orders HJOIN",
 					q10_c_join_l_o_buffer,
 					new trivial_filter_t(sizeof(q10_c_join_l_o_tuple)),
 					q10_customer_tscan_packet,
@@ -701,7 +703,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q10(const int xct_id,
 	//NATION JOIN CUSTOMER_LINEITEM_ORDERS
 	tuple_fifo* q10_all_joins_buffer = new tuple_fifo(sizeof(q10_final_tuple));
 	packet_t* q10_all_joins_packet =
-			new hash_join_packet_t("nation - customer_lineitem_orders HJOIN",
+			create_hash_join_packet("nation - customer_lineitem_orders HJOIN",
 					q10_all_joins_buffer,
 					new trivial_filter_t(sizeof(q10_final_tuple)),
 					q10_nation_tscan_packet,
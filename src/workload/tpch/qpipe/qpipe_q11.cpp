@@ -601,7 +601,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q11(const int xct_id,
     //SUPPLIER JOIN NATION
     tuple_fifo* q11_s_join_n_buffer = new tuple_fifo(sizeof(q11_s_join_n_tuple));
     packet_t* q11_s_join_n_packet =
-    		new hash_join_packet_t("supplier - nation HJOIN",
+    		create_hash_join_packet("supplier - nation HJOIN",
     				q11_s_join_n_buffer,
     				new trivial_filter_t(sizeof(q11_s_join_n_tuple)),
     				q11_supplier_tscan_packet,
@@ -611,7 +611,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q11(const int xct_id,
     //PARTSUPP JOIN SUPPLIER_NATION
     tuple_fifo* q11_ps_join_s_n_buffer = new tuple_fifo(sizeof(q11_ps_join_s_n_tuple));
     packet_t* q11_ps_join_s_n_packet =
-    		new hash_join_packet_t("partsupp - supplier_nation HJOIN",
+    		create_hash_join_packet("partsupp - supplier_nation HJOIN",
     				q11_ps_join_s_n_buffer,
     				new trivial_filter_t(sizeof(q11_ps_join_s_n_tuple)),
     				q11_partsupp_tscan_packet,
@@ -635,7 +635,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q11(const int xct_id,
     //SUPPLIER JOIN NATION
     tuple_fifo* q11_s_join_n_sub_buffer = new tuple_fifo(sizeof(q11_s_join_n_tuple));
     packet_t* q11_s_join_n_sub_packet =
-    		new hash_join_packet_t("supplier - nation HJOIN subquery",
+    		create_hash_join_packet("supplier - nation HJOIN subquery",
     				q11_s_join_n_sub_buffer,
     				new trivial_filter_t(sizeof(q11_s_join_n_tuple)),
     				q11_supplier_sub_tscan_packet,
@@ -645,7 +645,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q11(const int xct_id,
     //PARTSUPP JOIN SUPPLIER_NATION
     tuple_fifo* q11_ps_join_s_n_sub_buffer = new tuple_fifo(sizeof(q11_ps_join_s_n_tuple));
     packet_t* q11_ps_join_s_n_sub_packet =
-    		new hash_join_packet_t("partsupp - supplier_nation HJOIN subquery",
+    		create_hash_join_packet("partsupp - supplier_nation HJOIN subquery",
     				q11_ps_join_s_n_sub_buffer,
     				new trivial_filter_t(sizeof(q11_ps_join_s_n_tuple)),
     				q11_partsupp_sub_tscan_packet,
@@ -668,7 +668,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q11(const int xct_id,
     //SUBQUERY JOIN MAINQUERY
     tuple_fifo* q11_all_joins_buffer = new tuple_fifo(sizeof(q11_final_tuple));
     packet_t* q11_all_joins_packet =
-    		new hash_join_packet_t("partsupp_supplier_nation sub - partsupp_supplier_nation main HJOIN",
+    		create_hash_join_packet("partsupp_supplier_nation sub - partsupp_supplier_nation main HJOIN",
     				q11_all_joins_buffer,
     				new q11_threshold_filter_t((&in)->fraction),
     				q11_agg_sub_packet,
@@ -114,9 +114,6 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _commitdate;
-	time_t _receiptdate;
-	time_t _shipdate;
 	int _shipmode;
 
 	/* Random Predicates */
@@ -127,6 +124,8 @@ private:
 	 */
 	q12_input_t* q12_input;
 	time_t _last_l_receiptdate;
+	int _first_day;
+	int _last_day;
 public:
 
 	q12_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q12_input_t &in)
@@ -147,6 +146,8 @@ public:
 		gmtime_r(&(q12_input->l_receiptdate), &date);
 		date.tm_year ++;
 		_last_l_receiptdate=mktime(&date);
+		_first_day = timet_to_daynum(q12_input->l_receiptdate);
+		_last_day = timet_to_daynum(_last_l_receiptdate);
 
 		char shipmode1[11];
 		char shipmode2[11];
@@ -176,19 +177,16 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
-		_prline->get_value(11, _lineitem.L_COMMITDATE, 15);
-		_commitdate = str_to_timet(_lineitem.L_COMMITDATE);
-		_prline->get_value(12, _lineitem.L_RECEIPTDATE, 15);
-		_receiptdate = str_to_timet(_lineitem.L_RECEIPTDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
+		_prline->get_value(11, _lineitem.L_COMMITDATE);
+		_prline->get_value(12, _lineitem.L_RECEIPTDATE);
 		_prline->get_value(14, _lineitem.L_SHIPMODE, 15);
 		_shipmode=str_to_shipmode(_lineitem.L_SHIPMODE);
 
 		//TODO implement it with _and_predicate
 
 		// Return true if it passes the filter
-		if  ( (_shipmode==q12_input->l_shipmode1 || _shipmode==q12_input->l_shipmode2) && _commitdate<_receiptdate && _shipdate<_commitdate && _receiptdate >= q12_input->l_receiptdate && _receiptdate < _last_l_receiptdate ) {
+		if  ( (_shipmode==q12_input->l_shipmode1 || _shipmode==q12_input->l_shipmode2) && _lineitem.L_COMMITDATE<_lineitem.L_RECEIPTDATE && _lineitem.L_SHIPDATE<_lineitem.L_COMMITDATE && _lineitem.L_RECEIPTDATE >= _first_day && _lineitem.L_RECEIPTDATE < _last_day ) {
 			//TRACE(TRACE_RECORD_FLOW, "+ %d %s\n", _lineitem.L_ORDERKEY, _lineitem.L_SHIPMODE);
 			return (true);
 		}
@@ -515,7 +513,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q12(const int xct_id,
 	//JOIN
 	tuple_fifo* q12_join_buffer = new tuple_fifo(sizeof(q12_join_tuple));
 	packet_t* q12_join_packet =
-			new hash_join_packet_t("orders-lineitem HJOIN",
+			create_hash_join_packet("orders-lineitem HJOIN",
 					q12_join_buffer,
 					new trivial_filter_t(sizeof(q12_join_tuple)),
 					q12_orders_tscan_packet,
@@ -429,7 +429,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q13(const int xct_id,
 
     //Join
     tuple_fifo* q13_join_buffer = new tuple_fifo(sizeof(q13_join_tuple));
-    packet_t* q13_join_packet = new hash_join_packet_t("Orders - Customer JOIN",
+    packet_t* q13_join_packet = create_hash_join_packet("Orders - Customer JOIN",
                                                    q13_join_buffer,
                                                    new trivial_filter_t(sizeof(q13_join_tuple)),
                                                    q13_customer_tscan_packet,
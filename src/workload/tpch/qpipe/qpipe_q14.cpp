@@ -98,8 +98,9 @@ private:
 
     /*One lineitem tuple*/
     tpch_lineitem_tuple _lineitem;
-    /*The columns needed for the selection*/
-    time_t _shipdate;
+    /*The bounds of the selection, as day numbers*/
+    int _first_day;
+    int _last_day;
 
   //and_predicate_t _filter;
 
@@ -125,6 +126,8 @@ public:
         date1 = q14_input->l_shipdate;
 	// L_SHIPDATE < [date] + 1 month
         date2 = time_add_month(date1, 1);
+        _first_day = timet_to_daynum(date1);
+        _last_day = timet_to_daynum(date2);
 
         char shdate1[15];
         char shdate2[15];
@@ -174,10 +177,9 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-	_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-	_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+	_prline->get_value(10, _lineitem.L_SHIPDATE);
 
-	if (_shipdate>=date1 && _shipdate<date2)
+	if (_lineitem.L_SHIPDATE>=_first_day && _lineitem.L_SHIPDATE<_last_day)
 	  {
 	    return (true);
 	  }
@@ -409,7 +411,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q14(const int xct_id,
 
     //join
     tuple_fifo* q14_join_buffer = new tuple_fifo(sizeof(q14_join_tuple));
-    packet_t* q14_join_packet = new hash_join_packet_t("part-lineitem HJOIN",
+    packet_t* q14_join_packet = create_hash_join_packet("part-lineitem HJOIN",
                                          q14_join_buffer, 
 					 new trivial_filter_t(sizeof(q14_join_tuple)),
                                          q14_tscan_part_packet,
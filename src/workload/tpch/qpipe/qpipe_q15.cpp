@@ -113,10 +113,11 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
 
 	time_t _firstdate;
 	time_t _lastdate;
+	int _first_day;
+	int _last_day;
 
 public:
 	q15_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q15_input_t &in)
@@ -131,6 +132,8 @@ public:
 		struct tm *tm = gmtime(&_firstdate);
 		tm->tm_mon += 3;
 		_lastdate = mktime(tm);
+		_first_day = timet_to_daynum(_firstdate);
+		_last_day = timet_to_daynum(_lastdate);
 
 		char f_shipdate[STRSIZE(10)];
 		char l_shipdate[STRSIZE(10)];
@@ -152,10 +155,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, sizeof(_lineitem.L_SHIPDATE));
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
 
-		return _shipdate >= _firstdate && _shipdate < _lastdate;
+		return _lineitem.L_SHIPDATE >= _first_day && _lineitem.L_SHIPDATE < _last_day;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -453,7 +455,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q15(const int xct_id,
 	//LINEITEM JOIN SUPPLIER
 	tuple_fifo* q15_l_join_s_buffer = new tuple_fifo(sizeof(q15_final_tuple));
 	packet_t* q15_l_join_s_packet =
-			new hash_join_packet_t("lineitem - supplier HJOIN",
+			create_hash_join_packet("lineitem - supplier HJOIN",
 					q15_l_join_s_buffer,
 					new trivial_filter_t(sizeof(q15_final_tuple)),
 					q15_l_sort_packet,
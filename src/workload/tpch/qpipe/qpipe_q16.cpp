@@ -680,7 +680,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q16(const int xct_id,
 	//PARTSUPP JOIN PART
 	tuple_fifo* q16_ps_join_p_buffer = new tuple_fifo(sizeof(q16_ps_join_p_tuple));
 	packet_t* q16_ps_join_p_packet =
-			new hash_join_packet_t("partsupp - part HJOIN",
+			create_hash_join_packet("partsupp - part HJOIN",
 					q16_ps_join_p_buffer,
 					new trivial_filter_t(sizeof(q16_ps_join_p_tuple)),
 					q16_partsupp_tscan_packet,
@@ -690,7 +690,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q16(const int xct_id,
 	//PARTSUPP_PART JOIN SUPPLIER
 	tuple_fifo* q16_ps_p_join_s_buffer = new tuple_fifo(sizeof(q16_all_joins_tuple));
 	packet_t* q16_ps_p_join_s_packet =
-			new hash_join_packet_t("partsupp_part - supplier HJOIN",
+			create_hash_join_packet("partsupp_part - supplier HJOIN",
 					q16_ps_p_join_s_buffer,
 					new trivial_filter_t(sizeof(q16_all_joins_tuple)),
 					q16_ps_join_p_packet,
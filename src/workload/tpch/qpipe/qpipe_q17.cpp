@@ -532,7 +532,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q17(const int xct_id,
     //LINEITEM JOIN PART
     tuple_fifo* q17_l_join_p_buffer = new tuple_fifo(sizeof(q17_l_join_p_tuple));
     packet_t* q17_l_join_p_packet =
-    		new hash_join_packet_t("lineitem - part HJOIN",
+    		create_hash_join_packet("lineitem - part HJOIN",
     				q17_l_join_p_buffer,
     				new trivial_filter_t(sizeof(q17_l_join_p_tuple)),
     				q17_lineitem_tscan_packet,
@@ -542,7 +542,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q17(const int xct_id,
     //LINEITEM sub JOIN LINEITEM_PART
     tuple_fifo* q17_all_join_buffer = new tuple_fifo(sizeof(q17_all_join_tuple));
     packet_t* q17_all_join_packet =
-    		new hash_join_packet_t("lineitem sub - lineitem_part HJOIN",
+    		create_hash_join_packet("lineitem sub - lineitem_part HJOIN",
     				q17_all_join_buffer,
     				new q17_join_filter_t(),
     				q17_sub_aggregate_packet,
@@ -91,7 +91,7 @@ struct q18_projected_lineitem_tuple {
 struct q18_projected_orders_tuple {
 	int O_ORDERKEY;
 	int O_CUSTKEY;
-	char O_ORDERDATE[STRSIZE(10)];
+	int O_ORDERDATE; // day number
 	decimal O_TOTALPRICE;
 };
 
@@ -104,13 +104,13 @@ struct q18_projected_customer_tuple {
 struct q18_l_join_o_tuple {
 	int O_ORDERKEY;
 	int O_CUSTKEY;
-	char O_ORDERDATE[STRSIZE(10)];
+	int O_ORDERDATE; // day number
 	decimal O_TOTALPRICE;
 	decimal L_QUANTITY;
 };
 
 struct q18_final_tuple {
-	char O_ORDERDATE[STRSIZE(10)];
+	int O_ORDERDATE; // day number
 	decimal O_TOTALPRICE;
 	char C_NAME[STRSIZE(25)];
 	int C_CUSTKEY;
@@ -119,7 +119,7 @@ struct q18_final_tuple {
 };
 
 struct q18_sort_key {
-	char O_ORDERDATE[STRSIZE(10)];
+	int O_ORDERDATE; // day number
 	decimal O_TOTALPRICE;
 };
 
@@ -221,14 +221,14 @@ public:
 		_prorders->get_value(0, _orders.O_ORDERKEY);
 		_prorders->get_value(1, _orders.O_CUSTKEY);
 		_prorders->get_value(3, _orders.O_TOTALPRICE);
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%.2f|%s\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, _orders.O_TOTALPRICE.to_double(), _orders.O_ORDERDATE);
+		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%.2f|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, _orders.O_TOTALPRICE.to_double(), _orders.O_ORDERDATE);
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
 		dest->O_CUSTKEY = _orders.O_CUSTKEY;
 		dest->O_TOTALPRICE = _orders.O_TOTALPRICE;
-		memcpy(dest->O_ORDERDATE, _orders.O_ORDERDATE, sizeof(dest->O_ORDERDATE));
+		dest->O_ORDERDATE = _orders.O_ORDERDATE;
 	}
 
 	q18_orders_tscan_filter_t* clone() const {
@@ -315,12 +315,12 @@ struct q18_l_join_o_t : public tuple_join_t {
 		q18_projected_orders_tuple *order = aligned_cast<q18_projected_orders_tuple>(r.data);
 
 		dest->L_QUANTITY = line->L_QUANTITY;
-		memcpy(dest->O_ORDERDATE, order->O_ORDERDATE, sizeof(dest->O_ORDERDATE));
+		dest->O_ORDERDATE = order->O_ORDERDATE;
 		dest->O_ORDERKEY = order->O_ORDERKEY;
 		dest->O_TOTALPRICE = order->O_TOTALPRICE;
 		dest->O_CUSTKEY = order->O_CUSTKEY;
 
-		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %.2f %s %d %.2f %d\n", line->L_ORDERKEY, order->O_ORDERKEY, line->L_QUANTITY.to_double(), order->O_ORDERDATE, order->O_ORDERKEY,
+		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %.2f %d %d %.2f %d\n", line->L_ORDERKEY, order->O_ORDERKEY, line->L_QUANTITY.to_double(), order->O_ORDERDATE, order->O_ORDERKEY,
 		//															order->O_TOTALPRICE.to_double(), order->O_CUSTKEY);
 	}
 
@@ -353,11 +353,11 @@ struct q18_l_o_join_c_t : public tuple_join_t {
 		dest->C_CUSTKEY = cust->C_CUSTKEY;
 		memcpy(dest->C_NAME, cust->C_NAME, sizeof(dest->C_NAME));
 		dest->L_QUANTITY = left->L_QUANTITY;
-		memcpy(dest->O_ORDERDATE, left->O_ORDERDATE, sizeof(dest->O_ORDERDATE));
+		dest->O_ORDERDATE = left->O_ORDERDATE;
 		dest->O_ORDERKEY = left->O_ORDERKEY;
 		dest->O_TOTALPRICE = left->O_TOTALPRICE;
 
-		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %d %s %.2f %s %d %.2f\n", left->O_CUSTKEY, cust->C_CUSTKEY, cust->C_CUSTKEY, cust->C_NAME, left->L_QUANTITY.to_double(),
+		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %d %s %.2f %d %d %.2f\n", left->O_CUSTKEY, cust->C_CUSTKEY, cust->C_CUSTKEY, cust->C_NAME, left->L_QUANTITY.to_double(),
 		//																	left->O_ORDERDATE, left->O_ORDERKEY, left->O_TOTALPRICE.to_double());
 	}
 
@@ -509,10 +509,7 @@ struct q18_sort_key_compare_t : public key_compare_t {
 		q18_sort_key *k1 = aligned_cast<q18_sort_key>(key1);
 		q18_sort_key *k2 = aligned_cast<q18_sort_key>(key2);
 
-		time_t d1 = str_to_timet(k1->O_ORDERDATE);
-		time_t d2 = str_to_timet(k2->O_ORDERDATE);
-
-		return (k1->O_TOTALPRICE > k2->O_TOTALPRICE ? -1 : (k1->O_TOTALPRICE < k2->O_TOTALPRICE ? 1 : d1 - d2));
+		return (k1->O_TOTALPRICE > k2->O_TOTALPRICE ? -1 : (k1->O_TOTALPRICE < k2->O_TOTALPRICE ? 1 : k1->O_ORDERDATE - k2->O_ORDERDATE));
 	}
 
 	virtual q18_sort_key_compare_t* clone() const {
@@ -535,7 +532,9 @@ public:
 	virtual void process(const tuple_t& output) {
 		q18_final_tuple *agg = aligned_cast<q18_final_tuple>(output.data);
 
-		TRACE(TRACE_QUERY_RESULTS, "*** Q18 %s %d %d %s %.4f %.4f\n", agg->C_NAME, agg->C_CUSTKEY, agg->O_ORDERKEY, agg->O_ORDERDATE, agg->O_TOTALPRICE.to_double(),
+		char date[STRSIZE(10)];
+		daynum_to_str(date, agg->O_ORDERDATE);
+		TRACE(TRACE_QUERY_RESULTS, "*** Q18 %s %d %d %s %.4f %.4f\n", agg->C_NAME, agg->C_CUSTKEY, agg->O_ORDERKEY, date, agg->O_TOTALPRICE.to_double(),
 				agg->L_QUANTITY.to_double());
 	}
 
@@ -601,7 +600,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q18(const int xct_id,
 	//LINEITEM JOIN ORDERS
 	tuple_fifo* q18_l_join_o_buffer = new tuple_fifo(sizeof(q18_l_join_o_tuple));
 	packet_t* q18_l_join_o_packet =
-			new hash_join_packet_t("lineitem - orders HJOIN",
+			create_hash_join_packet("lineitem - orders HJOIN",
 					q18_l_join_o_buffer,
 					new trivial_filter_t(sizeof(q18_l_join_o_tuple)),
 					q18_line_agg_packet,
@@ -611,7 +610,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q18(const int xct_id,
 	//LINEITEM_ORDERS JOIN CUSTOMER
 	tuple_fifo* q18_l_o_join_c_buffer = new tuple_fifo(sizeof(q18_final_tuple));
 	packet_t* q18_l_o_join_c_packet =
-			new hash_join_packet_t("lineitem_orders - customer HJOIN",
+			create_hash_join_packet("lineitem_orders - customer HJOIN",
 					q18_l_o_join_c_buffer,
 					new trivial_filter_t(sizeof(q18_final_tuple)),
 					q18_l_join_o_packet,
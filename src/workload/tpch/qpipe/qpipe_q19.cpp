@@ -430,7 +430,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q19(const int xct_id,
 	//LINEITEM JOIN PART
 	tuple_fifo* q19_l_join_p_buffer = new tuple_fifo(sizeof(q19_final_tuple));
 	packet_t* q19_l_join_p_packet =
-			new hash_join_packet_t("lineitem - part HJOIN",
+			create_hash_join_packet("lineitem - part HJOIN",
 					q19_l_join_p_buffer,
 					new q19_join_filter_t((&in)->l_quantity),
 					q19_lineitem_tscan_packet,
@@ -1169,7 +1169,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//PARTSUPP JOIN PART
 	tuple_fifo* q2_ps_join_p_buffer = new tuple_fifo(sizeof(q2_ps_join_p_tuple));
 	packet_t* q2_ps_join_p_packet =
-			new hash_join_packet_t("partsupp-part HJOIN",
+			create_hash_join_packet("partsupp-part HJOIN",
 					q2_ps_join_p_buffer,
 					new trivial_filter_t(sizeof(q2_ps_join_p_tuple)),
 					q2_partsupp_tscan_packet,
@@ -1189,7 +1189,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//SUPPLIER JOIN PARTSUPP_PART
 	tuple_fifo* q2_s_join_ps_p_buffer = new tuple_fifo(sizeof(q2_s_join_ps_p_tuple));
 	packet_t* q2_s_join_ps_p_paket =
-			new hash_join_packet_t("supplier - partsupp_part HJOIN",
+			create_hash_join_packet("supplier - partsupp_part HJOIN",
 					q2_s_join_ps_p_buffer,
 					new trivial_filter_t(sizeof(q2_s_join_ps_p_tuple)),
 					q2_supplier_tscan_packet,
@@ -1209,7 +1209,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//SUPPLIER_PARTSUPP_PART JOIN NATION
 	tuple_fifo* q2_s_ps_p_join_n_buffer = new tuple_fifo(sizeof(q2_s_ps_p_join_n_tuple));
 	packet_t* q2_s_ps_p_join_n_packet =
-			new hash_join_packet_t("supplier_partsupp_part - nation HJOIN",
+			create_hash_join_packet("supplier_partsupp_part - nation HJOIN",
 					q2_s_ps_p_join_n_buffer,
 					new trivial_filter_t(sizeof(q2_s_ps_p_join_n_tuple)),
 					q2_s_join_ps_p_paket,
@@ -1229,7 +1229,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//SUPPLIER_PARTSUPP_PART_NATION JOIN REGION
 	tuple_fifo* q2_s_ps_p_n_join_r_buffer = new tuple_fifo(sizeof(q2_s_ps_p_n_join_r_tuple));
 	packet_t* q2_s_ps_p_n_join_r_packet =
-			new hash_join_packet_t("supplier_partsupp_part_nation - region HJOIN",
+			create_hash_join_packet("supplier_partsupp_part_nation - region HJOIN",
 					q2_s_ps_p_n_join_r_buffer,
 					new trivial_filter_t(sizeof(q2_s_ps_p_n_join_r_tuple)),
 					q2_s_ps_p_join_n_packet,
@@ -1271,7 +1271,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//NATION JOIN REGION
 	tuple_fifo* q2_n_join_r_subquery_buffer = new tuple_fifo(sizeof(q2_n_join_r_subquery_tuple));
 	packet_t* q2_n_join_r_subquery_packet =
-			new hash_join_packet_t("nation - region HJOIN subquery",
+			create_hash_join_packet("nation - region HJOIN subquery",
 					q2_n_join_r_subquery_buffer,
 					new trivial_filter_t(sizeof(q2_n_join_r_subquery_tuple)),
 					q2_nation_tscan_subquery_packet,
@@ -1291,7 +1291,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//SUPPLIER JOIN NATION_REGION
 	tuple_fifo* q2_s_join_n_r_subquery_buffer = new tuple_fifo(sizeof(q2_s_join_n_r_subquery_tuple));
 	packet_t* q2_s_join_n_r_subquery_packet =
-			new hash_join_packet_t("supplier - nation_region HJOIN subquery",
+			create_hash_join_packet("supplier - nation_region HJOIN subquery",
 					q2_s_join_n_r_subquery_buffer,
 					new trivial_filter_t(sizeof(q2_s_join_n_r_subquery_tuple)),
 					q2_supplier_tscan_subquery_packet,
@@ -1311,7 +1311,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//PARTSUPP JOIN SUPPLIER_NATION_REGION
 	tuple_fifo* q2_ps_join_s_n_r_subquery_buffer = new tuple_fifo(sizeof(q2_subquery_aggregate_tuple));
 	packet_t* q2_ps_join_s_n_r_subquery_packet =
-			new hash_join_packet_t("partsupp - supplier_nation_region HJOIN subquery",
+			create_hash_join_packet("partsupp - supplier_nation_region HJOIN subquery",
 					q2_ps_join_s_n_r_subquery_buffer,
 					new trivial_filter_t(sizeof(q2_subquery_aggregate_tuple)),
 					q2_partsupp_tscan_subquery_packet,
@@ -1334,7 +1334,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q2(const int xct_id,
 	//FINAL JOIN + TOP100-Filter
 	tuple_fifo* q2_final_buffer = new tuple_fifo(sizeof(q2_aggregate_tuple));
 	packet_t* q2_final_packet =
-			new hash_join_packet_t("subquery join main_query",
+			create_hash_join_packet("subquery join main_query",
 					q2_final_buffer,
 					new q2_top100_filter_t(),
 					q2_sort_packet,
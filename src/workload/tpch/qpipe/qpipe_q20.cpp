@@ -418,10 +418,11 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
 
 	time_t _first_shipdate;
 	time_t _last_shipdate;
+	int _first_day;
+	int _last_day;
 
 	q20_input_t *q20_input;
 
@@ -440,6 +441,8 @@ public:
 		struct tm *tm = gmtime(&_first_shipdate);
 		tm->tm_year++;
 		_last_shipdate = mktime(tm);
+		_first_day = timet_to_daynum(_first_shipdate);
+		_last_day = timet_to_daynum(_last_shipdate);
 
 		char f_shipdate[10];
 		char l_shipdate[10];
@@ -461,10 +464,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, sizeof(_lineitem.L_SHIPDATE));
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
 
-		return _shipdate >= _first_shipdate && _shipdate < _last_shipdate;
+		return _lineitem.L_SHIPDATE >= _first_day && _lineitem.L_SHIPDATE < _last_day;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -835,7 +837,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q20(const int xct_id,
 	//SUPPLIER JOIN NATION
 	tuple_fifo* q20_s_join_n_buffer = new tuple_fifo(sizeof(q20_s_join_n_tuple));
 	packet_t* q20_s_join_n_packet =
-			new hash_join_packet_t("supplier - nation HJOIN",
+			create_hash_join_packet("supplier - nation HJOIN",
 					q20_s_join_n_buffer,
 					new trivial_filter_t(sizeof(q20_s_join_n_tuple)),
 					q20_supplier_tscan_packet,
@@ -845,7 +847,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q20(const int xct_id,
 	//PART JOIN PARTSUPP
 	tuple_fifo* q20_p_join_ps_buffer = new tuple_fifo(sizeof(q20_p_join_ps_tuple));
 	packet_t* q20_p_join_ps_packet =
-			new hash_join_packet_t("part - partsupp HJOIN",
+			create_hash_join_packet("part - partsupp HJOIN",
 					q20_p_join_ps_buffer,
 					new trivial_filter_t(sizeof(q20_p_join_ps_tuple)),
 					q20_part_tscan_packet,
@@ -855,7 +857,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q20(const int xct_id,
 	//PART_PARTSUPP JOIN SUPPLIER_NATION
 	tuple_fifo* q20_p_ps_join_s_n_buffer = new tuple_fifo(sizeof(q20_p_ps_join_s_n_tuple));
 	packet_t* q20_p_ps_join_s_n_packet =
-			new hash_join_packet_t("part_partsupp - supplier_nation HJOIN",
+			create_hash_join_packet("part_partsupp - supplier_nation HJOIN",
 					q20_p_ps_join_s_n_buffer,
 					new trivial_filter_t(sizeof(q20_p_ps_join_s_n_tuple)),
 					q20_p_join_ps_packet,
@@ -865,7 +867,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q20(const int xct_id,
 	//LINEITEM JOIN PART_PARTSUPP_SUPPLIER_NATION
 	tuple_fifo* q20_all_joins_buffer = new tuple_fifo(sizeof(q20_final_tuple));
 	packet_t* q20_all_joins_packet =
-			new hash_join_packet_t("lineitem - part_partsupp_supplier_nation HJOIN",
+			create_hash_join_packet("lineitem - part_partsupp_supplier_nation HJOIN",
 					q20_all_joins_buffer,
 					new q20_final_join_filter_t(),
 					q20_lineitem_aggregate_packet,
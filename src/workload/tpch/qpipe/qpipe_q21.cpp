@@ -311,10 +311,10 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(11, _lineitem.L_COMMITDATE, sizeof(_lineitem.L_COMMITDATE));
-		_prline->get_value(12, _lineitem.L_RECEIPTDATE, sizeof(_lineitem.L_RECEIPTDATE));
+		_prline->get_value(11, _lineitem.L_COMMITDATE);
+		_prline->get_value(12, _lineitem.L_RECEIPTDATE);
 
-		return str_to_timet(_lineitem.L_RECEIPTDATE) > str_to_timet(_lineitem.L_COMMITDATE);
+		return _lineitem.L_RECEIPTDATE > _lineitem.L_COMMITDATE;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -797,7 +797,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q21(const int xct_id,
     //SUPPLIER JOIN NATION
     tuple_fifo* q21_s_join_n_buffer = new tuple_fifo(sizeof(q21_s_join_n_tuple));
     packet_t* q21_s_join_n_packet =
-    		new hash_join_packet_t("supplier - nation HJOIN",
+    		create_hash_join_packet("supplier - nation HJOIN",
     				q21_s_join_n_buffer,
     				new trivial_filter_t(sizeof(q21_s_join_n_tuple)),
     				q21_supplier_tscan_packet,
@@ -807,7 +807,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q21(const int xct_id,
     //LINEITEM L1 JOIN SUPPLIER_NATION
     tuple_fifo* q21_l1_join_s_n_buffer = new tuple_fifo(sizeof(q21_l1_join_s_n_tuple));
     packet_t* q21_l1_join_s_n_packet =
-    		new hash_join_packet_t("lineitem l1 - supplier_nation HJOIN",
+    		create_hash_join_packet("lineitem l1 - supplier_nation HJOIN",
     				q21_l1_join_s_n_buffer,
     				new trivial_filter_t(sizeof(q21_l1_join_s_n_tuple)),
     				q21_lineitem_l1_tscan_packet,
@@ -817,7 +817,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q21(const int xct_id,
     //LINEITEM L2 JOIN L1_SUPPLIER_NATION
     tuple_fifo* q21_l2_join_l1_s_n_buffer = new tuple_fifo(sizeof(q21_l2_join_l1_s_n_tuple));
     packet_t* q21_l2_join_l1_s_n_packet =
-    		new hash_join_packet_t("lineitem l2 - l1_supplier_nation HJOIN",
+    		create_hash_join_packet("lineitem l2 - l1_supplier_nation HJOIN",
     				q21_l2_join_l1_s_n_buffer,
     				new q21_exists_join_filter_t(),
     				q21_lineitem_l2_tscan_packet,
@@ -838,7 +838,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q21(const int xct_id,
     //ORDERS JOIN SUB_AGG_TUPLE
     tuple_fifo* q21_all_joins_buffer = new tuple_fifo(sizeof(q21_all_joins_tuple));
     packet_t* q21_all_joins_packet =
-    		new hash_join_packet_t("orders - l2_l1_supplier_nation HJOIN",
+    		create_hash_join_packet("orders - l2_l1_supplier_nation HJOIN",
     				q21_all_joins_buffer,
     				new trivial_filter_t(sizeof(q21_all_joins_tuple)),
     				q21_orders_tscan_packet,
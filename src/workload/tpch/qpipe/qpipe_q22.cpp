@@ -495,7 +495,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q22(const int xct_id,
     //CUSTOMER JOIN CUSTOMER SUB
     tuple_fifo* q22_c_join_c_buffer = new tuple_fifo(sizeof(q22_c_join_c_tuple));
     packet_t* q22_c_join_c_packet =
-    		new hash_join_packet_t("customer - customer HJOIN",
+    		create_hash_join_packet("customer - customer HJOIN",
     				q22_c_join_c_buffer,
     				new q22_join_filter_t(),
     				q22_customer_tscan_packet,
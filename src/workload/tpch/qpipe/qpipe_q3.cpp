@@ -81,7 +81,7 @@ struct q3_projected_customer_tuple {
 struct q3_projected_orders_tuple {
 	int O_ORDERKEY;
 	int O_CUSTKEY;
-	time_t O_ORDERDATE;
+	int O_ORDERDATE; // day number
 	int O_SHIPPRIORITY;
 };
 
@@ -94,7 +94,7 @@ struct q3_projected_lineitem_tuple {
 
 struct q3_o_join_c_tuple {
 	int O_ORDERKEY;
-	time_t O_ORDERDATE;
+	int O_ORDERDATE; // day number
 	int O_SHIPPRIORITY;
 };
 
@@ -105,14 +105,14 @@ struct q3_aggregated_lineitem_tuple {
 
 struct q3_aggregated_tuple {
 	int L_ORDERKEY;
-	time_t O_ORDERDATE;
+	int O_ORDERDATE; // day number
 	int O_SHIPPRIORITY;
 	decimal REVENUE;
 };
 
 struct q3_agg_key {
 	int L_ORDERKEY;
-	time_t O_ORDERDATE;
+	int O_ORDERDATE; // day number
 	int O_SHIPPRIORITY;
 };
 
@@ -192,7 +192,7 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
+	int _current_date;
 
 	q3_input_t* q3_input;
 
@@ -207,6 +207,7 @@ public:
 
 		// Generate the random predicates
 		q3_input = &in;
+		_current_date = timet_to_daynum(q3_input->current_date);
 
 		char time[15];
 		timet_to_str(time, q3_input->current_date);
@@ -225,10 +226,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, 15);
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		return _orderdate < q3_input->current_date;
+		return _orders.O_ORDERDATE < _current_date;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -237,14 +237,14 @@ public:
 
 		_prorders->get_value(0, _orders.O_ORDERKEY);
 		_prorders->get_value(1, _orders.O_CUSTKEY);
-		_prorders->get_value(4, _orders.O_ORDERDATE, 15);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 		_prorders->get_value(7, _orders.O_SHIPPRIORITY);
 
 		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%s|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, _orders.O_ORDERDATE, _orders.O_SHIPPRIORITY);
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
 		dest->O_CUSTKEY = _orders.O_CUSTKEY;
-		dest->O_ORDERDATE = str_to_timet(_orders.O_ORDERDATE);
+		dest->O_ORDERDATE = _orders.O_ORDERDATE;
 		dest->O_SHIPPRIORITY = _orders.O_SHIPPRIORITY;
 
 	}
@@ -266,7 +266,7 @@ private:
 	rep_row_t _rr;
 
 	tpch_lineitem_tuple _lineitem;
-	time_t _shipdate;
+	int _current_date;
 
 	q3_input_t* q3_input;
 
@@ -281,6 +281,7 @@ public:
 
 		// Generate the random predicates
 		q3_input = &in;
+		_current_date = timet_to_daynum(q3_input->current_date);
 
 		char time[15];
 		timet_to_str(time, q3_input->current_date);
@@ -299,10 +300,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-		_shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+		_prline->get_value(10, _lineitem.L_SHIPDATE);
 
-		return _shipdate > q3_input->current_date;
+		return _lineitem.L_SHIPDATE > _current_date;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -351,7 +351,7 @@ struct q3_o_join_c_t : public tuple_join_t {
 		dest->O_SHIPPRIORITY = left->O_SHIPPRIORITY;
 
 		char date[STRSIZE(10)];
-		timet_to_str(date, left->O_ORDERDATE);
+		daynum_to_str(date, left->O_ORDERDATE);
 		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %d %s %d\n", left->O_CUSTKEY, right->C_CUSTKEY, left->O_ORDERKEY, date, left->O_SHIPPRIORITY);
 	}
 
@@ -415,7 +415,7 @@ struct q3_l_join_oc_t : public tuple_join_t {
 		dest->O_SHIPPRIORITY = right->O_SHIPPRIORITY;
 
 		char date[STRSIZE(10)];
-		timet_to_str(date, right->O_ORDERDATE);
+		daynum_to_str(date, right->O_ORDERDATE);
 		//TRACE(TRACE_RECORD_FLOW, "JOIN: %d=%d: %d %.2f %s %d\n", left->L_ORDERKEY, right->O_ORDERKEY, right->O_ORDERKEY, left->REVENUE.to_double(), date, right->O_SHIPPRIORITY);
 	}
 
@@ -590,7 +590,7 @@ public:
 		q3_aggregated_tuple* r = aligned_cast<q3_aggregated_tuple>(output.data);
 
 		char date[STRSIZE(10)];
-		timet_to_str(date, r->O_ORDERDATE);
+		daynum_to_str(date, r->O_ORDERDATE);
 		TRACE(TRACE_QUERY_RESULTS, "*** Q3 %14d %14.4f %14s %14d\n",
 				r->L_ORDERKEY, r->REVENUE.to_double(), date, r->O_SHIPPRIORITY);
 	}
@@ -637,7 +637,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q3(const int xct_id,
 	//ORDERS JOIN CUSTOMERS
 	tuple_fifo* q3_o_join_c_buffer = new tuple_fifo(sizeof(q3_o_join_c_tuple));
 	packet_t* q3_o_join_c_packet =
-			new hash_join_packet_t("orders-customer HJOIN",
+			create_hash_join_packet("orders-customer HJOIN",
 					q3_o_join_c_buffer,
 					new trivial_filter_t(sizeof(q3_o_join_c_tuple)),
 					q3_orders_tscan_packet,
@@ -666,7 +666,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q3(const int xct_id,
 	//LINEITEM JOIN O_C
 	tuple_fifo* q3_l_join_oc_buffer = new tuple_fifo(sizeof(q3_aggregated_tuple));
 	packet_t* q3_l_join_oc_packet =
-			new hash_join_packet_t("lineitem-orders_customer HJOIN",
+			create_hash_join_packet("lineitem-orders_customer HJOIN",
 					q3_l_join_oc_buffer,
 					new trivial_filter_t(sizeof(q3_aggregated_tuple)),
 					q3_aggregated_lineitem_packet,
@@ -113,9 +113,6 @@ private:
 
     /*One lineitem tuple*/
     tpch_lineitem_tuple _lineitem;
-    /*The columns needed for the selection*/
-    time_t _commitdate;
-    time_t _receiptdate;
     /* No Random Predicates */
 public:
 
@@ -145,20 +142,17 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-        _prline->get_value(12, _lineitem.L_RECEIPTDATE, 15);
-        _receiptdate = str_to_timet(_lineitem.L_RECEIPTDATE);
-
-        _prline->get_value(11, _lineitem.L_COMMITDATE, 15);
-        _commitdate = str_to_timet(_lineitem.L_COMMITDATE);
+        _prline->get_value(12, _lineitem.L_RECEIPTDATE);
+        _prline->get_value(11, _lineitem.L_COMMITDATE);
 
 
         // Return true if it passes the filter
-		if  ( _receiptdate > _commitdate) {
-			//TRACE(TRACE_RECORD_FLOW, "+ %s > %s\n", _lineitem.L_RECEIPTDATE, _lineitem.L_COMMITDATE);
+		if  ( _lineitem.L_RECEIPTDATE > _lineitem.L_COMMITDATE) {
+			//TRACE(TRACE_RECORD_FLOW, "+ %d > %d\n", _lineitem.L_RECEIPTDATE, _lineitem.L_COMMITDATE);
 			return (true);
 		}
 		else {
-			//TRACE(TRACE_RECORD_FLOW, ". %s <= %s\n", _lineitem.L_RECEIPTDATE, _lineitem.L_COMMITDATE);
+			//TRACE(TRACE_RECORD_FLOW, ". %d <= %d\n", _lineitem.L_RECEIPTDATE, _lineitem.L_COMMITDATE);
 			return (false);
 		}
     }
@@ -261,8 +255,9 @@ private:
 
     /*One lineitem tuple*/
     tpch_orders_tuple _orders;
-    /*The columns needed for the selection*/
-    time_t _orderdate;
+    /*The bounds of the selection, as day numbers*/
+    int _first_day;
+    int _last_day;
 
     /* Random Predicates */
     /* TPC-H Specification 2.7.3 */
@@ -291,6 +286,8 @@ public:
 	gmtime_r(&(q4_input->o_orderdate), &date);
 	date.tm_mon += 3;
 	_last_o_orderdate=mktime(&date);
+	_first_day = timet_to_daynum(q4_input->o_orderdate);
+	_last_day = timet_to_daynum(_last_o_orderdate);
 
 	char date1[15];
 	char date2[15];
@@ -314,17 +311,16 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-        _prorder->get_value(4, _orders.O_ORDERDATE, 15);
-        _orderdate = str_to_timet(_orders.O_ORDERDATE);
+        _prorder->get_value(4, _orders.O_ORDERDATE);
 
 
         // Return true if it passes the filter
-		if  ( _orderdate >= q4_input->o_orderdate && _orderdate < _last_o_orderdate ) {
-			//TRACE(TRACE_RECORD_FLOW, "+ %s (between %s and %s)\n", _orders.O_ORDERDATE, q4_input->o_orderdate, _last_o_orderdate);
+		if  ( _orders.O_ORDERDATE >= _first_day && _orders.O_ORDERDATE < _last_day ) {
+			//TRACE(TRACE_RECORD_FLOW, "+ %d (between %d and %d)\n", _orders.O_ORDERDATE, _first_day, _last_day);
 			return (true);
 		}
 		else {
-			//TRACE(TRACE_RECORD_FLOW, ". %s (not between %s and %s)\n", _orders.O_ORDERDATE, q4_input->o_orderdate, _last_o_orderdate );
+			//TRACE(TRACE_RECORD_FLOW, ". %d (not between %d and %d)\n", _orders.O_ORDERDATE, _first_day, _last_day);
 			return (false);
 		}
     }
@@ -576,7 +572,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q4(const int xct_id,
     tuple_filter_t* filter = new trivial_filter_t(sizeof(q4_join_tuple));
     tuple_fifo* q4_join_out = new tuple_fifo(sizeof(q4_join_tuple));
     tuple_join_t* q4_join = new q4_join_t();
-    packet_t* q4_join_packet = new hash_join_packet_t("Orders - Lineitem JOIN",
+    packet_t* q4_join_packet = create_hash_join_packet("Orders - Lineitem JOIN",
 												   q4_join_out,
                                                    filter,
                                                    q4_tscan_orders_packet,
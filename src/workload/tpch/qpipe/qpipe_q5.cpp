@@ -339,10 +339,11 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
 
 	q5_input_t* q5_input;
 	time_t _last_orderdate;
+	int _first_day;
+	int _last_day;
 
 public:
 	q5_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q5_input_t &in)
@@ -359,6 +360,8 @@ public:
 		gmtime_r(&(q5_input->o_orderdate), &date);
 		date.tm_year++;
 		_last_orderdate = mktime(&date);
+		_first_day = timet_to_daynum(q5_input->o_orderdate);
+		_last_day = timet_to_daynum(_last_orderdate);
 
 		char t1[15];
 		char t2[15];
@@ -380,10 +383,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, 15);
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		return _orderdate >= q5_input->o_orderdate && _orderdate < _last_orderdate;
+		return _orders.O_ORDERDATE >= _first_day && _orders.O_ORDERDATE < _last_day;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -842,7 +844,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q5(const int xct_id,
 	//REGION JOIN NATION
 	tuple_fifo* q5_r_join_n_buffer = new tuple_fifo(sizeof(q5_r_join_n_tuple));
 	packet_t* q5_r_join_n_packet =
-			new hash_join_packet_t("region - nation HJOIN",
+			create_hash_join_packet("region - nation HJOIN",
 					q5_r_join_n_buffer,
 					new trivial_filter_t(sizeof(q5_r_join_n_tuple)),
 					q5_region_tscan_packet,
@@ -862,7 +864,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q5(const int xct_id,
 	//CUSTOMER JOIN R_N
 	tuple_fifo* q5_c_join_r_n_buffer = new tuple_fifo(sizeof(q5_c_join_r_n_tuple));
 	packet_t* q5_c_join_r_n_packet =
-			new hash_join_packet_t("customer - region_nation HJOIN",
+			create_hash_join_packet("customer - region_nation HJOIN",
 					q5_c_join_r_n_buffer,
 					new trivial_filter_t(sizeof(q5_c_join_r_n_tuple)),
 					q5_customer_tscan_packet,
@@ -882,7 +884,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q5(const int xct_id,
 	//ORDERS JOIN C_R_N
 	tuple_fifo* q5_o_join_c_r_n_buffer = new tuple_fifo(sizeof(q5_o_join_c_r_n_tuple));
 	packet_t* q5_o_join_c_r_n_packet =
-			new hash_join_packet_t("orders - customer_region_nation HJOIN",
+			create_hash_join_packet("orders - customer_region_nation HJOIN",
 					q5_o_join_c_r_n_buffer,
 					new trivial_filter_t(sizeof(q5_o_join_c_r_n_tuple)),
 					q5_orders_tscan_packet,
@@ -902,7 +904,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q5(const int xct_id,
 	//LINEITEM JOIN O_C_R_N
 	tuple_fifo* q5_l_join_o_c_r_n_buffer = new tuple_fifo(sizeof(q5_l_join_o_c_r_n_tuple));
 	packet_t* q5_l_join_o_c_r_n_packet =
-			new hash_join_packet_t("lineitem - orders_customer_region_nation HJOIN",
+			create_hash_join_packet("lineitem - orders_customer_region_nation HJOIN",
 					q5_l_join_o_c_r_n_buffer,
 					new trivial_filter_t(sizeof(q5_l_join_o_c_r_n_tuple)),
 					q5_lineitem_tscan_packet,
@@ -922,7 +924,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q5(const int xct_id,
 	//L_O_C_R_N JOIN SUPPLIER
 	tuple_fifo* q5_all_join_buffer = new tuple_fifo(sizeof(q5_all_join_tuple));
 	packet_t* q5_all_join_packet =
-			new hash_join_packet_t("lineitem_orders_customer_region_nation - supplier HJOIN",
+			create_hash_join_packet("lineitem_orders_customer_region_nation - supplier HJOIN",
 					q5_all_join_buffer,
 					new trivial_filter_t(sizeof(q5_all_join_tuple)),
 					q5_l_join_o_c_r_n_packet,
@@ -30,6 +30,7 @@
  */
 
 #include "workload/tpch/shore_tpch_env.h"
+#include "sm/shore/shore_column_scan.h"
 #include "qpipe.h"
 
 using namespace shore;
@@ -88,7 +89,6 @@ private:
     /*One lineitem tuple*/
     tpch_lineitem_tuple _lineitem;
     /*The columns needed for the selection*/
-    time_t _shipdate;
     double _discount;
     double _quantity;
 
@@ -96,6 +96,14 @@ private:
     /* TPC-H Specification 2.9.3 */
     q6_input_t* q6_input;
     time_t _last_l_shipdate;
+    int _first_day;
+    int _last_day;
+
+    /* Offsets of the fields in the lineitem records, for the batches */
+    offset_t _quantity_off;
+    offset_t _extendedprice_off;
+    offset_t _discount_off;
+    offset_t _shipdate_off;
 public:
 
     q6_tscan_filter_t(ShoreTPCHEnv* tpchdb, q6_input_t &in)
@@ -121,6 +129,13 @@ public:
 	gmtime_r(&(q6_input->l_shipdate), &date);
 	date.tm_year ++;
 	_last_l_shipdate=mktime(&date);
+	_first_day = timet_to_daynum(q6_input->l_shipdate);
+	_last_day = timet_to_daynum(_last_l_shipdate);
+
+	_quantity_off = fixed_field_offset(_tpchdb->lineitem_desc(), 4);
+	_extendedprice_off = fixed_field_offset(_tpchdb->lineitem_desc(), 5);
+	_discount_off = fixed_field_offset(_tpchdb->lineitem_desc(), 6);
+	_shipdate_off = fixed_field_offset(_tpchdb->lineitem_desc(), 10);
 
 	char date1[15];
 	char date2[15];
@@ -144,8 +159,7 @@ public:
             assert(false); // RC(se_WRONG_DISK_DATA)
         }
 
-        _prline->get_value(10, _lineitem.L_SHIPDATE, 15); //get column 10 (15 characters)
-        _shipdate = str_to_timet(_lineitem.L_SHIPDATE);        
+        _prline->get_value(10, _lineitem.L_SHIPDATE);
         _prline->get_value(6, _lineitem.L_DISCOUNT); //get column 6 (float)
         _discount=_lineitem.L_DISCOUNT/100.0;
 #warning MA: Discount from TPCH dbgen is created between 0 and 100 instead between 0 and 1.
@@ -155,14 +169,14 @@ public:
 
 
         // Return true if it passes the filter
-		if  ( _shipdate >= q6_input->l_shipdate && _shipdate < _last_l_shipdate && _discount>=(q6_input->l_discount-0.01) &&
+		if  ( _lineitem.L_SHIPDATE >= _first_day && _lineitem.L_SHIPDATE < _last_day && _discount>=(q6_input->l_discount-0.01) &&
 				_discount<=(q6_input->l_discount+0.01) && _quantity<q6_input->l_quantity) {
 
-			//TRACE(TRACE_RECORD_FLOW, "+ %s, %lf, %lf\n", _lineitem.L_SHIPDATE, _lineitem.L_DISCOUNT, _lineitem.L_QUANTITY);
+			//TRACE(TRACE_RECORD_FLOW, "+ %d, %lf, %lf\n", _lineitem.L_SHIPDATE, _lineitem.L_DISCOUNT, _lineitem.L_QUANTITY);
 			return (true);
 		}
 		else {
-				//TRACE(TRACE_RECORD_FLOW, ". %s, %lf, %lf\n", _lineitem.L_SHIPDATE, _lineitem.L_DISCOUNT, _lineitem.L_QUANTITY);
+				//TRACE(TRACE_RECORD_FLOW, ". %d, %lf, %lf\n", _lineitem.L_SHIPDATE, _lineitem.L_DISCOUNT, _lineitem.L_QUANTITY);
 			return (false);
 		}
     }
@@ -186,6 +200,53 @@ public:
 #warning MA: Discount from TPCH dbgen is created between 0 and 100 instead between 0 and 1.
     }
 
+
+    // The batches read the fields straight from the lineitem records
+    bool batched() const {
+        return (true);
+    }
+
+    // The predicates of the batches, on the lineitem records
+    struct batch_pred_t {
+        offset_t _shipdate_off;
+        offset_t _discount_off;
+        offset_t _quantity_off;
+        int _first_day;
+        int _last_day;
+        double _low_discount;
+        double _high_discount;
+        double _quantity;
+        bool operator()(const char* rec) const {
+            int shipdate = fixed_field<int>(rec, _shipdate_off);
+            double discount = fixed_field<double>(rec, _discount_off)/100.0;
+            return ((shipdate >= _first_day) & (shipdate < _last_day) &
+                    (discount >= _low_discount) & (discount <= _high_discount) &
+                    (fixed_field<double>(rec, _quantity_off) < _quantity));
+        }
+    };
+
+    // Batch predication, without loading the records
+    void select_batch(page &p, selection_t &sel) {
+        batch_pred_t pred = { _shipdate_off, _discount_off, _quantity_off,
+                              _first_day, _last_day,
+                              q6_input->l_discount - 0.01,
+                              q6_input->l_discount + 0.01,
+                              q6_input->l_quantity };
+        select_batch_if(p, sel, pred);
+    }
+
+    // Batch projection of the survivors
+    void project_batch(tuple_fifo* out, page &p, const selection_t &sel) {
+        for (size_t i=0; i<sel.size(); i++) {
+            const char* rec = p.get_tuple(sel[i]).data;
+            tuple_t d = out->allocate();
+            q6_projected_lineitem_tuple *dest;
+            dest = aligned_cast<q6_projected_lineitem_tuple>(d.data);
+            dest->L_EXTENDEDPRICE = fixed_field<double>(rec, _extendedprice_off) / 100.0;
+            dest->L_DISCOUNT = fixed_field<double>(rec, _discount_off) / 100.0;
+        }
+    }
+
     q6_tscan_filter_t* clone() const {
         return new q6_tscan_filter_t(*this);
     }
@@ -357,10 +357,9 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
         rep_row_t _rr;
 
         tpch_lineitem_tuple _lineitem;
-        time_t _shipdate;
 
-        time_t _firstdate;
-        time_t _lastdate;
+        int _firstdate;
+        int _lastdate;
 
     public:
         q7_lineitem_tscan_filter_t(ShoreTPCHEnv* tpchdb, q7_input_t &in)
@@ -371,8 +370,8 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
                        _tpchdb->lineitem_desc()->maxsize());
             _prline->_rep = &_rr;
 
-            _firstdate = str_to_timet("1995-01-01");
-            _lastdate = str_to_timet("1996-12-31");
+            _firstdate = str_to_daynum("1995-01-01");
+            _lastdate = str_to_daynum("1996-12-31");
         }
 
         virtual ~q7_lineitem_tscan_filter_t()
@@ -387,10 +386,9 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
                 assert(false); // RC(se_WRONG_DISK_DATA)
             }
 
-            _prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-            _shipdate = str_to_timet(_lineitem.L_SHIPDATE);
+            _prline->get_value(10, _lineitem.L_SHIPDATE);
 
-            return (_shipdate >= _firstdate && _shipdate <= _lastdate);
+            return (_lineitem.L_SHIPDATE >= _firstdate && _lineitem.L_SHIPDATE <= _lastdate);
         }
 
         void project(tuple_t &d, const tuple_t &s) {
@@ -401,23 +399,17 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
             _prline->get_value(2, _lineitem.L_SUPPKEY);
             _prline->get_value(5, _lineitem.L_EXTENDEDPRICE);
             _prline->get_value(6, _lineitem.L_DISCOUNT);
-            _prline->get_value(10, _lineitem.L_SHIPDATE, 15);
-            _shipdate = str_to_timet(_lineitem.L_SHIPDATE);
-            struct tm *tm_shipdate = gmtime(&_shipdate);
+            _prline->get_value(10, _lineitem.L_SHIPDATE);
 
             //TRACE(TRACE_RECORD_FLOW, "%d|%d|%.2f|%.2f|%d\n", _lineitem.L_ORDERKEY, _lineitem.L_SUPPKEY, _lineitem.L_EXTENDEDPRICE / 100.0, _lineitem.L_DISCOUNT / 100.0,
-            //													tm_shipdate->tm_year + 1900);
+            //													daynum_year(_lineitem.L_SHIPDATE));
 
             dest->L_ORDERKEY = _lineitem.L_ORDERKEY;
             dest->L_SUPPKEY = _lineitem.L_SUPPKEY;
             dest->L_EXTENDEDPRICE = _lineitem.L_EXTENDEDPRICE / 100.0;
 #warning MA: Discount from TPCH dbgen is created between 0 and 100 instead between 0 and 1.
             dest->L_DISCOUNT = _lineitem.L_DISCOUNT / 100.0;
-            dest->L_YEAR = tm_shipdate->tm_year + 1900;
-            /*char ryear[5];
-            strncpy(ryear, _lineitem.L_SHIPDATE, 4);
-            ryear[4] = '\0';
-            if(dest->L_YEAR != atoi(ryear)) TRACE(TRACE_RECORD_FLOW, "%d\t%d\t%s\t%s\n", dest->L_ORDERKEY, dest->L_YEAR, ryear, _lineitem.L_SHIPDATE);*/
+            dest->L_YEAR = daynum_year(_lineitem.L_SHIPDATE);
         }
 
         q7_lineitem_tscan_filter_t* clone() const {
@@ -425,7 +417,11 @@ class q7_lineitem_tscan_filter_t : public tuple_filter_t
         }
 
         c_str to_string() const {
-            return c_str("q7_lineitem_tscan_filter_t(between(%s, %s))", ctime(&(_firstdate)), ctime(&(_lastdate)));
+            char first[STRSIZE(10)];
+            char last[STRSIZE(10)];
+            daynum_to_str(first, _firstdate);
+            daynum_to_str(last, _lastdate);
+            return c_str("q7_lineitem_tscan_filter_t(between(%s, %s))", first, last);
         }
 };
 
@@ -826,7 +822,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q7(const int xct_id,
 	//CUSTOMER JOIN NATION(n2)
 	tuple_fifo* q7_c_join_n2_buffer = new tuple_fifo(sizeof(q7_c_join_n2_tuple));
 	packet_t* q7_c_join_n2_packet =
-			new hash_join_packet_t("customer - nation(n2) HJOIN",
+			create_hash_join_packet("customer - nation(n2) HJOIN",
 									q7_c_join_n2_buffer,
 									new trivial_filter_t(sizeof(q7_c_join_n2_tuple)),
 									q7_customer_tscan_packet,
@@ -846,7 +842,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q7(const int xct_id,
 	//ORDERS JOIN CUSTOMER_NATION
 	tuple_fifo* q7_o_join_c_n2_buffer = new tuple_fifo(sizeof(q7_o_join_c_n2_tuple));
 	packet_t* q7_o_join_c_n2_packet =
-			new hash_join_packet_t("orders - customer_nation HJOIN",
+			create_hash_join_packet("orders - customer_nation HJOIN",
 									q7_o_join_c_n2_buffer,
 									new trivial_filter_t(sizeof(q7_o_join_c_n2_tuple)),
 									q7_orders_tscan_packet,
@@ -866,7 +862,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q7(const int xct_id,
 	//LINEITEM JOIN ORDERS_CUSTOMER_NATION
 	tuple_fifo* q7_l_join_o_c_n2_buffer = new tuple_fifo(sizeof(q7_l_join_o_c_n2_tuple));
 	packet_t* q7_l_join_o_c_n2_packet =
-			new hash_join_packet_t("lineitem - orders_customer_nation HJOIN",
+			create_hash_join_packet("lineitem - orders_customer_nation HJOIN",
 									q7_l_join_o_c_n2_buffer,
 									new trivial_filter_t(sizeof(q7_l_join_o_c_n2_tuple)),
 									q7_lineitem_tscan_packet,
@@ -886,7 +882,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q7(const int xct_id,
 	//LINEITEM_ORDERS_CUSTOMER_NATION JOIN SUPPLIER
 	tuple_fifo* q7_l_o_c_n2_join_s_buffer = new tuple_fifo(sizeof(q7_l_o_c_n2_join_s_tuple));
 	packet_t* q7_l_o_c_n2_join_s_packet =
-			new hash_join_packet_t("lineitem_orders_customer_nation - supplier HJOIN",
+			create_hash_join_packet("lineitem_orders_customer_nation - supplier HJOIN",
 									q7_l_o_c_n2_join_s_buffer,
 									new trivial_filter_t(sizeof(q7_l_o_c_n2_join_s_tuple)),
 									q7_l_join_o_c_n2_packet,
@@ -917,7 +913,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q7(const int xct_id,
 	//NATION JOIN LINEITEM_ORDERS_CUSTOMER_NATION_SUPPLIER
 	tuple_fifo* q7_all_join_buffer = new tuple_fifo(sizeof(q7_final_tuple));
 	packet_t* q7_all_join_packet =
-			new hash_join_packet_t("nation(n1) - lineitem_orders_customer_nation_supplier HJOIN",
+			create_hash_join_packet("nation(n1) - lineitem_orders_customer_nation_supplier HJOIN",
 									q7_all_join_buffer,
 									new q7_join_nation_filter_t(),
 									q7_nation_n1_tscan_packet,
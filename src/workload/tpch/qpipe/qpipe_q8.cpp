@@ -326,10 +326,9 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
 
-	time_t _first_orderdate;
-	time_t _last_orderdate;
+	int _first_orderdate;
+	int _last_orderdate;
 
 public:
 	q8_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q8_input_t &in)
@@ -340,8 +339,8 @@ public:
 				_tpchdb->orders_desc()->maxsize());
 		_prorders->_rep = &_rr;
 
-		_first_orderdate = str_to_timet("1995-01-01");
-		_last_orderdate = str_to_timet("1996-12-31");
+		_first_orderdate = str_to_daynum("1995-01-01");
+		_last_orderdate = str_to_daynum("1996-12-31");
 	}
 
 	virtual ~q8_orders_tscan_filter_t()
@@ -356,10 +355,9 @@ public:
 			assert(false); // RC(se_WRONG_DISK_DATA)
 		}
 
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		return _orderdate >= _first_orderdate && _orderdate <= _last_orderdate;
+		return _orders.O_ORDERDATE >= _first_orderdate && _orders.O_ORDERDATE <= _last_orderdate;
 	}
 
 	void project(tuple_t &d, const tuple_t &s) {
@@ -368,15 +366,13 @@ public:
 
 		_prorders->get_value(0, _orders.O_ORDERKEY);
 		_prorders->get_value(1, _orders.O_CUSTKEY);
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
-		struct tm *tm_orderdate = gmtime(&_orderdate);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, tm_orderdate->tm_year + 1900);
+		//TRACE(TRACE_RECORD_FLOW, "%d|%d|%d\n", _orders.O_ORDERKEY, _orders.O_CUSTKEY, daynum_year(_orders.O_ORDERDATE));
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
 		dest->O_CUSTKEY = _orders.O_CUSTKEY;
-		dest->O_YEAR = tm_orderdate->tm_year + 1900;
+		dest->O_YEAR = daynum_year(_orders.O_ORDERDATE);
 	}
 
 	q8_orders_tscan_filter_t* clone() const {
@@ -384,7 +380,11 @@ public:
 	}
 
 	c_str to_string() const {
-		return c_str("q8_orders_tscan_filter_t(between (%s, %s))", ctime(&(_first_orderdate)), ctime(&(_last_orderdate)));
+		char first[STRSIZE(10)];
+		char last[STRSIZE(10)];
+		daynum_to_str(first, _first_orderdate);
+		daynum_to_str(last, _last_orderdate);
+		return c_str("q8_orders_tscan_filter_t(between (%s, %s))", first, last);
 	}
 };
 
@@ -1099,7 +1099,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //LINEITEM JOIN PART
     tuple_fifo* q8_l_join_p_buffer = new tuple_fifo(sizeof(q8_l_join_p_tuple));
     packet_t* q8_l_join_p_packet =
-    		new hash_join_packet_t("lineitem - part HJOIN",
+    		create_hash_join_packet("lineitem - part HJOIN",
     				q8_l_join_p_buffer,
     				new trivial_filter_t(sizeof(q8_l_join_p_tuple)),
     				q8_lineitem_tscan_packet,
@@ -1109,7 +1109,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //ORDERS JOIN L_P
     tuple_fifo* q8_o_join_l_p_buffer = new tuple_fifo(sizeof(q8_o_join_l_p_tuple));
     packet_t* q8_o_join_l_p_packet =
-    		new hash_join_packet_t("orders - lineitem_part HJOIN",
+    		create_hash_join_packet("orders - lineitem_part HJOIN",
     				q8_o_join_l_p_buffer,
     				new trivial_filter_t(sizeof(q8_o_join_l_p_tuple)),
     				q8_orders_tscan_packet,
@@ -1119,7 +1119,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //CUSTOMER JOIN O_L_P
     tuple_fifo* q8_c_join_o_l_p_buffer = new tuple_fifo(sizeof(q8_c_join_o_l_p_tuple));
     packet_t* q8_c_join_o_l_p_packet =
-    		new hash_join_packet_t("customer - orders_lineitem_part HJOIN",
+    		create_hash_join_packet("customer - orders_lineitem_part HJOIN",
     				q8_c_join_o_l_p_buffer,
     				new trivial_filter_t(sizeof(q8_c_join_o_l_p_tuple)),
     				q8_customer_tscan_packet,
@@ -1129,7 +1129,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //C_O_L_P JOIN NATION n1
     tuple_fifo* q8_c_o_l_p_join_n1_buffer = new tuple_fifo(sizeof(q8_c_o_l_p_join_n1_tuple));
     packet_t* q8_c_o_l_p_join_n1_packet =
-    		new hash_join_packet_t("customer_orders_lineitem_part - nation n1 HJOIN",
+    		create_hash_join_packet("customer_orders_lineitem_part - nation n1 HJOIN",
     				q8_c_o_l_p_join_n1_buffer,
     				new trivial_filter_t(sizeof(q8_c_o_l_p_join_n1_tuple)),
     				q8_c_join_o_l_p_packet,
@@ -1139,7 +1139,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //C_O_L_P_N1 JOIN REGION
     tuple_fifo* q8_c_o_l_p_n1_join_r_buffer = new tuple_fifo(sizeof(q8_c_o_l_p_n1_join_r_tuple));
     packet_t* q8_c_o_l_p_n1_join_r_packet =
-    		new hash_join_packet_t("customer_orders_lineitem_part_nation - region HJOIN",
+    		create_hash_join_packet("customer_orders_lineitem_part_nation - region HJOIN",
     				q8_c_o_l_p_n1_join_r_buffer,
     				new trivial_filter_t(sizeof(q8_c_o_l_p_n1_join_r_tuple)),
     				q8_c_o_l_p_join_n1_packet,
@@ -1149,7 +1149,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //SUPPLIER JOIN C_O_L_P_N1_R
     tuple_fifo* q8_s_join_c_o_l_p_n1_r_buffer = new tuple_fifo(sizeof(q8_s_join_c_o_l_p_n1_r_tuple));
     packet_t* q8_s_join_c_o_l_p_n1_r_packet =
-    		new hash_join_packet_t("supplier - customer_orders_lineitem_part_nation_region HJOIN",
+    		create_hash_join_packet("supplier - customer_orders_lineitem_part_nation_region HJOIN",
     				q8_s_join_c_o_l_p_n1_r_buffer,
     				new trivial_filter_t(sizeof(q8_s_join_c_o_l_p_n1_r_tuple)),
     				q8_supplier_tscan_packet,
@@ -1159,7 +1159,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q8(const int xct_id,
     //S_C_O_L_P_N1_R JOIN NATION n2
     tuple_fifo* q8_all_joins_buffer = new tuple_fifo(sizeof(q8_all_joins_tuple));
     packet_t* q8_all_joins_packet =
-    		new hash_join_packet_t("supplier_customer_orders_lineitem_part_nation_region - nation n2 HJOIN",
+    		create_hash_join_packet("supplier_customer_orders_lineitem_part_nation_region - nation n2 HJOIN",
     				q8_all_joins_buffer,
     				new trivial_filter_t(sizeof(q8_all_joins_tuple)),
     				q8_s_join_c_o_l_p_n1_r_packet,
@@ -438,7 +438,6 @@ private:
 	rep_row_t _rr;
 
 	tpch_orders_tuple _orders;
-	time_t _orderdate;
 
 public:
 	q9_orders_tscan_filter_t(ShoreTPCHEnv* tpchdb, q9_input_t &in)
@@ -470,14 +469,12 @@ public:
 		q9_projected_orders_tuple *dest = aligned_cast<q9_projected_orders_tuple>(d.data);
 
 		_prorders->get_value(0, _orders.O_ORDERKEY);
-		_prorders->get_value(4, _orders.O_ORDERDATE, sizeof(_orders.O_ORDERDATE));
-		_orderdate = str_to_timet(_orders.O_ORDERDATE);
-		struct tm *tm_orderdate = gmtime(&_orderdate);
+		_prorders->get_value(4, _orders.O_ORDERDATE);
 
-		//TRACE(TRACE_RECORD_FLOW, "%d|%d\n", _orders.O_ORDERKEY, tm_orderdate->tm_year + 1900);
+		//TRACE(TRACE_RECORD_FLOW, "%d|%d\n", _orders.O_ORDERKEY, daynum_year(_orders.O_ORDERDATE));
 
 		dest->O_ORDERKEY = _orders.O_ORDERKEY;
-		dest->O_YEAR = tm_orderdate->tm_year + 1900;
+		dest->O_YEAR = daynum_year(_orders.O_ORDERDATE);
 	}
 
 	q9_orders_tscan_filter_t* clone() const {
@@ -906,7 +903,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q9(const int xct_id,
 	//LINEITEM JOIN PART
 	tuple_fifo* q9_l_join_p_buffer = new tuple_fifo(sizeof(q9_l_join_p_tuple));
 	packet_t* q9_l_join_p_packet =
-			new hash_join_packet_t("lineitem - part HJOIN",
+			create_hash_join_packet("lineitem - part HJOIN",
 					q9_l_join_p_buffer,
 					new trivial_filter_t(sizeof(q9_l_join_p_tuple)),
 					q9_lineitem_tscan_packet,
@@ -916,7 +913,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q9(const int xct_id,
 	//LINEITEM_PART JOIN SUPPLIER
 	tuple_fifo* q9_l_p_join_s_buffer = new tuple_fifo(sizeof(q9_l_p_join_s_tuple));
 	packet_t* q9_l_p_join_s_packet =
-			new hash_join_packet_t("lineitem_part - supplier HJOIN",
+			create_hash_join_packet("lineitem_part - supplier HJOIN",
 					q9_l_p_join_s_buffer,
 					new trivial_filter_t(sizeof(q9_l_p_join_s_tuple)),
 					q9_l_join_p_packet,
@@ -926,7 +923,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q9(const int xct_id,
 	//LINEITEM_PART_SUPPLIER JOIN NATION
 	tuple_fifo* q9_l_p_s_join_n_buffer = new tuple_fifo(sizeof(q9_l_p_s_join_n_tuple));
 	packet_t* q9_l_p_s_join_n_packet =
-			new hash_join_packet_t("lineitem_part_supplier - nation HJOIN",
+			create_hash_join_packet("lineitem_part_supplier - nation HJOIN",
 					q9_l_p_s_join_n_buffer,
 					new trivial_filter_t(sizeof(q9_l_p_s_join_n_tuple)),
 					q9_l_p_join_s_packet,
@@ -936,7 +933,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q9(const int xct_id,
 	//LINEITEM_PART_SUPPLIER_NATION JOIN ORDERS
 	tuple_fifo* q9_l_p_s_n_join_o_buffer = new tuple_fifo(sizeof(q9_l_p_s_n_join_o_tuple));
 	packet_t* q9_l_p_s_n_join_o_packet =
-			new hash_join_packet_t("lineitem_part_supplier_nation - orders HJOIN",
+			create_hash_join_packet("lineitem_part_supplier_nation - orders HJOIN",
 					q9_l_p_s_n_join_o_buffer,
 					new trivial_filter_t(sizeof(q9_l_p_s_n_join_o_tuple)),
 					q9_l_p_s_join_n_packet,
@@ -946,7 +943,7 @@ w_rc_t ShoreTPCHEnv::xct_qpipe_q9(const int xct_id,
 	//LINEITEM_PART_SUPPLIER_NATION_ORDERS JOIN PARTSUPP
 	tuple_fifo* q9_all_joins_buffer = new tuple_fifo(sizeof(q9_all_joins_tuple));
 	packet_t* q9_all_joins_packet =
-			new hash_join_packet_t("lineitem_part_supplier_nation_orders - partsupp HJOIN",
+			create_hash_join_packet("lineitem_part_supplier_nation_orders - partsupp HJOIN",
 					q9_all_joins_buffer,
 					new trivial_filter_t(sizeof(q9_all_joins_tuple)),
 					q9_l_p_s_n_join_o_packet,
@@ -111,7 +111,7 @@ public:
         _prord->get_value(1,  _orders.O_CUSTKEY);
         _prord->get_value(2,  _orders.O_ORDERSTATUS);
         _prord->get_value(3,  _orders.O_TOTALPRICE);
-        _prord->get_value(4,  _orders.O_ORDERDATE,15);
+        _prord->get_value(4,  _orders.O_ORDERDATE);
         _prord->get_value(5,  _orders.O_ORDERPRIORITY,15);
         _prord->get_value(6,  _orders.O_CLERK,15);
         _prord->get_value(7,  _orders.O_SHIPPRIORITY);
@@ -125,7 +125,7 @@ public:
           TRACE(TRACE_ALWAYS, "%d|\n",
 		dest->O_ORDERKEY);
 
-		/*TRACE(TRACE_RECORD_FLOW, "%d|%d|%c|%lf|%s|%s|%s|%d|%s|\n",
+		/*TRACE(TRACE_RECORD_FLOW, "%d|%d|%c|%lf|%d|%s|%s|%d|%s|\n",
  	  dest->O_ORDERKEY,
  	  dest->O_CUSTKEY,
 	  dest->O_ORDERSTATUS,
@@ -230,7 +230,7 @@ public:
 static const c_str* dump_o_tuple(tuple_t* tup) {
     tpch_orders_tuple *dest;
     dest = aligned_cast<tpch_orders_tuple> (tup->data);
-    return new c_str("%d|%d|%c|%lf|%s|%s|%s|%d|%s|\n",
+    return new c_str("%d|%d|%c|%lf|%d|%s|%s|%d|%s|\n",
 		     dest->O_ORDERKEY,
 		     dest->O_CUSTKEY,
 		     dest->O_ORDERSTATUS,
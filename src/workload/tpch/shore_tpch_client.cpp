@@ -96,6 +96,9 @@ int baseline_tpch_client_t::load_sup_xct(mapSupTrxs& stmap)
     stmap[XCT_TPCH_QPART]          = "TPCH-QPART";
     stmap[XCT_TPCH_QPARTSUPP]      = "TPCH-QPARTSUPP";
 
+    stmap[XCT_TPCH_VEC_Q1]         = "TPCH-VEC-Q1";
+    stmap[XCT_TPCH_VEC_Q6]         = "TPCH-VEC-Q6";
+
 
 
 #ifdef CFG_QPIPE
@@ -169,7 +172,7 @@ w_rc_t baseline_tpch_client_t::submit_one(int xct_type, int xctid)
 //         selid = URand(1,_qf);
 
     // Get one action from the trash stack
-    trx_request_t* arequest = new (_env->_request_pool) trx_request_t;
+    trx_request_t* arequest = _env->_request_pool.borrow();
     tid_t atid;
     arequest->set(NULL,atid,xctid,atrt,xct_type,selid);
 
@@ -178,6 +178,9 @@ void ShoreTPCHEnv::table_creator_t::work()
     _env->_porders_man->register_table_man();
     _env->_plineitem_man->register_table_man();
 
+    // In bulk loading mode also the baseline goes only to the heap files
+    if (_env->is_bulkload_enabled()) _env->bulkload_begin();
+
 
     // Do the baseline transaction
     populate_baseline_input_t in = {_sf, _loader_count, DIVISOR, 
@@ -541,6 +544,15 @@ w_rc_t ShoreTPCHEnv::loaddata()
 	loaders[i]->join();
     }
 
+    if (is_bulkload_enabled()) {
+        w_rc_t e = bulkload_end();
+        if (e.is_error()) {
+            _loaded = true;
+            chk->join();
+            return (e);
+        }
+    }
+
     time_t tstop = time(NULL);
 
     // 5. Print stats
@@ -284,18 +284,14 @@ w_rc_t orders_man_impl::o_get_range_iter_by_index(ss_m* db,
 	index_desc_t* pindex = _ptable->find_index("O_IDX_ORDERDATE");
 	assert (pindex);
 
-	/* get the lowest key value */
-	char low_date[15];
-	timet_to_str(low_date, low_o_orderdate);
-	ptuple->set_value(4, low_date);
+	/* get the lowest key value (day number) */
+	ptuple->set_value(4, timet_to_daynum(low_o_orderdate));
 
 	int lowsz = format_key(pindex, ptuple, replow);
 	assert (replow._dest);
 
-	/* get the highest key value */
-	char high_date[15];
-	timet_to_str(high_date, high_o_orderdate+1);
-	ptuple->set_value(4, high_date);
+	/* get the highest key value, the day after (high_o_orderdate) */
+	ptuple->set_value(4, timet_to_daynum(high_o_orderdate)+1);
 
 	int highsz = format_key(pindex, ptuple, rephigh);
 	assert (rephigh._dest);
@@ -330,18 +326,14 @@ w_rc_t lineitem_man_impl::l_get_range_iter_by_receiptdate_index(ss_m* db,
     index_desc_t* pindex = _ptable->find_index("L_IDX_RECEIPTDATE");
     assert (pindex);
 
-    /* get the lowest key value */
-    char lowdate[15];
-    timet_to_str(lowdate, low_l_receiptdate);
-    ptuple->set_value(12, lowdate);
+    /* get the lowest key value (day number) */
+    ptuple->set_value(12, timet_to_daynum(low_l_receiptdate));
 
     int lowsz = format_key(pindex, ptuple, replow);
     assert (replow._dest);
 
-    /* get the highest key value */
-    char highdate[15];
-    timet_to_str(highdate, high_l_receiptdate+1);
-    ptuple->set_value(12,highdate );
+    /* get the highest key value, the day after (high_l_receiptdate) */
+    ptuple->set_value(12, timet_to_daynum(high_l_receiptdate)+1);
 
     int highsz = format_key(pindex, ptuple, rephigh);
     assert (rephigh._dest);
@@ -371,18 +363,14 @@ w_rc_t lineitem_man_impl::l_get_range_iter_by_index(ss_m* db,
     index_desc_t* pindex = _ptable->find_index("L_IDX_SHIPDATE");
     assert (pindex);
  
-    /* get the lowest key value */
-    char lowdate[15];
-    timet_to_str(lowdate, low_l_shipdate);
-    ptuple->set_value(10, lowdate);
+    /* get the lowest key value (day number) */
+    ptuple->set_value(10, timet_to_daynum(low_l_shipdate));
 
     int lowsz = format_key(pindex, ptuple, replow);
     assert (replow._dest);
 
-    /* get the highest key value */
-    char highdate[15];
-    timet_to_str(highdate, high_l_shipdate+1);
-    ptuple->set_value(10, highdate);
+    /* get the highest key value, the day after (high_l_shipdate) */
+    ptuple->set_value(10, timet_to_daynum(high_l_shipdate)+1);
 
     int highsz = format_key(pindex, ptuple, rephigh);
     assert (rephigh._dest);
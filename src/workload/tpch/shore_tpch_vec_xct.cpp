@@ -0,0 +1,244 @@
+/* -*- mode:C++; c-basic-offset:4 -*-
+     Shore-kits -- Benchmark implementations for Shore-MT
+
+                       Copyright (c) 2007-2009
+      Data Intensive Applications and Systems Labaratory (DIAS)
+               Ecole Polytechnique Federale de Lausanne
+
+                         All Rights Reserved.
+
+   Permission to use, copy, modify and distribute this software and
+   its documentation is hereby granted, provided that both the
+   copyright notice and this permission notice appear in all copies of
+   the software, derivative works or modified versions, and any
+   portions thereof, and that both notices appear in supporting
+   documentation.
+
+   This code is distributed in the hope that it will be useful, but
+   WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. THE AUTHORS
+   DISCLAIM ANY LIABILITY OF ANY KIND FOR ANY DAMAGES WHATSOEVER
+   RESULTING FROM THE USE OF THIS SOFTWARE.
+*/
+
+/** @file:   shore_tpch_vec_xct.cpp
+ *
+ *  @brief:  Vectorized (column-at-a-time) implementations of TPC-H
+ *           Q1 and Q6
+ *
+ *  @note:   The lineitem heap file is read through a column_scan_t,
+ *           which decodes only the referenced fields to batches of
+ *           COLUMN_BATCH_ROWS rows. The filters produce 0/1 masks, and the
+ *           aggregates multiply by the masks, so that the loops have
+ *           no data-dependent branches and can be vectorized by the
+ *           compiler. They run as TPCH-VEC-Q1 and TPCH-VEC-Q6, next
+ *           to the tuple-at-a-time TPCH-Q1 and TPCH-Q6.
+ */
+
+#include "workload/tpch/shore_tpch_env.h"
+#include "sm/shore/shore_column_scan.h"
+
+using namespace shore;
+
+
+ENTER_NAMESPACE(tpch);
+
+
+/********************************************************************
+ *
+ * TPC-H VECTORIZED TRXs Wrappers
+ *
+ * @note: They share the inputs and the statistics of the
+ *        tuple-at-a-time queries
+ *
+ ********************************************************************/
+
+DEFINE_TRX_IMPL(ShoreTPCHEnv,q1,vec_q1);
+DEFINE_TRX_IMPL(ShoreTPCHEnv,q6,vec_q6);
+
+
+
+/********************************************************************
+ *
+ * TPC-H VEC-Q1
+ *
+ * @note: The (L_RETURNFLAG,L_LINESTATUS) domain is tiny, so the groups
+ *        are kept in a dense array. Each distinct flag and status get
+ *        a small id the first time they are seen.
+ *
+ ********************************************************************/
+
+const int VEC_Q1_MAX_FLAGS  = 4;
+const int VEC_Q1_MAX_STATUS = 4;
+const int VEC_Q1_GROUPS     = VEC_Q1_MAX_FLAGS*VEC_Q1_MAX_STATUS;
+
+struct vec_q1_group_t
+{
+    double sum_qty;
+    double sum_base_price;
+    double sum_disc_price;
+    double sum_charge;
+    double sum_discount;
+    double count;
+};
+
+w_rc_t ShoreTPCHEnv::xct_vec_q1(const int /* xct_id */, q1_input_t& pq1in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // l_quantity = 4, l_extendedprice = 5, l_discount = 6, l_tax = 7
+    // l_returnflag = 8, l_linestatus = 9, l_shipdate = 10
+    const uint_t fields[] = { 4, 5, 6, 7, 8, 9, 10 };
+    column_scan_t scan(_pssm, _plineitem_desc.get(), fields, 7);
+
+    const int cutoff = timet_to_daynum(pq1in.l_shipdate);
+
+    // group ids
+    int flag_id[256];
+    int status_id[256];
+    for (int i=0; i<256; i++) { flag_id[i] = -1; status_id[i] = -1; }
+    int nflags = 0;
+    int nstatus = 0;
+
+    vec_q1_group_t groups[VEC_Q1_GROUPS];
+    memset(groups, 0, sizeof(groups));
+
+    int gids[COLUMN_BATCH_ROWS];
+    double mask[COLUMN_BATCH_ROWS];
+
+    uint_t rows = 0;
+    bool eof = false;
+    W_DO(scan.next_batch(rows, eof));
+    while (!eof) {
+        const double* qty   = scan.column<double>(0);
+        const double* price = scan.column<double>(1);
+        const double* disc  = scan.column<double>(2);
+        const double* tax   = scan.column<double>(3);
+        const unsigned char* rf = scan.column<unsigned char>(4);
+        const unsigned char* ls = scan.column<unsigned char>(5);
+        const int* dates    = scan.column<int>(6);
+
+        // filter: l_shipdate <= cutoff
+        for (uint_t i=0; i<rows; i++) {
+            mask[i] = (dates[i] <= cutoff);
+        }
+
+        // group ids
+        for (uint_t i=0; i<rows; i++) {
+            if (flag_id[rf[i]] < 0) {
+                if (nflags == VEC_Q1_MAX_FLAGS) return (RC(se_WRONG_DISK_DATA));
+                flag_id[rf[i]] = nflags++;
+            }
+            if (status_id[ls[i]] < 0) {
+                if (nstatus == VEC_Q1_MAX_STATUS) return (RC(se_WRONG_DISK_DATA));
+                status_id[ls[i]] = nstatus++;
+            }
+            gids[i] = flag_id[rf[i]]*VEC_Q1_MAX_STATUS + status_id[ls[i]];
+        }
+
+        // aggregate
+        for (uint_t i=0; i<rows; i++) {
+            vec_q1_group_t& g = groups[gids[i]];
+            double m = mask[i];
+            double disc_price = price[i] * (1-disc[i]);
+            g.sum_qty        += m * qty[i];
+            g.sum_base_price += m * price[i];
+            g.sum_disc_price += m * disc_price;
+            g.sum_charge     += m * disc_price * (1+tax[i]);
+            g.sum_discount   += m * disc[i];
+            g.count          += m;
+        }
+
+        W_DO(scan.next_batch(rows, eof));
+    }
+
+    // output in (l_returnflag,l_linestatus) order
+    for (int f=0; f<256; f++) {
+        if (flag_id[f] < 0) continue;
+        for (int s=0; s<256; s++) {
+            if (status_id[s] < 0) continue;
+            vec_q1_group_t& g = groups[flag_id[f]*VEC_Q1_MAX_STATUS + status_id[s]];
+            if (g.count == 0) continue;
+
+            TRACE( TRACE_QUERY_RESULTS, "%d|%d|%.0f|%.2f|%.2f|%.2f|%.2f|%.2f|%.2f|%.0f\n",
+                   f, s,
+                   g.sum_qty,
+                   g.sum_base_price,
+                   g.sum_disc_price,
+                   g.sum_charge,
+                   g.sum_qty / g.count,
+                   g.sum_base_price / g.count,
+                   g.sum_discount / g.count,
+                   g.count);
+        }
+    }
+
+    return (RCOK);
+
+}; // EOF: VEC-Q1
+
+
+
+/********************************************************************
+ *
+ * TPC-H VEC-Q6
+ *
+ * @note: Unlike TPCH-Q6, which probes the L_SHIPDATE index, it scans
+ *        the whole lineitem file and filters on the date as well.
+ *
+ ********************************************************************/
+
+w_rc_t ShoreTPCHEnv::xct_vec_q6(const int /* xct_id */, q6_input_t& pq6in)
+{
+    // ensure a valid environment
+    assert (_pssm);
+    assert (_initialized);
+    assert (_loaded);
+
+    // l_quantity = 4, l_extendedprice = 5, l_discount = 6, l_shipdate = 10
+    const uint_t fields[] = { 4, 5, 6, 10 };
+    column_scan_t scan(_pssm, _plineitem_desc.get(), fields, 4);
+
+    // [DATE], [DATE] + interval '1' year
+    const int low_date = timet_to_daynum(pq6in.l_shipdate);
+    const int high_date = timet_to_daynum(time_add_year(pq6in.l_shipdate, 1));
+    const double low_disc = pq6in.l_discount - 0.01;
+    const double high_disc = pq6in.l_discount + 0.01;
+    const double max_qty = pq6in.l_quantity;
+
+    double mask[COLUMN_BATCH_ROWS];
+    double q6_result = 0;
+
+    uint_t rows = 0;
+    bool eof = false;
+    W_DO(scan.next_batch(rows, eof));
+    while (!eof) {
+        const double* qty   = scan.column<double>(0);
+        const double* price = scan.column<double>(1);
+        const double* disc  = scan.column<double>(2);
+        const int* dates    = scan.column<int>(3);
+
+        for (uint_t i=0; i<rows; i++) {
+            mask[i] = ((dates[i] >= low_date) & (dates[i] < high_date) &
+                       (disc[i] > low_disc) & (disc[i] < high_disc) &
+                       (qty[i] < max_qty));
+        }
+
+        for (uint_t i=0; i<rows; i++) {
+            q6_result += mask[i] * price[i] * disc[i];
+        }
+
+        W_DO(scan.next_batch(rows, eof));
+    }
+
+    TRACE( TRACE_QUERY_RESULTS, "%.2f\n", q6_result);
+
+    return (RCOK);
+
+}; // EOF: VEC-Q6
+
+
+EXIT_NAMESPACE(tpch);
@@ -34,6 +34,8 @@
 #include "workload/tpch/tpch_struct.h"
 #include "workload/tpch/tpch_util.h"
 
+#include "util/query_hash.h"
+
 #include <vector>
 #include <map>
 #include <set>
@@ -112,6 +114,7 @@ void ShoreTPCHEnv::reset_stats()
 {
     CRITICAL_SECTION(last_stats_cs, _last_stats_mutex);
     _last_stats = _get_stats();
+    qpipe::tscan_stage_t::clear_stats();
 }
 
 
@@ -159,6 +162,9 @@ void ShoreTPCHEnv::print_throughput(const double iQueriedSF,
            delay, mioch/delay, avgcpuusage, 
            100*avgcpuusage/get_max_cpu_count(),
            (trxs_att-trxs_abt-trxs_dld)/delay);
+
+    // pages saved by the shared scans of the QPipe queries
+    qpipe::tscan_stage_t::trace_stats();
 }
 
 
@@ -403,7 +409,7 @@ w_rc_t ShoreTPCHEnv::_gen_one_cust_based(const int id, rep_row_t& areprow)
 	pror->set_value(1, (int)ao.custkey);
 	pror->set_value(2, ao.orderstatus);
 	pror->set_value(3, (double)ao.totalprice);
-	pror->set_value(4, ao.odate);
+	pror->set_value(4, str_to_daynum(ao.odate));
 	pror->set_value(5, ao.opriority);
 	pror->set_value(6, ao.clerk);
 	pror->set_value(7, (int)ao.spriority);
@@ -434,9 +440,9 @@ w_rc_t ShoreTPCHEnv::_gen_one_cust_based(const int id, rep_row_t& areprow)
 	    prli->set_value(7, (double)ao.l[j].tax);
 	    prli->set_value(8, ao.l[j].rflag);
 	    prli->set_value(9, ao.l[j].lstatus);
-	    prli->set_value(10, ao.l[j].cdate);
-	    prli->set_value(11, ao.l[j].sdate);
-	    prli->set_value(12, ao.l[j].rdate);
+	    prli->set_value(10, str_to_daynum(ao.l[j].sdate));
+	    prli->set_value(11, str_to_daynum(ao.l[j].cdate));
+	    prli->set_value(12, str_to_daynum(ao.l[j].rdate));
 	    prli->set_value(13, ao.l[j].shipinstruct);
 	    prli->set_value(14, ao.l[j].shipmode);
 	    prli->set_value(15, ao.l[j].comment);
@@ -727,6 +733,13 @@ w_rc_t ShoreTPCHEnv::run_one_xct(Request* prequest)
     case XCT_TPCH_QPARTSUPP:
 	return (run_qpartsupp(prequest));
 
+        // TPC-H VECTORIZED
+    case XCT_TPCH_VEC_Q1:
+        return (run_vec_q1(prequest));
+
+    case XCT_TPCH_VEC_Q6:
+        return (run_vec_q6(prequest));
+
     default:
         //assert (0); // UNKNOWN TRX-ID
         TRACE( TRACE_ALWAYS, "Unknown transaction\n");
@@ -839,6 +852,23 @@ w_rc_t ShoreTPCHEnv::xct_qpartsupp(const int /* xct_id */, qpartsupp_input_t&)
 
 
 
+/******************************************************************** 
+ *
+ * @fn:    sf_card()
+ *
+ * @brief: The cardinality of a table at the scaling factor, to size the
+ *         hash and dense tables of the queries
+ *
+ ********************************************************************/
+
+static int sf_card(const double sf, const int card)
+{
+    int n = (int)(sf*card);
+    return ((n < 1) ? 1 : n);
+}
+
+
+
 /******************************************************************** 
  *
  * TPC-H Q1
@@ -1001,6 +1031,7 @@ w_rc_t ShoreTPCHEnv::xct_q1(const int /* xct_id */, q1_input_t& pq1in)
     map<q1_group_by_key_t, q1_group_by_value_t, q1_group_by_comp> q1_result;
     map<q1_group_by_key_t, q1_group_by_value_t>::iterator it;
     vector<q1_output_ele_t> q1_output;
+    const int last_shipdate = timet_to_daynum(pq1in.l_shipdate);
     
     /*
       l_returnflag = 8 l_linestatus = 9 l_quantity = 4
@@ -1025,11 +1056,9 @@ w_rc_t ShoreTPCHEnv::xct_q1(const int /* xct_id */, q1_input_t& pq1in)
 	prlineitem->get_value(7, aline.L_TAX);
 	prlineitem->get_value(8, aline.L_RETURNFLAG);
 	prlineitem->get_value(9, aline.L_LINESTATUS);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);
+	prlineitem->get_value(10, aline.L_SHIPDATE);
 	
-	time_t the_shipdate = str_to_timet(aline.L_SHIPDATE);
-	
-	if (the_shipdate <= pq1in.l_shipdate) {
+	if (aline.L_SHIPDATE <= last_shipdate) {
 	    q1_group_by_key_t key(aline.L_RETURNFLAG, aline.L_LINESTATUS);
 	    
 	    value.sum_qty = aline.L_QUANTITY;
@@ -1091,6 +1120,16 @@ w_rc_t ShoreTPCHEnv::xct_q1(const int /* xct_id */, q1_input_t& pq1in)
  *
  ********************************************************************/
 
+// the min supply cost of a part, and the suppliers that offer it
+struct q2_min_supp_t
+{
+    decimal _cost;
+    arena_list_t<int> _supps;
+
+    q2_min_supp_t() : _cost(-1) { }
+};
+
+
 w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 {
     // ensure a valid environment
@@ -1098,8 +1137,11 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //table scan part    
-    map<int, pair< decimal, vector<int>* > > minlist;
+    dense_map_t<q2_min_supp_t> minlist(arena, 1, sf_card(sf,PARTS));
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
     
@@ -1130,17 +1172,13 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 	types3_to_str(types3, q2in.p_types3);
 	    
 	if( size == q2in.p_size && strstr(apart.P_TYPE, types3) != NULL){
-	    vector<int>* v = new vector<int>();
-	    minlist.insert(pair<int,
-			   pair< decimal,vector<int>* > >(apart.P_PARTKEY,
-							  pair<decimal,
-							  vector<int>* >(-1, v)));
+	    minlist.get(apart.P_PARTKEY);
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
 
     // table scan nation
-    map<int,bool> nationK;
+    dense_map_t<bool> nationK(arena, 0, NATIONS-1);
 
     tuple_guard<nation_man_impl> prnation(_pnation_man);
 
@@ -1164,13 +1202,13 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 	prnation->get_value(0, anation.N_NATIONKEY);
 	prnation->get_value(2, anation.N_REGIONKEY);
 	if( anation.N_REGIONKEY == q2in.r_name ) {
-	    nationK.insert(pair<int,bool> (anation.N_NATIONKEY,0));
+	    nationK.insert(anation.N_NATIONKEY, true);
 	}
 	W_DO(n_iter->next(_pssm, eof, *prnation));
     }
     
     //table scan supplier
-    map<int, bool> suppK;
+    dense_map_t<bool> suppK(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -1193,8 +1231,8 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
     while(!eof){
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);	
-	if( nationK.find(asupplier.S_NATIONKEY) != nationK.end()){
-	    suppK.insert(pair<int,bool>(asupplier.S_SUPPKEY, true));
+	if( nationK.contains(asupplier.S_NATIONKEY) ){
+	    suppK.insert(asupplier.S_SUPPKEY, true);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
@@ -1223,20 +1261,16 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
 	prpartsupp->get_value(3, apartsupp.PS_SUPPLYCOST);
 	
-	map<int, pair< decimal, vector<int>* > >::iterator pit =  minlist.find
-	    (apartsupp.PS_PARTKEY);	
-	map<int,bool>::iterator sit = suppK.find(apartsupp.PS_SUPPKEY);
-	
-	if( pit != minlist.end() && sit != suppK.end() ){		
-	    if( pit->second.first > apartsupp.PS_SUPPLYCOST ||
-		pit->second.first == -1){
-		minlist.insert(pair<int, pair< decimal, vector<int>* > >
-			       (apartsupp.PS_PARTKEY,pair< decimal, vector<int>* >
-				(apartsupp.PS_SUPPLYCOST, new vector<int>()) ));
+	q2_min_supp_t* pmin = minlist.find(apartsupp.PS_PARTKEY);
+
+	if( pmin != NULL && suppK.contains(apartsupp.PS_SUPPKEY) ){
+	    if( pmin->_cost > apartsupp.PS_SUPPLYCOST ||
+		pmin->_cost == -1){
+		pmin->_cost = apartsupp.PS_SUPPLYCOST;
+		pmin->_supps.clear();
 	    }
-	    //problem with decimal datatype
-	    if( pit->second.first == apartsupp.PS_SUPPLYCOST){ 		    
-		pit->second.second->push_back(apartsupp.PS_SUPPKEY);
+	    if( pmin->_cost == apartsupp.PS_SUPPLYCOST){
+		pmin->_supps.push(arena, apartsupp.PS_SUPPKEY);
 	    }
 	}
 	W_DO(ps_iter->next(_pssm, eof, *prpartsupp));
@@ -1256,10 +1290,10 @@ w_rc_t ShoreTPCHEnv::xct_q2(const int /* xct_id */, q2_input_t& q2in)
 struct q3_group_by_key_t 
 {
     int l_orderkey;
-    time_t o_orderdate;
+    int o_orderdate; // day number
     int o_shippriority;
   
-    q3_group_by_key_t(int okey, time_t date, int shpprrty)
+    q3_group_by_key_t(int okey, int date, int shpprrty)
     {
 	l_orderkey = okey;
 	o_orderdate = date;
@@ -1285,28 +1319,31 @@ struct q3_group_by_key_t
 };
 
 
-class q3_group_by_comp {
-public:
+struct q3_group_by_hash {
+    uint32_t operator() (const q3_group_by_key_t& key) const
+    {
+	return (hash_combine(hash_combine(key.l_orderkey, key.o_orderdate),
+			     key.o_shippriority));
+    }
+};
+
+struct q3_group_by_equal {
     bool operator() (
-                     const q3_group_by_key_t& lhs, 
-                     const q3_group_by_key_t& rhs) const
+		     const q3_group_by_key_t& lhs, 
+		     const q3_group_by_key_t& rhs) const
     {
-        return ((lhs.l_orderkey < rhs.l_orderkey) ||
-                ((lhs.l_orderkey == rhs.l_orderkey) &&
-                 (lhs.o_orderdate < rhs.o_orderdate))||
-		(lhs.l_orderkey == rhs.l_orderkey) &&
-                 (lhs.o_orderdate == rhs.o_orderdate) &&
-		(lhs.o_shippriority < rhs.o_shippriority)
-		);
+	return ((lhs.l_orderkey == rhs.l_orderkey) &&
+		(lhs.o_orderdate == rhs.o_orderdate) &&
+		(lhs.o_shippriority == rhs.o_shippriority));
     }
 };
 
 class q3_order_needed_data{
 public:
-    time_t o_orderdate;
+    int o_orderdate; // day number
     int o_shippriority;
 
-    q3_order_needed_data(time_t date, int shpprrty)
+    q3_order_needed_data(int date, int shpprrty)
     {
 	o_orderdate = date;
 	o_shippriority = shpprrty;
@@ -1322,8 +1359,13 @@ w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
     assert (_initialized);
     assert (_loaded);
 
+    const int current_date = timet_to_daynum(q3in.current_date);
+
+    arena_t arena;
+    const double sf = get_sf();
+
     //table scan customer
-    map<int,bool> custkeys;
+    dense_map_t<bool> custkeys(arena, 1, sf_card(sf,CUSTOMERS));
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -1349,14 +1391,15 @@ w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
 	prcustomer->get_value(6, acust.C_MKTSEGMENT, 10);
 	int seg = str_to_segment(acust.C_MKTSEGMENT);
 	if( seg == q3in.c_segment) {
-	    custkeys.insert(pair<int,bool> (acust.C_CUSTKEY, true));
+	    custkeys.insert(acust.C_CUSTKEY, true);
 	}
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
     //table scan orders
     int c =0 ;
-    map<int, q3_order_needed_data> ordersdt;
+    hash_map_t<int, q3_order_needed_data> ordersdt(arena,
+						   sf_card(sf,ORDERS/10));
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -1380,20 +1423,19 @@ w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
 	c++;
 	prorder->get_value(0, anorder.O_ORDERKEY);
 	prorder->get_value(1, anorder.O_CUSTKEY);
-	prorder->get_value(4, anorder.O_ORDERDATE, 15);
+	prorder->get_value(4, anorder.O_ORDERDATE);
 	prorder->get_value(7, anorder.O_SHIPPRIORITY);	
-	time_t the_date = str_to_timet(anorder.O_ORDERDATE);
-	if(custkeys.find(anorder.O_CUSTKEY) != custkeys.end()
-	    && the_date < q3in.current_date) {		
-	    ordersdt.insert(pair<int,q3_order_needed_data>
-			    (anorder.O_ORDERKEY, q3_order_needed_data
-			     (the_date, anorder.O_SHIPPRIORITY)));
+	if(custkeys.contains(anorder.O_CUSTKEY)
+	    && anorder.O_ORDERDATE < current_date) {		
+	    ordersdt.insert(anorder.O_ORDERKEY, q3_order_needed_data
+			    (anorder.O_ORDERDATE, anorder.O_SHIPPRIORITY));
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
     
     //table scan lineitem
-    map<q3_group_by_key_t, double, q3_group_by_comp> shippingQ;
+    hash_map_t<q3_group_by_key_t, double, q3_group_by_hash, q3_group_by_equal>
+	shippingQ(arena, ordersdt.size());
 
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
 
@@ -1415,25 +1457,15 @@ w_rc_t ShoreTPCHEnv::xct_q3(const int /* xct_id */, q3_input_t&  q3in)
     
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);
+	prlineitem->get_value(10, aline.L_SHIPDATE);
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);	
-	time_t the_shipdate = str_to_timet(aline.L_SHIPDATE);	
-	map<int, q3_order_needed_data>::iterator tmp =
-	    ordersdt.find(aline.L_ORDERKEY);
-	if(tmp != ordersdt.end() && the_shipdate > q3in.current_date ){
-	    map<q3_group_by_key_t, double, q3_group_by_comp>::iterator tmp2 = 
-		shippingQ.find(q3_group_by_key_t(aline.L_ORDERKEY,
-						 tmp->second.o_orderdate,
-						 tmp->second.o_shippriority));
-	    double  sum = aline.L_EXTENDEDPRICE * (1-aline.L_DISCOUNT);
-	    if(tmp2 != shippingQ.end()){
-		sum += tmp2->second; 
-	    }
-	    shippingQ.insert(pair<q3_group_by_key_t, double >
-			     (q3_group_by_key_t(aline.L_ORDERKEY,
-						tmp->second.o_orderdate,
-						tmp->second.o_shippriority),sum));
+	q3_order_needed_data* tmp = ordersdt.find(aline.L_ORDERKEY);
+	if(tmp != NULL && aline.L_SHIPDATE > current_date ){
+	    shippingQ.get(q3_group_by_key_t(aline.L_ORDERKEY,
+					    tmp->o_orderdate,
+					    tmp->o_shippriority), 0.0)
+		+= aline.L_EXTENDEDPRICE * (1-aline.L_DISCOUNT);
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
@@ -1462,8 +1494,12 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase one: Index Seek Orders(OrderDate)
-    map<int, int> forder_prio; //filtered order + priority
+    //filtered order + priority, -1 once counted
+    hash_map_t<int, int> forder_prio(arena, sf_card(sf,ORDERS/20));
     
     //we need to touch table orders
     tuple_guard<orders_man_impl> prorders(_porders_man);
@@ -1506,14 +1542,14 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
 	prorders->get_value(0, anorder.O_ORDERKEY);
 	prorders->get_value(5, anorder.O_ORDERPRIORITY, 16);
 	int p = str_to_priority(anorder.O_ORDERPRIORITY);
-	forder_prio.insert(pair<int, int>( anorder.O_ORDERKEY, p));
+	forder_prio.insert(anorder.O_ORDERKEY, p);
 	W_DO(o_iter->next(_pssm, eof, *prorders));
     }
     
     //phase two: file Scan Lineitem
-    map<int,int> priority_count;
+    dense_map_t<int> priority_count(arena, 0, 4);
     for( int i = 0; i < 5; i++) {
-	priority_count.insert(pair<int,int>(i,0));
+	priority_count.insert(i, 0);
     }
 
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
@@ -1537,17 +1573,13 @@ w_rc_t ShoreTPCHEnv::xct_q4(const int /* xct_id */, q4_input_t&  in)
     
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
-	prlineitem->get_value(11, aline.L_COMMITDATE, 15);
-	prlineitem->get_value(12, aline.L_RECEIPTDATE, 15);	
-	time_t the_commitdate = str_to_timet(aline.L_COMMITDATE);
-	time_t the_receiptdate = str_to_timet(aline.L_RECEIPTDATE);	
-	map<int,int>::iterator tmp;	
-	if((tmp = forder_prio.find(aline.L_ORDERKEY)) != forder_prio.end() &&
-	   the_commitdate < the_receiptdate){
-	    int c =priority_count.find(tmp->second)->second;
-	    c++;
-	    priority_count[tmp->second] = c;
-	    forder_prio.erase( tmp);
+	prlineitem->get_value(11, aline.L_COMMITDATE);
+	prlineitem->get_value(12, aline.L_RECEIPTDATE);	
+	int* prio = forder_prio.find(aline.L_ORDERKEY);
+	if(prio != NULL && *prio >= 0 &&
+	   aline.L_COMMITDATE < aline.L_RECEIPTDATE){
+	    priority_count.get(*prio, 0)++;
+	    *prio = -1;
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
@@ -1570,7 +1602,10 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     assert (_initialized);
     assert (_loaded);
 
-    map<int, double> nation_rev;
+    arena_t arena;
+    const double sf = get_sf();
+
+    dense_map_t<double> nation_rev(arena, 0, NATIONS-1);
 
     tuple_guard<nation_man_impl> prnation(_pnation_man);
 
@@ -1595,13 +1630,13 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
 	prnation->get_value(0, anation.N_NATIONKEY);
 	prnation->get_value(2, anation.N_REGIONKEY);
 	if( anation.N_REGIONKEY == q5in.r_name ) {
-	    nation_rev.insert(pair<int,double> (anation.N_NATIONKEY,0.0));
+	    nation_rev.insert(anation.N_NATIONKEY, 0.0);
 	}
 	W_DO(n_iter->next(_pssm, eof, *prnation));
     }
 
     //table scan customer : c_nationkey in nation_rev    
-    map<int, int> customer_nation;
+    dense_map_t<int> customer_nation(arena, 1, sf_card(sf,CUSTOMERS));
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -1624,15 +1659,14 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     while(!eof){
 	prcustomer->get_value(0, acust.C_CUSTKEY);
 	prcustomer->get_value(3, acust.C_NATIONKEY);
-	if( nation_rev.find(acust.C_NATIONKEY) != nation_rev.end() ){
-	    customer_nation.insert(pair<int,int>(acust.C_CUSTKEY,
-						 acust.C_NATIONKEY));
+	if( nation_rev.contains(acust.C_NATIONKEY) ){
+	    customer_nation.insert(acust.C_CUSTKEY, acust.C_NATIONKEY);
 	}
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
     //index scan on orderdate
-    map<int, int> ordersK_cust;
+    hash_map_t<int, int> ordersK_cust(arena, sf_card(sf,ORDERS/35));
 
     tuple_guard<orders_man_impl> prorders(_porders_man);
 
@@ -1652,6 +1686,8 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     date.tm_year += 1;
 	
     time_t last_orderdate = mktime(&date);
+    const int first_day = timet_to_daynum(q5in.o_orderdate);
+    const int last_day = timet_to_daynum(last_orderdate);
     
     tpch_orders_tuple anorder;
     
@@ -1666,18 +1702,16 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     while(!eof){
 	prorders->get_value(0, anorder.O_ORDERKEY);
 	prorders->get_value(1, anorder.O_CUSTKEY);
-	prorders->get_value(4, anorder.O_ORDERDATE, 15);
-	time_t orderT = str_to_timet(anorder.O_ORDERDATE);
-	if( customer_nation.find(anorder.O_CUSTKEY) != customer_nation.end() &&
-	    (orderT >= q5in.o_orderdate && orderT < last_orderdate)) {
-	    ordersK_cust.insert(pair<int,int> (anorder.O_ORDERKEY,
-					       anorder.O_CUSTKEY));
+	prorders->get_value(4, anorder.O_ORDERDATE);
+	if( customer_nation.contains(anorder.O_CUSTKEY) &&
+	    (anorder.O_ORDERDATE >= first_day && anorder.O_ORDERDATE < last_day)) {
+	    ordersK_cust.insert(anorder.O_ORDERKEY, anorder.O_CUSTKEY);
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorders));
     }
     
     //supplier
-    map<int,int> supp_nation;
+    dense_map_t<int> supp_nation(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -1700,9 +1734,8 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
     while(!eof){
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
-	if(nation_rev.find(asupplier.S_NATIONKEY) != nation_rev.end()){
-	    supp_nation.insert(pair<int,int>
-			       (asupplier.S_SUPPKEY, asupplier.S_NATIONKEY));
+	if(nation_rev.contains(asupplier.S_NATIONKEY)){
+	    supp_nation.insert(asupplier.S_SUPPKEY, asupplier.S_NATIONKEY);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
@@ -1732,17 +1765,12 @@ w_rc_t ShoreTPCHEnv::xct_q5(const int /* xct_id */, q5_input_t& q5in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	double price = ( 1 - aline.L_DISCOUNT)*aline.L_EXTENDEDPRICE;
-	map<int,int>::iterator suppiter = supp_nation.find(aline.L_SUPPKEY);
-	map<int,int>::iterator orderiter = ordersK_cust.find(aline.L_ORDERKEY);
-	if(orderiter != ordersK_cust.end() && suppiter != supp_nation.end()){
-	    map<int,int>::iterator custiter =
-		customer_nation.find(orderiter->second);
-	    if(custiter != customer_nation.end()
-	       && custiter->second == suppiter->second){
-		int nationKey = custiter->second;
-		double c =nation_rev.find(nationKey)->second;
-		c += price;
-		nation_rev[nationKey] = c;
+	int* suppnation = supp_nation.find(aline.L_SUPPKEY);
+	int* custkey = ordersK_cust.find(aline.L_ORDERKEY);
+	if(custkey != NULL && suppnation != NULL){
+	    int* custnation = customer_nation.find(*custkey);
+	    if(custnation != NULL && *custnation == *suppnation){
+		nation_rev.get(*custnation) += price;
 	    }
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
@@ -1820,7 +1848,7 @@ w_rc_t ShoreTPCHEnv::xct_q6(const int /* xct_id */, q6_input_t& pq6in)
 	prlineitem->get_value(4, aline.L_QUANTITY);
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);	
+	prlineitem->get_value(10, aline.L_SHIPDATE);	
 	if ((aline.L_DISCOUNT > pq6in.l_discount - 0.01) &&
 	    (aline.L_DISCOUNT < pq6in.l_discount + 0.01) &&
 	    (aline.L_QUANTITY < pq6in.l_quantity)) {
@@ -1873,18 +1901,22 @@ struct q7_group_by_key_t{
 };
 
 
-class q7_group_by_comp {
-public:
+struct q7_group_by_hash {
+    uint32_t operator() (const q7_group_by_key_t& key) const
+    {
+	return (hash_combine(hash_combine(key.supp_nation, key.cust_nation),
+			     key.l_year));
+    }
+};
+
+struct q7_group_by_equal {
     bool operator() (
-                     const q7_group_by_key_t& lhs, 
-                     const q7_group_by_key_t& rhs) const
+		     const q7_group_by_key_t& lhs, 
+		     const q7_group_by_key_t& rhs) const
     {
-        return (lhs.supp_nation < rhs.supp_nation ||
-		(lhs.supp_nation == rhs.supp_nation &&
-		 lhs.cust_nation < rhs.cust_nation ) ||
-		(lhs.supp_nation == rhs.supp_nation &&
-		 lhs.cust_nation == rhs.cust_nation &&
-		 rhs.l_year < lhs.l_year) );
+	return (lhs.supp_nation == rhs.supp_nation &&
+		lhs.cust_nation == rhs.cust_nation &&
+		lhs.l_year == rhs.l_year);
     }
 };
 
@@ -1895,8 +1927,11 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     // table scan customer c_nationkey = n_name1, n_name2
-    map<int,int> cust_nationK;
+    dense_map_t<int> cust_nationK(arena, 1, sf_card(sf,CUSTOMERS));
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -1921,13 +1956,13 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
 	prcustomer->get_value(0, acust.C_CUSTKEY);
 	prcustomer->get_value(3, acust.C_NATIONKEY);
 	if(acust.C_NATIONKEY == q7in.n_name1||acust.C_NATIONKEY == q7in.n_name2) {
-	    cust_nationK.insert(pair<int,int>(acust.C_CUSTKEY,acust.C_NATIONKEY));
+	    cust_nationK.insert(acust.C_CUSTKEY, acust.C_NATIONKEY);
 	}
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
     //table scan order o_customerkey in customer_nationK
-    map<int,int> orderk_custk;
+    hash_map_t<int,int> orderk_custk(arena, sf_card(sf,2*ORDERS/NATIONS));
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -1950,15 +1985,14 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
     while(!eof){
 	prorder->get_value(0, anorder.O_ORDERKEY);
 	prorder->get_value(1, anorder.O_CUSTKEY);
-	if( cust_nationK.find(anorder.O_CUSTKEY) != cust_nationK.end()) {
-	    orderk_custk.insert(pair<int,int>(anorder.O_ORDERKEY,
-					      anorder.O_CUSTKEY));
+	if( cust_nationK.contains(anorder.O_CUSTKEY) ) {
+	    orderk_custk.insert(anorder.O_ORDERKEY, anorder.O_CUSTKEY);
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
 
     //table scan supplier : s_nationkey = n_name1 s_nationkey = n_name2
-    map<int,int> supp_nationk;
+    dense_map_t<int> supp_nationk(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -1983,14 +2017,15 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
 	if( asupplier.S_NATIONKEY == q7in.n_name1 ||
 	    asupplier.S_NATIONKEY == q7in.n_name2) {
-	    supp_nationk.insert(pair<int,int>
-				(asupplier.S_SUPPKEY, asupplier.S_NATIONKEY));
+	    supp_nationk.insert(asupplier.S_SUPPKEY, asupplier.S_NATIONKEY);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
 
     //table scan lineitem
-    map<q7_group_by_key_t, double, q7_group_by_comp> vol_shipping;
+    // two nations each way, two years
+    hash_map_t<q7_group_by_key_t, double, q7_group_by_hash, q7_group_by_equal>
+	vol_shipping(arena, 8);
 
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
 
@@ -2027,43 +2062,23 @@ w_rc_t ShoreTPCHEnv::xct_q7(const int /* xct_id */, q7_input_t&  q7in )
 	prlineitem->get_value(2, aline.L_SUPPKEY);
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
-	prlineitem->get_value(10, aline.L_SHIPDATE, 15);
+	prlineitem->get_value(10, aline.L_SHIPDATE);
 	    
-	time_t shipdate = str_to_timet(aline.L_SHIPDATE);
-	struct tm date = (*localtime(&shipdate));
+	// years since 1900, as in struct tm
+	const int year = daynum_year(aline.L_SHIPDATE) - 1900;
 	double price = aline.L_EXTENDEDPRICE*(1- aline.L_DISCOUNT);
 
-	map<int,int>:: iterator order = orderk_custk.find(aline.L_ORDERKEY);
-	map<int,int>:: iterator supp = supp_nationk.find(aline.L_SUPPKEY);
-	map<int,int>:: iterator cust;
-	
-	if(order != orderk_custk.end() && supp != supp_nationk.end() &&
-	   date.tm_year <= 96 && date.tm_year >= 95){
-	    
-	    cust = cust_nationK.find(order->second);
-
-	    if(cust != cust_nationK.end()){
-		if(cust->second != supp->second){
-		    map<q7_group_by_key_t, double, q7_group_by_comp>::iterator it=
-			vol_shipping.find(q7_group_by_key_t(supp->second,
-							    cust->second,
-							    date.tm_year));
-		    if( it != vol_shipping.end()){
-			double c = it->second;
-			c +=  price;
-			vol_shipping.insert(pair<q7_group_by_key_t,
-					    double>
-					    (q7_group_by_key_t(supp->second,
-							       cust->second,
-							       date.tm_year), c));
-		    } else {
-			vol_shipping.insert(pair<q7_group_by_key_t, double>
-					    (q7_group_by_key_t(supp->second,
-							       cust->second,
-							       date.tm_year),
-					     price));
-		    }
-		} 
+	int* order = orderk_custk.find(aline.L_ORDERKEY);
+	int* supp = supp_nationk.find(aline.L_SUPPKEY);
+
+	if(order != NULL && supp != NULL &&
+	   year <= 96 && year >= 95){
+
+	    int* cust = cust_nationK.find(*order);
+
+	    if(cust != NULL && *cust != *supp){
+		vol_shipping.get(q7_group_by_key_t(*supp, *cust, year), 0.0)
+		    += price;
 	    }
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
@@ -2113,9 +2128,12 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //retrive r_key of q8in.n_name
     int r_key;
-    map<int, bool> nation_k;
+    dense_map_t<bool> nation_k(arena, 0, NATIONS-1);
 
     tuple_guard<nation_man_impl> prnation(_pnation_man);
    
@@ -2145,13 +2163,13 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 	prnation->get_value(2, anation.N_REGIONKEY);
 	prnation->get_value(0, anation.N_NATIONKEY);
 	if(anation.N_REGIONKEY == r_key) {
-	    nation_k.insert(pair<int,bool>(anation.N_NATIONKEY, true));
+	    nation_k.insert(anation.N_NATIONKEY, true);
 	}
 	W_DO(n_iter->next(_pssm, eof, *prnation));
     }
 
     //file scan part
-    map<int, bool> p_keys;
+    dense_map_t<bool> p_keys(arena, 1, sf_card(sf,PARTS));
     char p_type[26];    
     type_to_str(q8in.p_type, p_type);
 
@@ -2177,13 +2195,13 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 	prpart->get_value(4, apart.P_TYPE, 25);
 	prpart->get_value(0, apart.P_PARTKEY);
 	if( strcmp(apart.P_TYPE, p_type ) == 0  ){
-	    p_keys.insert(pair<int,bool> (apart.P_PARTKEY, true));
+	    p_keys.insert(apart.P_PARTKEY, true);
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
 
     //table scan customer
-    map<int, bool> cust_k;
+    dense_map_t<bool> cust_k(arena, 1, sf_card(sf,CUSTOMERS));
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -2206,15 +2224,16 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
     while(!eof){
 	prcustomer->get_value(0, acust.C_CUSTKEY);
 	prcustomer->get_value(3, acust.C_NATIONKEY);
-	if( nation_k.find(acust.C_NATIONKEY) != nation_k.end()){
-	    cust_k.insert(pair<int,bool>(acust.C_CUSTKEY,true));
+	if( nation_k.contains(acust.C_NATIONKEY) ){
+	    cust_k.insert(acust.C_CUSTKEY, true);
 	}
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
 
     //index scan order
     //we need to touch table orders
-    map<int,int> orders_ky; //orders key and date
+    //orders key and year
+    hash_map_t<int,int> orders_ky(arena, sf_card(sf,ORDERS/20));
 
     tuple_guard<orders_man_impl> prorders(_porders_man);
 
@@ -2249,17 +2268,16 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
     while(!eof){
 	prorders->get_value(0, anorder.O_ORDERKEY);
 	prorders->get_value(1, anorder.O_CUSTKEY);
-	prorders->get_value(4, anorder.O_ORDERDATE, 15);
-	time_t t = str_to_timet(anorder.O_ORDERDATE);
-	struct tm date = *(localtime(&t));
-	if( cust_k.find(anorder.O_CUSTKEY) != cust_k.end()) {
-	    orders_ky.insert(pair<int,int>(anorder.O_ORDERKEY, date.tm_year));
+	prorders->get_value(4, anorder.O_ORDERDATE);
+	if( cust_k.contains(anorder.O_CUSTKEY) ) {
+	    orders_ky.insert(anorder.O_ORDERKEY,
+			     daynum_year(anorder.O_ORDERDATE) - 1900);
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorders));
     }
 
     //supplier
-    map<int,int> supp_nation;
+    dense_map_t<int> supp_nation(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2282,8 +2300,7 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
     while(!eof){
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
-	supp_nation.insert(pair<int,int>(asupplier.S_SUPPKEY,
-					 asupplier.S_NATIONKEY));
+	supp_nation.insert(asupplier.S_SUPPKEY, asupplier.S_NATIONKEY);
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
 
@@ -2315,36 +2332,26 @@ w_rc_t ShoreTPCHEnv::xct_q8(const int /* xct_id */, q8_input_t&  q8in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	double price = (1-aline.L_DISCOUNT)*aline.L_EXTENDEDPRICE;
-	map<int,bool>:: iterator pit = p_keys.find(aline.L_PARTKEY);
-	map<int,int>::iterator oit = orders_ky.find(aline.L_ORDERKEY);
-	if(pit != p_keys.end() && oit != orders_ky.end()) {
+	int* oyear = orders_ky.find(aline.L_ORDERKEY);
+	if(p_keys.contains(aline.L_PARTKEY) && oyear != NULL) {
 	    all_nation.push_back(q8_inner_table(aline.L_SUPPKEY,
-						oit->second, price));
+						*oyear, price));
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
 
     //compute the final result
-    map<int,q8_groupe_by_value_t> mkt_share;
-    map<int,q8_groupe_by_value_t>::iterator it;
-    
-    for(int i = 0; i < all_nation.size(); i++){
-	it = mkt_share.find(all_nation[i].o_year);
-	double a,b;
-	if (it != mkt_share.end()){
-	    a = it->second.a;
-	    b = it->second.b;
-	}else{
-	    a = 0;
-	    b =0;
+    // two years
+    hash_map_t<int,q8_groupe_by_value_t> mkt_share(arena, 2);
+
+    for(uint i = 0; i < all_nation.size(); i++){
+	q8_groupe_by_value_t& share =
+	    mkt_share.get(all_nation[i].o_year, q8_groupe_by_value_t(0,0));
+	int* snation = supp_nation.find(all_nation[i].s_key);
+	if( snation != NULL && *snation == q8in.n_name){
+	    share.a += all_nation[i].price;
 	}
-	if( supp_nation.find(all_nation[i].s_key)->second == q8in.n_name){
-	    a+=all_nation[i].price;
-	}
-	b+=all_nation[i].price;
-	mkt_share.insert(pair<int,q8_groupe_by_value_t>(all_nation[i].o_year,
-							q8_groupe_by_value_t(a,
-									     b)));
+	share.b += all_nation[i].price;
     }
     
     return RCOK;
@@ -2370,14 +2377,19 @@ struct q9_group_by_key_t{
     }
 };
 
-class q9_group_by_comp {
-public:
+struct q9_group_by_hash {
+    uint32_t operator() (const q9_group_by_key_t& key) const
+    {
+	return (hash_combine(key.nation_k, key.year));
+    }
+};
+
+struct q9_group_by_equal {
     bool operator() (
-                     const q9_group_by_key_t& lhs, 
-                     const q9_group_by_key_t& rhs) const
+		     const q9_group_by_key_t& lhs, 
+		     const q9_group_by_key_t& rhs) const
     {
-        return (lhs.nation_k < rhs.nation_k) ||
-	    (lhs.nation_k == rhs.nation_k && lhs.year < rhs.year);
+	return (lhs.nation_k == rhs.nation_k && lhs.year == rhs.year);
     }
 };
 
@@ -2389,8 +2401,11 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //table scan part_t : p_name contains '%color%'
-    map<int, bool> p_keys;
+    dense_map_t<bool> p_keys(arena, 1, sf_card(sf,PARTS));
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -2417,13 +2432,13 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
 	    char part_name[55];
 	    pname_to_str(q9in.p_name, part_name);
 	    if(strstr(apart.P_NAME,part_name) != NULL){
-		p_keys.insert(pair<int,bool> ( apart.P_PARTKEY, 0));
+		p_keys.insert(apart.P_PARTKEY, true);
 	    } 
 	    W_DO(p_iter->next(_pssm, eof, *prpart));
     }
 
     //table scan supplier
-    map<int,int> suppK_nK;
+    dense_map_t<int> suppK_nK(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2446,12 +2461,12 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
     while(!eof){
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
-	suppK_nK.insert(pair<int,int>(asupplier.S_SUPPKEY,asupplier.S_NATIONKEY));
+	suppK_nK.insert(asupplier.S_SUPPKEY, asupplier.S_NATIONKEY);
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
 
     //table scan order
-    map<int,int> orderK_y;
+    hash_map_t<int,int> orderK_y(arena, sf_card(sf,ORDERS));
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
 
@@ -2473,15 +2488,16 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
 
     while(!eof){
 	prorder->get_value(1, anorder.O_ORDERKEY);
-	prorder->get_value(4, anorder.O_ORDERDATE,15);
-	time_t t = str_to_timet(anorder.O_ORDERDATE);
-	struct tm date = *localtime(&t);
-	orderK_y.insert( pair<int,int> (anorder.O_ORDERKEY, date.tm_year));
+	prorder->get_value(4, anorder.O_ORDERDATE);
+	orderK_y.insert(anorder.O_ORDERKEY,
+			daynum_year(anorder.O_ORDERDATE) - 1900);
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
         
     //table scane lineitem
-    map <q9_group_by_key_t, decimal, q9_group_by_comp> profit_m;
+    // nations times seven years
+    hash_map_t<q9_group_by_key_t, decimal, q9_group_by_hash, q9_group_by_equal>
+	profit_m(arena, 7*NATIONS);
 
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
 
@@ -2526,25 +2542,16 @@ w_rc_t ShoreTPCHEnv::xct_q9(const int /* xct_id */, q9_input_t& q9in)
 	decimal price = aline.L_EXTENDEDPRICE * (1 - aline.L_DISCOUNT) -
 	    apartsupp.PS_SUPPLYCOST* aline.L_QUANTITY;
 	
-	if( p_keys.find(aline.L_PARTKEY) != p_keys.end() ){		
-	    map<int,int>::iterator oit = orderK_y.find( aline.L_ORDERKEY);
-	    map<int,int>::iterator sit = suppK_nK.find( aline.L_SUPPKEY);
-	    
-	    if(oit == orderK_y.end() || sit == suppK_nK.end()){
+	if( p_keys.contains(aline.L_PARTKEY) ){		
+	    int* y = orderK_y.find(aline.L_ORDERKEY);
+	    int* nation_k = suppK_nK.find(aline.L_SUPPKEY);
+
+	    if(y == NULL || nation_k == NULL){
 		W_DO(l_iter->next(_pssm, eof, *prlineitem));
 		continue;
 	    }
-	    
-	    int y = oit->second; 
-	    int nation_k = sit->second; 	    
-	    map <q9_group_by_key_t, decimal, q9_group_by_comp>::iterator it =
-		profit_m.find(q9_group_by_key_t(nation_k, y));
-	    decimal c = price;
-	    if( it != profit_m.end()) {
-		c += it->second;
-	    }
-	    profit_m.insert(pair<q9_group_by_key_t, decimal>
-			    (q9_group_by_key_t(nation_k, y) ,c) );
+
+	    profit_m.get(q9_group_by_key_t(*nation_k, *y), decimal(0)) += price;
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
@@ -2585,15 +2592,9 @@ public:
     }
 };
 
-class q10_group_by_key_comp{
-
-public:
-    bool operator() (
-                     const q10_group_by_key_t& lhs, 
-                     const q10_group_by_key_t& rhs) const
-    {
-        return lhs.c_custkey < rhs.c_custkey;
-    }
+struct q10_order_t {
+    int custkey;
+    double revenue;
 };
 
 
@@ -2612,12 +2613,14 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	date2.tm_year++;
     }
 
-    time_t t2 = mktime(&date2);
-    time_t t1 = q10in.o_orderdate;
+    const int t2 = timet_to_daynum(mktime(&date2));
+    const int t1 = timet_to_daynum(q10in.o_orderdate);
     
-    // table scan order
-    map<int, vector<int>* > cust_ordersK;
-    map<int, double> orders_price;
+    arena_t arena;
+    const double sf = get_sf();
+
+    // table scan order, three months of orders
+    hash_map_t<int, q10_order_t> orders_price(arena, sf_card(sf,ORDERS/28));
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -2641,19 +2644,10 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
     while(!eof){
 	prorder->get_value(0, anorder.O_ORDERKEY);
 	prorder->get_value(1, anorder.O_CUSTKEY);
-	prorder->get_value(4, anorder.O_ORDERDATE, 15);
-	time_t orderdate = str_to_timet(anorder.O_ORDERDATE);
-	if(orderdate >= t1 && orderdate < t2){
-	    orders_price.insert(pair<int,double>(anorder.O_ORDERKEY, 0.0));
-	    map<int, vector<int>* >::iterator it =
-		cust_ordersK.find(anorder.O_CUSTKEY);
-	    if( it != cust_ordersK.end() ){
-		it->second->push_back(anorder.O_ORDERKEY);
-	    } else {
-		vector<int> * v = new vector<int>();
-		v->push_back(anorder.O_ORDERKEY);
-		cust_ordersK.insert(pair<int, vector<int>*>(anorder.O_CUSTKEY,v));
-	    }
+	prorder->get_value(4, anorder.O_ORDERDATE);
+	if(anorder.O_ORDERDATE >= t1 && anorder.O_ORDERDATE < t2){
+	    q10_order_t o = { anorder.O_CUSTKEY, 0.0 };
+	    orders_price.insert(anorder.O_ORDERKEY, o);
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
@@ -2683,11 +2677,9 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	double price =  (1 - aline.L_DISCOUNT) * aline.L_EXTENDEDPRICE;
-	map<int,double>::iterator it = orders_price.find(aline.L_ORDERKEY);
-	if(aline.L_RETURNFLAG == 'R' && it != orders_price.end() ){
-	    double c = it->second;
-	    c += price;
-	    orders_price[ aline.L_ORDERKEY ] = c;
+	q10_order_t* o = orders_price.find(aline.L_ORDERKEY);
+	if(aline.L_RETURNFLAG == 'R' && o != NULL ){
+	    o->revenue += price;
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
@@ -2700,20 +2692,21 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 
     prcustomer->_rep = &acreprow;
 
+    // the revenue of each customer with orders in the range
+    dense_map_t<double> cust_rev(arena, 1, sf_card(sf,CUSTOMERS));
+    for(hash_map_t<int, q10_order_t>::iterator it = orders_price.begin();
+	it != orders_price.end(); ++it){
+	cust_rev.get(it.value().custkey, 0.0) += it.value().revenue;
+    }
+
     tpch_customer_tuple acust;
-    map<q10_group_by_key_t, double, q10_group_by_key_comp> customer_rev;
-    map<int, vector<int>* > :: iterator cit = cust_ordersK.begin();
-
-    while( cit != cust_ordersK.end()){
-	vector<int>::iterator oit = cit->second->begin();
-	double rev = 0;
-	while(oit != cit->second->end()){
-	    rev += orders_price.find(*oit)->second;
-	    oit++;
-	}
+    vector< pair<q10_group_by_key_t, double> > customer_rev;
+    customer_rev.reserve(cust_rev.size());
+
+    for(dense_map_t<double>::iterator cit = cust_rev.begin();
+	cit != cust_rev.end(); ++cit){
 	if((_pcustomer_man->c_index_probe(_pssm, prcustomer,
-					  cit->first)).is_error()) {
-	    cit++;
+					  cit.key())).is_error()) {
 	    continue;
 	}
 	prcustomer->get_value(1, acust.C_NAME, 25);
@@ -2722,10 +2715,13 @@ w_rc_t ShoreTPCHEnv::xct_q10(const int /* xct_id */, q10_input_t&  q10in)
 	prcustomer->get_value(4, acust.C_PHONE, 15);
 	prcustomer->get_value(5, acust.C_ACCTBAL);
 	prcustomer->get_value(2, acust.C_COMMENT, 117);
-	customer_rev[q10_group_by_key_t(cit->first, acust.C_NAME, acust.C_ACCTBAL,
-					acust.C_PHONE, acust.C_NATIONKEY,
-					acust.C_ADDRESS, acust.C_COMMENT)] = rev;
-	cit++;
+	customer_rev.push_back(make_pair(q10_group_by_key_t(cit.key(), acust.C_NAME,
+							    acust.C_ACCTBAL,
+							    acust.C_PHONE,
+							    acust.C_NATIONKEY,
+							    acust.C_ADDRESS,
+							    acust.C_COMMENT),
+					 cit.value()));
     }
 
     return RCOK;
@@ -2746,8 +2742,11 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //table scan supplier
-    map<int,bool> suppK;
+    dense_map_t<bool> suppK(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -2772,13 +2771,13 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
 	if( asupplier.S_NATIONKEY == q11in.n_name ) {
-	    suppK.insert(pair<int,bool>(asupplier.S_SUPPKEY,true));
+	    suppK.insert(asupplier.S_SUPPKEY, true);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
     
     //table scan partsupp
-    map<int, decimal> partK_val;
+    dense_map_t<decimal> partK_val(arena, 1, sf_card(sf,PARTS));
     decimal totalval = 0;
 
     tuple_guard<partsupp_man_impl> prpartsupp(_ppartsupp_man);
@@ -2804,14 +2803,10 @@ w_rc_t ShoreTPCHEnv::xct_q11(const int /* xct_id */, q11_input_t& q11in)
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
 	prpartsupp->get_value(2, apartsupp.PS_AVAILQTY);
 	prpartsupp->get_value(3, apartsupp.PS_SUPPLYCOST);
-	if( suppK.find(apartsupp.PS_SUPPKEY) != suppK.end() ){
-	    map<int,decimal>::iterator pit =partK_val.find(apartsupp.PS_PARTKEY);
+	if( suppK.contains(apartsupp.PS_SUPPKEY) ){
 	    decimal c = apartsupp.PS_AVAILQTY * apartsupp.PS_SUPPLYCOST;
 	    totalval += c;
-	    if( pit != partK_val.end()){
-		c += pit->second;
-	    }
-	    partK_val[apartsupp.PS_PARTKEY] = c; 
+	    partK_val.get(apartsupp.PS_PARTKEY, decimal(0)) += c;
 	}
 	W_DO(ps_iter->next(_pssm, eof, *prpartsupp));
     }
@@ -2859,11 +2854,10 @@ w_rc_t ShoreTPCHEnv::xct_q12(const int /* xct_id */, q12_input_t& q12in)
 
     //phase one: indexscan lineitem
    vector<pair<int, int> > orderK_shipmode;
-   map<int, pair<int,int> > shpmd_HLC_LLC; 
-   shpmd_HLC_LLC.insert(pair<int, pair<int,int> >
-			(q12in.l_shipmode1, pair<int,int>(0,0)));
-   shpmd_HLC_LLC.insert(pair<int, pair<int,int> >
-			(q12in.l_shipmode2, pair<int,int>(0,0)));
+   arena_t arena;
+   hash_map_t<int, pair<int,int> > shpmd_HLC_LLC(arena, 2); 
+   shpmd_HLC_LLC.insert(q12in.l_shipmode1, pair<int,int>(0,0));
+   shpmd_HLC_LLC.insert(q12in.l_shipmode2, pair<int,int>(0,0));
 
    tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
 
@@ -2903,16 +2897,14 @@ w_rc_t ShoreTPCHEnv::xct_q12(const int /* xct_id */, q12_input_t& q12in)
 
    while(!eof){
        prlineitem->get_value(0, aline.L_ORDERKEY);
-       prlineitem->get_value(10, aline.L_SHIPDATE, 15);
-       prlineitem->get_value(11, aline.L_COMMITDATE, 15);
-       prlineitem->get_value(12, aline.L_RECEIPTDATE, 15);
+       prlineitem->get_value(10, aline.L_SHIPDATE);
+       prlineitem->get_value(11, aline.L_COMMITDATE);
+       prlineitem->get_value(12, aline.L_RECEIPTDATE);
        prlineitem->get_value(14, aline.L_SHIPMODE, 10);
-       time_t shipdate = str_to_timet(aline.L_SHIPDATE);
-       time_t commitdate = str_to_timet(aline.L_COMMITDATE);	
-       time_t receiptdate = str_to_timet(aline.L_RECEIPTDATE);
        int shipmode = str_to_shipmode(aline.L_SHIPMODE);
        if(shipmode == q12in.l_shipmode1 || shipmode == q12in.l_shipmode2) {
-	   if(commitdate < receiptdate && shipdate < commitdate) {
+	   if(aline.L_COMMITDATE < aline.L_RECEIPTDATE &&
+	      aline.L_SHIPDATE < aline.L_COMMITDATE) {
 	       orderK_shipmode.push_back(pair<int,int>(aline.L_ORDERKEY,
 						       shipmode));
 	   }
@@ -2953,13 +2945,12 @@ w_rc_t ShoreTPCHEnv::xct_q12(const int /* xct_id */, q12_input_t& q12in)
        char priority[15];
        prorder->get_value(5, priority, 15);
        
-       int hlc = shpmd_HLC_LLC[iter->second].first;
-       int llc = shpmd_HLC_LLC[iter->second].second;
-       
+       pair<int,int>& hlc_llc = shpmd_HLC_LLC.get(iter->second);
+
        if(strcmp(priority,"2-HIGH") == 0 or strcmp(priority,"1-URGENT") ==0){
-	   shpmd_HLC_LLC[iter->second] = pair<int,int>( hlc+1, llc);
+	   hlc_llc.first++;
        } else {
-	   shpmd_HLC_LLC[iter->second] = pair<int,int>( hlc, llc+1);
+	   hlc_llc.second++;
        }
    }
 
@@ -3000,8 +2991,11 @@ w_rc_t ShoreTPCHEnv::xct_q13(const int /* xct_id */, q13_input_t& /* in */)
 	custdist desc,
 	c_count desc;*/
     
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase 1: list of c_custkey
-    map<int,int> c_orders;
+    dense_map_t<int> c_orders(arena, 1, sf_card(sf,CUSTOMERS));
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
 
@@ -3025,7 +3019,7 @@ w_rc_t ShoreTPCHEnv::xct_q13(const int /* xct_id */, q13_input_t& /* in */)
 
     while(!eof){
 	prcustomer->get_value(0, acust.C_CUSTKEY);
-	c_orders[ acust.C_CUSTKEY ] = 0;
+	c_orders.insert(acust.C_CUSTKEY, 0);
 	W_DO(c_iter->next(_pssm, eof, *prcustomer));
     }
     
@@ -3050,26 +3044,18 @@ w_rc_t ShoreTPCHEnv::xct_q13(const int /* xct_id */, q13_input_t& /* in */)
 
     while(!eof){
 	prorder->get_value(1, aorder.O_CUSTKEY);
-	int n = c_orders[ aorder.O_CUSTKEY ];
-	n++;
-	c_orders[ aorder.O_CUSTKEY ] = n;
+	c_orders.get(aorder.O_CUSTKEY, 0)++;
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
     
     //phase 3: compute scalar
-    map<int, int> o_count_cust;
+    // a customer has a few tens of orders at most
+    dense_map_t<int> o_count_cust(arena, 0, 63);
 
-    for(map<int,int>::iterator iter = c_orders.begin();
+    for(dense_map_t<int>::iterator iter = c_orders.begin();
 	iter != c_orders.end();
-	iter++){
-	map<int,int>::iterator tmp = o_count_cust.find(iter->second);
-	if(tmp != o_count_cust.end()){
-	    int c = tmp->second;
-	    c++;
-	    o_count_cust[iter->second] = c;
-	} else {
-	    o_count_cust[iter->second] = 1;
-	}
+	++iter){
+	o_count_cust.get(iter.value(), 0)++;
     }
 
     return RCOK;
@@ -3090,7 +3076,11 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
     assert (_initialized);
     assert (_loaded);
 
-    map<int, vector<float>* > pKey_prices;
+    arena_t arena;
+    const double sf = get_sf();
+
+    // the revenue of each part shipped in the month
+    dense_map_t<double> pKey_prices(arena, 1, sf_card(sf,PARTS));
     double totalrevenue = 0;    
 
     //phase 1: index seek: lineitem
@@ -3138,15 +3128,7 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	float theprice = aline.L_EXTENDEDPRICE *(1 - aline.L_DISCOUNT);
-	map<int, vector<float>*>::iterator pvector =
-	    pKey_prices.find(aline.L_PARTKEY);
-	if( pvector != pKey_prices.end() ){
-	    pvector->second->push_back( theprice );
-	} else {
-	    vector<float>* v = new vector<float>();
-	    v->push_back( theprice );
-	    pKey_prices.insert(pair<int, vector<float>* > (aline.L_PARTKEY, v));
-	}
+	pKey_prices.get(aline.L_PARTKEY, 0.0) += theprice;
 	totalrevenue += theprice;
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
@@ -3176,11 +3158,9 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
     while(!eof){
 	prpart->get_value(4, apart.P_TYPE, 25);
 	prpart->get_value(0, apart.P_PARTKEY);
-	map<int,vector<float>* >::iterator temp=pKey_prices.find(apart.P_PARTKEY);
-	if( strstr(apart.P_TYPE, "PROMO") != NULL && temp != pKey_prices.end() ){
-	    for(int i = 0; i < temp->second->size(); i++ ){
-		promorevenue += ( *( temp->second ) )[i];
-	    }
+	double* temp = pKey_prices.find(apart.P_PARTKEY);
+	if( strstr(apart.P_TYPE, "PROMO") != NULL && temp != NULL ){
+	    promorevenue += *temp;
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
@@ -3196,11 +3176,7 @@ w_rc_t ShoreTPCHEnv::xct_q14(const int /* xct_id */, q14_input_t& q14in)
  *
  ********************************************************************/
 
-struct suppliercmp {
-    bool operator()( const tpch_supplier_tuple& s1, const tpch_supplier_tuple& s2 ) const {
-	return s1.S_SUPPKEY < s2.S_SUPPKEY;
-    }
-};
+
 
 
 w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
@@ -3210,7 +3186,10 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
     assert (_initialized);
     assert (_loaded);
 
-    map<int,float> stream_id;
+    arena_t arena;
+    const double sf = get_sf();
+
+    dense_map_t<float> stream_id(arena, 1, sf_card(sf,SUPPLIERS));
 
     //phase 1 :create the view
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
@@ -3258,35 +3237,26 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	float theprice = aline.L_EXTENDEDPRICE *(1 - aline.L_DISCOUNT);
-	map<int, float>::iterator tmp =  stream_id.find(aline.L_SUPPKEY);
-	if(tmp != stream_id.end()){
-	    float s = tmp->second;
-	    s += theprice;
-	    stream_id[ aline.L_SUPPKEY ] = s;
-	}else{	   
-	    stream_id[aline.L_SUPPKEY] = theprice;
-	}
+	stream_id.get(aline.L_SUPPKEY, 0) += theprice;
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
 
-    float maxrev = stream_id.begin()->second;
-    for(map<int,float>::iterator iter = stream_id.begin();
-	iter != stream_id.end();
-	iter++) {
-	if( maxrev < iter->second ) {
-	    maxrev = iter->second;
-	}
+    if (stream_id.empty()) {
+	return RCOK;
     }
-    for(map<int,float>::iterator iter = stream_id.begin();
+
+    float maxrev = stream_id.begin().value();
+    for(dense_map_t<float>::iterator iter = stream_id.begin();
 	iter != stream_id.end();
-	iter++) {
-	if(iter->second != maxrev) {
-	   stream_id.erase(iter);
+	++iter) {
+	if( maxrev < iter.value() ) {
+	    maxrev = iter.value();
 	}
     }
-    
-    //phase 2 joining with supply table: indexscan
-    map<tpch_supplier_tuple, int, suppliercmp> supprev;
+
+    //phase 2 joining with supply table: indexscan, the suppliers with
+    //the max revenue only, in supplier key order
+    vector< pair<tpch_supplier_tuple, int> > supprev;
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
    
@@ -3295,15 +3265,19 @@ w_rc_t ShoreTPCHEnv::xct_q15(const int /* xct_id */, q15_input_t& q15in)
     
     prsupp->_rep = &sreprow;
     
-    for(map<int,float>::iterator iter = stream_id.begin();
+    for(dense_map_t<float>::iterator iter = stream_id.begin();
 	iter != stream_id.end();
-	iter++){
-	_psupplier_man->s_index_probe(_pssm, prsupp, iter->first);
+	++iter){
+	if(iter.value() != maxrev) {
+	    continue;
+	}
+	_psupplier_man->s_index_probe(_pssm, prsupp, iter.key());
 	tpch_supplier_tuple asupp;
+	asupp.S_SUPPKEY = iter.key();
 	prsupp->get_value(1, asupp.S_NAME, 25);
 	prsupp->get_value(2, asupp.S_ADDRESS, 40);
 	prsupp->get_value(4, asupp.S_PHONE, 15);
-	supprev[asupp] = iter->second;
+	supprev.push_back(make_pair(asupp, (int)iter.value()));
     }
     
     return RCOK;    
@@ -3334,11 +3308,15 @@ public:
     required_type(){}
 };
 
-struct required_type_cmp {
+struct required_type_hash {
+    uint32_t operator()( const required_type& r ) const {
+	return (hash_combine(hash_combine(r.brand, r.type), r.size));
+    }
+};
+
+struct required_type_equal {
     bool operator()( const required_type& r1, const required_type& r2 ) const {
-	return ( (r1.brand < r2.brand) ||
-		 (r1.brand == r2.brand && r1.type < r2.type)||
-		 (r1.brand == r2.brand && r1.type == r2.type && r1.size < r2.size) );
+	return ( r1.brand == r2.brand && r1.type == r2.type && r1.size == r2.size );
     }
 };
 
@@ -3350,8 +3328,11 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase#1 table_scan part
-    map<int, required_type> pKeys_type;
+    dense_map_t<required_type> pKeys_type(arena, 1, sf_card(sf,PARTS));
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -3386,7 +3367,8 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
 	if( brand != q16in.p_brand &&  type != q16in.p_type){
 	    for(int i = 0; i < 8; i++) {
 		if( q16in.p_size[i] == psize){
-		    pKeys_type[apart.P_PARTKEY]=required_type(brand, psize, type);
+		    pKeys_type.insert(apart.P_PARTKEY,
+				      required_type(brand, psize, type));
 		    break;
 		}
 	    }
@@ -3395,7 +3377,8 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
     }
 
     //phase#2 table scan supplier
-    map<int,bool> suppkeybl; //supplier's key black list
+    //supplier's key black list
+    dense_map_t<bool> suppkeybl(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -3422,14 +3405,15 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
 	char* p2 = strstr(asupplier.S_COMMENT, "Complaints");
 	if( p1!= NULL && p2 != NULL){
 	    if( p2 - p1 > 0 ) {
-		suppkeybl[asupplier.S_SUPPKEY] = true;
+		suppkeybl.insert(asupplier.S_SUPPKEY, true);
 	    }
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
 
     //phase#3 table scan ps
-    map<required_type, int, required_type_cmp> suppcount;
+    hash_map_t<required_type, int, required_type_hash, required_type_equal>
+	suppcount(arena, pKeys_type.size());
 
     tuple_guard<partsupp_man_impl> prpartsupp(_ppartsupp_man);
 
@@ -3452,17 +3436,9 @@ w_rc_t ShoreTPCHEnv::xct_q16(const int /* xct_id */, q16_input_t& q16in)
     while(!eof){
 	prpartsupp->get_value(0, apartsupp.PS_PARTKEY);
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
-	map<int, required_type>::iterator tmpiter;
-	if((tmpiter = pKeys_type.find(apartsupp.PS_PARTKEY))!=pKeys_type.end() &&
-	   suppkeybl.find(apartsupp.PS_SUPPKEY) == suppkeybl.end()){
-	    map<required_type, int, required_type_cmp>::iterator tmpiter2;
-	    if((tmpiter2 = suppcount.find(tmpiter->second))!= suppcount.end()){
-		int c = tmpiter2->second;
-		c++;
-		suppcount[tmpiter2->first] = c;
-	    } else {
-		suppcount[tmpiter2->first] = 1;
-	    }		
+	required_type* ptype = pKeys_type.find(apartsupp.PS_PARTKEY);
+	if(ptype != NULL && !suppkeybl.contains(apartsupp.PS_SUPPKEY)){
+	    suppcount.get(*ptype, 0)++;
 	}
 	W_DO(ps_iter->next(_pssm, eof, *prpartsupp));
     }
@@ -3485,8 +3461,12 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase#1 table scan part
-    map<int, vector<pair<int,int> >* > pKey_lineitems;
+    dense_map_t< arena_list_t<pair<int,int> > >
+	pKey_lineitems(arena, 1, sf_card(sf,PARTS));
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -3516,8 +3496,7 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
 	int container = str_to_containers1(s1)*10+
 	    str_to_containers2(strtok(NULL," "));
 	if(brand == q17in.p_brand && container == q17in.p_container){
-	    vector<pair<int,int> > * v = new vector<pair<int,int> > ();
-	    pKey_lineitems[apart.P_PARTKEY] = v;
+	    pKey_lineitems.get(apart.P_PARTKEY);
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
@@ -3545,36 +3524,36 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
 	prlineitem->get_value(1, aline.L_PARTKEY);
 	prlineitem->get_value(5, aline.L_EXTENDEDPRICE);
 	prlineitem->get_value(4, aline.L_QUANTITY);
-	map<int, vector<pair<int,int> >* >::iterator tmpiter;
-	tmpiter = pKey_lineitems.find(aline.L_PARTKEY);
-	if(tmpiter != pKey_lineitems.end()){
-	    tmpiter->second->push_back(pair<int,int>
-				       (aline.L_EXTENDEDPRICE, aline.L_QUANTITY));
+	arena_list_t<pair<int,int> >* lines =
+	    pKey_lineitems.find(aline.L_PARTKEY);
+	if(lines != NULL){
+	    lines->push(arena, pair<int,int>
+			(aline.L_EXTENDEDPRICE, aline.L_QUANTITY));
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
 
     //phase#3 compute the scalar
     double sum = 0;
-    for(map<int, vector<pair<int,int> >* >::iterator iter=pKey_lineitems.begin();
+    typedef arena_list_t<pair<int,int> > q17_lines_t;
+    for(dense_map_t<q17_lines_t>::iterator iter=pKey_lineitems.begin();
 	iter != pKey_lineitems.end();
-	iter++){
-	if(iter->second->size() == 0){
-	    delete (iter->second);
+	++iter){
+	const q17_lines_t& lines = iter.value();
+	if(lines.size() == 0){
 	    continue;
 	}
 	double avg = 0;
-	for(int i=0; i< iter->second->size(); i++){
-	    avg+= (*(iter->second))[i].second;
+	for(const q17_lines_t::node_t* n = lines.head(); n; n = n->_next){
+	    avg+= n->_value.second;
 	}
-	avg /= iter->second->size();
+	avg /= lines.size();
 	avg *= .2;
-	for(int i=0; i< iter->second->size(); i++){
-	    if((*(iter->second))[i].second < avg){
-		sum += (*(iter->second))[i].first;
+	for(const q17_lines_t::node_t* n = lines.head(); n; n = n->_next){
+	    if(n->_value.second < avg){
+		sum += n->_value.first;
 	    }
 	}
-	delete (iter->second);
     }
 
     return RCOK;
@@ -3590,12 +3569,12 @@ w_rc_t ShoreTPCHEnv::xct_q17(const int /* xct_id */, q17_input_t& q17in )
 struct Q18_row{
     char c_name [25];
     int c_key;
-    time_t o_orderdate;
+    int o_orderdate; // day number
     decimal o_totalprice;
 
     Q18_row(){}
     
-    Q18_row(char* name, int key, time_t date, decimal price){
+    Q18_row(char* name, int key, int date, decimal price){
 
 	strcpy(c_name, name);
 	c_key = key;
@@ -3619,8 +3598,10 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
 
     prlineitem->_rep = &lreprow;
     
-    map<int, int> order_Squant;
-    map<int, Q18_row> result;
+    arena_t arena;
+    const double sf = get_sf();
+
+    hash_map_t<int, int> order_Squant(arena, sf_card(sf,ORDERS));
 
     guard< table_scan_iter_impl<lineitem_t> > l_iter;
     {
@@ -3637,14 +3618,7 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
 	prlineitem->get_value(4, aline.L_QUANTITY);
-	map<int,int>::iterator iter = order_Squant.find( aline.L_ORDERKEY);
-	if( iter != order_Squant.end()){
-	    int c = iter->second;
-	    c+= aline.L_QUANTITY;
-	    order_Squant[aline.L_ORDERKEY] = c;
-	} else {
-	    order_Squant[aline.L_ORDERKEY] = aline.L_QUANTITY;
-	}
+	order_Squant.get(aline.L_ORDERKEY, 0) += aline.L_QUANTITY;
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
 
@@ -3664,39 +3638,41 @@ w_rc_t ShoreTPCHEnv::xct_q18(const int /* xct_id */, q18_input_t& q18in)
     lowrep.set(_pcustomer_desc->maxsize());
     highrep.set(_pcustomer_desc->maxsize());
 
-    for(map<int,int>::iterator it = order_Squant.begin();
+    // a few large orders
+    hash_map_t<int, Q18_row> result(arena, 64);
+
+    for(hash_map_t<int,int>::iterator it = order_Squant.begin();
 	it != order_Squant.end();
-	it++){
+	++it){
 	// index scan order
 	tpch_orders_tuple anorder;
-	if( it->second > q18in.l_quantity){
+	if( it.value() > q18in.l_quantity){
 	    guard<index_scan_iter_impl<orders_t> > o_iter;
 	    {
 		index_scan_iter_impl<orders_t>* tmp_o_iter;
 		W_DO(_porders_man->o_get_iter_by_index(_pssm, tmp_o_iter,
 						       prorders, lowrep, highrep,
-						       it->first));
+						       it.key()));
 		o_iter = tmp_o_iter;
 	    }
-	    
+
 	    bool eof;
-	    
+
 	    W_DO(o_iter->next(_pssm, eof, *prorders));
 	    prorders->get_value(1, anorder.O_CUSTKEY);
 	    prorders->get_value(3, anorder.O_TOTALPRICE);
-	    prorders->get_value(4, anorder.O_ORDERDATE, 15);
+	    prorders->get_value(4, anorder.O_ORDERDATE);
+
+	    //index proble customer
+	    tpch_customer_tuple acustomer;
+	    _pcustomer_man->c_index_probe(_pssm, prcustomer, anorder.O_CUSTKEY);
+	    prcustomer->get_value(1, acustomer.C_NAME, 25);
+	    _pcustomer_man->give_tuple(prcustomer);
+	    result.insert(it.key(), Q18_row(acustomer.C_NAME,
+					    anorder.O_CUSTKEY,
+					    anorder.O_ORDERDATE,
+					    anorder.O_TOTALPRICE));
 	}
-	
-	//index proble customer
-	time_t the_orderdate = str_to_timet(anorder.O_ORDERDATE);     
-	tpch_customer_tuple acustomer;
-	_pcustomer_man->c_index_probe(_pssm, prcustomer, anorder.O_CUSTKEY);
-	prcustomer->get_value(1, acustomer.C_NAME, 25);
-	_pcustomer_man->give_tuple(prcustomer);
-	result.insert(pair<int,Q18_row>(it->first,Q18_row(acustomer.C_NAME,
-							  anorder.O_CUSTKEY,
-							  the_orderdate,
-							  anorder.O_TOTALPRICE)));
     }
 
     return RCOK;
@@ -3717,8 +3693,11 @@ w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase#1: table scan Part
-    map<int, int> partkey_brand;
+    dense_map_t<int> partkey_brand(arena, 1, sf_card(sf,PARTS));
     double revenue = 0;
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
@@ -3753,21 +3732,21 @@ w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
 	      strcmp( apart.P_CONTAINER, "SM PACK") == 0 ||
 	      strcmp( apart.P_CONTAINER, "SM PKG") == 0 ) &&
 	    size > 1 && size < 5 ){
-	    partkey_brand.insert( pair<int,int>(apart.P_PARTKEY, 1));
+	    partkey_brand.insert(apart.P_PARTKEY, 1);
 	} else if( brand == q19in.p_brand[1] &&
 		   ( strcmp( apart.P_CONTAINER, "MED BAG") ||
 		     strcmp( apart.P_CONTAINER, "MED BOX") ||
 		     strcmp( apart.P_CONTAINER, "MED PKG") ||
 		     strcmp( apart.P_CONTAINER, "MED PACK") ) &&
 		   size > 1 && size < 10){
-	    partkey_brand.insert( pair<int,int> (apart.P_PARTKEY, 2));
+	    partkey_brand.insert(apart.P_PARTKEY, 2);
 	} else if( brand == q19in.p_brand[2] &&
 		   ( strcmp( apart.P_CONTAINER, "MED BAG") ||
 		     strcmp( apart.P_CONTAINER, "MED BAG") ||
 		     strcmp( apart.P_CONTAINER, "MED BAG") ||
 		     strcmp( apart.P_CONTAINER, "MED BAG") ) &&
 		   size > 1 && size < 15 ){
-	    partkey_brand.insert( pair<int,int> (apart.P_PARTKEY, 3));
+	    partkey_brand.insert(apart.P_PARTKEY, 3);
 	} 
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
@@ -3798,13 +3777,13 @@ w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
 	prlineitem->get_value(6, aline.L_DISCOUNT);
 	prlineitem->get_value(13, aline.L_SHIPINSTRUCT, 25);
 	prlineitem->get_value(14, aline.L_SHIPMODE, 10);
-	map<int,int>::iterator iter = partkey_brand.find( aline.L_PARTKEY );
-	if(iter != partkey_brand.end() &&
+	int* pbrand = partkey_brand.find( aline.L_PARTKEY );
+	if(pbrand != NULL &&
 	   ( strcmp( aline.L_SHIPMODE, "AIR") == 0 ||
 	     strcmp( aline.L_SHIPMODE, "AIR REG") == 0 ) &&
 	   strcmp( aline.L_SHIPINSTRUCT, "DELIVER IN PERSON") == 0 &&
-	   aline.L_QUANTITY  >= q19in.l_quantity[iter->second-1] &&
-	   aline.L_QUANTITY <= q19in.l_quantity[iter->second-1] + 10 ){
+	   aline.L_QUANTITY  >= q19in.l_quantity[*pbrand-1] &&
+	   aline.L_QUANTITY <= q19in.l_quantity[*pbrand-1] + 10 ){
 	    revenue += aline.L_EXTENDEDPRICE * ( 1 - aline.L_DISCOUNT );
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
@@ -3821,9 +3800,9 @@ w_rc_t ShoreTPCHEnv::xct_q19(const int /* xct_id */, q19_input_t& q19in)
  *
  ********************************************************************/
 
-struct int_pair_cmp {
-    bool operator()( const pair<int,int>& r1, const pair<int,int>& r2 ) const {
-	return (r1.first < r2.first || ( r1.first == r2.first && r1.second < r2.second)) ;
+struct int_pair_hash {
+    uint32_t operator()( const pair<int,int>& r ) const {
+	return (hash_combine(r.first, r.second));
     }
 };
 
@@ -3838,8 +3817,11 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
     char p_name[55];
     pname_to_str(q20in.p_color, p_name);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase#1 :table scan part
-    map<int,bool> partkey;
+    dense_map_t<bool> partkey(arena, 1, sf_card(sf,PARTS));
 
     tuple_guard<part_man_impl> prpart(_ppart_man);
 
@@ -3865,13 +3847,15 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 	prpart->get_value(1, apart.P_NAME, 55);
 	char* s1 = strtok(apart.P_NAME, " ");
 	if( strcmp( s1, p_name) == 0 ) {
-	    partkey.insert(pair<int, bool> (apart.P_PARTKEY, 1));
+	    partkey.insert(apart.P_PARTKEY, true);
 	}
 	W_DO(p_iter->next(_pssm, eof, *prpart));
     }
   
     //phase#2 table scan ps
-    map<pair<int,int>, pair<int,int>, int_pair_cmp> supppart_avquant_sumquant;
+    // four suppliers per part
+    hash_map_t<pair<int,int>, pair<int,int>, int_pair_hash>
+	supppart_avquant_sumquant(arena, 4*partkey.size());
 
     tuple_guard<partsupp_man_impl> prpartsupp(_ppartsupp_man);
 
@@ -3895,11 +3879,10 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 	prpartsupp->get_value(0, apartsupp.PS_PARTKEY);
 	prpartsupp->get_value(1, apartsupp.PS_SUPPKEY);
 	prpartsupp->get_value(2, apartsupp.PS_AVAILQTY);
-	if( partkey.find(apartsupp.PS_PARTKEY) != partkey.end() ){
-	    pair< pair <int, int>,pair<int,int> > tmp
-		(pair<int,int>( apartsupp.PS_SUPPKEY, apartsupp.PS_SUPPKEY),
+	if( partkey.contains(apartsupp.PS_PARTKEY) ){
+	    supppart_avquant_sumquant.insert
+		(pair<int,int>( apartsupp.PS_PARTKEY, apartsupp.PS_SUPPKEY),
 		 pair<int,int>( apartsupp.PS_AVAILQTY, 0) );
-	    supppart_avquant_sumquant.insert(tmp);
 	}
 	W_DO(ps_iter->next(_pssm, eof, *prpartsupp));
     }
@@ -3944,28 +3927,24 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 	prlineitem->get_value(1, aline.L_PARTKEY);
 	prlineitem->get_value(2, aline.L_SUPPKEY);
 	prlineitem->get_value(4, aline.L_QUANTITY);
-	map< pair<int,int>, pair<int,int>, int_pair_cmp >::iterator it =
+	pair<int,int>* avquant_sumquant =
 	    supppart_avquant_sumquant.find(pair<int,int>
 					   (aline.L_PARTKEY, aline.L_SUPPKEY));
-	if( it != supppart_avquant_sumquant.end()){
-	    int c = it->second.second;
-	    c+= aline.L_QUANTITY;
-	    supppart_avquant_sumquant[ pair<int,int>(aline.L_PARTKEY,
-						     aline.L_SUPPKEY)]=
-		pair<int,int>( it->second.first, c);	       
+	if( avquant_sumquant != NULL){
+	    avquant_sumquant->second += aline.L_QUANTITY;
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
     
     //phase#4 : compare the available_quantity with sumof_quantity
-    map<int, bool> suppkey;
-    map< pair<int,int>, pair<int, int> > :: iterator it =
-	supppart_avquant_sumquant.begin();
-    while( it != supppart_avquant_sumquant.end()){
-	if( it->second.first > .5 * it->second.second ){
-	    suppkey.insert( pair<int,bool>(it->first.first, true));
+    dense_map_t<bool> suppkey(arena, 1, sf_card(sf,SUPPLIERS));
+    for(hash_map_t<pair<int,int>, pair<int,int>, int_pair_hash>::iterator it =
+	    supppart_avquant_sumquant.begin();
+	it != supppart_avquant_sumquant.end();
+	++it){
+	if( it.value().first > .5 * it.value().second ){
+	    suppkey.insert(it.key().second, true);
 	}
-	it++;
     }
 
     //phase#5 : look for the nationkey of [NATION]
@@ -3979,10 +3958,10 @@ w_rc_t ShoreTPCHEnv::xct_q20(const int /* xct_id */, q20_input_t& q20in)
 
     prsupp->_rep = &sreprow;
 
-    for(map<int,bool>::iterator iter = suppkey.begin();
+    for(dense_map_t<bool>::iterator iter = suppkey.begin();
 	iter != suppkey.end();
-	iter++){
-       _psupplier_man->s_index_probe(_pssm, prsupp, iter->first);
+	++iter){
+       _psupplier_man->s_index_probe(_pssm, prsupp, iter.key());
        tpch_supplier_tuple asupp;
        prsupp->get_value(1, asupp.S_NAME, 25);
        prsupp->get_value(2, asupp.S_ADDRESS, 40);
@@ -4010,8 +3989,11 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase#1 scan supplier_t for supps which s_nationkey == q21.in
-    map<int, string> suppkey;
+    dense_map_t<bool> suppkey(arena, 1, sf_card(sf,SUPPLIERS));
 
     tuple_guard<supplier_man_impl> prsupp(_psupplier_man);
 
@@ -4034,17 +4016,15 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
 
     while(!eof){
 	prsupp->get_value(0, asupplier.S_SUPPKEY);
-	prsupp->get_value(1, asupplier.S_NAME,25);
 	prsupp->get_value(3, asupplier.S_NATIONKEY);
 	if( asupplier.S_NATIONKEY == q21in.n_name){
-	    suppkey.insert(pair<int,string>
-			   ( asupplier.S_SUPPKEY, string(asupplier.S_NAME)));
+	    suppkey.insert(asupplier.S_SUPPKEY, true);
 	}
 	W_DO(s_iter->next(_pssm, eof, *prsupp));
     }
 
     //phase#2 : scan order for tuples which stat = 'F'
-    map<int,bool> orderkey;
+    hash_map_t<int,bool> orderkey(arena, sf_card(sf,ORDERS/2));
 
     tuple_guard<orders_man_impl> prorder(_porders_man);
     
@@ -4068,15 +4048,17 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
 	prorder->get_value(0, anorder.O_ORDERKEY);
 	prorder->get_value(2, anorder.O_ORDERSTATUS);
 	if( anorder.O_ORDERSTATUS == 'F' ) {
-	    orderkey.insert( pair <int,bool> (anorder.O_ORDERKEY, true) );
+	    orderkey.insert(anorder.O_ORDERKEY, true);
 	}
 	W_DO(o_iter->next(_pssm, eof, *prorder));
     }
 
     //table scan lineitem for delayed tuples
     vector<pair<int,int> > suppkey_orderkey;
-    map<int,int> multiOrders;
-    map<int,int> delay2order; //orders with more than 2 supp delay for them
+    //the supplier of each order, -1 if it has more than one
+    hash_map_t<int,int> multiOrders(arena, orderkey.size());
+    //the supplier that delayed each order, -1 if more than one did
+    hash_map_t<int,int> delay2order(arena, sf_card(sf,ORDERS/20));
 
     tuple_guard<lineitem_man_impl> prlineitem(_plineitem_man);
 
@@ -4099,44 +4081,32 @@ w_rc_t ShoreTPCHEnv::xct_q21(const int /* xct_id */, q21_input_t& q21in)
     while (!eof) {
 	prlineitem->get_value(0, aline.L_ORDERKEY);
 	prlineitem->get_value(2, aline.L_SUPPKEY);	    
-	prlineitem->get_value(11, aline.L_COMMITDATE, 15);
-	prlineitem->get_value(12, aline.L_RECEIPTDATE, 15);
-	time_t the_commitdate = str_to_timet(aline.L_COMMITDATE);
-	time_t the_receiptdate = str_to_timet(aline.L_RECEIPTDATE);
-	if( orderkey.find(aline.L_ORDERKEY) != orderkey.end()){
-	    if (the_commitdate < the_receiptdate &&
-		suppkey.find(aline.L_SUPPKEY) != suppkey.end()){
+	prlineitem->get_value(11, aline.L_COMMITDATE);
+	prlineitem->get_value(12, aline.L_RECEIPTDATE);
+	if( orderkey.contains(aline.L_ORDERKEY) ){
+	    if (aline.L_COMMITDATE < aline.L_RECEIPTDATE &&
+		suppkey.contains(aline.L_SUPPKEY)){
 		suppkey_orderkey.push_back(pair<int,int>
 					   (aline.L_SUPPKEY, aline.L_ORDERKEY));
-		map<int,int>::iterator it = delay2order.find(aline.L_ORDERKEY);
-		if (it != delay2order.end() && it->second != aline.L_SUPPKEY){
-		    delay2order[it->first] = -1;
-		} else {
-		    delay2order[it->first] = aline.L_SUPPKEY;
+		int& delayed = delay2order.get(aline.L_ORDERKEY, aline.L_SUPPKEY);
+		if (delayed != aline.L_SUPPKEY){
+		    delayed = -1;
 		}
 	    }
-	    map<int,int>::iterator it = multiOrders.find(aline.L_ORDERKEY);
-	    if (it != multiOrders.end() && it->second != aline.L_SUPPKEY){
-		multiOrders[it->first] = -1;
-	    } else {
-		multiOrders[it->first] = aline.L_SUPPKEY;
+	    int& supp = multiOrders.get(aline.L_ORDERKEY, aline.L_SUPPKEY);
+	    if (supp != aline.L_SUPPKEY){
+		supp = -1;
 	    }
 	}
 	W_DO(l_iter->next(_pssm, eof, *prlineitem));
     }
     
     //final phase: computing the scalar
-    map<int,int> supK_numwait;    
-    for(int i = 0; i < suppkey_orderkey.size(); i++){
-	if( multiOrders[suppkey_orderkey[i].second] == -1 &&
-	    delay2order[suppkey_orderkey[i].second] != -1) {
-	    if(supK_numwait.find(suppkey_orderkey[i].first)!=supK_numwait.end()){
-		int n = supK_numwait.find(suppkey_orderkey[i].first)->second;
-		n++;
-		supK_numwait[suppkey_orderkey[i].first] = n;
-	    } else {
-		supK_numwait[suppkey_orderkey[i].first] = 1;
-	    }
+    dense_map_t<int> supK_numwait(arena, 1, sf_card(sf,SUPPLIERS));
+    for(uint i = 0; i < suppkey_orderkey.size(); i++){
+	if( *multiOrders.find(suppkey_orderkey[i].second) == -1 &&
+	    *delay2order.find(suppkey_orderkey[i].second) != -1) {
+	    supK_numwait.get(suppkey_orderkey[i].first, 0)++;
 	}
     }
    
@@ -4158,8 +4128,12 @@ w_rc_t ShoreTPCHEnv::xct_q22(const int /* xct_id */, q22_input_t& q22in)
     assert (_initialized);
     assert (_loaded);
 
+    arena_t arena;
+    const double sf = get_sf();
+
     //phase#1 tablescan customer: <ckey,acctbal,code> and AVG(acctbal)
-    map<int, pair<decimal,int> > ckey_acbalCcode;
+    dense_map_t< pair<decimal,int> >
+	ckey_acbalCcode(arena, 1, sf_card(sf,CUSTOMERS));
     decimal bal_avg = 0;
 
     tuple_guard<customer_man_impl> prcustomer(_pcustomer_man);
@@ -4189,9 +4163,8 @@ w_rc_t ShoreTPCHEnv::xct_q22(const int /* xct_id */, q22_input_t& q22in)
 	int c_cntrycode =  atoi( c_cntrycode_str);
 	for(int i = 0; i < 7; i++ ){
 	    if( q22in.cntrycode[i] == c_cntrycode){
-		ckey_acbalCcode.insert( pair<int,  pair<decimal,int> >
-					(acust.C_CUSTKEY, pair<decimal,int>
-					 (acust.C_ACCTBAL, c_cntrycode)));
+		ckey_acbalCcode.insert(acust.C_CUSTKEY, pair<decimal,int>
+				       (acust.C_ACCTBAL, c_cntrycode));
 		bal_avg += acust.C_ACCTBAL;
 		break;
 	    }
@@ -4203,7 +4176,8 @@ w_rc_t ShoreTPCHEnv::xct_q22(const int /* xct_id */, q22_input_t& q22in)
     
     //phase#2 index scan order
     //scalar: numof customer, total balance
-    map<int, pair<int, decimal> > cntrycode_scalars; 
+    //the country codes are 10 to 34
+    dense_map_t< pair<int, decimal> > cntrycode_scalars(arena, 0, 34);  
 
     tuple_guard<orders_man_impl> prorders(_porders_man);
 
@@ -4218,34 +4192,28 @@ w_rc_t ShoreTPCHEnv::xct_q22(const int /* xct_id */, q22_input_t& q22in)
     lowrep.set(_porders_desc->maxsize());
     highrep.set(_porders_desc->maxsize());
 
-    map<int, pair<decimal,int> >::iterator it =  ckey_acbalCcode.begin();
-    while(it != ckey_acbalCcode.end()){
+    for(dense_map_t< pair<decimal,int> >::iterator it = ckey_acbalCcode.begin();
+	it != ckey_acbalCcode.end();
+	++it){
+	const pair<decimal,int>& acbal_ccode = it.value();
 	guard<index_scan_iter_impl<orders_t> > o_iter;
 	{
 	    index_scan_iter_impl<orders_t>* tmp_o_iter;
 	    W_DO(_porders_man->o_get_iter_by_findex(_pssm, tmp_o_iter, prorders,
-						    lowrep, highrep, it->first));
+						    lowrep, highrep, it.key()));
 	    o_iter = tmp_o_iter;
 	}
 	
 	bool eof;
 	W_DO(o_iter->next(_pssm, eof, *prorders));
 
-	if(!eof && it->second.first > bal_avg){
-	    map<int, pair<int,decimal> >::iterator tmp =
-		cntrycode_scalars.find( it->second.second);
-	    if(tmp != cntrycode_scalars.end()){
-		int c = tmp->second.first;
-		decimal t = tmp->second.second;
-		c++;
-		t+= it->second.first;
-		cntrycode_scalars[it->second.second] = pair<int, decimal> (c, t);
-	    } else {
-		cntrycode_scalars[it->second.second] = pair<int, decimal>
-		    (1, it->second.first);
-	    }
+	if(!eof && acbal_ccode.first > bal_avg){
+	    pair<int,decimal>& scalars =
+		cntrycode_scalars.get(acbal_ccode.second,
+				      pair<int,decimal>(0, decimal(0)));
+	    scalars.first++;
+	    scalars.second += acbal_ccode.first;
 	}       
-	it++;
     }
 
     return RCOK;